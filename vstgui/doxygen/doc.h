@@ -74,6 +74,7 @@ Debian/Ubuntu based distribution:
 - libxcb-cursor-dev
 - libxcb-keysyms1-dev
 - libxcb-xkb-dev
+- libxcb-shm0-dev
 - libxkbcommon-dev
 - libxkbcommon-x11-dev
 - libfontconfig1-dev
@@ -0,0 +1,271 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "bitmapcache.h"
+#include "cbitmap.h"
+#include "platform/iplatformbitmap.h"
+#include <atomic>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace BitmapCache {
+namespace {
+
+//------------------------------------------------------------------------
+struct Entry
+{
+	CBitmap* bitmap;
+	size_t index;
+	const IPlatformBitmap* platformBitmap;
+	size_t bytes;
+};
+
+//------------------------------------------------------------------------
+struct Key
+{
+	const CBitmap* bitmap;
+	size_t index;
+
+	bool operator== (const Key& other) const
+	{
+		return bitmap == other.bitmap && index == other.index;
+	}
+};
+
+//------------------------------------------------------------------------
+struct KeyHash
+{
+	size_t operator() (const Key& key) const
+	{
+		return std::hash<const CBitmap*> () (key.bitmap) ^ (key.index * 0x9e3779b97f4a7c15ull);
+	}
+};
+
+//------------------------------------------------------------------------
+struct Cache
+{
+	using EntryList = std::list<Entry>;
+
+	static Cache& instance ()
+	{
+		static Cache gInstance;
+		return gInstance;
+	}
+
+	// bitmaps may be drawn on multiple threads, so every access must hold the mutex
+	std::recursive_mutex mutex;
+	// the most recently drawn entry is the first one
+	EntryList entries;
+	std::unordered_map<Key, EntryList::iterator, KeyHash> map;
+	// a platform bitmap shared by several bitmaps has one entry per bitmap but is counted once
+	std::unordered_map<const IPlatformBitmap*, uint32_t> numEntries;
+	// read without the lock to decide if bitmaps are tracked at all
+	std::atomic<size_t> budget {0};
+	double drawScaleFactor {0.};
+	Statistics statistics;
+
+	static size_t bytesOf (const IPlatformBitmap* platformBitmap)
+	{
+		auto size = platformBitmap->getSize ();
+		return static_cast<size_t> (size.x) * static_cast<size_t> (size.y) * 4;
+	}
+
+	void erase (EntryList::iterator it)
+	{
+		auto count = numEntries.find (it->platformBitmap);
+		if (--count->second == 0)
+		{
+			numEntries.erase (count);
+			statistics.residentBytes -= it->bytes;
+			--statistics.numResident;
+		}
+		map.erase ({it->bitmap, it->index});
+		entries.erase (it);
+	}
+
+	void add (CBitmap* bitmap, size_t index, const IPlatformBitmap* platformBitmap)
+	{
+		auto it = map.find ({bitmap, index});
+		if (it != map.end ())
+			erase (it->second);
+		auto bytes = bytesOf (platformBitmap);
+		entries.push_front ({bitmap, index, platformBitmap, bytes});
+		map.emplace (Key {bitmap, index}, entries.begin ());
+		if (numEntries[platformBitmap]++ == 0)
+		{
+			statistics.residentBytes += bytes;
+			++statistics.numResident;
+		}
+	}
+
+	// a platform bitmap is unused if only the bitmaps which can reload it hold a reference
+	bool isUnused (const Entry& entry) const
+	{
+		auto count = numEntries.find (entry.platformBitmap);
+		return static_cast<uint32_t> (entry.platformBitmap->getNbReference ()) == count->second;
+	}
+
+	void release (const IPlatformBitmap* platformBitmap)
+	{
+		std::vector<EntryList::iterator> owners;
+		for (auto it = entries.begin (); it != entries.end (); ++it)
+		{
+			if (it->platformBitmap == platformBitmap)
+				owners.emplace_back (it);
+		}
+		for (auto& it : owners)
+		{
+			auto bitmap = it->bitmap;
+			auto index = it->index;
+			erase (it);
+			Access::release (bitmap, index);
+			++statistics.numReleased;
+		}
+		++statistics.evictions;
+	}
+
+	bool releaseLeastRecentlyUsed (bool onlyOtherScaleFactors)
+	{
+		for (auto it = entries.rbegin (); it != entries.rend (); ++it)
+		{
+			if (onlyOtherScaleFactors &&
+				(drawScaleFactor == 0. || it->platformBitmap->getScaleFactor () == drawScaleFactor))
+				continue;
+			if (!isUnused (*it))
+				continue;
+			release (it->platformBitmap);
+			return true;
+		}
+		return false;
+	}
+
+	void shrinkTo (size_t bytes)
+	{
+		while (statistics.residentBytes > bytes)
+		{
+			if (!releaseLeastRecentlyUsed (true) && !releaseLeastRecentlyUsed (false))
+				break;
+		}
+	}
+
+	void shrinkToBudget ()
+	{
+		if (auto bytes = budget.load ())
+			shrinkTo (bytes);
+	}
+};
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+void setMemoryBudget (size_t bytes)
+{
+	auto& cache = Cache::instance ();
+	std::lock_guard<std::recursive_mutex> guard (cache.mutex);
+	cache.budget = bytes;
+	cache.shrinkToBudget ();
+}
+
+//------------------------------------------------------------------------
+size_t getMemoryBudget ()
+{
+	return Cache::instance ().budget;
+}
+
+//------------------------------------------------------------------------
+Statistics getStatistics ()
+{
+	auto& cache = Cache::instance ();
+	std::lock_guard<std::recursive_mutex> guard (cache.mutex);
+	return cache.statistics;
+}
+
+//------------------------------------------------------------------------
+void resetStatistics ()
+{
+	auto& cache = Cache::instance ();
+	std::lock_guard<std::recursive_mutex> guard (cache.mutex);
+	cache.statistics.evictions = 0;
+	cache.statistics.reloads = 0;
+}
+
+//------------------------------------------------------------------------
+void purge ()
+{
+	auto& cache = Cache::instance ();
+	std::lock_guard<std::recursive_mutex> guard (cache.mutex);
+	cache.shrinkTo (0);
+}
+
+//------------------------------------------------------------------------
+std::unique_lock<std::recursive_mutex> Access::lock ()
+{
+	return std::unique_lock<std::recursive_mutex> (Cache::instance ().mutex);
+}
+
+//------------------------------------------------------------------------
+void Access::add (CBitmap* bitmap, size_t index, const IPlatformBitmap* platformBitmap,
+				  bool reloaded)
+{
+	auto& cache = Cache::instance ();
+	cache.add (bitmap, index, platformBitmap);
+	if (reloaded)
+	{
+		--cache.statistics.numReleased;
+		++cache.statistics.reloads;
+	}
+	cache.shrinkToBudget ();
+}
+
+//------------------------------------------------------------------------
+void Access::remove (CBitmap* bitmap, size_t index)
+{
+	auto& cache = Cache::instance ();
+	auto it = cache.map.find ({bitmap, index});
+	if (it != cache.map.end ())
+		cache.erase (it->second);
+}
+
+//------------------------------------------------------------------------
+void Access::remove (CBitmap* bitmap)
+{
+	auto& cache = Cache::instance ();
+	for (auto it = cache.entries.begin (); it != cache.entries.end ();)
+	{
+		auto next = std::next (it);
+		if (it->bitmap == bitmap)
+			cache.erase (it);
+		it = next;
+	}
+}
+
+//------------------------------------------------------------------------
+void Access::forgetReleased ()
+{
+	--Cache::instance ().statistics.numReleased;
+}
+
+//------------------------------------------------------------------------
+void Access::use (CBitmap* bitmap, size_t index, double drawScaleFactor)
+{
+	auto& cache = Cache::instance ();
+	cache.drawScaleFactor = drawScaleFactor;
+	auto it = cache.map.find ({bitmap, index});
+	if (it != cache.map.end () && it->second != cache.entries.begin ())
+		cache.entries.splice (cache.entries.begin (), cache.entries, it->second);
+}
+
+//------------------------------------------------------------------------
+void Access::release (CBitmap* bitmap, size_t index)
+{
+	bitmap->releasePlatformBitmap (index);
+}
+
+//------------------------------------------------------------------------
+} // BitmapCache
+} // VSTGUI
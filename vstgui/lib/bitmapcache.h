@@ -0,0 +1,90 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "vstguifwd.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+/** Process wide memory budget of the platform bitmaps of CBitmap objects
+ *
+ *	A CBitmap knows how to load a platform bitmap again if it was created from a resource
+ *	description or if a reload function was set for it (see CBitmap::setReloadFunction). These
+ *	platform bitmaps are tracked here and when the resident bitmaps exceed the memory budget, the
+ *	least recently drawn ones which are not used anywhere else are released. A released bitmap is
+ *	loaded again the next time it is drawn.
+ *
+ *	Bitmaps of other scale factors than the one of the last draw call are released first, so a
+ *	frame shown on a standard resolution screen drops its high resolution bitmaps before its
+ *	standard ones.
+ *
+ *	The default budget is zero, which means no bitmap is ever released. Bitmaps only become
+ *	releasable when they are created or get a reload function while a budget is set, so the budget
+ *	must be set before the bitmaps are loaded. Without a budget the bitmaps are not tracked and
+ *	using them never takes the lock of the cache.
+ */
+namespace BitmapCache {
+
+//------------------------------------------------------------------------
+/** counters of the bitmap cache */
+struct Statistics
+{
+	/** memory held by the resident platform bitmaps in bytes */
+	size_t residentBytes {0};
+	/** number of resident platform bitmaps */
+	size_t numResident {0};
+	/** number of platform bitmaps which are currently released */
+	size_t numReleased {0};
+	/** number of platform bitmaps released to stay inside the memory budget */
+	uint64_t evictions {0};
+	/** number of platform bitmaps loaded again after they were released */
+	uint64_t reloads {0};
+};
+
+/** set the memory budget in bytes, zero disables releasing bitmaps */
+void setMemoryBudget (size_t bytes);
+/** get the memory budget in bytes, does not take the lock */
+size_t getMemoryBudget ();
+
+/** get the current statistics */
+Statistics getStatistics ();
+/** reset the eviction and reload counters */
+void resetStatistics ();
+
+/** release all platform bitmaps which are not in use */
+void purge ();
+
+/// @cond ignore
+//------------------------------------------------------------------------
+/** used by CBitmap to report its releasable platform bitmaps
+ *
+ *	All calls except lock need the lock. The mutex is recursive as reloading a bitmap may load the
+ *	bitmap it was shared with.
+ */
+struct Access
+{
+	static std::unique_lock<std::recursive_mutex> lock ();
+	/** add a resident platform bitmap, releases other bitmaps if the budget is exceeded */
+	static void add (CBitmap* bitmap, size_t index, const IPlatformBitmap* platformBitmap,
+					 bool reloaded);
+	/** remove the platform bitmap, it is not releasable anymore */
+	static void remove (CBitmap* bitmap, size_t index);
+	/** remove all platform bitmaps of the bitmap */
+	static void remove (CBitmap* bitmap);
+	/** the platform bitmap was released before and is removed from the released ones */
+	static void forgetReleased ();
+	/** mark the platform bitmap as the most recently drawn one */
+	static void use (CBitmap* bitmap, size_t index, double drawScaleFactor);
+	/** let the bitmap drop its platform bitmap */
+	static void release (CBitmap* bitmap, size_t index);
+};
+/// @endcond
+
+//------------------------------------------------------------------------
+} // BitmapCache
+} // VSTGUI
@@ -3,14 +3,32 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "cbitmap.h"
+#include "bitmapcache.h"
 #include "cdrawcontext.h"
 #include "ccolor.h"
 #include "platform/iplatformbitmap.h"
 #include "platform/platformfactory.h"
+#include <algorithm>
 #include <cassert>
+#include <string>
 
 namespace VSTGUI {
 
+//-----------------------------------------------------------------------------
+static CBitmap::ReloadFunc makeReloadFunction (const CResourceDescription& desc)
+{
+	if (desc.type == CResourceDescription::kStringType)
+	{
+		// the resource description does not own the name
+		std::string name (desc.u.name);
+		return [name] () {
+			return getPlatformFactory ().createBitmap (CResourceDescription (name.data ()));
+		};
+	}
+	auto id = desc.u.id;
+	return [id] () { return getPlatformFactory ().createBitmap (CResourceDescription (id)); };
+}
+
 //-----------------------------------------------------------------------------
 // CBitmap Implementation
 //-----------------------------------------------------------------------------
@@ -46,6 +64,18 @@ CBitmap::CBitmap (const CResourceDescription& desc)
 : resourceDesc (desc)
 {
 	if (auto platformBitmap = getPlatformFactory ().createBitmap (desc))
+	{
+		bitmaps.emplace_back (platformBitmap);
+		if (desc.type != CResourceDescription::kUnknownType && BitmapCache::getMemoryBudget ())
+			setReloadFunction (platformBitmap, makeReloadFunction (desc));
+	}
+}
+
+//-----------------------------------------------------------------------------
+CBitmap::CBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap)
+: resourceDesc (desc)
+{
+	if (platformBitmap)
 		bitmaps.emplace_back (platformBitmap);
 }
 
@@ -75,6 +105,20 @@ CBitmap::CBitmap (const PlatformBitmapPtr& platformBitmap)
 	bitmaps.emplace_back (platformBitmap);
 }
 
+//-----------------------------------------------------------------------------
+CBitmap::~CBitmap () noexcept
+{
+	if (releasables.empty ())
+		return;
+	auto lock = BitmapCache::Access::lock ();
+	BitmapCache::Access::remove (this);
+	for (const auto& releasable : releasables)
+	{
+		if (releasable.released)
+			BitmapCache::Access::forgetReleased ();
+	}
+}
+
 //-----------------------------------------------------------------------------
 void CBitmap::draw (CDrawContext* context, const CRect& rect, const CPoint& offset, float alpha)
 {
@@ -86,42 +130,85 @@ void CBitmap::draw (CDrawContext* context, const CRect& rect, const CPoint& offs
 //-----------------------------------------------------------------------------
 CCoord CBitmap::getWidth () const
 {
-	if (auto pb = getPlatformBitmap ())
-		return pb->getSize ().x / pb->getScaleFactor ();
-	return 0;
+	return getSize ().x;
 }
 
 //-----------------------------------------------------------------------------
 CCoord CBitmap::getHeight () const
 {
-	if (auto pb = getPlatformBitmap ())
-		return pb->getSize ().y / pb->getScaleFactor ();
-	return 0;
+	return getSize ().y;
 }
 
 //------------------------------------------------------------------------
 CPoint CBitmap::getSize () const
 {
 	CPoint p;
-	if (auto pb = getPlatformBitmap ())
+	double scaleFactor = 1.;
+	if (releasables.empty ())
 	{
-		auto scaleFactor = pb->getScaleFactor ();
-		p = pb->getSize ();
-		p.x /= scaleFactor;
-		p.y /= scaleFactor;
+		if (bitmaps.empty ())
+			return p;
+		p = bitmaps[0]->getSize ();
+		scaleFactor = bitmaps[0]->getScaleFactor ();
 	}
+	else
+	{
+		// the size of a released bitmap is known without loading it again
+		auto lock = BitmapCache::Access::lock ();
+		auto self = const_cast<CBitmap*> (this);
+		if (numPlatformBitmaps () == 0)
+			return p;
+		auto it = self->findReleasable (0);
+		if (it != releasables.end () && it->released)
+		{
+			p = it->size;
+			scaleFactor = it->scaleFactor;
+		}
+		else
+		{
+			p = bitmaps[0]->getSize ();
+			scaleFactor = bitmaps[0]->getScaleFactor ();
+		}
+	}
+	p.x /= scaleFactor;
+	p.y /= scaleFactor;
 	return p;
 }
 
 //-----------------------------------------------------------------------------
 auto CBitmap::getPlatformBitmap () const -> PlatformBitmapPtr
 {
-	return bitmaps.empty () ? nullptr : bitmaps[0];
+	if (releasables.empty ())
+		return bitmaps.empty () ? nullptr : bitmaps[0];
+	auto lock = BitmapCache::Access::lock ();
+	// releasing and loading the platform bitmaps again is not visible to the outside
+	auto self = const_cast<CBitmap*> (this);
+	return numPlatformBitmaps () ? self->loadPlatformBitmap (0) : nullptr;
 }
 
 //-----------------------------------------------------------------------------
 void CBitmap::setPlatformBitmap (const PlatformBitmapPtr& bitmap)
 {
+	if (releasables.empty ())
+	{
+		if (bitmaps.empty ())
+			bitmaps.emplace_back (bitmap);
+		else
+			bitmaps[0] = bitmap;
+		return;
+	}
+	auto lock = BitmapCache::Access::lock ();
+	auto it = findReleasable (0);
+	if (it != releasables.end ())
+	{
+		auto released = it->released;
+		removeReleasable (it);
+		if (released)
+		{
+			bitmaps.insert (bitmaps.begin (), bitmap);
+			return;
+		}
+	}
 	if (bitmaps.empty ())
 		bitmaps.emplace_back (bitmap);
 	else
@@ -131,6 +218,9 @@ void CBitmap::setPlatformBitmap (const PlatformBitmapPtr& bitmap)
 //-----------------------------------------------------------------------------
 bool CBitmap::addBitmap (const PlatformBitmapPtr& platformBitmap)
 {
+	std::unique_lock<std::recursive_mutex> lock;
+	if (!releasables.empty ())
+		lock = BitmapCache::Access::lock ();
 	double scaleFactor = platformBitmap->getScaleFactor ();
 	CPoint size = getSize ();
 	CPoint bitmapSize = platformBitmap->getSize ();
@@ -149,6 +239,14 @@ bool CBitmap::addBitmap (const PlatformBitmapPtr& platformBitmap)
 			return false;
 		}
 	}
+	for (const auto& releasable : releasables)
+	{
+		if (releasable.released && releasable.scaleFactor == scaleFactor)
+		{
+			vstgui_assert (releasable.scaleFactor != scaleFactor);
+			return false;
+		}
+	}
 	bitmaps.emplace_back (platformBitmap);
 	return true;
 }
@@ -156,22 +254,164 @@ bool CBitmap::addBitmap (const PlatformBitmapPtr& platformBitmap)
 //-----------------------------------------------------------------------------
 auto CBitmap::getBestPlatformBitmapForScaleFactor (double scaleFactor) const -> PlatformBitmapPtr
 {
-	if (bitmaps.empty ())
+	if (releasables.empty ())
+	{
+		if (bitmaps.empty ())
+			return nullptr;
+		auto bestBitmap = bitmaps[0];
+		double bestDiff = std::abs (scaleFactor - bestBitmap->getScaleFactor ());
+		for (const auto& bitmap : bitmaps)
+		{
+			if (bitmap->getScaleFactor () == scaleFactor)
+				return bitmap;
+			else if (std::abs (scaleFactor - bitmap->getScaleFactor ()) <= bestDiff && bitmap->getScaleFactor () > bestBitmap->getScaleFactor ())
+			{
+				bestBitmap = bitmap;
+				bestDiff = std::abs (scaleFactor - bitmap->getScaleFactor ());
+			}
+		}
+
+		return bestBitmap;
+	}
+
+	// same choice as above, but released platform bitmaps are considered and loaded if chosen
+	auto lock = BitmapCache::Access::lock ();
+	auto self = const_cast<CBitmap*> (this);
+	auto num = numPlatformBitmaps ();
+	if (num == 0)
 		return nullptr;
-	auto bestBitmap = bitmaps[0];
-	double bestDiff = std::abs (scaleFactor - bestBitmap->getScaleFactor ());
-	for (const auto& bitmap : bitmaps)
+	size_t best = 0;
+	double bestScaleFactor = getScaleFactor (0);
+	double bestDiff = std::abs (scaleFactor - bestScaleFactor);
+	for (size_t index = 0; index < num; ++index)
 	{
-		if (bitmap->getScaleFactor () == scaleFactor)
-			return bitmap;
-		else if (std::abs (scaleFactor - bitmap->getScaleFactor ()) <= bestDiff && bitmap->getScaleFactor () > bestBitmap->getScaleFactor ())
+		auto indexScaleFactor = getScaleFactor (index);
+		if (indexScaleFactor == scaleFactor)
 		{
-			bestBitmap = bitmap;
-			bestDiff = std::abs (scaleFactor - bitmap->getScaleFactor ());
+			best = index;
+			break;
+		}
+		else if (std::abs (scaleFactor - indexScaleFactor) <= bestDiff && indexScaleFactor > bestScaleFactor)
+		{
+			best = index;
+			bestScaleFactor = indexScaleFactor;
+			bestDiff = std::abs (scaleFactor - indexScaleFactor);
 		}
 	}
+	auto platformBitmap = self->loadPlatformBitmap (best);
+	BitmapCache::Access::use (self, best, scaleFactor);
+	return platformBitmap;
+}
 
-	return bestBitmap;
+//-----------------------------------------------------------------------------
+bool CBitmap::setReloadFunction (const PlatformBitmapPtr& platformBitmap, ReloadFunc&& func)
+{
+	// without a budget nothing is ever released, so the bitmap is not tracked
+	if (!platformBitmap || !func || BitmapCache::getMemoryBudget () == 0)
+		return false;
+	auto lock = BitmapCache::Access::lock ();
+	auto num = numPlatformBitmaps ();
+	for (size_t index = 0, position = 0; index < num; ++index)
+	{
+		auto it = findReleasable (index);
+		if (it != releasables.end () && it->released)
+			continue;
+		if (bitmaps[position++] != platformBitmap)
+			continue;
+		if (it != releasables.end ())
+		{
+			it->reload = std::move (func);
+			return true;
+		}
+		releasables.push_back ({index, std::move (func)});
+		BitmapCache::Access::add (this, index, platformBitmap.get (), false);
+		return true;
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+size_t CBitmap::numPlatformBitmaps () const
+{
+	auto num = bitmaps.size ();
+	for (const auto& releasable : releasables)
+	{
+		if (releasable.released)
+			++num;
+	}
+	return num;
+}
+
+//-----------------------------------------------------------------------------
+size_t CBitmap::positionOf (size_t index) const
+{
+	auto position = index;
+	for (const auto& releasable : releasables)
+	{
+		if (releasable.released && releasable.index < index)
+			--position;
+	}
+	return position;
+}
+
+//-----------------------------------------------------------------------------
+auto CBitmap::findReleasable (size_t index) -> ReleasableVector::iterator
+{
+	return std::find_if (releasables.begin (), releasables.end (),
+	                     [index] (const Releasable& r) { return r.index == index; });
+}
+
+//-----------------------------------------------------------------------------
+double CBitmap::getScaleFactor (size_t index) const
+{
+	for (const auto& releasable : releasables)
+	{
+		if (releasable.index == index && releasable.released)
+			return releasable.scaleFactor;
+	}
+	return bitmaps[positionOf (index)]->getScaleFactor ();
+}
+
+//-----------------------------------------------------------------------------
+auto CBitmap::loadPlatformBitmap (size_t index) -> PlatformBitmapPtr
+{
+	auto it = findReleasable (index);
+	if (it == releasables.end () || !it->released)
+		return bitmaps[positionOf (index)];
+	// if loading fails the bitmap stays released and loading is tried again on the next use
+	auto platformBitmap = it->reload ();
+	if (!platformBitmap)
+		return nullptr;
+	if (platformBitmap->getScaleFactor () != it->scaleFactor)
+		platformBitmap->setScaleFactor (it->scaleFactor);
+	it->released = false;
+	bitmaps.insert (bitmaps.begin () + static_cast<std::ptrdiff_t> (positionOf (index)),
+	                platformBitmap);
+	BitmapCache::Access::add (this, index, platformBitmap.get (), true);
+	return platformBitmap;
+}
+
+//-----------------------------------------------------------------------------
+void CBitmap::releasePlatformBitmap (size_t index)
+{
+	auto it = findReleasable (index);
+	if (it == releasables.end () || it->released)
+		return;
+	auto position = bitmaps.begin () + static_cast<std::ptrdiff_t> (positionOf (index));
+	it->scaleFactor = (*position)->getScaleFactor ();
+	it->size = (*position)->getSize ();
+	it->released = true;
+	bitmaps.erase (position);
+}
+
+//-----------------------------------------------------------------------------
+void CBitmap::removeReleasable (ReleasableVector::iterator it)
+{
+	if (it->released)
+		BitmapCache::Access::forgetReleased ();
+	else
+		BitmapCache::Access::remove (this, it->index);
+	releasables.erase (it);
 }
 
 //-----------------------------------------------------------------------------
@@ -218,6 +458,13 @@ CNinePartTiledBitmap::CNinePartTiledBitmap (const PlatformBitmapPtr& platformBit
 {
 }
 
+//-----------------------------------------------------------------------------
+CNinePartTiledBitmap::CNinePartTiledBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap, const CNinePartTiledDescription& offsets)
+: CBitmap (desc, platformBitmap)
+, offsets (offsets)
+{
+}
+
 //-----------------------------------------------------------------------------
 void CNinePartTiledBitmap::draw (CDrawContext* inContext, const CRect& inDestRect, const CPoint& offset, float inAlpha)
 {
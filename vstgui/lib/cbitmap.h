@@ -10,9 +10,11 @@
 #include "cresourcedescription.h"
 #include "pixelbuffer.h"
 #include "platform/iplatformbitmap.h"
+#include <functional>
 #include <vector>
 
 namespace VSTGUI {
+namespace BitmapCache { struct Access; }
 
 //-----------------------------------------------------------------------------
 // CBitmap Declaration
@@ -23,15 +25,19 @@ class CBitmap : public AtomicReferenceCounted
 public:
 	using BitmapVector = std::vector<PlatformBitmapPtr>;
 	using const_iterator = BitmapVector::const_iterator;
+	/** loads a platform bitmap again after the BitmapCache released it */
+	using ReloadFunc = std::function<PlatformBitmapPtr ()>;
 
 	/** Create an image from a resource identifier */
 	explicit CBitmap (const CResourceDescription& desc);
+	/** Create an image from a resource identifier with the already loaded platform bitmap */
+	CBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap);
 	/** Create an image with a given size */
 	CBitmap (CCoord width, CCoord height);
 	/** Create an image with a given size and scale factor */
 	CBitmap (CPoint size, double scaleFactor = 1.);
 	explicit CBitmap (const PlatformBitmapPtr& platformBitmap);
-	~CBitmap () noexcept override = default;
+	~CBitmap () noexcept override;
 
 	//-----------------------------------------------------------------------------
 	/// @name CBitmap Methods
@@ -57,6 +63,16 @@ public:
 	bool addBitmap (const PlatformBitmapPtr& platformBitmap);
 	PlatformBitmapPtr getBestPlatformBitmapForScaleFactor (double scaleFactor) const;
 
+	/** let the BitmapCache release the platform bitmap while it is not used
+	 *
+	 *	The function is called to load the platform bitmap again the next time it is needed.
+	 *	Bitmaps created from a resource description are releasable without calling this. Only has
+	 *	an effect while a memory budget is set (see BitmapCache::setMemoryBudget).
+	 *	@return false if the platform bitmap is not one of this bitmap or if no budget is set
+	 */
+	bool setReloadFunction (const PlatformBitmapPtr& platformBitmap, ReloadFunc&& func);
+
+	/** iterate the resident platform bitmaps, released ones are skipped */
 	const_iterator begin () const { return bitmaps.begin (); }
 	const_iterator end () const { return bitmaps.end (); }
 	//@}
@@ -67,6 +83,32 @@ protected:
 
 	CResourceDescription resourceDesc;
 	BitmapVector bitmaps;
+
+private:
+	friend struct BitmapCache::Access;
+
+	struct Releasable
+	{
+		/** the position of the platform bitmap in the order it was added */
+		size_t index {0};
+		ReloadFunc reload;
+		bool released {false};
+		/** scale factor and size in pixels of the platform bitmap while it is released */
+		double scaleFactor {1.};
+		CPoint size {};
+	};
+	using ReleasableVector = std::vector<Releasable>;
+
+	// all following methods need the lock of the BitmapCache
+	size_t numPlatformBitmaps () const;
+	size_t positionOf (size_t index) const;
+	ReleasableVector::iterator findReleasable (size_t index);
+	double getScaleFactor (size_t index) const;
+	PlatformBitmapPtr loadPlatformBitmap (size_t index);
+	void releasePlatformBitmap (size_t index);
+	void removeReleasable (ReleasableVector::iterator it);
+
+	ReleasableVector releasables;
 };
 
 //-----------------------------------------------------------------------------
@@ -129,6 +171,7 @@ class CNinePartTiledBitmap : public CBitmap
 public:
 	CNinePartTiledBitmap (const CResourceDescription& desc, const CNinePartTiledDescription& offsets);
 	CNinePartTiledBitmap (const PlatformBitmapPtr& platformBitmap, const CNinePartTiledDescription& offsets);
+	CNinePartTiledBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap, const CNinePartTiledDescription& offsets);
 	~CNinePartTiledBitmap () noexcept override = default;
 	
 	//-----------------------------------------------------------------------------
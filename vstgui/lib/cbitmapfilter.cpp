@@ -9,6 +9,7 @@
 #include "cgraphicspath.h"
 #include "cgraphicstransform.h"
 #include "malloc.h"
+#include "detail/boxblur.h"
 #include <cassert>
 #include <algorithm>
 #include <memory>
@@ -469,13 +470,13 @@ private:
 				case IPlatformBitmapPixelAccess::kARGB:
 				case IPlatformBitmapPixelAccess::kABGR:
 				{
-					algo<true, false, false, false> (inputAddressPtr, outputAddressPtr, width, height, static_cast<int32_t> (radius / 2));
+					kernel.process<true, false, false, false> (inputAddressPtr, outputAddressPtr, width, height, static_cast<int32_t> (radius / 2));
 					break;
 				}
 				case IPlatformBitmapPixelAccess::kRGBA:
 				case IPlatformBitmapPixelAccess::kBGRA:
 				{
-					algo<false, false, false, true> (inputAddressPtr, outputAddressPtr, width, height, static_cast<int32_t> (radius / 2));
+					kernel.process<false, false, false, true> (inputAddressPtr, outputAddressPtr, width, height, static_cast<int32_t> (radius / 2));
 					break;
 				}
 			}
@@ -483,194 +484,11 @@ private:
 		}
 		else
 		{
-			algo<true, true, true, true> (inputAddressPtr, outputAddressPtr, width, height, static_cast<int32_t> (radius / 2));
+			kernel.process<true, true, true, true> (inputAddressPtr, outputAddressPtr, width, height, static_cast<int32_t> (radius / 2));
 		}
 	}
 
-	Buffer<uint8_t> pc0;
-	Buffer<uint8_t> pc1;
-	Buffer<uint8_t> pc2;
-	Buffer<uint8_t> pc3;
-	Buffer<int32_t> vMin;
-	Buffer<int32_t> vMax;
-	Buffer<uint8_t> dv;
-
-	template<bool plane0, bool plane1, bool plane2, bool plane3>
-	void algo (uint8_t* inPixel, uint8_t* outPixel, int32_t width, int32_t height, int32_t radius)
-	{
-		vstgui_assert (radius > 0);
-
-		constexpr int32_t pos0 = 0;
-		constexpr int32_t pos1 = 1;
-		constexpr int32_t pos2 = 2;
-		constexpr int32_t pos3 = 3;
-		constexpr int32_t numComponents = 4;
-
-		int32_t wm = width - 1;
-		int32_t hm = height - 1;
-		int32_t areaSize = width * height;
-		int32_t div = radius + radius + 1;
-		
-		if (plane0)
-			pc0.allocate (areaSize);
-		if (plane1)
-			pc1.allocate (areaSize);
-		if (plane2)
-			pc2.allocate (areaSize);
-		if (plane3)
-			pc3.allocate (areaSize);
-		vMin.allocate (std::max (width, height));
-		vMax.allocate (std::max (width, height));
-		dv.allocate (256 * div);
-
-		for (auto i = 0u; i < dv.size (); ++i)
-			dv[i] = (i / div);
-
-		int32_t sum0, sum1, sum2, sum3;
-		for (auto y = 0, yw = 0, yi = 0; y < height; ++y, yw += width)
-		{
-			sum0 = sum1 = sum2 = sum3 = 0;
-			for (auto i = -radius; i <= radius; i++)
-			{
-				auto p = (yi + std::min (wm, std::max (i, 0))) * numComponents;
-				if (plane0)
-					sum0 += inPixel[p + pos0];
-				if (plane1)
-					sum1 += inPixel[p + pos1];
-				if (plane2)
-					sum2 += inPixel[p + pos2];
-				if (plane3)
-					sum3 += inPixel[p + pos3];
-			}
-			if (y == 0)
-			{
-				for (auto x = 0; x < width; ++x, ++yi)
-				{
-					if (plane0)
-						pc0[yi] = dv[sum0];
-					if (plane1)
-						pc1[yi] = dv[sum1];
-					if (plane2)
-						pc2[yi] = dv[sum2];
-					if (plane3)
-						pc3[yi] = dv[sum3];
-					vMin[x] = std::min (x + radius + 1, wm);
-					vMax[x] = std::max (x - radius, 0);
-					auto p1 = (yw + vMin[x]) * numComponents;
-					auto p2 = (yw + vMax[x]) * numComponents;
-					if (plane0)
-						sum0 += inPixel[p1 + pos0] - inPixel[p2 + pos0];
-					if (plane1)
-						sum1 += inPixel[p1 + pos1] - inPixel[p2 + pos1];
-					if (plane2)
-						sum2 += inPixel[p1 + pos2] - inPixel[p2 + pos2];
-					if (plane3)
-						sum3 += inPixel[p1 + pos3] - inPixel[p2 + pos3];
-				}
-			}
-			else
-			{
-				for (auto x = 0; x < width; ++x, ++yi)
-				{
-					if (plane0)
-						pc0[yi] = dv[sum0];
-					if (plane1)
-						pc1[yi] = dv[sum1];
-					if (plane2)
-						pc2[yi] = dv[sum2];
-					if (plane3)
-						pc3[yi] = dv[sum3];
-					auto p1 = (yw + vMin[x]) * numComponents;
-					auto p2 = (yw + vMax[x]) * numComponents;
-					if (plane0)
-						sum0 += inPixel[p1 + pos0] - inPixel[p2 + pos0];
-					if (plane1)
-						sum1 += inPixel[p1 + pos1] - inPixel[p2 + pos1];
-					if (plane2)
-						sum2 += inPixel[p1 + pos2] - inPixel[p2 + pos2];
-					if (plane3)
-						sum3 += inPixel[p1 + pos3] - inPixel[p2 + pos3];
-				}
-			}
-		}
-
-		sum0 = sum1 = sum2 = sum3 = 0;
-		for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
-		{
-			auto yi = std::max (0, yp);
-			if (plane0)
-				sum0 += pc0[yi];
-			if (plane1)
-				sum1 += pc1[yi];
-			if (plane2)
-				sum2 += pc2[yi];
-			if (plane3)
-				sum3 += pc3[yi];
-		}
-		for (auto y = 0, yi = 0; y < height; ++y, yi += width)
-		{
-			auto pos = yi * numComponents;
-			if (plane0)
-				outPixel[pos + pos0] = dv[sum0];
-			if (plane1)
-				outPixel[pos + pos1] = dv[sum1];
-			if (plane2)
-				outPixel[pos + pos2] = dv[sum2];
-			if (plane3)
-				outPixel[pos + pos3] = dv[sum3];
-			vMin[y] = std::min (y + radius + 1, hm) * width;
-			vMax[y] = std::max (y - radius, 0) * width;
-			auto p1 = vMin[y];
-			auto p2 = vMax[y];
-			if (plane0)
-				sum0 += pc0[p1] - pc0[p2];
-			if (plane1)
-				sum1 += pc1[p1] - pc1[p2];
-			if (plane2)
-				sum2 += pc2[p1] - pc2[p2];
-			if (plane3)
-				sum3 += pc3[p1] - pc3[p2];
-		}
-
-		for (auto x = 1; x < width; ++x)
-		{
-			sum0 = sum1 = sum2 = sum3 = 0;
-			for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
-			{
-				auto yi = std::max (0, yp) + x;
-				if (plane0)
-					sum0 += pc0[yi];
-				if (plane1)
-					sum1 += pc1[yi];
-				if (plane2)
-					sum2 += pc2[yi];
-				if (plane3)
-					sum3 += pc3[yi];
-			}
-			for (auto y = 0, yi = x; y < height; ++y, yi += width)
-			{
-				auto pos = yi * numComponents;
-				if (plane0)
-					outPixel[pos + pos0] = dv[sum0];
-				if (plane1)
-					outPixel[pos + pos1] = dv[sum1];
-				if (plane2)
-					outPixel[pos + pos2] = dv[sum2];
-				if (plane3)
-					outPixel[pos + pos3] = dv[sum3];
-				auto p1 = x + vMin[y];
-				auto p2 = x + vMax[y];
-				if (plane0)
-					sum0 += pc0[p1] - pc0[p2];
-				if (plane1)
-					sum1 += pc1[p1] - pc1[p2];
-				if (plane2)
-					sum2 += pc2[p1] - pc2[p2];
-				if (plane3)
-					sum3 += pc3[p1] - pc3[p2];
-			}
-		}
-	}
+	Detail::BoxBlur kernel;
 };
 
 //----------------------------------------------------------------------------------------------------
@@ -46,9 +46,15 @@ public:
 	bool drawFocusOnTop () override;
 	bool getFocusPath (CGraphicsPath& outPath) override;
 protected:
+	struct ColumnSpan
+	{
+		CCoord left;
+		CCoord right;
+	};
 
 	IDataBrowserDelegate* db;
 	CDataBrowser* browser;
+	std::vector<ColumnSpan> columns;
 };
 
 //-----------------------------------------------------------------------------------------------
@@ -377,26 +383,30 @@ void CDataBrowser::setSelectedRow (int32_t index, bool makeVisible)
 	int32_t numRows = db->dbGetNumRows (this);
 	if (index >= numRows)
 		index = numRows-1;
+	if (index < 0)
+	{
+		unselectAll ();
+		return;
+	}
 
 	bool hasChanged = true;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), index);
-	if (alreadySelected != selection.end ())
+	if (isRowSelected (index))
 	{
-		selection.erase (alreadySelected);
-		hasChanged = !selection.empty ();
+		removeFromSelection (index);
+		hasChanged = !getSelection ().empty ();
 	}
 	else
 	{
 		invalidateRow (index);
 	}
 	
-	for (auto row : selection)
+	for (auto row : getSelection ())
 	{
 		dbView->invalidateRow (row);
 	}
-	selection.clear ();
+	clearSelection ();
 	
-	selection.emplace_back (index);
+	addToSelection (index);
 	if (hasChanged)
 		db->dbSelectionChanged (this);
 	
@@ -407,22 +417,29 @@ void CDataBrowser::setSelectedRow (int32_t index, bool makeVisible)
 //-----------------------------------------------------------------------------------------------
 int32_t CDataBrowser::getSelectedRow () const
 {
-	if (!selection.empty ())
-		return selection[0];
+	const auto& rows = getSelection ();
+	if (!rows.empty ())
+		return rows[0];
 	return kNoSelection;
 }
 
+//-----------------------------------------------------------------------------------------------
+const CDataBrowser::Selection& CDataBrowser::getSelection () const
+{
+	compactSelection ();
+	return selection;
+}
+
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::selectRow (int32_t row)
 {
-	if (row > db->dbGetNumRows (this))
+	if (row < 0 || row > db->dbGetNumRows (this))
 		return;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), row);
-	if (alreadySelected == selection.end ())
+	if (!isRowSelected (row))
 	{
 		if (getStyle () & kMultiSelectionStyle)
 		{
-			selection.emplace_back (row);
+			addToSelection (row);
 			dbView->invalidateRow (row);
 			db->dbSelectionChanged (this);
 		}
@@ -436,14 +453,13 @@ void CDataBrowser::selectRow (int32_t row)
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::unselectRow (int32_t row)
 {
-	if (row > db->dbGetNumRows (this))
+	if (row < 0 || row > db->dbGetNumRows (this))
 		return;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), row);
-	if (alreadySelected != selection.end ())
+	if (isRowSelected (row))
 	{
 		if (getStyle () & kMultiSelectionStyle)
 		{
-			selection.erase (alreadySelected);
+			removeFromSelection (row);
 			dbView->invalidateRow (row);
 			db->dbSelectionChanged (this);
 		}
@@ -457,13 +473,13 @@ void CDataBrowser::unselectRow (int32_t row)
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::unselectAll ()
 {
-	if (!selection.empty ())
+	if (!getSelection ().empty ())
 	{
 		for (auto row : selection)
 		{
 			dbView->invalidateRow (row);
 		}
-		selection.clear ();
+		clearSelection ();
 		db->dbSelectionChanged (this);
 	}
 }
@@ -471,24 +487,99 @@ void CDataBrowser::unselectAll ()
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::validateSelection ()
 {
+	syncSelectionPositions ();
 	bool selectionChanged = false;
-	int32_t numRows = db->dbGetNumRows (this);
-	for (Selection::iterator it = selection.begin (); it != selection.end ();)
+	auto numRows = static_cast<size_t> (std::max<int32_t> (db->dbGetNumRows (this), 0));
+	for (auto row = numRows; row < selectionPositions.size (); ++row)
 	{
-		if (*it >= numRows)
+		if (selectionPositions[row])
 		{
-			it = selection.erase (it);
+			removeFromSelection (static_cast<int32_t> (row));
 			selectionChanged = true;
 		}
-		else
-		{
-			++it;
-		}
 	}
+	if (selectionPositions.size () > numRows)
+		selectionPositions.resize (numRows);
 	if (selectionChanged)
 		db->dbSelectionChanged (this);
 }
 
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::addToSelection (int32_t row)
+{
+	if (row < 0 || isRowSelected (row))
+		return;
+	if (static_cast<size_t> (row) >= selectionPositions.size ())
+		selectionPositions.resize (static_cast<size_t> (row) + 1);
+	selection.emplace_back (row);
+	selectionPositions[row] = static_cast<uint32_t> (selection.size ());
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::removeFromSelection (int32_t row)
+{
+	if (!isRowSelected (row))
+		return;
+	selection[selectionPositions[row] - 1] = kNoSelection;
+	selectionPositions[row] = 0;
+	if (++numRemovedFromSelection == selection.size ())
+		clearSelection ();
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::clearSelection ()
+{
+	selection.clear ();
+	selectionPositions.clear ();
+	numRemovedFromSelection = 0;
+	selectionPositionsDirty = false;
+}
+
+//-----------------------------------------------------------------------------------------------
+CDataBrowser::Selection& CDataBrowser::getMutableSelection ()
+{
+	compactSelection ();
+	selectionPositionsDirty = true;
+	return selection;
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::syncSelectionPositions () const
+{
+	if (!selectionPositionsDirty)
+		return;
+	selectionPositionsDirty = false;
+	selectionPositions.clear ();
+	numRemovedFromSelection = 0;
+	// drop invalid and duplicated rows a subclass may have added
+	size_t count = 0;
+	for (auto row : selection)
+	{
+		if (row < 0)
+			continue;
+		if (static_cast<size_t> (row) >= selectionPositions.size ())
+			selectionPositions.resize (static_cast<size_t> (row) + 1);
+		if (selectionPositions[row])
+			continue;
+		selection[count++] = row;
+		selectionPositions[row] = static_cast<uint32_t> (count);
+	}
+	selection.resize (count);
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::compactSelection () const
+{
+	syncSelectionPositions ();
+	if (numRemovedFromSelection == 0)
+		return;
+	selection.erase (std::remove (selection.begin (), selection.end (), kNoSelection),
+	                 selection.end ());
+	for (size_t index = 0; index < selection.size (); ++index)
+		selectionPositions[selection[index]] = static_cast<uint32_t> (index + 1);
+	numRemovedFromSelection = 0;
+}
+
 //-----------------------------------------------------------------------------------------------
 /**
  * @param cell cell
@@ -781,9 +872,10 @@ void CDataBrowserView::draw (CDrawContext* context)
 void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 {
 	const bool drawRowLines = (browser->getStyle () & CDataBrowser::kDrawRowLines) ? true : false;
+	const bool drawColumnLines = (browser->getStyle () & CDataBrowser::kDrawColumnLines) ? true : false;
 	CCoord lineWidth = 0;
 	CColor lineColor;
-	if (browser->getStyle () & CDataBrowser::kDrawRowLines || browser->getStyle () & CDataBrowser::kDrawColumnLines)
+	if (drawRowLines || drawColumnLines)
 	{
 		db->dbGetLineWidthAndColor (lineWidth, lineColor, browser);
 	}
@@ -794,58 +886,66 @@ void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 	int32_t numRows = db->dbGetNumRows (browser);
 	int32_t numColumns = db->dbGetNumColumns (browser);
 
-	const CDataBrowser::Selection& selection = browser->getSelection ();
+	const CRect& viewSize = getViewSize ();
+	columns.resize (static_cast<size_t> (std::max<int32_t> (numColumns, 0)));
+	CCoord left = viewSize.left;
+	for (int32_t col = 0; col < numColumns; col++)
+	{
+		columns[col].left = left;
+		columns[col].right = left + db->dbGetCurrentColumnWidth (col, browser);
+		left = columns[col].right;
+		if (drawColumnLines)
+			left += lineWidth;
+	}
 
 	CDrawContext::LineList lines;
 
-	CRect r (getViewSize ());
-	r.setHeight (rowHeight - lineWidth);
-	for (int32_t row = 0; row < numRows; row++)
+	// only the rows and columns intersecting the update rect are visited, including the
+	// neighbour rows as the row lines are drawn at the bottom edge of a row
+	int32_t firstRow = 0;
+	int32_t lastRow = 0;
+	if (rowHeight > 0.)
 	{
-		CRect testRect (r);
-		testRect.bound (updateRect);
-		if (testRect.isEmpty () == false)
+		auto top = std::floor ((updateRect.top - viewSize.top) / rowHeight) - 1.;
+		auto bottom = std::ceil ((updateRect.bottom - viewSize.top) / rowHeight) + 1.;
+		firstRow = static_cast<int32_t> (std::max (top, 0.));
+		lastRow = static_cast<int32_t> (std::min (bottom, static_cast<double> (numRows)));
+	}
+	auto firstColumn = std::upper_bound (columns.begin (), columns.end (), updateRect.left,
+	                                     [] (CCoord x, const ColumnSpan& c) { return x < c.right; });
+	auto lastColumn = std::lower_bound (firstColumn, columns.end (), updateRect.right,
+	                                    [] (const ColumnSpan& c, CCoord x) { return c.left < x; });
+
+	CRect r (viewSize.left, 0, viewSize.left + getWidth (), 0);
+	for (int32_t row = firstRow; row < lastRow; row++)
+	{
+		r.top = viewSize.top + rowHeight * row;
+		r.setHeight (rowHeight - lineWidth);
+		bool isSelected = browser->isRowSelected (row);
+		for (auto column = firstColumn; column != lastColumn; ++column)
 		{
-			bool isSelected = std::find (selection.begin (), selection.end (), row) != selection.end ();
-			for (int32_t col = 0; col < numColumns; col++)
+			CRect cellSize (column->left, r.top, column->right, r.bottom);
+			CRect testRect (cellSize);
+			testRect.bound (updateRect);
+			if (testRect.isEmpty () == false)
 			{
-				CCoord columnWidth = db->dbGetCurrentColumnWidth (col, browser);
-				r.setWidth (columnWidth);
-				testRect = r;
-				testRect.bound (updateRect);
-				if (testRect.isEmpty () == false)
-				{
-					context->setClipRect (testRect);
-					CRect cellSize (r);
-					cellSize.bottom++;
-					cellSize.right++;
-					db->dbDrawCell (context, cellSize, row, col, isSelected ? IDataBrowserDelegate::kRowSelected : 0, browser);
-				}
-				r.offset (columnWidth, 0);
-				if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
-					r.offset (lineWidth, 0);
+				context->setClipRect (testRect);
+				cellSize.bottom++;
+				cellSize.right++;
+				db->dbDrawCell (context, cellSize, row, static_cast<int32_t> (column - columns.begin ()), isSelected ? IDataBrowserDelegate::kRowSelected : 0, browser);
 			}
 		}
-		r.left = getViewSize ().left;
-		r.setWidth (getWidth ());
 		if (drawRowLines)
 			lines.emplace_back (r.getBottomLeft (), r.getBottomRight ());
-		r.offset (0, rowHeight);
 	}
-	if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
+	if (drawColumnLines)
 	{
-		
-		CPoint p1;
-		CPoint p2;
-		if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
+		CPoint p1 (0, viewSize.top);
+		CPoint p2 (0, viewSize.bottom);
+		for (int32_t col = 0; col < numColumns - 1; col++)
 		{
-			p1 (getViewSize ().left - lineWidth, getViewSize ().top);
-			p2 (getViewSize ().left - lineWidth, getViewSize ().bottom);
-			for (int32_t col = 0; col < numColumns - 1; col++)
-			{
-				p1.x = p2.x = p1.x + db->dbGetCurrentColumnWidth (col, browser) + lineWidth;
-				lines.emplace_back (p1, p2);
-			}
+			p1.x = p2.x = columns[col + 1].left - lineWidth;
+			lines.emplace_back (p1, p2);
 		}
 	}
 	if (!lines.empty ())
@@ -906,7 +1006,7 @@ CMouseEventResult CDataBrowserView::onMouseDown (CPoint &where, const CButtonSta
 	if (getCell (where, cell))
 	{
 		const CDataBrowser::Selection& selection = browser->getSelection ();
-		bool alreadySelected = std::find (selection.begin (), selection.end (), cell.row) != selection.end ();
+		bool alreadySelected = browser->isRowSelected (cell.row);
 		if (browser->getStyle () & CDataBrowser::kMultiSelectionStyle)
 		{
 			if (buttons.getModifierState () == kControl)
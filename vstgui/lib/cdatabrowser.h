@@ -86,7 +86,14 @@ public:
 	virtual void setSelectedRow (int32_t row, bool makeVisible = false);
 
 	/** get all selected rows */
-	const Selection& getSelection () const { return selection; }
+	const Selection& getSelection () const;
+	/** check if the row is selected */
+	bool isRowSelected (int32_t row) const
+	{
+		syncSelectionPositions ();
+		return row >= 0 && static_cast<size_t> (row) < selectionPositions.size () &&
+		       selectionPositions[row] != 0;
+	}
 	/** add row to selection */
 	virtual void selectRow (int32_t row);
 	/** remove row from selection */
@@ -118,11 +125,31 @@ protected:
 	void recalculateSubViews () override;
 	void validateSelection ();
 
+	void addToSelection (int32_t row);
+	void removeFromSelection (int32_t row);
+	void clearSelection ();
+	/** the selected rows to change directly, the reference is only valid until the next call of
+	 *	another CDataBrowser method */
+	Selection& getMutableSelection ();
+
 	IDataBrowserDelegate* db;
 	CDataBrowserView* dbView;
 	CDataBrowserHeader* dbHeader;
 	CViewContainer* dbHeaderContainer;
-	Selection selection;
+
+private:
+	void compactSelection () const;
+	void syncSelectionPositions () const;
+
+	/** the selected rows in the order they were selected, removed rows stay as kNoSelection until
+	 *	the selection is accessed the next time */
+	mutable Selection selection;
+	/** one based position in selection of the rows up to the highest selected one, 0 if the row
+	 *	is not selected */
+	mutable std::vector<uint32_t> selectionPositions;
+	mutable size_t numRemovedFromSelection {0};
+	/** selection was handed out by getMutableSelection, selectionPositions must be rebuilt */
+	mutable bool selectionPositionsDirty {false};
 };
 
 //-----------------------------------------------------------------------------
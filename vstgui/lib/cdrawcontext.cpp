@@ -238,8 +238,21 @@ void CDrawContext::drawString (IPlatformString* string, const CRect& _rect, cons
 	if (painter == nullptr)
 		return;
 	
+	CCoord stringWidth = 0.;
+	if (hAlign != kLeftText)
+		stringWidth = painter->getStringWidth (this, string, antialias);
+
+	painter->drawString (this, string, getStringDrawPoint (_rect, stringWidth, hAlign), antialias);
+}
+
+//------------------------------------------------------------------------
+CPoint CDrawContext::getStringDrawPoint (const CRect& _rect, CCoord stringWidth,
+										 CHoriTxtAlign hAlign) const
+{
 	CRect rect (_rect);
-	
+	if (currentState.font == nullptr)
+		return {rect.left, rect.bottom};
+
 	double capHeight = -1;
 	auto platformFont = currentState.font->getPlatformFont ();
 	if (platformFont)
@@ -249,16 +262,28 @@ void CDrawContext::drawString (IPlatformString* string, const CRect& _rect, cons
 		rect.bottom -= (rect.getHeight () / 2. - capHeight / 2.);
 	else
 		rect.bottom -= (rect.getHeight () / 2. - currentState.font->getSize () / 2.) + 1.;
-	if (hAlign != kLeftText)
+	if (hAlign == kRightText)
+		rect.left = rect.right - stringWidth;
+	else if (hAlign == kCenterText)
+		rect.left = rect.left + (rect.getWidth () / 2.) - (stringWidth / 2.);
+	return {rect.left, rect.bottom};
+}
+
+//------------------------------------------------------------------------
+void CDrawContext::drawStrings (const CDrawStringItemList& items, bool antialias)
+{
+	if (items.empty () || currentState.font == nullptr)
+		return;
+	auto painter = currentState.font->getFontPainter ();
+	if (painter == nullptr)
+		return;
+	if (painter->drawStrings (this, items, antialias))
+		return;
+	for (const auto& item : items)
 	{
-		CCoord stringWidth = painter->getStringWidth (this, string, antialias);
-		if (hAlign == kRightText)
-			rect.left = rect.right - stringWidth;
-		else
-			rect.left = rect.left + (rect.getWidth () / 2.) - (stringWidth / 2.);
+		if (item.string)
+			drawString (item.string, item.rect, item.hAlign, antialias);
 	}
-
-	painter->drawString (this, string, CPoint (rect.left, rect.bottom), antialias);
 }
 
 //------------------------------------------------------------------------
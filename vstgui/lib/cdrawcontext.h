@@ -164,6 +164,15 @@ public:
 	void drawString (IPlatformString* string, const CRect& _rect, const CHoriTxtAlign hAlign = kCenterText, bool antialias = true);
 	/** draw a platform string */
 	void drawString (IPlatformString* string, const CPoint& _point, bool antialias = true);
+
+	/** draw multiple UTF-8 encoded strings with the current font and font color
+	 *
+	 *	Same as calling drawString (item.string, item.rect, item.hAlign, antialias) for every item,
+	 *	but the font painter may draw all strings at once.
+	 */
+	void drawStrings (const CDrawStringItemList& items, bool antialias = true);
+	/** get the point where a string with the width is drawn inside the rect with the current font */
+	CPoint getStringDrawPoint (const CRect& rect, CCoord stringWidth, CHoriTxtAlign hAlign) const;
 	//@}
 	
 	//-----------------------------------------------------------------------------
@@ -5,6 +5,8 @@
 #pragma once
 
 #include "vstguifwd.h"
+#include "crect.h"
+#include <vector>
 
 namespace VSTGUI {
 
@@ -55,6 +57,18 @@ enum CHoriTxtAlign
 	kRightText
 };
 
+//----------------------------
+// @brief String Draw Item
+//----------------------------
+/** a string drawn with CDrawContext::drawStrings */
+struct CDrawStringItem
+{
+	UTF8StringPtr string {nullptr};
+	CRect rect;
+	CHoriTxtAlign hAlign {kCenterText};
+};
+using CDrawStringItemList = std::vector<CDrawStringItem>;
+
 //----------------------------
 // @brief Draw Style
 //----------------------------
@@ -7,6 +7,8 @@
 #include "finally.h"
 #include "coffscreencontext.h"
 #include "ctooltipsupport.h"
+#include "cvstguitimer.h"
+#include "meterfeed.h"
 #include "cinvalidrectlist.h"
 #include "itouchevent.h"
 #include "iscalefactorchangedlistener.h"
@@ -15,6 +17,7 @@
 #include "controls/ctextedit.h"
 #include "platform/platformfactory.h"
 #include "platform/iplatformframe.h"
+#include <atomic>
 #include <cassert>
 #include <vector>
 #include <queue>
@@ -80,6 +83,8 @@ struct CFrame::Impl
 	DispatchList<IMouseObserver*> mouseObservers;
 	DispatchList<IFocusViewObserver*> focusViewObservers;
 	DispatchList<IKeyboardHook*> keyboardHooks;
+	DispatchList<SharedPointer<MeterFeed>> meterFeeds;
+	SharedPointer<CVSTGUITimer> meterFeedTimer;
 	FunctionQueue postEventFunctionQueue;
 
 	ModalViewSessionID modalViewSessionIDCounter {0};
@@ -89,6 +94,9 @@ struct CFrame::Impl
 	bool windowActive {false};
 	bool inEventHandling {false};
 	BitmapInterpolationQuality bitmapQuality {BitmapInterpolationQuality::kDefault};
+	// the frame may be drawn on multiple threads
+	std::atomic<uint64_t> numVisitedViews {0};
+	std::atomic<uint64_t> numDrawnViews {0};
 
 	struct PostEventHandler
 	{
@@ -149,6 +157,7 @@ void CFrame::beforeDelete ()
 
 	pImpl->tooltips = nullptr;
 	pImpl->animator = nullptr;
+	pImpl->meterFeedTimer = nullptr;
 
 #if DEBUG
 	if (!pImpl->scaleFactorChangedListenerList.empty ())
@@ -1150,6 +1159,33 @@ void CFrame::onViewAdded (CView* pView)
 	}
 }
 
+//-----------------------------------------------------------------------------
+CFrame::DrawStatistics CFrame::getDrawStatistics () const
+{
+	DrawStatistics result;
+	result.numVisitedViews = pImpl->numVisitedViews.load (std::memory_order_relaxed);
+	result.numDrawnViews = pImpl->numDrawnViews.load (std::memory_order_relaxed);
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+void CFrame::resetDrawStatistics ()
+{
+	pImpl->numVisitedViews = 0;
+	pImpl->numDrawnViews = 0;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @param numVisitedViews number of child views the container looked at
+ * @param numDrawnViews number of child views the container drew
+ */
+void CFrame::onChildViewsDrawn (uint32_t numVisitedViews, uint32_t numDrawnViews)
+{
+	pImpl->numVisitedViews.fetch_add (numVisitedViews, std::memory_order_relaxed);
+	pImpl->numDrawnViews.fetch_add (numDrawnViews, std::memory_order_relaxed);
+}
+
 //-----------------------------------------------------------------------------
 /**
  * @param pView new focus view
@@ -1589,6 +1625,34 @@ void CFrame::unregisterMouseObserver (IMouseObserver* observer)
 	pImpl->mouseObservers.remove (observer);
 }
 
+//-----------------------------------------------------------------------------
+void CFrame::addMeterFeed (MeterFeed* feed)
+{
+	SharedPointer<MeterFeed> meterFeed (feed);
+	if (pImpl->meterFeeds.contains (meterFeed))
+		return;
+	pImpl->meterFeeds.add (std::move (meterFeed));
+	if (!pImpl->meterFeedTimer)
+	{
+		pImpl->meterFeedTimer = makeOwned<CVSTGUITimer> (
+		    [this] (CVSTGUITimer*) {
+			    pImpl->meterFeeds.forEach ([] (const SharedPointer<MeterFeed>& f) { f->drain (); });
+		    },
+		    1000 / CView::idleRate);
+	}
+	else
+		pImpl->meterFeedTimer->start ();
+}
+
+//-----------------------------------------------------------------------------
+void CFrame::removeMeterFeed (MeterFeed* feed)
+{
+	SharedPointer<MeterFeed> meterFeed (feed);
+	pImpl->meterFeeds.remove (meterFeed);
+	if (pImpl->meterFeeds.empty () && pImpl->meterFeedTimer)
+		pImpl->meterFeedTimer->stop ();
+}
+
 //-----------------------------------------------------------------------------
 void CFrame::callMouseObserverMouseEntered (CView* view)
 {
@@ -1661,6 +1725,44 @@ bool CFrame::platformDrawRect (CDrawContext* context, const CRect& rect)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+static bool allViewsCanDrawConcurrently (const CViewContainer* container, CRect rect,
+										const CView* focusContainer)
+{
+	// rect is in the coordinate system of the container's parent view, see CViewContainer::drawRect
+	rect.bound (container->getViewSize ());
+	if (rect.isEmpty ())
+		return true;
+	rect.offset (-container->getViewSize ().left, -container->getViewSize ().top);
+	container->getTransform ().inverse ().transform (rect);
+	bool result = true;
+	container->forEachChild ([&] (const auto& view) {
+		if (!result || !view->isVisible () || !view->getViewSize ().rectOverlap (rect))
+			return;
+		// the container draws the focus of its focus view and remembers the drawn rect
+		if (!view->canDrawConcurrently () || view == focusContainer)
+			result = false;
+		else if (auto childContainer = view->asViewContainer ())
+			result = allViewsCanDrawConcurrently (childContainer, rect, focusContainer);
+	});
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+bool CFrame::platformCanDrawRectConcurrently (const CRect& rect)
+{
+	if (!canDrawConcurrently ())
+		return false;
+	const CView* focusContainer = nullptr;
+	if (focusDrawingEnabled () && getFocusView ())
+	{
+		focusContainer = getFocusView ()->getParentView ();
+		if (focusContainer == this)
+			return false;
+	}
+	return allViewsCanDrawConcurrently (this, rect, focusContainer);
+}
+
 //-----------------------------------------------------------------------------
 void CFrame::platformOnEvent (Event& event)
 {
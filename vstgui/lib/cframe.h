@@ -111,6 +111,21 @@ public:
 	void onViewAdded (CView* pView);
 	void onViewRemoved (CView* pView);
 
+	/** counters of the child views the view containers of the frame visited and drew */
+	struct DrawStatistics
+	{
+		/** number of child views looked at to find the ones in the update rects */
+		uint64_t numVisitedViews {0};
+		/** number of child views drawn */
+		uint64_t numDrawnViews {0};
+	};
+	/** get the counters since the last reset. Reset them before each redraw to get the counts
+	 *	per frame */
+	DrawStatistics getDrawStatistics () const;
+	void resetDrawStatistics ();
+	/** called by the view containers after drawing their child views, thread safe */
+	void onChildViewsDrawn (uint32_t numVisitedViews, uint32_t numDrawnViews);
+
 	/** called when the platform view/window is activated/deactivated */
 	void onActivate (bool state);
 
@@ -143,6 +158,11 @@ public:
 	/** unregister a mouse observer */
 	void unregisterMouseObserver (IMouseObserver* observer);
 
+	/** drain the meter feed once per idle tick, see MeterFeed */
+	void addMeterFeed (MeterFeed* feed);
+	/** stop draining the meter feed */
+	void removeMeterFeed (MeterFeed* feed);
+
 	VSTGUI_DEPRECATED_MSG (
 		void registerScaleFactorChangedListeneer (IScaleFactorChangedListener* listener) {
 			registerScaleFactorChangedListener (listener);
@@ -257,6 +277,7 @@ protected:
 
 	// platform frame
 	bool platformDrawRect (CDrawContext* context, const CRect& rect) override;
+	bool platformCanDrawRectConcurrently (const CRect& rect) override;
 	void platformOnEvent (Event& event) override;
 	DragOperation platformOnDragEnter (DragEventData data) override;
 	DragOperation platformOnDragMove (DragEventData data) override;
@@ -5,15 +5,33 @@
 #pragma once
 
 #include "crect.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <vector>
 
 namespace VSTGUI {
 
 //-----------------------------------------------------------------------------
+/** List of dirty rectangles
+ *
+ *	Adding a rectangle merges it with all rectangles in the list it overlaps or touches, if the
+ *	joined rectangle does not cover more area than the two rectangles together. Every added
+ *	rectangle is always completely covered by one rectangle of the list.
+ *
+ *	As long as the list is small it is searched linearly, once it grows beyond
+ *	kIndexThreshold entries a spatial hash grid is used to find the merge candidates, so that
+ *	adding a rectangle only touches the rectangles in its neighbourhood.
+ *
+ *	The rectangles must not be modified via the iterators.
+ */
 struct CInvalidRectList
 {
 	using RectList = std::vector<CRect>;
 
+	/** add a rectangle
+	 *	@return true if the list was changed
+	 */
 	bool add (const CRect& r);
 
 	RectList::iterator begin () { return list.begin (); }
@@ -21,90 +39,343 @@ struct CInvalidRectList
 	RectList::const_iterator begin () const { return list.begin (); }
 	RectList::const_iterator end () const { return list.end (); }
 
-	void erase (RectList::iterator it) { list.erase (it); }
+	void erase (RectList::iterator it)
+	{
+		list.erase (it);
+		grid.invalidate ();
+	}
 
-	void clear () { list.clear (); }
+	void clear ()
+	{
+		list.clear ();
+		grid.reset ();
+	}
 	const RectList& data () const { return list; }
 	bool empty () const { return list.empty (); }
 
+	static constexpr size_t kIndexThreshold = 16;
+
 private:
+	using Index = uint32_t;
+	using IndexList = std::vector<Index>;
+
+	//-----------------------------------------------------------------------------
+	struct Grid
+	{
+		static constexpr CCoord kCellSize = 64.;
+		static constexpr int64_t kMaxCellsPerRect = 64;
+		static constexpr size_t kNumBuckets = 1024;
+
+		struct CellRange
+		{
+			int64_t left, top, right, bottom;
+
+			int64_t count () const { return (right - left + 1) * (bottom - top + 1); }
+		};
+
+		static CellRange cellRange (const CRect& r)
+		{
+			return {static_cast<int64_t> (std::floor (r.left / kCellSize)),
+					static_cast<int64_t> (std::floor (r.top / kCellSize)),
+					static_cast<int64_t> (std::floor (r.right / kCellSize)),
+					static_cast<int64_t> (std::floor (r.bottom / kCellSize))};
+		}
+
+		static size_t bucketIndex (int64_t x, int64_t y)
+		{
+			auto h = (static_cast<uint64_t> (x) * 73856093u) ^ (static_cast<uint64_t> (y) * 19349663u);
+			return static_cast<size_t> (h & (kNumBuckets - 1));
+		}
+
+		bool active () const { return valid; }
+
+		template<typename Proc>
+		void forEachBucket (const CRect& r, Proc proc)
+		{
+			auto range = cellRange (r);
+			if (range.count () > kMaxCellsPerRect)
+			{
+				proc (largeRects);
+				return;
+			}
+			for (auto y = range.top; y <= range.bottom; ++y)
+			{
+				for (auto x = range.left; x <= range.right; ++x)
+				{
+					auto bucketIdx = bucketIndex (x, y);
+					if (!used[bucketIdx])
+					{
+						used[bucketIdx] = true;
+						usedBuckets.emplace_back (bucketIdx);
+					}
+					proc (buckets[bucketIdx]);
+				}
+			}
+		}
+
+		void insert (const CRect& r, Index index)
+		{
+			forEachBucket (r, [&] (IndexList& bucket) { bucket.emplace_back (index); });
+		}
+
+		void remove (const CRect& r, Index index)
+		{
+			forEachBucket (r, [&] (IndexList& bucket) {
+				auto it = std::find (bucket.begin (), bucket.end (), index);
+				if (it != bucket.end ())
+				{
+					*it = bucket.back ();
+					bucket.pop_back ();
+				}
+			});
+		}
+
+		/** collects the indices of all rectangles which may overlap or touch r */
+		void query (const CRect& r, IndexList& result)
+		{
+			result.clear ();
+			result.insert (result.end (), largeRects.begin (), largeRects.end ());
+			auto range = cellRange (r);
+			if (range.count () > kMaxCellsPerRect)
+			{
+				for (auto bucketIdx : usedBuckets)
+					result.insert (result.end (), buckets[bucketIdx].begin (),
+								   buckets[bucketIdx].end ());
+			}
+			else
+			{
+				for (auto y = range.top; y <= range.bottom; ++y)
+				{
+					for (auto x = range.left; x <= range.right; ++x)
+					{
+						const auto& bucket = buckets[bucketIndex (x, y)];
+						result.insert (result.end (), bucket.begin (), bucket.end ());
+					}
+				}
+			}
+			std::sort (result.begin (), result.end ());
+			result.erase (std::unique (result.begin (), result.end ()), result.end ());
+		}
+
+		void build (const RectList& list)
+		{
+			reset ();
+			if (buckets.empty ())
+			{
+				buckets.resize (kNumBuckets);
+				used.resize (kNumBuckets);
+			}
+			valid = true;
+			for (Index i = 0; i < static_cast<Index> (list.size ()); ++i)
+				insert (list[i], i);
+		}
+
+		void invalidate () { valid = false; }
+
+		void reset ()
+		{
+			for (auto bucketIdx : usedBuckets)
+			{
+				buckets[bucketIdx].clear ();
+				used[bucketIdx] = false;
+			}
+			usedBuckets.clear ();
+			largeRects.clear ();
+			valid = false;
+		}
+
+	private:
+		std::vector<IndexList> buckets;
+		std::vector<bool> used;
+		std::vector<size_t> usedBuckets;
+		IndexList largeRects;
+		bool valid {false};
+	};
+
+	void removeAt (Index index);
+
+	friend void joinNearbyInvalidRects (CInvalidRectList& list, CCoord maxDistance);
+
 	RectList list;
+	Grid grid;
+	IndexList candidates;
 };
 
 //-----------------------------------------------------------------------------
-inline bool CInvalidRectList::add (const CRect& r)
+inline void CInvalidRectList::removeAt (Index index)
 {
-	for (auto it = list.begin (), end = list.end (); it != end; ++it)
+	auto last = static_cast<Index> (list.size () - 1);
+	if (grid.active ())
 	{
-		// the same rectangle is already in the list
-		if (*it == r)
-			return false;
-		// the new rectangle is part of one already in the list
-		if (it->rectInside (r))
+		grid.remove (list[index], index);
+		if (index != last)
+		{
+			grid.remove (list[last], last);
+			grid.insert (list[last], index);
+		}
+	}
+	if (index != last)
+		list[index] = list[last];
+	list.pop_back ();
+}
+
+//-----------------------------------------------------------------------------
+inline bool CInvalidRectList::add (const CRect& rect)
+{
+	if (!grid.active () && list.size () >= kIndexThreshold)
+		grid.build (list);
+
+	auto r = rect;
+	auto changed = false;
+	auto restart = true;
+	while (restart)
+	{
+		restart = false;
+		auto checkRect = [&] (Index index) {
+			const auto& other = list[index];
+			if (!other.rectOverlap (r))
+				return false;
+			// the new rectangle is part of one already in the list
+			if (other.rectInside (r))
+				return true;
+			// if the new rectangle contains one of the previous rectangles
+			if (r.rectInside (other))
+			{
+				removeAt (index);
+				restart = true;
+				return true;
+			}
+			// now check if the combined rect has the same or less area as both rects together
+			auto area1 = r.getWidth () * r.getHeight ();
+			auto area2 = other.getWidth () * other.getHeight ();
+			CRect jr (other);
+			jr.unite (r);
+			auto joinedArea = jr.getWidth () * jr.getHeight ();
+			if (joinedArea <= (area1 + area2))
+			{
+				r = jr;
+				removeAt (index);
+				restart = true;
+				return true;
+			}
 			return false;
-		// if the new rectangle contains one of the previous rectangles
-		if (r.rectInside (*it))
+		};
+		auto found = false;
+		if (grid.active ())
 		{
-			list.erase (it);
-			return add (r);
+			grid.query (r, candidates);
+			for (auto index : candidates)
+			{
+				if ((found = checkRect (index)))
+					break;
+			}
 		}
-		// now check if the combined rect has the same or less area as both rects together
-		auto area1 = r.getWidth () * r.getHeight ();
-		auto area2 = it->getWidth () * it->getHeight ();
-		CRect jr (*it);
-		jr.unite (r);
-		auto joinedArea = jr.getWidth () * jr.getHeight ();
-		if (joinedArea <= (area1 + area2))
+		else
 		{
-			list.erase (it);
-			return add (jr);
+			for (Index index = 0; index < static_cast<Index> (list.size ()); ++index)
+			{
+				if ((found = checkRect (index)))
+					break;
+			}
 		}
+		if (found && !restart)
+			return changed;
+		changed |= restart;
 	}
 	list.emplace_back (r);
+	if (grid.active ())
+		grid.insert (r, static_cast<Index> (list.size () - 1));
 	return true;
 }
 
 //-----------------------------------------------------------------------------
+/** join rectangles with the same horizontal or vertical extent which are not more than
+ *	maxDistance apart
+ */
 inline void joinNearbyInvalidRects (CInvalidRectList& list, CCoord maxDistance)
 {
-	for (auto it = list.begin (); it != list.end (); ++it)
-	{
-		for (auto it2 = list.begin (); it2 != list.end (); ++it2)
+	auto& rects = list.list;
+	if (rects.size () < 2)
+		return;
+
+	std::vector<size_t> order (rects.size ());
+	std::vector<bool> removed (rects.size ());
+	auto joinRuns = [&] (auto sameRun, auto runLess, auto distance) {
+		for (size_t i = 0; i < order.size (); ++i)
+			order[i] = i;
+		std::sort (order.begin (), order.end (), [&] (auto i1, auto i2) {
+			return runLess (rects[i1], rects[i2]);
+		});
+		auto joined = false;
+		auto current = order[0];
+		for (size_t i = 1; i < order.size (); ++i)
 		{
-			if (it2 == it)
-				continue;
-			if (it->left == it2->left && it->right == it2->right)
-			{
-				CCoord distance;
-				if (it->bottom < it2->top)
-					distance = it2->top - it->bottom;
-				else
-					distance = it->top - it2->bottom;
-				if (distance <= maxDistance)
-				{
-					it->unite (*it2);
-					list.erase (it2);
-					joinNearbyInvalidRects (list, maxDistance);
-					return;
-				}
-			}
-			if (it->top == it2->top && it->bottom == it2->bottom)
+			auto next = order[i];
+			if (sameRun (rects[current], rects[next]) &&
+				distance (rects[current], rects[next]) <= maxDistance)
 			{
-				CCoord distance;
-				if (it->right < it2->left)
-					distance = it2->left - it->right;
-				else
-					distance = it->left - it2->right;
-				if (distance <= maxDistance)
-				{
-					it->unite (*it2);
-					list.erase (it2);
-					joinNearbyInvalidRects (list, maxDistance);
-					return;
-				}
+				rects[current].unite (rects[next]);
+				removed[next] = true;
+				joined = true;
 			}
+			else
+				current = next;
 		}
+		if (!joined)
+			return false;
+		size_t index = 0;
+		for (size_t i = 0; i < rects.size (); ++i)
+		{
+			if (!removed[i])
+				rects[index++] = rects[i];
+		}
+		rects.resize (index);
+		order.resize (index);
+		removed.assign (index, false);
+		return true;
+	};
+
+	auto joinVertical = [&] () {
+		return joinRuns (
+			[] (const CRect& r1, const CRect& r2) {
+				return r1.left == r2.left && r1.right == r2.right;
+			},
+			[] (const CRect& r1, const CRect& r2) {
+				if (r1.left != r2.left)
+					return r1.left < r2.left;
+				if (r1.right != r2.right)
+					return r1.right < r2.right;
+				return r1.top < r2.top;
+			},
+			[] (const CRect& r1, const CRect& r2) {
+				return r1.bottom < r2.top ? r2.top - r1.bottom : r1.top - r2.bottom;
+			});
+	};
+	auto joinHorizontal = [&] () {
+		return joinRuns (
+			[] (const CRect& r1, const CRect& r2) {
+				return r1.top == r2.top && r1.bottom == r2.bottom;
+			},
+			[] (const CRect& r1, const CRect& r2) {
+				if (r1.top != r2.top)
+					return r1.top < r2.top;
+				if (r1.bottom != r2.bottom)
+					return r1.bottom < r2.bottom;
+				return r1.left < r2.left;
+			},
+			[] (const CRect& r1, const CRect& r2) {
+				return r1.right < r2.left ? r2.left - r1.right : r1.left - r2.right;
+			});
+	};
+
+	auto joined = true;
+	while (joined && rects.size () > 1)
+	{
+		joined = joinVertical ();
+		if (rects.size () > 1)
+			joined |= joinHorizontal ();
 	}
+	list.grid.invalidate ();
 }
 
 //-----------------------------------------------------------------------------
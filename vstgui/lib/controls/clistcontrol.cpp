@@ -9,6 +9,8 @@
 #include "../cscrollview.h"
 #include "../events.h"
 #include "clistcontrol.h"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 //------------------------------------------------------------------------
@@ -21,9 +23,56 @@ struct CListControl::Impl
 	SharedPointer<IListControlConfigurator> configurator;
 
 	std::vector<CListControlRowDesc> rowDescriptions;
+	// the top of every row relative to the view followed by the height of all rows, only used if
+	// the rows have different heights
+	std::vector<CCoord> rowTops;
+	// the height of every row if all rows have the same height, zero otherwise
+	CCoord uniformRowHeight {0.};
 	Optional<int32_t> hoveredRow {};
 	bool doHoverCheck {false};
 	CCoord minHeight {0.};
+
+	size_t numRows () const { return rowDescriptions.size (); }
+
+	CCoord getRowTop (size_t row) const
+	{
+		if (uniformRowHeight > 0.)
+			return uniformRowHeight * row;
+		return rowTops[row];
+	}
+
+	/** the first row with its bottom below y (or at y if inclusive), numRows if there is none */
+	size_t findRowEndingAfter (CCoord y, bool inclusive) const
+	{
+		if (numRows () == 0)
+			return 0;
+		if (uniformRowHeight > 0.)
+		{
+			auto row = inclusive ? std::ceil (y / uniformRowHeight) - 1.
+			                     : std::floor (y / uniformRowHeight);
+			return static_cast<size_t> (
+			    std::min (std::max (row, 0.), static_cast<double> (numRows ())));
+		}
+		auto bottoms = rowTops.begin () + 1;
+		auto it = inclusive ? std::lower_bound (bottoms, rowTops.end (), y)
+		                    : std::upper_bound (bottoms, rowTops.end (), y);
+		return static_cast<size_t> (it - bottoms);
+	}
+
+	/** the first row with its top below y, numRows if there is none */
+	size_t findRowStartingAfter (CCoord y) const
+	{
+		if (numRows () == 0)
+			return 0;
+		if (uniformRowHeight > 0.)
+		{
+			auto row = std::floor (y / uniformRowHeight) + 1.;
+			return static_cast<size_t> (
+			    std::min (std::max (row, 0.), static_cast<double> (numRows ())));
+		}
+		auto end = rowTops.begin () + static_cast<ptrdiff_t> (numRows ());
+		return static_cast<size_t> (std::upper_bound (rowTops.begin (), end, y) - rowTops.begin ());
+	}
 };
 
 //------------------------------------------------------------------------
@@ -93,11 +142,27 @@ void CListControl::recalculateLayout ()
 	impl->rowDescriptions.resize (static_cast<size_t> (numRows));
 	impl->doHoverCheck = false;
 
+	bool uniform = true;
 	for (auto row = 0; row < numRows; ++row)
 	{
 		impl->rowDescriptions[row] = impl->configurator->getRowDesc (row);
 		height += impl->rowDescriptions[row].height;
 		impl->doHoverCheck |= (impl->rowDescriptions[row].flags & CListControlRowDesc::Hoverable) != 0;
+		uniform &= impl->rowDescriptions[row].height == impl->rowDescriptions[0].height;
+	}
+
+	impl->uniformRowHeight = 0.;
+	impl->rowTops.clear ();
+	if (uniform && numRows > 0 && impl->rowDescriptions[0].height > 0.)
+	{
+		impl->uniformRowHeight = impl->rowDescriptions[0].height;
+	}
+	else
+	{
+		impl->rowTops.resize (static_cast<size_t> (numRows) + 1);
+		impl->rowTops[0] = 0.;
+		for (auto row = 0; row < numRows; ++row)
+			impl->rowTops[row + 1] = impl->rowTops[row] + impl->rowDescriptions[row].height;
 	}
 
 	if (impl->minHeight > 0 && height < impl->minHeight)
@@ -117,16 +182,13 @@ Optional<CRect> CListControl::getRowRect (int32_t row) const
 {
 	if (row < getMinRowIndex () || row > getMaxRowIndex ())
 		return {};
-	row -= getMinRowIndex ();
+	auto index = getNormalizedRowIndex (row);
+	if (index >= impl->numRows ())
+		return {};
 	CRect rowSize;
 	rowSize.setWidth (getWidth ());
-	for (auto i = 0u; i < impl->rowDescriptions.size (); ++i)
-	{
-		rowSize.setHeight (impl->rowDescriptions[i].height);
-		if (i == row)
-			break;
-		rowSize.offset (0, impl->rowDescriptions[i].height);
-	}
+	rowSize.setHeight (impl->rowDescriptions[index].height);
+	rowSize.offset (0, impl->getRowTop (index));
 	rowSize.offset (getViewSize ().getTopLeft ());
 	return makeOptional (rowSize);
 }
@@ -143,13 +205,9 @@ Optional<int32_t> CListControl::getRowAtPoint (CPoint where) const
 {
 	where.offsetInverse (getViewSize ().getTopLeft ());
 
-	auto numRows = getNumRows ();
-	for (auto row = 0; row < numRows; ++row)
-	{
-		if (where.y < impl->rowDescriptions[row].height)
-			return {row + getMinRowIndex ()};
-		where.y -= impl->rowDescriptions[row].height;
-	}
+	auto row = impl->findRowEndingAfter (where.y, false);
+	if (row < impl->numRows ())
+		return {static_cast<int32_t> (row) + getMinRowIndex ()};
 	return {};
 }
 
@@ -176,14 +234,19 @@ void CListControl::drawRect (CDrawContext* context, const CRect& updateRect)
 	if (!getTransparency ())
 		impl->drawer->drawBackground (context, getViewSize ());
 
+	// only the rows overlapping the update rect are visited
+	const auto& viewSize = getViewSize ();
+	auto firstRow = static_cast<int32_t> (impl->findRowEndingAfter (updateRect.top - viewSize.top, true));
+	auto lastRow = static_cast<int32_t> (impl->findRowStartingAfter (updateRect.bottom - viewSize.top));
+
 	CRect rowSize;
-	rowSize.setTopLeft (getViewSize ().getTopLeft ());
+	rowSize.setTopLeft (viewSize.getTopLeft ());
 	rowSize.setWidth (getWidth ());
-	rowSize.setHeight (0);
-	auto numRows = getNumRows ();
+	auto numRows = static_cast<int32_t> (impl->numRows ());
 	auto selectedRow = static_cast<int32_t> (getNormalizedRowIndex (getIntValue ()));
-	for (auto row = 0; row < numRows; ++row)
+	for (auto row = firstRow; row < lastRow; ++row)
 	{
+		rowSize.top = viewSize.top + impl->getRowTop (static_cast<size_t> (row));
 		rowSize.setHeight (impl->rowDescriptions[row].height);
 		if (updateRect.rectOverlap (rowSize))
 		{
@@ -196,7 +259,6 @@ void CListControl::drawRect (CDrawContext* context, const CRect& updateRect)
 				flags |= IListControlDrawer::Row::LastRow;
 			impl->drawer->drawRow (context, rowSize, {row + getMinRowIndex (), flags});
 		}
-		rowSize.offset (0, impl->rowDescriptions[row].height);
 	}
 }
 
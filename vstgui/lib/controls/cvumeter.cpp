@@ -99,11 +99,64 @@ void CVuMeter::setDirty (bool state)
 	CView::setDirty (state);
 }
 
+//------------------------------------------------------------------------
+bool CVuMeter::isDirty () const
+{
+	// without idle and feed the value change is drawn by the next redraw
+	if (advancesDisplayValueOnDraw ())
+		return CControl::isDirty ();
+	return CView::isDirty ();
+}
+
 //------------------------------------------------------------------------
 void CVuMeter::onIdle ()
 {
-	if (getOldValue () != value)
-		invalid ();
+	updateDisplayValue ();
+}
+
+//------------------------------------------------------------------------
+/**
+ * the number of LEDs which are lit for a value.
+ * @param value the value in the range of the control
+ */
+int32_t CVuMeter::getNumLitLeds (float value) const
+{
+	auto normValue = (value - getMin ()) / getRange ();
+	if (style & kHorizontal)
+		return (int32_t)(nbLed * normValue + 0.5f);
+	return nbLed - (int32_t)(nbLed * (1.f - normValue) + 0.5f);
+}
+
+//------------------------------------------------------------------------
+/**
+ * moves the displayed value one step towards the value. The displayed value falls by the
+ * decrease step value per call and follows rising values immediately. The meter is only
+ * invalidated if the number of lit LEDs changes.
+ * @return true if the meter was invalidated
+ */
+bool CVuMeter::updateDisplayValue ()
+{
+	if (!advanceDisplayValue ())
+		return false;
+	invalid ();
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool CVuMeter::advanceDisplayValue ()
+{
+	bounceValue ();
+
+	auto displayValue = getOldValue ();
+	if (displayValue == value)
+		return false;
+
+	auto newDisplayValue = displayValue - decreaseValue;
+	if (newDisplayValue < value)
+		newDisplayValue = value;
+	setOldValue (newDisplayValue);
+
+	return getNumLitLeds (newDisplayValue) != getNumLitLeds (displayValue);
 }
 
 //------------------------------------------------------------------------
@@ -118,18 +171,14 @@ void CVuMeter::draw (CDrawContext *_pContext)
 	CPoint pointOff;
 	CDrawContext *pContext = _pContext;
 
-	bounceValue ();
-	
-	float newValue = getOldValue () - decreaseValue;
-	if (newValue < value)
-		newValue = value;
-	setOldValue (newValue);
-
-	newValue = (newValue - getMin ()) / getRange (); // normalize
-	
+	// a meter driven by its own timer with setValue and invalid decays on every redraw
+	if (advancesDisplayValueOnDraw ())
+		advanceDisplayValue ();
+	auto numLitLeds = getNumLitLeds (getOldValue ());
+
 	if (style & kHorizontal) 
 	{
-		auto tmp = (CCoord)(((int32_t)(nbLed * newValue + 0.5f) / (float)nbLed) * getOnBitmap ()->getWidth ());
+		auto tmp = (CCoord)((numLitLeds / (float)nbLed) * getOnBitmap ()->getWidth ());
 		pointOff (tmp, 0);
 
 		_rectOff.left += tmp;
@@ -137,7 +186,7 @@ void CVuMeter::draw (CDrawContext *_pContext)
 	}
 	else 
 	{
-		auto tmp = (CCoord)(((int32_t)(nbLed * (1.f - newValue) + 0.5f) / (float)nbLed) * getOnBitmap ()->getHeight ());
+		auto tmp = (CCoord)(((nbLed - numLitLeds) / (float)nbLed) * getOnBitmap ()->getHeight ());
 		pointOn (0, tmp);
 
 		_rectOff.bottom = tmp + rectOff.top;
@@ -48,11 +48,22 @@ public:
 	
 	void setStyle (int32_t newStyle) { style = newStyle; invalid (); }
 	int32_t getStyle () const { return style; }
+
+	/** get the number of LEDs which are lit for a value */
+	int32_t getNumLitLeds (float value) const;
+	/** decay the displayed value one step, called per idle tick or by a MeterFeed. Only
+	 *	invalidates the meter if the number of lit LEDs changes, returns true in that case. */
+	bool updateDisplayValue ();
+	/** set by a MeterFeed while it advances the displayed value. A meter which is neither fed
+	 *	nor wants idle advances it each time it is drawn. */
+	void setFedByMeterFeed (bool state) { fedByMeterFeed = state; }
+	bool isFedByMeterFeed () const { return fedByMeterFeed; }
 	//@}
 
 
 	// overrides
 	void setDirty (bool state) override;
+	bool isDirty () const override;
 	void draw (CDrawContext* pContext) override;
 	void setViewSize (const CRect& newSize, bool invalid = true) override;
 	bool sizeToFit () override;
@@ -62,6 +73,11 @@ public:
 protected:
 	~CVuMeter () noexcept override;	
 
+	/** move the displayed value one step towards the value without invalidating the meter,
+	 *	returns true if the number of lit LEDs changed */
+	bool advanceDisplayValue ();
+	bool advancesDisplayValueOnDraw () const { return !fedByMeterFeed && !wantsIdle (); }
+
 	CBitmap* offBitmap;
 	
 	int32_t     nbLed;
@@ -70,6 +86,8 @@ protected:
 
 	CRect    rectOn;
 	CRect    rectOff;
+
+	bool fedByMeterFeed {false};
 };
 
 } // VSTGUI
@@ -13,9 +13,11 @@
 #include "iviewlistener.h"
 #include "malloc.h"
 #include "events.h"
+#include "viewdrawcache.h"
 #include "animation/animator.h"
 #include "../uidescription/icontroller.h"
 #include "platform/iplatformframe.h"
+#include <atomic>
 #include <cassert>
 #include <unordered_map>
 #if DEBUG
@@ -189,7 +191,9 @@ struct CView::Impl
 #include "private/enabledeprecatedmessage.h"
 #endif
 	CRect size;
-	int32_t viewFlags {0};
+	// views which can draw concurrently are drawn by several threads when they span more than one
+	// tile, and the drawing code clears the dirty flag
+	std::atomic<int32_t> viewFlags {0};
 	int32_t autosizeFlags {kAutosizeNone};
 	CFrame* parentFrame {nullptr};
 	CView* parentView {nullptr};
@@ -215,7 +219,8 @@ CView::CView (const CView& v)
 {
 	pImpl = std::unique_ptr<Impl> (new Impl ());
 	pImpl->size = v.pImpl->size;
-	pImpl->viewFlags = v.pImpl->viewFlags;
+	// the copy is neither attached nor added to a container
+	pImpl->viewFlags = v.pImpl->viewFlags.load () & ~(kIsAttached | kIsSubview);
 	pImpl->autosizeFlags = v.pImpl->autosizeFlags;
 
 	setMouseableArea (v.getMouseableArea ());
@@ -233,6 +238,8 @@ CView::~CView () noexcept = default;
 //-----------------------------------------------------------------------------
 void CView::beforeDelete ()
 {
+	if (isDrawingCached ())
+		ViewDrawCache::invalidate (this);
 	if (pImpl->viewListeners)
 	{
 		pImpl->viewListeners->forEach ([&] (IViewListener* listener) {
@@ -285,6 +292,8 @@ void CView::setMouseableArea (const CRect& rect)
 		setViewFlag (kHasMouseableArea, true);
 		setAttribute (kCViewMouseableAreaAttrID, rect);
 	}
+	if (auto parent = getParentView ())
+		parent->asViewContainer ()->childViewGeometryChanged (this);
 }
 
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
@@ -338,13 +347,16 @@ CGraphicsPath* CView::getHitTestPath () const
 //-----------------------------------------------------------------------------
 bool CView::hasViewFlag (int32_t bit) const
 {
-	return hasBit (pImpl->viewFlags, bit);
+	return hasBit (pImpl->viewFlags.load (std::memory_order_relaxed), bit);
 }
 
 //-----------------------------------------------------------------------------
 void CView::setViewFlag (int32_t bit, bool state)
 {
-	setBit (pImpl->viewFlags, bit, state);
+	if (state)
+		pImpl->viewFlags.fetch_or (bit, std::memory_order_relaxed);
+	else
+		pImpl->viewFlags.fetch_and (~bit, std::memory_order_relaxed);
 }
 
 //-----------------------------------------------------------------------------
@@ -389,6 +401,22 @@ void CView::setWantsFocus (bool state)
 	setViewFlag (kWantsFocus, state);
 }
 
+//-----------------------------------------------------------------------------
+void CView::setCanDrawConcurrently (bool state)
+{
+	setViewFlag (kCanDrawConcurrently, state);
+}
+
+//-----------------------------------------------------------------------------
+void CView::setDrawingCached (bool state)
+{
+	if (isDrawingCached () == state)
+		return;
+	setViewFlag (kDrawingCached, state);
+	if (!state)
+		ViewDrawCache::invalidate (this);
+}
+
 //-----------------------------------------------------------------------------
 void CView::setWantsIdle (bool state)
 {
@@ -469,6 +497,8 @@ bool CView::removed (CView* parent)
 	}
 	if (pImpl->parentFrame)
 		pImpl->parentFrame->onViewRemoved (this);
+	if (isDrawingCached ())
+		ViewDrawCache::invalidate (this);
 	pImpl->parentView = nullptr;
 	pImpl->parentFrame = nullptr;
 	setViewFlag (kIsAttached, false);
@@ -862,6 +892,8 @@ CGraphicsTransform CView::getGlobalTransform (bool ignoreFrame) const
  */
 void CView::invalidRect (const CRect& rect)
 {
+	if (isDrawingCached ())
+		ViewDrawCache::invalidate (this);
 	if (isAttached () && hasViewFlag (kVisible))
 	{
 		vstgui_assert (pImpl->parentView);
@@ -996,10 +1028,15 @@ void CView::setViewSize (const CRect& newSize, bool doInvalid)
 			invalid ();
 		CRect oldSize = getViewSize ();
 		pImpl->size = newSize;
+		if (isDrawingCached ())
+			ViewDrawCache::invalidate (this);
 		if (doInvalid)
 			setDirty ();
-		if (getParentView ())
-			getParentView ()->notify (this, kMsgViewSizeChanged);
+		if (auto parent = getParentView ())
+		{
+			parent->asViewContainer ()->childViewGeometryChanged (this);
+			parent->notify (this, kMsgViewSizeChanged);
+		}
 		if (pImpl->viewListeners)
 		{
 			pImpl->viewListeners->forEach (
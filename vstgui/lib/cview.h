@@ -70,6 +70,22 @@ public:
 	/** if this is true, setting a view dirty will call invalid() instead of checking it in idle. Default value is false. */
 	static bool kDirtyCallAlwaysOnMainThread;
 
+	/** if the platform draws the frame on multiple threads, only the parts of the frame where all
+	 *	visible views (including the containers and the frame itself) have set this are drawn on a
+	 *	worker thread, everything else is drawn on the main thread. A view must only set this if its
+	 *	drawing does not change shared state and if the platform objects of the fonts, bitmaps and
+	 *	gradients it draws are already created. Default value is false. */
+	void setCanDrawConcurrently (bool state);
+	/** returns true if the view may be drawn on a worker thread */
+	bool canDrawConcurrently () const { return hasViewFlag (kCanDrawConcurrently); }
+
+	/** draw the view once into an offscreen bitmap and draw the bitmap instead of the view until
+	 *	the view is invalidated, resized or drawn with another scale factor (see ViewDrawCache).
+	 *	Default value is false. */
+	void setDrawingCached (bool state);
+	/** returns true if the drawing of the view is cached */
+	bool isDrawingCached () const { return hasViewFlag (kDrawingCached); }
+
 	/** mark rect as invalid */
 	virtual void invalidRect (const CRect& rect);
 	/** mark whole view as invalid */
@@ -463,7 +479,9 @@ protected:
 		kHasBackground			= 1 << 9,
 		kHasDisabledBackground	= 1 << 10,
 		kHasMouseableArea		= 1 << 11,
-		kLastCViewFlag			= 11
+		kCanDrawConcurrently	= 1 << 12,
+		kDrawingCached			= 1 << 13,
+		kLastCViewFlag			= 13
 	};
 
 	~CView () noexcept override;
@@ -17,9 +17,14 @@
 #include "dispatchlist.h"
 #include "events.h"
 #include "finally.h"
+#include "viewdrawcache.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -30,6 +35,147 @@ const CViewAttributeID kCViewContainerMouseDownViewAttribute = 'vcmd';
 const CViewAttributeID kCViewContainerLastDrawnFocusAttribute = 'vclf';
 const CViewAttributeID kCViewContainerBackgroundOffsetAttribute = 'vcbo';
 
+//-----------------------------------------------------------------------------
+/** Uniform grid over the area of the child views of a container.
+ *
+ *	Every cell holds the z-order positions of the children which overlap it in ascending order, so
+ *	the views at a point are found by looking at a single cell and the views in a rect by looking
+ *	at the cells it overlaps. Views outside of the grid are put into the border cells.
+ */
+struct CViewContainerSpatialIndex
+{
+	explicit CViewContainerSpatialIndex (const CViewContainer::ViewList& children)
+	{
+		views.reserve (children.size ());
+		viewBounds.reserve (children.size ());
+		CRect area;
+		for (const auto& child : children)
+		{
+			positions.emplace (child.get (), static_cast<uint32_t> (views.size ()));
+			views.emplace_back (child);
+			viewBounds.emplace_back (boundsOf (child));
+			if (views.size () == 1)
+				area = viewBounds.back ();
+			else
+				area.unite (viewBounds.back ());
+		}
+		origin = area.getTopLeft ();
+		// about as many cells as views
+		auto cellSize = std::sqrt (area.getWidth () * area.getHeight () /
+		                           static_cast<double> (std::max<size_t> (views.size (), 1)));
+		if (cellSize > 0.)
+		{
+			numColumns = static_cast<uint32_t> (
+			    std::clamp (std::ceil (area.getWidth () / cellSize), 1., kMaxCellsPerAxis));
+			numRows = static_cast<uint32_t> (
+			    std::clamp (std::ceil (area.getHeight () / cellSize), 1., kMaxCellsPerAxis));
+			cellWidth = std::max (area.getWidth () / numColumns, 1.);
+			cellHeight = std::max (area.getHeight () / numRows, 1.);
+		}
+		cells.resize (numColumns * numRows);
+		for (uint32_t position = 0; position < views.size (); ++position)
+			forEachCell (viewBounds[position],
+			             [&] (size_t cell) { cells[cell].emplace_back (position); });
+	}
+
+	/** move the view to the cells of its current size and mouseable area */
+	void update (CView* view)
+	{
+		auto it = positions.find (view);
+		if (it == positions.end ())
+			return;
+		auto position = it->second;
+		auto newBounds = boundsOf (view);
+		if (newBounds == viewBounds[position])
+			return;
+		forEachCell (viewBounds[position], [&] (size_t cell) {
+			auto pos = std::lower_bound (cells[cell].begin (), cells[cell].end (), position);
+			if (pos != cells[cell].end () && *pos == position)
+				cells[cell].erase (pos);
+		});
+		viewBounds[position] = newBounds;
+		forEachCell (newBounds, [&] (size_t cell) {
+			auto& c = cells[cell];
+			c.insert (std::lower_bound (c.begin (), c.end (), position), position);
+		});
+	}
+
+	/** the views which may contain the point, bottom most first */
+	void viewsAt (const CPoint& where, std::vector<CView*>& result) const
+	{
+		const auto& cell = cells[row (where.y) * numColumns + column (where.x)];
+		result.reserve (cell.size ());
+		for (auto position : cell)
+			result.emplace_back (views[position]);
+	}
+
+	/** the views which may overlap the rect in z-order. The extra view is added at its z-order
+	 *	position, even if it is outside of the rect */
+	void viewsIn (const CRect& r, std::vector<CView*>& result, const CView* extraView) const
+	{
+		std::vector<uint32_t> found;
+		forEachCell (r, [&] (size_t cell) {
+			found.insert (found.end (), cells[cell].begin (), cells[cell].end ());
+		});
+		if (extraView)
+		{
+			auto it = positions.find (extraView);
+			if (it != positions.end ())
+				found.emplace_back (it->second);
+		}
+		std::sort (found.begin (), found.end ());
+		found.erase (std::unique (found.begin (), found.end ()), found.end ());
+		result.reserve (found.size ());
+		for (auto position : found)
+			result.emplace_back (views[position]);
+	}
+
+private:
+	static constexpr double kMaxCellsPerAxis = 256.;
+
+	static CRect boundsOf (CView* view)
+	{
+		CRect r (view->getViewSize ());
+		r.normalize ();
+		CRect mouseableArea (view->getMouseableArea ());
+		return r.unite (mouseableArea.normalize ());
+	}
+
+	uint32_t cellIndex (CCoord coord, CCoord cellOrigin, CCoord cellSize, uint32_t numCells) const
+	{
+		auto index = std::floor ((coord - cellOrigin) / cellSize);
+		if (!(index > 0.))
+			return 0;
+		if (index >= numCells - 1)
+			return numCells - 1;
+		return static_cast<uint32_t> (index);
+	}
+	uint32_t column (CCoord x) const { return cellIndex (x, origin.x, cellWidth, numColumns); }
+	uint32_t row (CCoord y) const { return cellIndex (y, origin.y, cellHeight, numRows); }
+
+	template<typename Proc>
+	void forEachCell (const CRect& r, Proc proc) const
+	{
+		auto right = column (r.right);
+		auto bottom = row (r.bottom);
+		for (auto y = row (r.top); y <= bottom; ++y)
+		{
+			for (auto x = column (r.left); x <= right; ++x)
+				proc (static_cast<size_t> (y) * numColumns + x);
+		}
+	}
+
+	std::vector<CView*> views;
+	std::vector<CRect> viewBounds;
+	std::unordered_map<const CView*, uint32_t> positions;
+	std::vector<std::vector<uint32_t>> cells;
+	CPoint origin;
+	CCoord cellWidth {1.};
+	CCoord cellHeight {1.};
+	uint32_t numColumns {1};
+	uint32_t numRows {1};
+};
+
 //-----------------------------------------------------------------------------
 // CViewContainer Implementation
 //-----------------------------------------------------------------------------
@@ -44,6 +190,23 @@ struct CViewContainer::Impl
 	
 	CDrawStyle backgroundColorDrawStyle {kDrawFilledAndStroked};
 	CColor backgroundColor {kBlackCColor};
+
+	bool spatialIndexEnabled {false};
+	/** built on demand, reset when the children change */
+	std::unique_ptr<CViewContainerSpatialIndex> spatialIndex;
+	// the frame may be drawn on multiple threads
+	std::mutex spatialIndexMutex;
+
+	const CViewContainerSpatialIndex* getSpatialIndex (const CViewContainer* container)
+	{
+		// child views only report geometry changes to the container they are attached to
+		if (!spatialIndexEnabled || !container->isAttached ())
+			return nullptr;
+		std::lock_guard<std::mutex> guard (spatialIndexMutex);
+		if (!spatialIndex)
+			spatialIndex = std::make_unique<CViewContainerSpatialIndex> (children);
+		return spatialIndex.get ();
+	}
 };
 
 //------------------------------------------------------------------------
@@ -150,6 +313,7 @@ CViewContainer::CViewContainer (const CViewContainer& v)
 	pImpl->transform = v.getTransform ();
 	pImpl->backgroundColorDrawStyle = v.pImpl->backgroundColorDrawStyle;
 	pImpl->backgroundColor = v.pImpl->backgroundColor;
+	pImpl->spatialIndexEnabled = v.pImpl->spatialIndexEnabled;
 	setBackgroundOffset (v.getBackgroundOffset ());
 	for (auto& view : v.pImpl->children)
 		addView (static_cast<CView*> (view->newCopy ()));
@@ -516,6 +680,7 @@ bool CViewContainer::addView (CView *pView, CView* pBefore)
 
 	vstgui_assert (!pView->isSubview (), "view is already added to a container view");
 
+	invalidateSpatialIndex ();
 	if (pBefore)
 	{
 		auto it = std::find (pImpl->children.begin (), pImpl->children.end (), pBefore);
@@ -567,7 +732,8 @@ bool CViewContainer::addView (CView* pView, const CRect &mouseableArea, bool mou
 bool CViewContainer::removeAll (bool withForget)
 {
 	clearMouseDownView ();
-	
+	invalidateSpatialIndex ();
+
 	auto it = pImpl->children.begin ();
 	while (it != pImpl->children.end ())
 	{
@@ -597,6 +763,7 @@ bool CViewContainer::removeView (CView *pView, bool withForget)
 	auto it = std::find (pImpl->children.begin (), pImpl->children.end (), pView);
 	if (it != pImpl->children.end ())
 	{
+		invalidateSpatialIndex ();
 		pView->invalid ();
 		if (pView == getMouseDownView ())
 			clearMouseDownView ();
@@ -701,6 +868,8 @@ bool CViewContainer::changeViewZOrder (CView* view, uint32_t newIndex)
 			if (newIndex > oldIndex)
 				++newIndex;
 
+			invalidateSpatialIndex ();
+
 			auto dest = pImpl->children.begin ();
 			std::advance (dest, newIndex);
 
@@ -723,6 +892,8 @@ bool CViewContainer::invalidateDirtyViews ()
 		return true;
 	if (CView::isDirty ())
 	{
+		if (isDrawingCached ())
+			ViewDrawCache::invalidate (this);
 		if (auto parent = getParentView ())
 			parent->invalidRect (getViewSize ());
 		return true;
@@ -743,6 +914,8 @@ bool CViewContainer::invalidateDirtyViews ()
 //-----------------------------------------------------------------------------
 void CViewContainer::invalid ()
 {
+	if (isDrawingCached ())
+		ViewDrawCache::invalidate (this);
 	if (!isVisible ())
 		return;
 	CRect _rect (getViewSize ());
@@ -753,6 +926,8 @@ void CViewContainer::invalid ()
 //-----------------------------------------------------------------------------
 void CViewContainer::invalidRect (const CRect& rect)
 {
+	if (isDrawingCached ())
+		ViewDrawCache::invalidate (this);
 	if (!isVisible ())
 		return;
 	CRect _rect (rect);
@@ -852,48 +1027,71 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 		getTransform ().inverse ().transform (clientRect);
 		getTransform ().transform (oldClip2);
 		
-		// draw each view
-		for (const auto& pV : pImpl->children)
-		{
-			if (pV->isVisible ())
+		uint32_t numDrawnViews = 0;
+		auto drawChild = [&] (CView* pV) {
+			if (!pV->isVisible ())
+				return;
+			if (frame && _focusDrawing && _focusView == pV && !_focusDrawing->drawFocusOnTop ())
 			{
-				if (frame && _focusDrawing && _focusView == pV && !_focusDrawing->drawFocusOnTop ())
+				SharedPointer<CGraphicsPath> focusPath = owned (pContext->createGraphicsPath ());
+				if (focusPath)
 				{
-					SharedPointer<CGraphicsPath> focusPath = owned (pContext->createGraphicsPath ());
-					if (focusPath)
+					if (_focusDrawing->getFocusPath (*focusPath))
 					{
-						if (_focusDrawing->getFocusPath (*focusPath))
+						auto lastDrawnFocus = focusPath->getBoundingBox ();
+						if (!lastDrawnFocus.isEmpty ())
 						{
-							auto lastDrawnFocus = focusPath->getBoundingBox ();
-							if (!lastDrawnFocus.isEmpty ())
-							{
-								pContext->setClipRect (oldClip2);
-								pContext->setDrawMode (kAntiAliasing|kNonIntegralMode);
-								pContext->setFillColor (frame->getFocusColor ());
-								pContext->drawGraphicsPath (focusPath, CDrawContext::kPathFilledEvenOdd);
-								lastDrawnFocus.extend (1, 1);
-								setLastDrawnFocus (lastDrawnFocus);
-							}
-							_focusDrawing = nullptr;
-							_focusView = nullptr;
+							pContext->setClipRect (oldClip2);
+							pContext->setDrawMode (kAntiAliasing|kNonIntegralMode);
+							pContext->setFillColor (frame->getFocusColor ());
+							pContext->drawGraphicsPath (focusPath, CDrawContext::kPathFilledEvenOdd);
+							lastDrawnFocus.extend (1, 1);
+							setLastDrawnFocus (lastDrawnFocus);
 						}
+						_focusDrawing = nullptr;
+						_focusView = nullptr;
 					}
 				}
+			}
 
-				if (checkUpdateRect (pV, clientRect))
-				{
-					CRect viewSize = pV->getViewSize ();
-					viewSize.bound (newClip);
-					if (viewSize.getWidth () == 0 || viewSize.getHeight () == 0)
-						continue;
-					pContext->setClipRect (viewSize);
-					float globalContextAlpha = pContext->getGlobalAlpha ();
-					pContext->setGlobalAlpha (globalContextAlpha * pV->getAlphaValue ());
+			if (checkUpdateRect (pV, clientRect))
+			{
+				CRect viewSize = pV->getViewSize ();
+				viewSize.bound (newClip);
+				if (viewSize.getWidth () == 0 || viewSize.getHeight () == 0)
+					return;
+				pContext->setClipRect (viewSize);
+				float globalContextAlpha = pContext->getGlobalAlpha ();
+				pContext->setGlobalAlpha (globalContextAlpha * pV->getAlphaValue ());
+				if (pV->isDrawingCached ())
+					ViewDrawCache::drawView (pV, pContext, viewSize);
+				else
 					pV->drawRect (pContext, viewSize);
-					pContext->setGlobalAlpha (globalContextAlpha);
-				}
+				pContext->setGlobalAlpha (globalContextAlpha);
+				++numDrawnViews;
 			}
+		};
+
+		// draw each view
+		uint32_t numVisitedViews = 0;
+		if (auto index = pImpl->getSpatialIndex (this))
+		{
+			// only the views overlapping the clip rect can draw something, but the focus of the
+			// focus view may be drawn outside of it
+			std::vector<CView*> views;
+			index->viewsIn (newClip, views, _focusView);
+			numVisitedViews = static_cast<uint32_t> (views.size ());
+			for (auto view : views)
+				drawChild (view);
+		}
+		else
+		{
+			numVisitedViews = static_cast<uint32_t> (pImpl->children.size ());
+			for (const auto& pV : pImpl->children)
+				drawChild (pV);
 		}
+		if (frame)
+			frame->onChildViewsDrawn (numVisitedViews, numDrawnViews);
 	}
 	
 	pContext->setClipRect (oldClip2);
@@ -943,6 +1141,68 @@ bool CViewContainer::checkUpdateRect (CView* view, const CRect& rect)
 	return view->checkUpdate (rect) && view->isVisible ();
 }
 
+//-----------------------------------------------------------------------------
+void CViewContainer::setSpatialIndexEnabled (bool state)
+{
+	pImpl->spatialIndexEnabled = state;
+	invalidateSpatialIndex ();
+}
+
+//-----------------------------------------------------------------------------
+bool CViewContainer::getSpatialIndexEnabled () const
+{
+	return pImpl->spatialIndexEnabled;
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::invalidateSpatialIndex ()
+{
+	std::lock_guard<std::mutex> guard (pImpl->spatialIndexMutex);
+	pImpl->spatialIndex = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+/** called by child views when their size or mouseable area changed */
+void CViewContainer::childViewGeometryChanged (CView* child)
+{
+	if (!pImpl->spatialIndexEnabled)
+		return;
+	std::lock_guard<std::mutex> guard (pImpl->spatialIndexMutex);
+	if (pImpl->spatialIndex)
+		pImpl->spatialIndex->update (child);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * calls proc for the child views which may contain the point, top most first, until it returns
+ * true
+ * @param where point in the coordinates of the child views
+ * @param proc callback
+ * @return true if proc returned true
+ */
+template<typename Proc>
+bool CViewContainer::visitChildrenAt (const CPoint& where, Proc proc) const
+{
+	if (auto index = pImpl->getSpatialIndex (this))
+	{
+		// a copy, as the callback may change the children
+		std::vector<CView*> candidates;
+		index->viewsAt (where, candidates);
+		for (auto it = candidates.rbegin (), end = candidates.rend (); it != end; ++it)
+		{
+			if (proc (*it))
+				return true;
+		}
+		return false;
+	}
+	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
+	{
+		if (proc (*it))
+			return true;
+	}
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 /**
  * @param where point
@@ -955,21 +1215,15 @@ bool CViewContainer::hitTestSubViews (const CPoint& where, const Event& event)
 	where2.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where2);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
+	return visitChildrenAt (where2, [&] (CView* pV) {
 		if (pV && pV->isVisible () && pV->getMouseEnabled () && pV->hitTest (where2, event))
 		{
 			if (auto container = pV->asViewContainer ())
-			{
-				if (container->hitTestSubViews (where2, event))
-					return true;
-			}
-			else
-				return true;
+				return container->hitTestSubViews (where2, event);
+			return true;
 		}
-	}
-	return false;
+		return false;
+	});
 }
 
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
@@ -990,18 +1244,15 @@ void CViewContainer::dispatchEventToSubViews (Event& event)
 		auto f = finally ([&] () { mouseEvent->mousePosition = mousePos; });
 		mouseEvent->mousePosition.offset (-getViewSize ().left, -getViewSize ().top);
 		getTransform ().inverse ().transform (mouseEvent->mousePosition);
-		for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end;
-			 ++it)
-		{
-			const auto& pV = *it;
+		visitChildrenAt (mouseEvent->mousePosition, [&] (CView* pV) {
 			if (pV && pV->isVisible () && pV->getMouseEnabled () &&
 				pV->getMouseableArea ().pointInside (mouseEvent->mousePosition))
 			{
 				pV->dispatchEvent (event);
-				if (!pV->getTransparency () || event.consumed)
-					return;
+				return !pV->getTransparency () || event.consumed;
 			}
-		}
+			return false;
+		});
 	}
 }
 
@@ -1357,33 +1608,35 @@ CView* CViewContainer::getViewAt (const CPoint& p, const GetViewOptions& options
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
+	CView* result = nullptr;
+	visitChildrenAt (where, [&] (CView* pV) {
 		if (pV && pV->getMouseableArea ().pointInside (where))
 		{
 			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
+				return false;
 			if (options.getMouseEnabled ())
 			{
 				if (pV->getMouseEnabled () == false)
-					continue;
+					return false;
 			}
 			if (options.getDeep ())
 			{
 				if (auto container = pV->asViewContainer ())
 				{
 					CView* view = container->getViewAt (where, options);
-					return options.getIncludeViewContainer () ? (view ? view : container) : view;
+					result = options.getIncludeViewContainer () ? (view ? view : container) : view;
+					return true;
 				}
 			}
 			if (!options.getIncludeViewContainer () && pV->asViewContainer ())
-				continue;
-			return pV;
+				return false;
+			result = pV;
+			return true;
 		}
-	}
+		return false;
+	});
 
-	return nullptr;
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1401,17 +1654,15 @@ bool CViewContainer::getViewsAt (const CPoint& p, ViewList& views, const GetView
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
+	visitChildrenAt (where, [&] (CView* pV) {
 		if (pV && pV->getMouseableArea ().pointInside (where))
 		{
 			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
+				return false;
 			if (options.getMouseEnabled ())
 			{
 				if (pV->getMouseEnabled () == false)
-					continue;
+					return false;
 			}
 			if (options.getDeep ())
 			{
@@ -1421,12 +1672,13 @@ bool CViewContainer::getViewsAt (const CPoint& p, ViewList& views, const GetView
 			if (options.getIncludeViewContainer () == false)
 			{
 				if (pV->asViewContainer ())
-					continue;
+					return false;
 			}
 			views.emplace_back (pV);
 			result = true;
 		}
-	}
+		return false;
+	});
 
 	return result;
 }
@@ -1443,28 +1695,28 @@ CViewContainer* CViewContainer::getContainerAt (const CPoint& p, const GetViewOp
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
+	auto result = const_cast<CViewContainer*>(this);
+	visitChildrenAt (where, [&] (CView* pV) {
 		if (pV && pV->getMouseableArea ().pointInside (where))
 		{
 			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
+				return false;
 			if (options.getMouseEnabled ())
 			{
 				if (pV->getMouseEnabled() == false)
-					continue;
+					return false;
 			}
 			if (options.getDeep ())
 			{
 				if (CViewContainer* container = pV->asViewContainer ())
-					return container->getContainerAt (where, options);
+					result = container->getContainerAt (where, options);
 			}
-			break;
+			return true;
 		}
-	}
+		return false;
+	});
 
-	return const_cast<CViewContainer*>(this);
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1491,6 +1743,7 @@ bool CViewContainer::removed (CView* parent)
 	if (!isAttached ())
 		return false;
 
+	invalidateSpatialIndex ();
 	for (const auto& pV : pImpl->children)
 		pV->removed (this);
 	
@@ -1504,6 +1757,7 @@ bool CViewContainer::attached (CView* parent)
 		return false;
 
 	setParentFrame (parent->getFrame ());
+	invalidateSpatialIndex ();
 
 	bool result = CView::attached (parent);
 	if (result)
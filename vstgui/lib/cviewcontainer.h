@@ -90,6 +90,13 @@ public:
 
 	virtual bool hitTestSubViews (const CPoint& where, const Event& event);
 
+	/** enable an index of the child view positions which lets containers with many children
+	 *	answer hit tests and find the views to draw without visiting all of them. While enabled,
+	 *	child views must not accept hits outside of their view size and mouseable area. Per default
+	 *	this is disabled. */
+	void setSpatialIndexEnabled (bool state);
+	bool getSpatialIndexEnabled () const;
+
 	/** enable or disable autosizing subviews. Per default this is enabled. */
 	virtual void setAutosizingEnabled (bool state);
 	bool getAutosizingEnabled () const { return hasViewFlag (kAutosizeSubviews); }
@@ -262,6 +269,10 @@ protected:
 	const ViewList& getChildren () const;
 private:
 	void dispatchEventToSubViews (Event& event);
+	template<typename Proc>
+	bool visitChildrenAt (const CPoint& where, Proc proc) const;
+	void childViewGeometryChanged (CView* child);
+	void invalidateSpatialIndex ();
 	
 	void clearMouseDownView ();
 	CRect getLastDrawnFocus () const;
@@ -269,6 +280,8 @@ private:
 
 	struct Impl;
 	std::unique_ptr<Impl> pImpl;
+
+	friend class CView;
 };
 
 using ViewIterator = CViewContainer::Iterator<false>;
@@ -0,0 +1,264 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "boxblur.h"
+#include "cpufeatures.h"
+#include <atomic>
+
+namespace VSTGUI {
+namespace Detail {
+namespace {
+
+// All kernels divide a column sum n by the divisor d as (n * m) >> 32 with m = ceil (2^32 / d).
+// The error of m is smaller than d, so the result is exact as long as n * d < 2^32. The sums are
+// at most 255 * d, which holds for d <= BoxBlur::kMaxSIMDDivisor.
+
+#if VSTGUI_SIMD_X86
+//-----------------------------------------------------------------------------
+// SSE2
+//-----------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("sse2")
+inline __m128i divideSSE2 (__m128i sums, __m128i multiplier, __m128i oddMask)
+{
+	// the quotients are the high halves of the 64 bit products
+	auto even = _mm_mul_epu32 (sums, multiplier);
+	auto odd = _mm_mul_epu32 (_mm_srli_epi64 (sums, 32), multiplier);
+	return _mm_or_si128 (_mm_srli_epi64 (even, 32), _mm_and_si128 (odd, oddMask));
+}
+
+//-----------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("sse2")
+int32_t verticalStepSSE2 (int32_t* columnSums, const uint8_t* add, const uint8_t* sub,
+						  uint8_t* output, int32_t count, uint32_t multiplier)
+{
+	const auto m = _mm_set1_epi32 (static_cast<int32_t> (multiplier));
+	const auto oddMask = _mm_set_epi32 (-1, 0, -1, 0);
+	const auto zero = _mm_setzero_si128 ();
+	int32_t j = 0;
+	for (; j + 16 <= count; j += 16)
+	{
+		auto sums = reinterpret_cast<__m128i*> (columnSums + j);
+		auto s0 = _mm_loadu_si128 (sums);
+		auto s1 = _mm_loadu_si128 (sums + 1);
+		auto s2 = _mm_loadu_si128 (sums + 2);
+		auto s3 = _mm_loadu_si128 (sums + 3);
+
+		auto q01 = _mm_packs_epi32 (divideSSE2 (s0, m, oddMask), divideSSE2 (s1, m, oddMask));
+		auto q23 = _mm_packs_epi32 (divideSSE2 (s2, m, oddMask), divideSSE2 (s3, m, oddMask));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (output + j), _mm_packus_epi16 (q01, q23));
+
+		auto a = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (add + j));
+		auto b = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (sub + j));
+		auto dLo = _mm_sub_epi16 (_mm_unpacklo_epi8 (a, zero), _mm_unpacklo_epi8 (b, zero));
+		auto dHi = _mm_sub_epi16 (_mm_unpackhi_epi8 (a, zero), _mm_unpackhi_epi8 (b, zero));
+		// sign extend the differences to 32 bit
+		s0 = _mm_add_epi32 (s0, _mm_srai_epi32 (_mm_unpacklo_epi16 (dLo, dLo), 16));
+		s1 = _mm_add_epi32 (s1, _mm_srai_epi32 (_mm_unpackhi_epi16 (dLo, dLo), 16));
+		s2 = _mm_add_epi32 (s2, _mm_srai_epi32 (_mm_unpacklo_epi16 (dHi, dHi), 16));
+		s3 = _mm_add_epi32 (s3, _mm_srai_epi32 (_mm_unpackhi_epi16 (dHi, dHi), 16));
+		_mm_storeu_si128 (sums, s0);
+		_mm_storeu_si128 (sums + 1, s1);
+		_mm_storeu_si128 (sums + 2, s2);
+		_mm_storeu_si128 (sums + 3, s3);
+	}
+	return j;
+}
+
+//-----------------------------------------------------------------------------
+// AVX2
+//-----------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("avx2")
+inline __m256i divideAVX2 (__m256i sums, __m256i multiplier, __m256i oddMask)
+{
+	auto even = _mm256_mul_epu32 (sums, multiplier);
+	auto odd = _mm256_mul_epu32 (_mm256_srli_epi64 (sums, 32), multiplier);
+	return _mm256_or_si256 (_mm256_srli_epi64 (even, 32), _mm256_and_si256 (odd, oddMask));
+}
+
+//-----------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("avx2")
+int32_t verticalStepAVX2 (int32_t* columnSums, const uint8_t* add, const uint8_t* sub,
+						  uint8_t* output, int32_t count, uint32_t multiplier)
+{
+	const auto m = _mm256_set1_epi32 (static_cast<int32_t> (multiplier));
+	const auto oddMask = _mm256_set_epi32 (-1, 0, -1, 0, -1, 0, -1, 0);
+	// the packs work per 128 bit lane, this restores the order of the 4 byte groups
+	const auto order = _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7);
+	int32_t j = 0;
+	for (; j + 32 <= count; j += 32)
+	{
+		auto sums = reinterpret_cast<__m256i*> (columnSums + j);
+		auto s0 = _mm256_loadu_si256 (sums);
+		auto s1 = _mm256_loadu_si256 (sums + 1);
+		auto s2 = _mm256_loadu_si256 (sums + 2);
+		auto s3 = _mm256_loadu_si256 (sums + 3);
+
+		auto q01 = _mm256_packs_epi32 (divideAVX2 (s0, m, oddMask), divideAVX2 (s1, m, oddMask));
+		auto q23 = _mm256_packs_epi32 (divideAVX2 (s2, m, oddMask), divideAVX2 (s3, m, oddMask));
+		auto q = _mm256_permutevar8x32_epi32 (_mm256_packus_epi16 (q01, q23), order);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (output + j), q);
+
+		auto a = reinterpret_cast<const __m128i*> (add + j);
+		auto b = reinterpret_cast<const __m128i*> (sub + j);
+		auto d01 = _mm256_sub_epi16 (_mm256_cvtepu8_epi16 (_mm_loadu_si128 (a)),
+									 _mm256_cvtepu8_epi16 (_mm_loadu_si128 (b)));
+		auto d23 = _mm256_sub_epi16 (_mm256_cvtepu8_epi16 (_mm_loadu_si128 (a + 1)),
+									 _mm256_cvtepu8_epi16 (_mm_loadu_si128 (b + 1)));
+		s0 = _mm256_add_epi32 (s0, _mm256_cvtepi16_epi32 (_mm256_castsi256_si128 (d01)));
+		s1 = _mm256_add_epi32 (s1, _mm256_cvtepi16_epi32 (_mm256_extracti128_si256 (d01, 1)));
+		s2 = _mm256_add_epi32 (s2, _mm256_cvtepi16_epi32 (_mm256_castsi256_si128 (d23)));
+		s3 = _mm256_add_epi32 (s3, _mm256_cvtepi16_epi32 (_mm256_extracti128_si256 (d23, 1)));
+		_mm256_storeu_si256 (sums, s0);
+		_mm256_storeu_si256 (sums + 1, s1);
+		_mm256_storeu_si256 (sums + 2, s2);
+		_mm256_storeu_si256 (sums + 3, s3);
+	}
+	return j;
+}
+#endif // VSTGUI_SIMD_X86
+
+#if VSTGUI_SIMD_NEON
+//-----------------------------------------------------------------------------
+// NEON
+//-----------------------------------------------------------------------------
+inline uint16x4_t divideNEON (int32x4_t sums, uint32x2_t multiplier)
+{
+	auto s = vreinterpretq_u32_s32 (sums);
+	auto lo = vshrn_n_u64 (vmull_u32 (vget_low_u32 (s), multiplier), 32);
+	auto hi = vshrn_n_u64 (vmull_u32 (vget_high_u32 (s), multiplier), 32);
+	return vmovn_u32 (vcombine_u32 (lo, hi));
+}
+
+//-----------------------------------------------------------------------------
+int32_t verticalStepNEON (int32_t* columnSums, const uint8_t* add, const uint8_t* sub,
+						  uint8_t* output, int32_t count, uint32_t multiplier)
+{
+	const auto m = vdup_n_u32 (multiplier);
+	int32_t j = 0;
+	for (; j + 16 <= count; j += 16)
+	{
+		auto sums = columnSums + j;
+		auto s0 = vld1q_s32 (sums);
+		auto s1 = vld1q_s32 (sums + 4);
+		auto s2 = vld1q_s32 (sums + 8);
+		auto s3 = vld1q_s32 (sums + 12);
+
+		auto q01 = vmovn_u16 (vcombine_u16 (divideNEON (s0, m), divideNEON (s1, m)));
+		auto q23 = vmovn_u16 (vcombine_u16 (divideNEON (s2, m), divideNEON (s3, m)));
+		vst1q_u8 (output + j, vcombine_u8 (q01, q23));
+
+		auto a = vld1q_u8 (add + j);
+		auto b = vld1q_u8 (sub + j);
+		auto dLo = vreinterpretq_s16_u16 (vsubl_u8 (vget_low_u8 (a), vget_low_u8 (b)));
+		auto dHi = vreinterpretq_s16_u16 (vsubl_u8 (vget_high_u8 (a), vget_high_u8 (b)));
+		vst1q_s32 (sums, vaddw_s16 (s0, vget_low_s16 (dLo)));
+		vst1q_s32 (sums + 4, vaddw_s16 (s1, vget_high_s16 (dLo)));
+		vst1q_s32 (sums + 8, vaddw_s16 (s2, vget_low_s16 (dHi)));
+		vst1q_s32 (sums + 12, vaddw_s16 (s3, vget_high_s16 (dHi)));
+	}
+	return j;
+}
+#endif // VSTGUI_SIMD_NEON
+
+//-----------------------------------------------------------------------------
+BoxBlur::Implementation bestImplementation ()
+{
+	for (auto impl : {BoxBlur::Implementation::AVX2, BoxBlur::Implementation::SSE2,
+					  BoxBlur::Implementation::NEON})
+	{
+		if (BoxBlur::isAvailable (impl))
+			return impl;
+	}
+	return BoxBlur::Implementation::Scalar;
+}
+
+//-----------------------------------------------------------------------------
+std::atomic<BoxBlur::Implementation>& selectedImplementation ()
+{
+	static std::atomic<BoxBlur::Implementation> gImplementation {bestImplementation ()};
+	return gImplementation;
+}
+
+//-----------------------------------------------------------------------------
+} // anonymous
+
+//-----------------------------------------------------------------------------
+int32_t BoxBlur::verticalStep (Implementation impl, int32_t* columnSums, const uint8_t* add,
+							   const uint8_t* sub, uint8_t* output, int32_t count,
+							   uint32_t multiplier)
+{
+	switch (impl)
+	{
+#if VSTGUI_SIMD_X86
+		case Implementation::AVX2:
+			return verticalStepAVX2 (columnSums, add, sub, output, count, multiplier);
+		case Implementation::SSE2:
+			return verticalStepSSE2 (columnSums, add, sub, output, count, multiplier);
+#endif
+#if VSTGUI_SIMD_NEON
+		case Implementation::NEON:
+			return verticalStepNEON (columnSums, add, sub, output, count, multiplier);
+#endif
+		default:
+			return 0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool BoxBlur::isAvailable (Implementation impl)
+{
+	switch (impl)
+	{
+		case Implementation::Scalar:
+			return true;
+#if VSTGUI_SIMD_X86
+		case Implementation::SSE2:
+			return cpuSupportsSSE2 ();
+		case Implementation::AVX2:
+			return cpuSupportsSSE2 () && cpuSupportsAVX2 ();
+#endif
+#if VSTGUI_SIMD_NEON
+		case Implementation::NEON:
+			return true;
+#endif
+		default:
+			return false;
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool BoxBlur::setImplementation (Implementation impl)
+{
+	if (!isAvailable (impl))
+		return false;
+	selectedImplementation ().store (impl);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+auto BoxBlur::getImplementation () -> Implementation
+{
+	return selectedImplementation ().load ();
+}
+
+//-----------------------------------------------------------------------------
+const char* BoxBlur::getImplementationName (Implementation impl)
+{
+	switch (impl)
+	{
+		case Implementation::Scalar:
+			return "Scalar";
+		case Implementation::SSE2:
+			return "SSE2";
+		case Implementation::AVX2:
+			return "AVX2";
+		case Implementation::NEON:
+			return "NEON";
+	}
+	return "";
+}
+
+//-----------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
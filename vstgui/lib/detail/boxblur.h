@@ -0,0 +1,189 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../malloc.h"
+#include "../vstguidebug.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace VSTGUI {
+namespace Detail {
+
+//-----------------------------------------------------------------------------
+/** Box blur for interleaved 32 bit pixels
+ *
+ *	The horizontal pass writes only the processed components into an interleaved intermediate
+ *	buffer, the vertical pass keeps one running sum per column and component and walks the
+ *	intermediate buffer row by row. Both passes access the memory linearly. The vertical pass
+ *	uses SSE2 or AVX2 on x86 and NEON on ARM64 processors if available, see setImplementation.
+ *	It divides by multiplying with a fixed point reciprocal instead of the division table of the
+ *	scalar code, which gives the same results for the supported radii. The horizontal pass keeps
+ *	a running sum along each row, one pixel depends on the previous one, so it stays scalar.
+ *
+ *	The buffers are kept between runs, so running the same blur multiple times on the same
+ *	bitmap (like for a gaussian blur approximation) only allocates once.
+ *
+ *	Input and output may point to the same memory.
+ */
+class BoxBlur
+{
+public:
+	enum class Implementation
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+		NEON,
+	};
+
+	/** check if the processor supports the implementation */
+	static bool isAvailable (Implementation impl);
+	/** select the implementation used by all box blurs of the process, the best available one is
+	 *	used by default. Returns false if the implementation is not available. */
+	static bool setImplementation (Implementation impl);
+	static Implementation getImplementation ();
+	static const char* getImplementationName (Implementation impl);
+
+	template<bool plane0, bool plane1, bool plane2, bool plane3>
+	void process (const uint8_t* inPixel, uint8_t* outPixel, int32_t width, int32_t height,
+				  int32_t radius);
+
+private:
+	/** the largest divisor for which the fixed point reciprocal gives exact results */
+	static constexpr int32_t kMaxSIMDDivisor = 4096;
+
+	/** one row of the vertical pass: writes the column sums divided by the divisor to the output
+	 *	and adds the entering and removes the leaving row from the sums. Returns the number of
+	 *	processed columns, the caller processes the rest. */
+	static int32_t verticalStep (Implementation impl, int32_t* columnSums, const uint8_t* add,
+								 const uint8_t* sub, uint8_t* output, int32_t count,
+								 uint32_t multiplier);
+
+	template<bool... enabled>
+	struct Planes
+	{
+		static constexpr int32_t count = (static_cast<int32_t> (enabled) + ...);
+		static constexpr std::array<int32_t, count> offsets ()
+		{
+			std::array<int32_t, count> result {};
+			bool flags[] = {enabled...};
+			int32_t index = 0;
+			for (int32_t i = 0; i < static_cast<int32_t> (sizeof...(enabled)); ++i)
+			{
+				if (flags[i])
+					result[index++] = i;
+			}
+			return result;
+		}
+	};
+
+	void prepareDivisionTable (int32_t div)
+	{
+		if (divisor == div)
+			return;
+		divisor = div;
+		dv.allocate (256 * div);
+		for (auto i = 0u; i < dv.size (); ++i)
+			dv[i] = static_cast<uint8_t> (i / div);
+	}
+
+	Buffer<uint8_t> intermediate;
+	Buffer<int32_t> sums;
+	Buffer<uint8_t> row;
+	Buffer<uint8_t> dv;
+	int32_t divisor {0};
+};
+
+//-----------------------------------------------------------------------------
+template<bool plane0, bool plane1, bool plane2, bool plane3>
+inline void BoxBlur::process (const uint8_t* inPixel, uint8_t* outPixel, int32_t width,
+							  int32_t height, int32_t radius)
+{
+	vstgui_assert (radius > 0);
+
+	using PlaneList = Planes<plane0, plane1, plane2, plane3>;
+	constexpr int32_t numPlanes = PlaneList::count;
+	constexpr auto offsets = PlaneList::offsets ();
+	constexpr int32_t numComponents = 4;
+
+	static_assert (numPlanes > 0, "at least one plane must be processed");
+
+	const int32_t wm = width - 1;
+	const int32_t hm = height - 1;
+	const int32_t div = radius + radius + 1;
+	const int32_t rowSize = width * numPlanes;
+
+	prepareDivisionTable (div);
+	intermediate.allocate (static_cast<size_t> (rowSize) * height);
+	sums.allocate (rowSize);
+
+	auto table = dv.data ();
+
+	// horizontal pass
+	for (auto y = 0; y < height; ++y)
+	{
+		auto src = inPixel + static_cast<size_t> (y) * width * numComponents;
+		auto dst = intermediate.data () + static_cast<size_t> (y) * rowSize;
+		int32_t sum[numPlanes] = {};
+		for (auto i = -radius; i <= radius; ++i)
+		{
+			auto p = std::min (wm, std::max (i, 0)) * numComponents;
+			for (auto k = 0; k < numPlanes; ++k)
+				sum[k] += src[p + offsets[k]];
+		}
+		for (auto x = 0; x < width; ++x, dst += numPlanes)
+		{
+			for (auto k = 0; k < numPlanes; ++k)
+				dst[k] = table[sum[k]];
+			auto p1 = std::min (x + radius + 1, wm) * numComponents;
+			auto p2 = std::max (x - radius, 0) * numComponents;
+			for (auto k = 0; k < numPlanes; ++k)
+				sum[k] += src[p1 + offsets[k]] - src[p2 + offsets[k]];
+		}
+	}
+
+	// vertical pass
+	auto impl = div <= kMaxSIMDDivisor ? getImplementation () : Implementation::Scalar;
+	auto multiplier = static_cast<uint32_t> (((static_cast<uint64_t> (1) << 32) + div - 1) / div);
+	if (numPlanes != numComponents)
+		row.allocate (rowSize);
+	auto columnSums = sums.data ();
+	std::fill (columnSums, columnSums + rowSize, 0);
+	for (auto i = -radius; i <= radius; ++i)
+	{
+		auto src = intermediate.data () + static_cast<size_t> (std::min (hm, std::max (i, 0))) *
+											  rowSize;
+		for (auto j = 0; j < rowSize; ++j)
+			columnSums[j] += src[j];
+	}
+	for (auto y = 0; y < height; ++y)
+	{
+		auto dst = outPixel + static_cast<size_t> (y) * width * numComponents;
+		auto add = intermediate.data () + static_cast<size_t> (std::min (y + radius + 1, hm)) *
+											  rowSize;
+		auto sub = intermediate.data () + static_cast<size_t> (std::max (y - radius, 0)) * rowSize;
+		auto rowDst = numPlanes == numComponents ? dst : row.data ();
+		auto j = verticalStep (impl, columnSums, add, sub, rowDst, rowSize, multiplier);
+		for (; j < rowSize; ++j)
+		{
+			rowDst[j] = table[columnSums[j]];
+			columnSums[j] += add[j] - sub[j];
+		}
+		if (numPlanes != numComponents)
+		{
+			for (auto x = 0, k = 0; x < width; ++x, dst += numComponents)
+			{
+				for (auto plane = 0; plane < numPlanes; ++plane, ++k)
+					dst[offsets[plane]] = rowDst[k];
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
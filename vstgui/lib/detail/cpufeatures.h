@@ -0,0 +1,77 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define VSTGUI_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#define VSTGUI_SIMD_TARGET(name)
+#else
+#define VSTGUI_SIMD_TARGET(name) __attribute__ ((target (name)))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define VSTGUI_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace VSTGUI {
+namespace Detail {
+
+#if VSTGUI_SIMD_X86
+//-----------------------------------------------------------------------------
+/** Runtime detection of the x86 instruction sets used by the SIMD kernels of the library
+ *
+ *	The kernels are compiled with per function target attributes, so they may only be called
+ *	after checking that the processor supports them.
+ */
+inline bool cpuSupportsSSE2 ()
+{
+#if defined(_M_X64) || defined(__x86_64__)
+	return true;
+#elif defined(_MSC_VER)
+	int info[4];
+	__cpuid (info, 1);
+	return (info[3] & (1 << 26)) != 0;
+#else
+	return __builtin_cpu_supports ("sse2");
+#endif
+}
+
+//-----------------------------------------------------------------------------
+inline bool cpuSupportsSSSE3 ()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid (info, 1);
+	return (info[2] & (1 << 9)) != 0;
+#else
+	return __builtin_cpu_supports ("ssse3");
+#endif
+}
+
+//-----------------------------------------------------------------------------
+inline bool cpuSupportsAVX2 ()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid (info, 1);
+	// the operating system must save the AVX registers
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv (0) & 6) != 6)
+		return false;
+	__cpuidex (info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports ("avx2");
+#endif
+}
+#endif // VSTGUI_SIMD_X86
+
+//-----------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
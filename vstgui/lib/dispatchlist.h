@@ -21,6 +21,7 @@ public:
 	void remove (const T& obj);
 	void remove (T&& obj);
 	bool empty () const;
+	bool contains (const T& obj) const;
 
 	template<typename Procedure>
 	void forEach (Procedure proc);
@@ -127,6 +128,19 @@ inline bool DispatchList<T>::empty () const
 	return entries.empty ();
 }
 
+//------------------------------------------------------------------------
+template<typename T>
+inline bool DispatchList<T>::contains (const T& obj) const
+{
+	auto it = std::find_if (entries.begin (), entries.end (),
+	                        [&] (const typename Array::value_type& element) {
+		                        return element.first && element.second == obj;
+	                        });
+	if (it != entries.end ())
+		return true;
+	return std::find (toAdd.begin (), toAdd.end (), obj) != toAdd.end ();
+}
+
 //------------------------------------------------------------------------
 template<typename T>
 inline void DispatchList<T>::postForEach ()
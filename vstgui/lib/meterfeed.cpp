@@ -0,0 +1,208 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "meterfeed.h"
+#include "controls/cvumeter.h"
+#include <atomic>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+struct MeterFeed::Impl
+{
+	struct Entry
+	{
+		MeterID meter;
+		float value;
+	};
+
+	struct Meter
+	{
+		SharedPointer<CControl> control;
+		CVuMeter* vuMeter {nullptr};
+		float value {0.f};
+		/** increased when the meter is removed, so the old id does not match a new meter */
+		uint16_t generation {0};
+		bool hasValue {false};
+		bool vuMeterWantedIdle {false};
+	};
+
+	// a meter id is the slot in the low and the generation of the slot in the high 16 bits. The
+	// last slot is not used, so no id is kInvalidMeterID.
+	static constexpr uint32_t kMaxMeters = 0xFFFFu;
+
+	static MeterID makeMeterID (uint32_t slot, uint16_t generation)
+	{
+		return (static_cast<MeterID> (generation) << 16) | slot;
+	}
+
+	/** returns nullptr if the meter was removed */
+	Meter* findMeter (MeterID meter)
+	{
+		auto slot = meter & 0xFFFFu;
+		if (slot >= meters.size ())
+			return nullptr;
+		auto& entry = meters[slot];
+		if (entry.generation != (meter >> 16) || !entry.control)
+			return nullptr;
+		return &entry;
+	}
+
+	static_assert (std::atomic<uint32_t>::is_always_lock_free,
+	               "the ring buffer indices must be lock free");
+
+	std::vector<Entry> entries;
+	uint32_t mask {0};
+
+	// the indices are only increased and wrap around, each one is written by one thread. They are
+	// kept on separate cache lines so the threads do not invalidate each others cache.
+	alignas (64) std::atomic<uint32_t> writeIndex {0};
+	alignas (64) std::atomic<uint32_t> readIndex {0};
+
+	// UI thread only
+	std::vector<Meter> meters;
+	std::vector<uint32_t> freeSlots;
+};
+
+//------------------------------------------------------------------------
+MeterFeed::MeterFeed (uint32_t capacity)
+{
+	impl = std::make_unique<Impl> ();
+	uint32_t size = 1;
+	while (size < capacity && size < 0x80000000u)
+		size <<= 1;
+	impl->entries.resize (size);
+	impl->mask = size - 1;
+}
+
+//------------------------------------------------------------------------
+MeterFeed::~MeterFeed () noexcept
+{
+	for (auto slot = 0u; slot < impl->meters.size (); ++slot)
+		removeMeter (Impl::makeMeterID (slot, impl->meters[slot].generation));
+}
+
+//------------------------------------------------------------------------
+uint32_t MeterFeed::getCapacity () const
+{
+	return impl->mask + 1;
+}
+
+//------------------------------------------------------------------------
+bool MeterFeed::push (MeterID meter, float value)
+{
+	auto writeIndex = impl->writeIndex.load (std::memory_order_relaxed);
+	auto readIndex = impl->readIndex.load (std::memory_order_acquire);
+	if (writeIndex - readIndex > impl->mask)
+		return false;
+	impl->entries[writeIndex & impl->mask] = {meter, value};
+	impl->writeIndex.store (writeIndex + 1, std::memory_order_release);
+	return true;
+}
+
+//------------------------------------------------------------------------
+auto MeterFeed::addMeter (CControl* control) -> MeterID
+{
+	if (!control)
+		return kInvalidMeterID;
+	uint32_t slot;
+	if (impl->freeSlots.empty ())
+	{
+		if (impl->meters.size () >= Impl::kMaxMeters)
+			return kInvalidMeterID;
+		slot = static_cast<uint32_t> (impl->meters.size ());
+		impl->meters.emplace_back ();
+	}
+	else
+	{
+		slot = impl->freeSlots.back ();
+		impl->freeSlots.pop_back ();
+	}
+	auto& entry = impl->meters[slot];
+	entry.control = control;
+	entry.vuMeter = dynamic_cast<CVuMeter*> (control);
+	entry.hasValue = false;
+	if (entry.vuMeter)
+	{
+		entry.vuMeterWantedIdle = entry.vuMeter->wantsIdle ();
+		entry.vuMeter->setWantsIdle (false);
+		entry.vuMeter->setFedByMeterFeed (true);
+	}
+	return Impl::makeMeterID (slot, entry.generation);
+}
+
+//------------------------------------------------------------------------
+void MeterFeed::removeMeter (MeterID meter)
+{
+	auto entry = impl->findMeter (meter);
+	if (!entry)
+		return;
+	if (entry->vuMeter)
+	{
+		entry->vuMeter->setFedByMeterFeed (false);
+		entry->vuMeter->setWantsIdle (entry->vuMeterWantedIdle);
+	}
+	entry->control = nullptr;
+	entry->vuMeter = nullptr;
+	entry->hasValue = false;
+	++entry->generation;
+	impl->freeSlots.push_back (meter & 0xFFFFu);
+}
+
+//------------------------------------------------------------------------
+CControl* MeterFeed::getMeter (MeterID meter) const
+{
+	auto entry = impl->findMeter (meter);
+	return entry ? entry->control.get () : nullptr;
+}
+
+//------------------------------------------------------------------------
+uint32_t MeterFeed::drain ()
+{
+	// only the last value of every meter is of interest
+	auto readIndex = impl->readIndex.load (std::memory_order_relaxed);
+	auto writeIndex = impl->writeIndex.load (std::memory_order_acquire);
+	for (; readIndex != writeIndex; ++readIndex)
+	{
+		const auto& entry = impl->entries[readIndex & impl->mask];
+		if (auto meter = impl->findMeter (entry.meter))
+		{
+			meter->value = entry.value;
+			meter->hasValue = true;
+		}
+	}
+	impl->readIndex.store (readIndex, std::memory_order_release);
+
+	uint32_t numInvalidated = 0;
+	for (auto& meter : impl->meters)
+	{
+		if (!meter.control)
+			continue;
+		if (meter.vuMeter)
+		{
+			// the decay continues without new values
+			if (meter.hasValue)
+				meter.vuMeter->setValue (meter.value);
+			if (meter.vuMeter->updateDisplayValue ())
+				++numInvalidated;
+		}
+		else if (meter.hasValue)
+		{
+			auto oldValue = meter.control->getValue ();
+			meter.control->setValue (meter.value);
+			if (meter.control->getValue () != oldValue)
+			{
+				meter.control->invalid ();
+				++numInvalidated;
+			}
+		}
+		meter.hasValue = false;
+	}
+	return numInvalidated;
+}
+
+//------------------------------------------------------------------------
+} // VSTGUI
@@ -0,0 +1,65 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "vstguifwd.h"
+#include <cstdint>
+#include <memory>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+/** Feeds meter values from an audio thread to the controls of a frame
+ *
+ *	The audio thread pushes the values into a single producer, single consumer ring buffer without
+ *	locks or allocations. The frame drains the feed once per idle tick (see CFrame::addMeterFeed),
+ *	sets the last pushed value of every meter in one batch and only invalidates the controls whose
+ *	drawing changes: a CVuMeter if the number of its lit LEDs changes, any other control if its
+ *	value changes. A CVuMeter added to a feed does not use an idle timer of its own, its decay is
+ *	advanced by the feed.
+ *
+ *	The meters must be added on the UI thread before the audio thread pushes values for them. The
+ *	id of a removed meter is not valid anymore, values still pushed for it are dropped, even if
+ *	its slot is used by another meter.
+ */
+class MeterFeed : public AtomicReferenceCounted
+{
+public:
+	using MeterID = uint32_t;
+
+	static constexpr MeterID kInvalidMeterID = 0xFFFFFFFFu;
+
+	/** the capacity of the ring buffer is rounded up to a power of two */
+	explicit MeterFeed (uint32_t capacity = 1024);
+	~MeterFeed () noexcept override;
+
+	/** push a value for the meter, call this only from the audio thread.
+	 *	Returns false and drops the value if the ring buffer is full. */
+	bool push (MeterID meter, float value);
+
+	/** add a control to the feed, call this only from the UI thread.
+	 *	Returns kInvalidMeterID if the feed has no free slot. */
+	MeterID addMeter (CControl* control);
+	/** remove a control from the feed, call this only from the UI thread.
+	 *	A CVuMeter gets back the idle state it had before it was added. */
+	void removeMeter (MeterID meter);
+	/** get the control of the meter */
+	CControl* getMeter (MeterID meter) const;
+
+	/** pop all pushed values and update the meters, call this only from the UI thread.
+	 *	Returns the number of invalidated meters. */
+	uint32_t drain ();
+
+	/** get the number of values the ring buffer can hold */
+	uint32_t getCapacity () const;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl;
+};
+
+//------------------------------------------------------------------------
+} // VSTGUI
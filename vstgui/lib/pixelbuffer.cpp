@@ -4,6 +4,12 @@
 
 #include "pixelbuffer.h"
 #include "vstguibase.h"
+#include "detail/cpufeatures.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <utility>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -53,237 +59,410 @@ inline uint32_t shuffle (uint32_t input)
 
 //------------------------------------------------------------------------
 template<Format SourceFormat, Format DestinationFormat>
-inline void convert (uint8_t* buffer, uint32_t bytesPerRow, uint32_t width, uint32_t height)
+inline uint32_t convertPixel (uint32_t pixel)
 {
-	for (auto y = 0u; y < height; ++y, buffer += bytesPerRow)
-	{
-		auto intPtr = reinterpret_cast<uint32_t*> (buffer);
-		for (auto x = 0u; x < width; ++x, ++intPtr)
-		{
-			auto pixel = *intPtr;
-			switch (SourceFormat)
-			{
-				case Format::ARGB:
-				{
-					switch (DestinationFormat)
-					{
-						case Format::ARGB:
-						{
-							// nothing to do
-							break;
-						}
-						case Format::ABGR:
-						{
-							*intPtr = shuffle<-2, 0, 2, 0> (pixel);
-							break;
-						}
-						case Format::BGRA:
-						{
-							*intPtr = shuffle<-3, -1, 1, 3> (pixel);
-							break;
-						}
-						case Format::RGBA:
-						{
-							*intPtr = shuffle<-1, -1, -1, 3> (pixel);
-							break;
-						}
-					}
-					break;
-				}
-				case Format::ABGR:
-				{
-					switch (DestinationFormat)
-					{
-						case Format::ARGB:
-						{
-							*intPtr = shuffle<-2, 0, 2, 0> (pixel);
-							break;
-						}
-						case Format::ABGR:
-						{
-							// nothing to do
-							break;
-						}
-						case Format::BGRA:
-						{
-							*intPtr = shuffle<-1, -1, -1, 3> (pixel);
-							break;
-						}
-						case Format::RGBA:
-						{
-							*intPtr = shuffle<-3, -1, 1, 3> (pixel);
-							break;
-						}
-					}
-					break;
-				}
-				case Format::RGBA:
-				{
-					switch (DestinationFormat)
-					{
-						case Format::ARGB:
-						{
-							*intPtr = shuffle<-1, -1, -1, 3> (pixel);
-							break;
-						}
-						case Format::ABGR:
-						{
-							*intPtr = shuffle<-3, -1, 1, 3> (pixel);
-							break;
-						}
-						case Format::BGRA:
-						{
-							*intPtr = shuffle<-2, 0, 2, 0> (pixel);
-							break;
-						}
-						case Format::RGBA:
-						{
-							// nothing to do
-							break;
-						}
-					}
-					break;
-				}
-				case Format::BGRA:
-				{
-					switch (DestinationFormat)
-					{
-						case Format::ARGB:
-						{
-							*intPtr = shuffle<-3, -1, 1, 3> (pixel);
-							break;
-						}
-						case Format::ABGR:
-						{
-							*intPtr = shuffle<-1, -1, -1, 3> (pixel);
-							break;
-						}
-						case Format::BGRA:
-						{
-							// nothing to do
-							break;
-						}
-						case Format::RGBA:
-						{
-							*intPtr = shuffle<0, -2, 0, 2> (pixel);
-							break;
-						}
-					}
-					break;
-				}
-			}
-		}
-	}
-}
-
-//------------------------------------------------------------------------
-} // Private
-
-//------------------------------------------------------------------------
-void convert (Format srcFormat, Format dstFormat, uint8_t* buffer, uint32_t bytesPerRow,
-			  uint32_t width, uint32_t height)
-{
-	using namespace Private;
-	switch (srcFormat)
+	switch (SourceFormat)
 	{
 		case Format::ARGB:
 		{
-			switch (dstFormat)
+			switch (DestinationFormat)
 			{
-				case Format::ARGB:
-					return;
-				case Format::ABGR:
-				{
-					convert<Format::ARGB, Format::ABGR> (buffer, bytesPerRow, width, height);
-					break;
-				}
-				case Format::RGBA:
-				{
-					convert<Format::ARGB, Format::RGBA> (buffer, bytesPerRow, width, height);
-					break;
-				}
-				case Format::BGRA:
-				{
-					convert<Format::ARGB, Format::BGRA> (buffer, bytesPerRow, width, height);
-					break;
-				}
+				case Format::ARGB: return pixel;
+				case Format::ABGR: return shuffle<-2, 0, 2, 0> (pixel);
+				case Format::BGRA: return shuffle<-3, -1, 1, 3> (pixel);
+				case Format::RGBA: return shuffle<-1, -1, -1, 3> (pixel);
 			}
 			break;
 		}
 		case Format::ABGR:
 		{
-			switch (dstFormat)
+			switch (DestinationFormat)
 			{
-				case Format::ARGB:
-				{
-					convert<Format::ABGR, Format::ARGB> (buffer, bytesPerRow, width, height);
-					break;
-				}
-				case Format::ABGR:
-					return;
-				case Format::RGBA:
-				{
-					convert<Format::ABGR, Format::RGBA> (buffer, bytesPerRow, width, height);
-					break;
-				}
-				case Format::BGRA:
-				{
-					convert<Format::ABGR, Format::BGRA> (buffer, bytesPerRow, width, height);
-					break;
-				}
+				case Format::ARGB: return shuffle<-2, 0, 2, 0> (pixel);
+				case Format::ABGR: return pixel;
+				case Format::BGRA: return shuffle<-1, -1, -1, 3> (pixel);
+				case Format::RGBA: return shuffle<-3, -1, 1, 3> (pixel);
 			}
 			break;
 		}
 		case Format::RGBA:
 		{
-			switch (dstFormat)
+			switch (DestinationFormat)
 			{
-				case Format::ARGB:
-				{
-					convert<Format::RGBA, Format::ARGB> (buffer, bytesPerRow, width, height);
-					break;
-				}
-				case Format::ABGR:
-				{
-					convert<Format::RGBA, Format::ABGR> (buffer, bytesPerRow, width, height);
-					break;
-				}
-				case Format::RGBA:
-					return;
-				case Format::BGRA:
-				{
-					convert<Format::RGBA, Format::BGRA> (buffer, bytesPerRow, width, height);
-					break;
-				}
+				case Format::ARGB: return shuffle<-1, -1, -1, 3> (pixel);
+				case Format::ABGR: return shuffle<-3, -1, 1, 3> (pixel);
+				case Format::BGRA: return shuffle<-2, 0, 2, 0> (pixel);
+				case Format::RGBA: return pixel;
 			}
 			break;
 		}
 		case Format::BGRA:
 		{
-			switch (dstFormat)
+			switch (DestinationFormat)
+			{
+				case Format::ARGB: return shuffle<-3, -1, 1, 3> (pixel);
+				case Format::ABGR: return shuffle<-1, -1, -1, 3> (pixel);
+				case Format::BGRA: return pixel;
+				case Format::RGBA: return shuffle<0, -2, 0, 2> (pixel);
+			}
+			break;
+		}
+	}
+	return pixel;
+}
+
+//------------------------------------------------------------------------
+/** the index of the source byte of each destination byte of a pixel. Derived from the scalar
+ *	conversion, so both always agree. */
+template<Format SourceFormat, Format DestinationFormat>
+inline std::array<uint8_t, 4> bytePermutation ()
+{
+	const uint8_t probe[4] = {0, 1, 2, 3};
+	uint32_t pixel;
+	memcpy (&pixel, probe, 4);
+	pixel = convertPixel<SourceFormat, DestinationFormat> (pixel);
+	std::array<uint8_t, 4> result;
+	memcpy (result.data (), &pixel, 4);
+	return result;
+}
+
+//------------------------------------------------------------------------
+/** the byte shuffle mask for four pixels */
+inline void makeShuffleMask (const std::array<uint8_t, 4>& permutation, uint8_t mask[16])
+{
+	for (auto i = 0; i < 16; ++i)
+		mask[i] = static_cast<uint8_t> ((i & ~3) + permutation[i & 3]);
+}
+
+#if VSTGUI_SIMD_X86
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("ssse3")
+static uint32_t shuffleRowSSSE3 (uint32_t* pixels, uint32_t width, const uint8_t maskBytes[16])
+{
+	const auto mask = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (maskBytes));
+	uint32_t x = 0;
+	for (; x + 8 <= width; x += 8)
+	{
+		auto p = reinterpret_cast<__m128i*> (pixels + x);
+		auto p0 = _mm_loadu_si128 (p);
+		auto p1 = _mm_loadu_si128 (p + 1);
+		_mm_storeu_si128 (p, _mm_shuffle_epi8 (p0, mask));
+		_mm_storeu_si128 (p + 1, _mm_shuffle_epi8 (p1, mask));
+	}
+	for (; x + 4 <= width; x += 4)
+	{
+		auto p = reinterpret_cast<__m128i*> (pixels + x);
+		_mm_storeu_si128 (p, _mm_shuffle_epi8 (_mm_loadu_si128 (p), mask));
+	}
+	return x;
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("avx2")
+static uint32_t shuffleRowAVX2 (uint32_t* pixels, uint32_t width, const uint8_t maskBytes[16])
+{
+	// the shuffle works per 128 bit lane, each lane holds four whole pixels
+	const auto mask = _mm256_broadcastsi128_si256 (
+		_mm_loadu_si128 (reinterpret_cast<const __m128i*> (maskBytes)));
+	uint32_t x = 0;
+	for (; x + 16 <= width; x += 16)
+	{
+		auto p = reinterpret_cast<__m256i*> (pixels + x);
+		auto p0 = _mm256_loadu_si256 (p);
+		auto p1 = _mm256_loadu_si256 (p + 1);
+		_mm256_storeu_si256 (p, _mm256_shuffle_epi8 (p0, mask));
+		_mm256_storeu_si256 (p + 1, _mm256_shuffle_epi8 (p1, mask));
+	}
+	for (; x + 8 <= width; x += 8)
+	{
+		auto p = reinterpret_cast<__m256i*> (pixels + x);
+		_mm256_storeu_si256 (p, _mm256_shuffle_epi8 (_mm256_loadu_si256 (p), mask));
+	}
+	return x;
+}
+#endif // VSTGUI_SIMD_X86
+
+#if VSTGUI_SIMD_NEON
+//------------------------------------------------------------------------
+static uint32_t shuffleRowNEON (uint32_t* pixels, uint32_t width, const uint8_t maskBytes[16])
+{
+	const auto mask = vld1q_u8 (maskBytes);
+	uint32_t x = 0;
+	for (; x + 8 <= width; x += 8)
+	{
+		auto p = reinterpret_cast<uint8_t*> (pixels + x);
+		auto p0 = vld1q_u8 (p);
+		auto p1 = vld1q_u8 (p + 16);
+		vst1q_u8 (p, vqtbl1q_u8 (p0, mask));
+		vst1q_u8 (p + 16, vqtbl1q_u8 (p1, mask));
+	}
+	for (; x + 4 <= width; x += 4)
+	{
+		auto p = reinterpret_cast<uint8_t*> (pixels + x);
+		vst1q_u8 (p, vqtbl1q_u8 (vld1q_u8 (p), mask));
+	}
+	return x;
+}
+#endif // VSTGUI_SIMD_NEON
+
+//------------------------------------------------------------------------
+/** shuffle the bytes of the pixels of a row, returns the number of converted pixels. The caller
+ *	converts the rest. */
+inline uint32_t shuffleRow (Implementation impl, uint32_t* pixels, uint32_t width,
+							const uint8_t mask[16])
+{
+	switch (impl)
+	{
+#if VSTGUI_SIMD_X86
+		case Implementation::AVX2:
+			return shuffleRowAVX2 (pixels, width, mask);
+		case Implementation::SSSE3:
+			return shuffleRowSSSE3 (pixels, width, mask);
+#endif
+#if VSTGUI_SIMD_NEON
+		case Implementation::NEON:
+			return shuffleRowNEON (pixels, width, mask);
+#endif
+		default:
+			return 0;
+	}
+}
+
+//------------------------------------------------------------------------
+static Implementation bestImplementation ()
+{
+	for (auto impl : {Implementation::AVX2, Implementation::SSSE3, Implementation::NEON})
+	{
+		if (isAvailable (impl))
+			return impl;
+	}
+	return Implementation::Scalar;
+}
+
+//------------------------------------------------------------------------
+static std::atomic<Implementation>& selectedImplementation ()
+{
+	static std::atomic<Implementation> gImplementation {bestImplementation ()};
+	return gImplementation;
+}
+
+//------------------------------------------------------------------------
+/** the index of the alpha byte of a pixel in memory. It is taken from the same byte shuffles as
+ *	the format conversions: the alpha component is the most significant byte of a Format::ARGB
+ *	value in the native byte order and the other formats have it where the shuffle from
+ *	Format::ARGB puts it. */
+template<Format format>
+inline uint32_t alphaByteIndex ()
+{
+	constexpr uint8_t argbAlphaIndex =
+		ByteOrder::kNativeByteOrder == ByteOrder::kLittleEndianByteOrder ? 3 : 0;
+	auto permutation = bytePermutation<Format::ARGB, format> ();
+	uint32_t index = 0;
+	while (index < 3 && permutation[index] != argbAlphaIndex)
+		++index;
+	return index;
+}
+
+//------------------------------------------------------------------------
+using AlphaTable = std::array<std::array<uint8_t, 256>, 256>;
+
+//------------------------------------------------------------------------
+static const AlphaTable& premultiplyTable ()
+{
+	static const AlphaTable table = [] () {
+		AlphaTable t;
+		for (uint32_t a = 0; a < 256; ++a)
+		{
+			for (uint32_t c = 0; c < 256; ++c)
+				t[a][c] = static_cast<uint8_t> ((c * a + 127) / 255);
+		}
+		return t;
+	}();
+	return table;
+}
+
+//------------------------------------------------------------------------
+static const AlphaTable& unpremultiplyTable ()
+{
+	static const AlphaTable table = [] () {
+		AlphaTable t;
+		for (uint32_t c = 0; c < 256; ++c)
+			t[0][c] = static_cast<uint8_t> (c);
+		for (uint32_t a = 1; a < 256; ++a)
+		{
+			for (uint32_t c = 0; c < 256; ++c)
+				t[a][c] = static_cast<uint8_t> (std::min<uint32_t> (255, (c * 255 + a / 2) / a));
+		}
+		return t;
+	}();
+	return table;
+}
+
+//------------------------------------------------------------------------
+template<Format SourceFormat, Format DestinationFormat, Alpha alpha>
+static void convert (uint8_t* buffer, uint32_t bytesPerRow, uint32_t width, uint32_t height)
+{
+	const AlphaTable* table = nullptr;
+	if constexpr (alpha == Alpha::Premultiply)
+		table = &premultiplyTable ();
+	else if constexpr (alpha == Alpha::Unpremultiply)
+		table = &unpremultiplyTable ();
+
+	const auto a = alphaByteIndex<SourceFormat> ();
+	const auto c1 = (a + 1) % 4;
+	const auto c2 = (a + 2) % 4;
+	const auto c3 = (a + 3) % 4;
+	constexpr auto shuffleOnly = alpha == Alpha::Keep && SourceFormat != DestinationFormat;
+
+	auto impl = Implementation::Scalar;
+	uint8_t mask[16] = {};
+	if constexpr (shuffleOnly)
+	{
+		impl = selectedImplementation ().load ();
+		makeShuffleMask (bytePermutation<SourceFormat, DestinationFormat> (), mask);
+	}
+
+	for (auto y = 0u; y < height; ++y, buffer += bytesPerRow)
+	{
+		auto intPtr = reinterpret_cast<uint32_t*> (buffer);
+		auto x = 0u;
+		if constexpr (shuffleOnly)
+			x = shuffleRow (impl, intPtr, width, mask);
+		for (; x < width; ++x)
+		{
+			if constexpr (SourceFormat == DestinationFormat)
 			{
-				case Format::ARGB:
-				{
-					convert<Format::BGRA, Format::ARGB> (buffer, bytesPerRow, width, height);
-					break;
-				}
-				case Format::ABGR:
-				{
-					convert<Format::BGRA, Format::ABGR> (buffer, bytesPerRow, width, height);
-					break;
-				}
-				case Format::RGBA:
-				{
-					convert<Format::BGRA, Format::RGBA> (buffer, bytesPerRow, width, height);
-					break;
-				}
-				case Format::BGRA:
-					return;
+				auto bytes = reinterpret_cast<uint8_t*> (intPtr + x);
+				const auto& row = (*table)[bytes[a]];
+				bytes[c1] = row[bytes[c1]];
+				bytes[c2] = row[bytes[c2]];
+				bytes[c3] = row[bytes[c3]];
+				continue;
 			}
+			auto pixel = intPtr[x];
+			if constexpr (alpha != Alpha::Keep)
+			{
+				// work on a local copy, writing single bytes of the buffer and reading the pixel
+				// as a whole afterwards is a lot slower
+				uint8_t bytes[4];
+				memcpy (bytes, &pixel, 4);
+				const auto& row = (*table)[bytes[a]];
+				bytes[c1] = row[bytes[c1]];
+				bytes[c2] = row[bytes[c2]];
+				bytes[c3] = row[bytes[c3]];
+				memcpy (&pixel, bytes, 4);
+			}
+			intPtr[x] = convertPixel<SourceFormat, DestinationFormat> (pixel);
 		}
 	}
 }
 
+//------------------------------------------------------------------------
+using ConvertFunc = void (*) (uint8_t*, uint32_t, uint32_t, uint32_t);
+
+static constexpr size_t kNumFormats = 4;
+static constexpr size_t kNumAlphaConversions = 3;
+
+//------------------------------------------------------------------------
+template<size_t index>
+constexpr ConvertFunc getConvertFunc ()
+{
+	constexpr auto src = static_cast<Format> (index / (kNumFormats * kNumAlphaConversions));
+	constexpr auto dst = static_cast<Format> ((index / kNumAlphaConversions) % kNumFormats);
+	constexpr auto alpha = static_cast<Alpha> (index % kNumAlphaConversions);
+	return &convert<src, dst, alpha>;
+}
+
+//------------------------------------------------------------------------
+template<size_t... indices>
+constexpr std::array<ConvertFunc, sizeof...(indices)>
+	makeConvertFuncTable (std::index_sequence<indices...>)
+{
+	return {{getConvertFunc<indices> ()...}};
+}
+
+//------------------------------------------------------------------------
+/** all conversion functions indexed by source format, destination format and alpha conversion */
+static constexpr auto convertFuncs = makeConvertFuncTable (
+	std::make_index_sequence<kNumFormats * kNumFormats * kNumAlphaConversions> ());
+
+//------------------------------------------------------------------------
+} // Private
+
+//------------------------------------------------------------------------
+bool isAvailable (Implementation impl)
+{
+	switch (impl)
+	{
+		case Implementation::Scalar:
+			return true;
+#if VSTGUI_SIMD_X86
+		case Implementation::SSSE3:
+			return Detail::cpuSupportsSSSE3 ();
+		case Implementation::AVX2:
+			return Detail::cpuSupportsSSSE3 () && Detail::cpuSupportsAVX2 ();
+#endif
+#if VSTGUI_SIMD_NEON
+		case Implementation::NEON:
+			return true;
+#endif
+		default:
+			return false;
+	}
+}
+
+//------------------------------------------------------------------------
+bool setImplementation (Implementation impl)
+{
+	if (!isAvailable (impl))
+		return false;
+	Private::selectedImplementation ().store (impl);
+	return true;
+}
+
+//------------------------------------------------------------------------
+Implementation getImplementation ()
+{
+	return Private::selectedImplementation ().load ();
+}
+
+//------------------------------------------------------------------------
+const char* getImplementationName (Implementation impl)
+{
+	switch (impl)
+	{
+		case Implementation::Scalar:
+			return "Scalar";
+		case Implementation::SSSE3:
+			return "SSSE3";
+		case Implementation::AVX2:
+			return "AVX2";
+		case Implementation::NEON:
+			return "NEON";
+	}
+	return "";
+}
+
+//------------------------------------------------------------------------
+void convert (Format srcFormat, Format dstFormat, uint8_t* buffer, uint32_t bytesPerRow,
+			  uint32_t width, uint32_t height)
+{
+	convert (srcFormat, dstFormat, Alpha::Keep, buffer, bytesPerRow, width, height);
+}
+
+//------------------------------------------------------------------------
+void convert (Format srcFormat, Format dstFormat, Alpha alpha, uint8_t* buffer,
+			  uint32_t bytesPerRow, uint32_t width, uint32_t height)
+{
+	using namespace Private;
+	if (srcFormat == dstFormat && alpha == Alpha::Keep)
+		return;
+	auto index = (static_cast<size_t> (srcFormat) * kNumFormats + static_cast<size_t> (dstFormat)) *
+					 kNumAlphaConversions +
+				 static_cast<size_t> (alpha);
+	convertFuncs[index](buffer, bytesPerRow, width, height);
+}
+
 //------------------------------------------------------------------------
 } // PixelBuffer
 } // VSTGUI
@@ -11,6 +11,13 @@ namespace VSTGUI {
 namespace PixelBuffer {
 
 //------------------------------------------------------------------------
+/** Layout of a 32 bit pixel
+ *
+ *	A format names the components from the most to the least significant byte of the pixel read
+ *	as a 32 bit value in ByteOrder::kNativeByteOrder. On a little endian processor Format::ARGB is
+ *	stored as B, G, R, A in memory and Format::BGRA as A, R, G, B, the reverse of the order
+ *	IPlatformBitmapPixelAccess::PixelFormat names.
+ */
 enum class Format
 {
 	ARGB,
@@ -19,6 +26,40 @@ enum class Format
 	BGRA
 };
 
+//------------------------------------------------------------------------
+/** Alpha conversion applied while converting a pixel buffer */
+enum class Alpha
+{
+	/** leave the color components as they are */
+	Keep,
+	/** multiply the color components with the alpha value */
+	Premultiply,
+	/** divide the color components by the alpha value */
+	Unpremultiply
+};
+
+//------------------------------------------------------------------------
+/** Implementation of the format conversions without alpha conversion
+ *
+ *	Uses SSSE3 or AVX2 on x86 and NEON on ARM64 processors if available. The conversions with
+ *	alpha conversion look up tables per pixel and always use the scalar code.
+ */
+enum class Implementation
+{
+	Scalar,
+	SSSE3,
+	AVX2,
+	NEON,
+};
+
+/** check if the processor supports the implementation */
+bool isAvailable (Implementation impl);
+/** select the implementation used by all conversions of the process, the best available one is
+ *	used by default. Returns false if the implementation is not available. */
+bool setImplementation (Implementation impl);
+Implementation getImplementation ();
+const char* getImplementationName (Implementation impl);
+
 //------------------------------------------------------------------------
 /** Convert a buffer of 32 bit pixels from one format to another
  *
@@ -32,6 +73,42 @@ enum class Format
 void convert (Format srcFormat, Format dstFormat, uint8_t* buffer, uint32_t bytesPerRow,
 			  uint32_t width, uint32_t height);
 
+//------------------------------------------------------------------------
+/** Convert a buffer of 32 bit pixels from one format to another and (un)premultiply the alpha
+ *	in the same pass
+ *
+ *	The alpha conversion is applied to the source pixels. The alpha component is found with the
+ *	same byte order as the format conversion uses (see Format): it is the most significant byte
+ *	of the value for Format::ARGB and Format::ABGR and the least significant byte for
+ *	Format::RGBA and Format::BGRA.
+ *
+ *	@param srcFormat Source Pixel Format
+ *	@param dstFormat Destination Pixel Format
+ *	@param alpha Alpha conversion
+ *	@param buffer Pixel Buffer
+ *	@param bytesPerRow Number of bytes per row in buffer
+ *	@param width Number of pixels per row
+ *	@param height Number of rows
+ */
+void convert (Format srcFormat, Format dstFormat, Alpha alpha, uint8_t* buffer,
+			  uint32_t bytesPerRow, uint32_t width, uint32_t height);
+
+//------------------------------------------------------------------------
+/** Multiply the color components of a buffer of 32 bit pixels with their alpha value */
+inline void premultiply (Format format, uint8_t* buffer, uint32_t bytesPerRow, uint32_t width,
+						 uint32_t height)
+{
+	convert (format, format, Alpha::Premultiply, buffer, bytesPerRow, width, height);
+}
+
+//------------------------------------------------------------------------
+/** Divide the color components of a buffer of 32 bit pixels by their alpha value */
+inline void unpremultiply (Format format, uint8_t* buffer, uint32_t bytesPerRow, uint32_t width,
+						   uint32_t height)
+{
+	convert (format, format, Alpha::Unpremultiply, buffer, bytesPerRow, width, height);
+}
+
 //------------------------------------------------------------------------
 } // PixelBuffer
 } // VSTGUI
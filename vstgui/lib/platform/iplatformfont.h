@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../vstguifwd.h"
+#include "../cdrawdefs.h"
 #include <list>
 
 namespace VSTGUI {
@@ -22,6 +23,16 @@ public:
 							 bool antialias = true) const = 0;
 	virtual CCoord getStringWidth (CDrawContext* context, IPlatformString* string,
 								   bool antialias = true) const = 0;
+	/** draw multiple strings with the font color of the context
+	 *
+	 *	The strings are aligned inside their rects like CDrawContext::getStringDrawPoint () does.
+	 *	@return false if not supported, the draw context draws the strings one by one in this case
+	 */
+	virtual bool drawStrings (CDrawContext* context, const CDrawStringItemList& items,
+							  bool antialias = true) const
+	{
+		return false;
+	}
 };
 
 //-----------------------------------------------------------------------------
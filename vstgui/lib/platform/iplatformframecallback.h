@@ -31,6 +31,8 @@ class IPlatformFrameCallback
 {
 public:
 	virtual bool platformDrawRect (CDrawContext* context, const CRect& rect) = 0;
+	/** returns true if the rect may be drawn on a worker thread */
+	virtual bool platformCanDrawRectConcurrently (const CRect& /*rect*/) { return false; }
 	
 	virtual void platformOnEvent (Event& event) = 0;
 
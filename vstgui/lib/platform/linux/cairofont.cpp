@@ -11,6 +11,11 @@
 #include <pango/pango-features.h>
 #include <pango/pangofc-fontmap.h>
 #include <fontconfig/fontconfig.h>
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -21,6 +26,122 @@ using PangoFontHandle =
 	Handle<PangoFont*, decltype (&g_object_ref), g_object_ref,
 		   decltype (&g_object_unref), g_object_unref>;
 
+using PangoLayoutHandle =
+	Handle<PangoLayout*, decltype (&g_object_ref), g_object_ref,
+		   decltype (&g_object_unref), g_object_unref>;
+
+//------------------------------------------------------------------------
+/** a shaped text with its metrics */
+struct ShapedLayout
+{
+	PangoLayoutHandle layout;
+	PangoRectangle extents {};
+	CCoord baseline {0.};
+};
+
+//------------------------------------------------------------------------
+/** LRU cache of shaped layouts, keyed on the font and the text
+ *
+ *	Every font has a unique id, as a font is created for one style the id also covers the style.
+ */
+class LayoutCache
+{
+public:
+	struct Key
+	{
+		uint64_t fontID;
+		std::string text;
+
+		bool operator== (const Key& other) const
+		{
+			return fontID == other.fontID && text == other.text;
+		}
+	};
+
+	using Statistics = Font::LayoutCacheStatistics;
+
+	const ShapedLayout* find (uint64_t fontID, const std::string& text)
+	{
+		Key key {fontID, text};
+		auto it = map.find (&key);
+		if (it == map.end ())
+		{
+			++statistics.misses;
+			return nullptr;
+		}
+		++statistics.hits;
+		entries.splice (entries.begin (), entries, it->second);
+		return &it->second->second;
+	}
+
+	const ShapedLayout* add (uint64_t fontID, const std::string& text, ShapedLayout&& layout)
+	{
+		while (entries.size () >= maxEntries)
+			removeLast ();
+		entries.emplace_front (Key {fontID, text}, std::move (layout));
+		map.emplace (&entries.front ().first, entries.begin ());
+		return &entries.front ().second;
+	}
+
+	void removeFont (uint64_t fontID)
+	{
+		for (auto it = entries.begin (); it != entries.end ();)
+		{
+			if (it->first.fontID == fontID)
+			{
+				map.erase (&it->first);
+				it = entries.erase (it);
+			}
+			else
+				++it;
+		}
+	}
+
+	void setMaxEntries (size_t numEntries)
+	{
+		maxEntries = std::max<size_t> (numEntries, 1);
+		while (entries.size () > maxEntries)
+			removeLast ();
+	}
+
+	Statistics getStatistics () const
+	{
+		auto result = statistics;
+		result.numEntries = entries.size ();
+		return result;
+	}
+
+	void resetStatistics () { statistics = {}; }
+
+private:
+	using Entry = std::pair<Key, ShapedLayout>;
+	using EntryList = std::list<Entry>;
+
+	struct KeyHash
+	{
+		size_t operator() (const Key* key) const
+		{
+			return std::hash<std::string> () (key->text) ^ std::hash<uint64_t> () (key->fontID);
+		}
+	};
+	struct KeyEqual
+	{
+		bool operator() (const Key* a, const Key* b) const { return *a == *b; }
+	};
+
+	void removeLast ()
+	{
+		map.erase (&entries.back ().first);
+		entries.pop_back ();
+	}
+
+	// the most recently used entry is the first one
+	EntryList entries;
+	std::unordered_map<const Key*, EntryList::iterator, KeyHash, KeyEqual> map;
+	size_t maxEntries {Font::kDefaultLayoutCacheSize};
+	Statistics statistics;
+};
+
 //------------------------------------------------------------------------
 class FontList
 {
@@ -46,6 +167,69 @@ public:
 		return fontContext;
 	}
 
+	/** the font map and context are shared, they must only be used by one thread at a time
+	 *	(the frame may draw on multiple threads, see X11::FrameConfig::numRenderThreads) */
+	std::mutex& getMutex ()
+	{
+		return mutex;
+	}
+
+	LayoutCache& getLayoutCache ()
+	{
+		return layoutCache;
+	}
+
+	uint64_t createFontID ()
+	{
+		return ++lastFontID;
+	}
+
+	/** returns the shaped layout of the text, the mutex must be locked while the layout is used */
+	const ShapedLayout* getLayout (uint64_t fontID, PangoFont* font, int32_t style,
+								   const std::string& text)
+	{
+		if (auto layout = layoutCache.find (fontID, text))
+			return layout;
+		if (!fontContext)
+			return nullptr;
+
+		ShapedLayout shaped;
+		shaped.layout.assign (pango_layout_new (fontContext));
+		if (!shaped.layout)
+			return nullptr;
+		if (font)
+		{
+			PangoFontDescription* desc = pango_font_describe (font);
+			if (desc)
+			{
+				pango_layout_set_font_description (shaped.layout, desc);
+				pango_font_description_free (desc);
+			}
+		}
+
+		PangoAttrList* attrs = pango_attr_list_new ();
+		if (attrs)
+		{
+			if (style & kUnderlineFace)
+				pango_attr_list_insert (attrs, pango_attr_underline_new (PANGO_UNDERLINE_SINGLE));
+			if (style & kStrikethroughFace)
+				pango_attr_list_insert (attrs, pango_attr_strikethrough_new (true));
+			pango_layout_set_attributes (shaped.layout, attrs);
+			pango_attr_list_unref (attrs);
+		}
+
+		pango_layout_set_text (shaped.layout, text.c_str (), -1);
+		pango_layout_get_pixel_extents (shaped.layout, nullptr, &shaped.extents);
+
+		PangoLayoutIter* iter = pango_layout_get_iter (shaped.layout);
+		if (iter)
+		{
+			shaped.baseline = pango_units_to_double (pango_layout_iter_get_baseline (iter));
+			pango_layout_iter_free (iter);
+		}
+		return layoutCache.add (fontID, text, std::move (shaped));
+	}
+
 	bool queryFont (UTF8StringPtr name, CCoord size, int32_t style, PangoFontHandle& fontHandle)
 	{
 		PangoFontDescription* desc = pango_font_description_new ();
@@ -116,6 +300,9 @@ private:
 	FcConfig* fcConfig = nullptr;
 	PangoFontMap* fontMap = nullptr;
 	PangoContext* fontContext = nullptr;
+	std::mutex mutex;
+	LayoutCache layoutCache;
+	uint64_t lastFontID {0};
 
 	static int slantFromStyle (int32_t style)
 	{
@@ -135,6 +322,7 @@ private:
 struct Font::Impl
 {
 	PangoFontHandle font;
+	uint64_t id {0};
 	int32_t style;
 	CCoord ascent {-1.};
 	CCoord descent {-1.};
@@ -148,7 +336,9 @@ Font::Font (UTF8StringPtr name, const CCoord& size, const int32_t& style)
 	impl = std::unique_ptr<Impl> (new Impl);
 
 	auto& fontList = FontList::instance ();
+	std::lock_guard<std::mutex> guard (fontList.getMutex ());
 
+	impl->id = fontList.createFontID ();
 	if (fontList.queryFont (name, size, style, impl->font))
 	{
 		PangoFontMetrics* metrics = pango_font_get_metrics (impl->font, nullptr);
@@ -193,7 +383,12 @@ Font::Font (UTF8StringPtr name, const CCoord& size, const int32_t& style)
 }
 
 //------------------------------------------------------------------------
-Font::~Font () {}
+Font::~Font ()
+{
+	auto& fontList = FontList::instance ();
+	std::lock_guard<std::mutex> guard (fontList.getMutex ());
+	fontList.getLayoutCache ().removeFont (impl->id);
+}
 
 //------------------------------------------------------------------------
 bool Font::valid () const
@@ -247,50 +442,14 @@ void Font::drawString (CDrawContext* context, IPlatformString* string, const CPo
 				cairo_set_source_rgba (cr, color.normRed<double> (), color.normGreen<double> (),
 									   color.normBlue<double> (), alpha);
 
-				PangoContext* context = FontList::instance ().getFontContext();
-				if (context)
+				auto& fontList = FontList::instance ();
+				std::lock_guard<std::mutex> guard (fontList.getMutex ());
+				if (auto shaped = fontList.getLayout (impl->id, impl->font, impl->style,
+													  linuxString->get ()))
 				{
-					PangoLayout* layout = pango_layout_new (context);
-					if (layout)
-					{
-						if (impl->font)
-						{
-							PangoFontDescription* desc = pango_font_describe (impl->font);
-							if (desc)
-							{
-								pango_layout_set_font_description (layout, desc);
-								pango_font_description_free (desc);
-							}
-						}
-
-						PangoAttrList* attrs = pango_attr_list_new ();
-						if (attrs)
-						{
-							if (impl->style & kUnderlineFace)
-								pango_attr_list_insert (attrs, pango_attr_underline_new (PANGO_UNDERLINE_SINGLE));
-							if (impl->style & kStrikethroughFace)
-								pango_attr_list_insert (attrs, pango_attr_strikethrough_new (true));
-							pango_layout_set_attributes(layout, attrs);
-							pango_attr_list_unref (attrs);
-						}
-
-						pango_layout_set_text (layout, linuxString->get ().c_str (), -1);
-
-						PangoRectangle extents {};
-						pango_layout_get_pixel_extents (layout, nullptr, &extents);
-
-						PangoLayoutIter* iter = pango_layout_get_iter (layout);
-						CCoord baseline = 0.0;
-						if (iter)
-						{
-							baseline = pango_units_to_double (pango_layout_iter_get_baseline (iter));
-							pango_layout_iter_free (iter);
-						}
-
-						cairo_move_to (cr, p.x + extents.x, p.y + extents.y - baseline);
-						pango_cairo_show_layout (cr, layout);
-						g_object_unref (layout);
-					}
+					cairo_move_to (cr, p.x + shaped->extents.x,
+								   p.y + shaped->extents.y - shaped->baseline);
+					pango_cairo_show_layout (cr, shaped->layout);
 				}
 			}
 		}
@@ -298,33 +457,52 @@ void Font::drawString (CDrawContext* context, IPlatformString* string, const CPo
 }
 
 //------------------------------------------------------------------------
-CCoord Font::getStringWidth (CDrawContext* context, IPlatformString* string, bool antialias) const
+bool Font::drawStrings (CDrawContext* context, const CDrawStringItemList& items,
+						bool antialias) const
 {
-	if (auto linuxString = dynamic_cast<LinuxString*> (string))
+	auto cairoContext = dynamic_cast<Context*> (context);
+	if (!cairoContext)
+		return false;
+	if (auto cd = DrawBlock::begin (*cairoContext))
 	{
-		int pangoWidth = 0;
-		PangoContext* context = FontList::instance ().getFontContext();
-		if (context)
+		auto color = cairoContext->getFontColor ();
+		const auto& cr = cairoContext->getCairo ();
+		auto alpha = color.normAlpha<double> () * cairoContext->getGlobalAlpha ();
+		cairo_set_source_rgba (cr, color.normRed<double> (), color.normGreen<double> (),
+							   color.normBlue<double> (), alpha);
+
+		auto& fontList = FontList::instance ();
+		std::lock_guard<std::mutex> guard (fontList.getMutex ());
+		std::string text;
+		for (const auto& item : items)
 		{
-			PangoLayout* layout = pango_layout_new (context);
-			if (layout)
+			if (!item.string)
+				continue;
+			text.assign (item.string);
+			if (auto shaped = fontList.getLayout (impl->id, impl->font, impl->style, text))
 			{
-				if (impl->font)
-				{
-					PangoFontDescription* desc = pango_font_describe (impl->font);
-					if (desc)
-					{
-						pango_layout_set_font_description (layout, desc);
-						pango_font_description_free (desc);
-					}
-				}
-				pango_layout_set_text (layout, linuxString->get ().c_str (), -1);
-				pango_layout_get_pixel_size (layout, &pangoWidth, nullptr);
-				g_object_unref (layout);
+				auto p = context->getStringDrawPoint (item.rect, shaped->extents.width,
+													  item.hAlign);
+				cairo_move_to (cr, p.x + shaped->extents.x,
+							   p.y + shaped->extents.y - shaped->baseline);
+				pango_cairo_show_layout (cr, shaped->layout);
 			}
 		}
+	}
+	return true;
+}
 
-		return pangoWidth;
+//------------------------------------------------------------------------
+CCoord Font::getStringWidth (CDrawContext* context, IPlatformString* string, bool antialias) const
+{
+	if (auto linuxString = dynamic_cast<LinuxString*> (string))
+	{
+		auto& fontList = FontList::instance ();
+		std::lock_guard<std::mutex> guard (fontList.getMutex ());
+		if (auto shaped = fontList.getLayout (impl->id, impl->font, impl->style,
+											  linuxString->get ()))
+			return shaped->extents.width;
+		return 0;
 	}
 	return 0;
 }
@@ -332,9 +510,34 @@ CCoord Font::getStringWidth (CDrawContext* context, IPlatformString* string, boo
 //------------------------------------------------------------------------
 bool Font::getAllFamilies (const FontFamilyCallback& callback)
 {
+	std::lock_guard<std::mutex> guard (FontList::instance ().getMutex ());
 	return Cairo::FontList::instance ().getAllFontFamilies (callback);
 }
 
+//------------------------------------------------------------------------
+void Font::setLayoutCacheSize (size_t maxEntries)
+{
+	auto& fontList = FontList::instance ();
+	std::lock_guard<std::mutex> guard (fontList.getMutex ());
+	fontList.getLayoutCache ().setMaxEntries (maxEntries);
+}
+
+//------------------------------------------------------------------------
+auto Font::getLayoutCacheStatistics () -> LayoutCacheStatistics
+{
+	auto& fontList = FontList::instance ();
+	std::lock_guard<std::mutex> guard (fontList.getMutex ());
+	return fontList.getLayoutCache ().getStatistics ();
+}
+
+//------------------------------------------------------------------------
+void Font::resetLayoutCacheStatistics ()
+{
+	auto& fontList = FontList::instance ();
+	std::lock_guard<std::mutex> guard (fontList.getMutex ());
+	fontList.getLayoutCache ().resetStatistics ();
+}
+
 //------------------------------------------------------------------------
 } // Cairo
 } // VSTGUI
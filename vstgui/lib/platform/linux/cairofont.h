@@ -6,6 +6,7 @@
 
 #include "../iplatformfont.h"
 #include "../platformfactory.h"
+#include <cstdint>
 #include <memory>
 
 //------------------------------------------------------------------------
@@ -33,9 +34,31 @@ public:
 					 bool antialias = true) const override;
 	CCoord getStringWidth (CDrawContext* context, IPlatformString* string,
 						   bool antialias = true) const override;
+	bool drawStrings (CDrawContext* context, const CDrawStringItemList& items,
+					  bool antialias = true) const override;
 
 	static bool getAllFamilies (const FontFamilyCallback& callback);
 
+	/** counters of the layout cache shared by all fonts */
+	struct LayoutCacheStatistics
+	{
+		/** number of times a shaped layout was reused */
+		uint64_t hits {0};
+		/** number of times a string had to be shaped */
+		uint64_t misses {0};
+		/** number of cached layouts */
+		size_t numEntries {0};
+	};
+
+	/** the default maximum number of cached layouts */
+	static constexpr size_t kDefaultLayoutCacheSize = 512;
+
+	/** set the maximum number of cached layouts, at least one layout is always kept */
+	static void setLayoutCacheSize (size_t maxEntries);
+	static LayoutCacheStatistics getLayoutCacheStatistics ();
+	/** reset the hit and miss counters */
+	static void resetLayoutCacheStatistics ();
+
 private:
 	struct Impl;
 	std::unique_ptr<Impl> impl;
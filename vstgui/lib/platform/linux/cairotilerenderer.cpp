@@ -0,0 +1,295 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cairotilerenderer.h"
+#include "cairocontext.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+namespace {
+
+//------------------------------------------------------------------------
+constexpr int32_t kBytesPerPixel = 4;
+
+//------------------------------------------------------------------------
+struct Tile
+{
+	CRect rect;
+};
+
+//------------------------------------------------------------------------
+struct Job
+{
+	const TileRenderer::DrawProc* drawProc {nullptr};
+	uint8_t* targetData {nullptr};
+	int32_t targetStride {0};
+	std::vector<Tile> tiles;
+	std::atomic<size_t> nextTile {0};
+	std::atomic<size_t> remaining {0};
+};
+
+//------------------------------------------------------------------------
+void copyPixels (const uint8_t* src, int32_t srcStride, uint8_t* dst, int32_t dstStride,
+				 int32_t width, int32_t height)
+{
+	auto rowSize = static_cast<size_t> (width) * kBytesPerPixel;
+	for (auto y = 0; y < height; ++y, src += srcStride, dst += dstStride)
+		memcpy (dst, src, rowSize);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+struct TileRenderer::Impl
+{
+	uint32_t tileSize;
+	std::vector<std::thread> threads;
+
+	std::mutex mutex;
+	std::condition_variable workCondition;
+	std::condition_variable doneCondition;
+	std::shared_ptr<Job> currentJob;
+	uint64_t generation {0};
+	bool quit {false};
+
+	SurfaceHandle mainThreadScratchSurface;
+	std::vector<int32_t> cellToTile;
+
+	//------------------------------------------------------------------------
+	Impl (uint32_t numThreads, uint32_t tileSize) : tileSize (tileSize)
+	{
+		threads.reserve (numThreads);
+		for (auto i = 0u; i < numThreads; ++i)
+			threads.emplace_back ([this] () { workerThread (); });
+	}
+
+	//------------------------------------------------------------------------
+	~Impl () noexcept
+	{
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			quit = true;
+		}
+		workCondition.notify_all ();
+		for (auto& thread : threads)
+			thread.join ();
+	}
+
+	//------------------------------------------------------------------------
+	SurfaceHandle createScratchSurface () const
+	{
+		return SurfaceHandle (cairo_image_surface_create (
+			CAIRO_FORMAT_ARGB32, static_cast<int> (tileSize), static_cast<int> (tileSize)));
+	}
+
+	//------------------------------------------------------------------------
+	void workerThread ()
+	{
+		auto scratchSurface = createScratchSurface ();
+		uint64_t lastGeneration = 0;
+		while (true)
+		{
+			std::shared_ptr<Job> job;
+			{
+				std::unique_lock<std::mutex> lock (mutex);
+				workCondition.wait (lock, [&] () { return quit || generation != lastGeneration; });
+				if (quit)
+					return;
+				lastGeneration = generation;
+				job = currentJob;
+			}
+			if (job)
+				processTiles (*job, scratchSurface);
+		}
+	}
+
+	//------------------------------------------------------------------------
+	void processTiles (Job& job, const SurfaceHandle& scratchSurface)
+	{
+		while (true)
+		{
+			auto index = job.nextTile.fetch_add (1);
+			if (index >= job.tiles.size ())
+				break;
+			drawTile (job, job.tiles[index], scratchSurface);
+			if (job.remaining.fetch_sub (1) == 1)
+			{
+				std::lock_guard<std::mutex> guard (mutex);
+				doneCondition.notify_all ();
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------
+	void drawTile (const Job& job, const Tile& tile, const SurfaceHandle& surface)
+	{
+		auto left = static_cast<int32_t> (tile.rect.left);
+		auto top = static_cast<int32_t> (tile.rect.top);
+		auto width = static_cast<int32_t> (tile.rect.getWidth ());
+		auto height = static_cast<int32_t> (tile.rect.getHeight ());
+		auto targetPixels =
+			job.targetData + static_cast<size_t> (top) * job.targetStride + left * kBytesPerPixel;
+
+		cairo_surface_flush (surface);
+		auto surfaceData = cairo_image_surface_get_data (surface);
+		auto surfaceStride = cairo_image_surface_get_stride (surface);
+		copyPixels (targetPixels, job.targetStride, surfaceData, surfaceStride, width, height);
+		cairo_surface_mark_dirty (surface);
+		cairo_surface_set_device_offset (surface, -tile.rect.left, -tile.rect.top);
+
+		{
+			auto context = makeOwned<Context> (tile.rect, surface);
+			context->beginDraw ();
+			context->setClipRect (tile.rect);
+			context->saveGlobalState ();
+			(*job.drawProc) (context, tile.rect);
+			context->restoreGlobalState ();
+			context->endDraw ();
+		}
+
+		copyPixels (surfaceData, surfaceStride, targetPixels, job.targetStride, width, height);
+	}
+
+	//------------------------------------------------------------------------
+	void collectTiles (const std::vector<CRect>& rects, const CRect& bounds,
+					   std::vector<Tile>& tiles)
+	{
+		auto size = static_cast<CCoord> (tileSize);
+		auto numColumns = static_cast<size_t> (std::ceil (bounds.getWidth () / size));
+		auto numRows = static_cast<size_t> (std::ceil (bounds.getHeight () / size));
+		cellToTile.assign (numColumns * numRows, -1);
+
+		for (auto r : rects)
+		{
+			r.makeIntegral ();
+			r.bound (bounds);
+			if (r.isEmpty ())
+				continue;
+			auto firstColumn = static_cast<size_t> (r.left / size);
+			auto lastColumn = static_cast<size_t> (std::ceil (r.right / size));
+			auto firstRow = static_cast<size_t> (r.top / size);
+			auto lastRow = static_cast<size_t> (std::ceil (r.bottom / size));
+			for (auto row = firstRow; row < lastRow; ++row)
+			{
+				for (auto column = firstColumn; column < lastColumn; ++column)
+				{
+					CRect cell (column * size, row * size, (column + 1) * size, (row + 1) * size);
+					cell.bound (r);
+					if (cell.isEmpty ())
+						continue;
+					auto& index = cellToTile[row * numColumns + column];
+					if (index < 0)
+					{
+						index = static_cast<int32_t> (tiles.size ());
+						tiles.push_back ({cell});
+					}
+					else
+						tiles[index].rect.unite (cell);
+				}
+			}
+		}
+	}
+};
+
+//------------------------------------------------------------------------
+TileRenderer::TileRenderer (uint32_t numThreads, uint32_t tileSize)
+{
+	impl = std::make_unique<Impl> (numThreads, std::max (tileSize, 16u));
+}
+
+//------------------------------------------------------------------------
+TileRenderer::~TileRenderer () noexcept = default;
+
+//------------------------------------------------------------------------
+uint32_t TileRenderer::getNumThreads () const
+{
+	return static_cast<uint32_t> (impl->threads.size ());
+}
+
+//------------------------------------------------------------------------
+uint32_t TileRenderer::getTileSize () const
+{
+	return impl->tileSize;
+}
+
+//------------------------------------------------------------------------
+bool TileRenderer::draw (const SurfaceHandle& target, const std::vector<CRect>& rects,
+						 const DrawProc& drawProc,
+						 const CanDrawConcurrentlyProc& canDrawConcurrently)
+{
+	if (impl->threads.empty () || cairo_surface_get_type (target) != CAIRO_SURFACE_TYPE_IMAGE ||
+		cairo_image_surface_get_format (target) != CAIRO_FORMAT_ARGB32)
+		return false;
+
+	CRect bounds (0, 0, cairo_image_surface_get_width (target),
+				  cairo_image_surface_get_height (target));
+
+	std::vector<Tile> tiles;
+	impl->collectTiles (rects, bounds, tiles);
+
+	// small updates are faster drawn directly than handed over to the workers
+	CCoord area = 0.;
+	for (const auto& tile : tiles)
+		area += tile.rect.getWidth () * tile.rect.getHeight ();
+	if (tiles.size () < 2 || area < 2. * impl->tileSize * impl->tileSize)
+		return false;
+
+	auto job = std::make_shared<Job> ();
+	job->drawProc = &drawProc;
+	job->tiles.reserve (tiles.size ());
+	std::vector<Tile> mainThreadTiles;
+	for (const auto& tile : tiles)
+	{
+		if (canDrawConcurrently (tile.rect))
+			job->tiles.emplace_back (tile);
+		else
+			mainThreadTiles.emplace_back (tile);
+	}
+
+	cairo_surface_flush (target);
+	job->targetData = cairo_image_surface_get_data (target);
+	job->targetStride = cairo_image_surface_get_stride (target);
+	job->remaining = job->tiles.size ();
+
+	if (!impl->mainThreadScratchSurface)
+		impl->mainThreadScratchSurface = impl->createScratchSurface ();
+
+	if (!job->tiles.empty ())
+	{
+		{
+			std::lock_guard<std::mutex> guard (impl->mutex);
+			impl->currentJob = job;
+			++impl->generation;
+		}
+		impl->workCondition.notify_all ();
+	}
+
+	for (const auto& tile : mainThreadTiles)
+		impl->drawTile (*job, tile, impl->mainThreadScratchSurface);
+
+	if (!job->tiles.empty ())
+	{
+		impl->processTiles (*job, impl->mainThreadScratchSurface);
+
+		std::unique_lock<std::mutex> lock (impl->mutex);
+		impl->doneCondition.wait (lock, [&] () { return job->remaining == 0; });
+		impl->currentJob = nullptr;
+	}
+
+	cairo_surface_mark_dirty (target);
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
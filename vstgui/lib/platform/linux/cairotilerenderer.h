@@ -0,0 +1,66 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../crect.h"
+#include "../../vstguifwd.h"
+#include "cairoutils.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+
+//------------------------------------------------------------------------
+/** Renders large dirty regions in tiles on a pool of worker threads
+ *
+ *	The dirty region is split into square tiles on a fixed grid. Every tile is drawn with its own
+ *	Cairo::Context into a per thread scratch surface which is initialized with the content of the
+ *	target and written back into the target when the tile is finished. Tiles never overlap, so the
+ *	threads do not need to synchronize while drawing.
+ *
+ *	The calling thread draws all tiles which must be drawn on the main thread and then helps the
+ *	workers with the remaining tiles. The draw call returns after all tiles are written back.
+ *
+ *	The target surface must be an image surface in CAIRO_FORMAT_ARGB32.
+ */
+class TileRenderer
+{
+public:
+	using DrawProc = std::function<void (CDrawContext* context, const CRect& rect)>;
+	using CanDrawConcurrentlyProc = std::function<bool (const CRect& rect)>;
+
+	/** the default size of a tile in pixels */
+	static constexpr uint32_t kDefaultTileSize = 256;
+
+	TileRenderer (uint32_t numThreads, uint32_t tileSize = kDefaultTileSize);
+	~TileRenderer () noexcept;
+
+	/** draw the rects into the target surface
+	 *
+	 *	@param target the image surface to draw into
+	 *	@param rects the dirty rects
+	 *	@param drawProc called for every tile, possibly on a worker thread
+	 *	@param canDrawConcurrently called on the calling thread for every tile, if it returns false
+	 *		   the tile is drawn on the calling thread
+	 *	@return false if the dirty region is too small to benefit from tiled rendering, nothing is
+	 *			drawn in this case
+	 */
+	bool draw (const SurfaceHandle& target, const std::vector<CRect>& rects,
+			   const DrawProc& drawProc, const CanDrawConcurrentlyProc& canDrawConcurrently);
+
+	uint32_t getNumThreads () const;
+	uint32_t getTileSize () const;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl;
+};
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
@@ -0,0 +1,292 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cairoviewlayer.h"
+#include "cairocontext.h"
+#include <algorithm>
+#include <cmath>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+
+//------------------------------------------------------------------------
+ViewLayer::ViewLayer (ViewLayerCompositor* compositor, ViewLayer* parent,
+					  IPlatformViewLayerDelegate* delegate)
+: compositor (compositor), parent (parent), delegate (delegate)
+{
+	insertIntoSiblings ();
+}
+
+//------------------------------------------------------------------------
+ViewLayer::~ViewLayer () noexcept
+{
+	invalidComposite ();
+	for (auto child : children)
+		child->detach ();
+	removeFromSiblings ();
+}
+
+//------------------------------------------------------------------------
+auto ViewLayer::getSiblings () const -> Layers*
+{
+	if (parent)
+		return &parent->children;
+	if (compositor)
+		return &compositor->layers;
+	return nullptr;
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::insertIntoSiblings ()
+{
+	if (auto siblings = getSiblings ())
+	{
+		auto it = std::upper_bound (
+			siblings->begin (), siblings->end (), zIndex,
+			[] (uint32_t zIndex, const ViewLayer* layer) { return zIndex < layer->zIndex; });
+		siblings->insert (it, this);
+	}
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::removeFromSiblings ()
+{
+	if (auto siblings = getSiblings ())
+	{
+		auto it = std::find (siblings->begin (), siblings->end (), this);
+		if (it != siblings->end ())
+			siblings->erase (it);
+	}
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::detach ()
+{
+	// the parent layer is gone, the layer is not shown anymore until it is destroyed, too
+	parent = nullptr;
+	detachFromCompositor ();
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::detachFromCompositor ()
+{
+	compositor = nullptr;
+	for (auto child : children)
+		child->detachFromCompositor ();
+}
+
+//------------------------------------------------------------------------
+CPoint ViewLayer::getOrigin () const
+{
+	auto origin = size.getTopLeft ();
+	if (parent)
+		origin += parent->getOrigin ();
+	return origin;
+}
+
+//------------------------------------------------------------------------
+CRect ViewLayer::getBounds () const
+{
+	CRect bounds (size);
+	if (parent)
+		bounds.offset (parent->getOrigin ());
+	for (auto child : children)
+	{
+		auto childBounds = child->getBounds ();
+		if (!childBounds.isEmpty ())
+			bounds.unite (childBounds);
+	}
+	return bounds;
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::invalidComposite ()
+{
+	if (!compositor)
+		return;
+	auto bounds = getBounds ();
+	if (!bounds.isEmpty ())
+		compositor->invalid (bounds);
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::invalidRect (const CRect& rect)
+{
+	auto r = rect;
+	r.normalize ();
+	r.makeIntegral ();
+	r.bound (CRect (0, 0, size.getWidth (), size.getHeight ()));
+	if (r.isEmpty ())
+		return;
+	invalidRects.add (r);
+	if (compositor)
+		compositor->invalid (r.offset (getOrigin ()));
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::setSize (const CRect& newSize)
+{
+	auto r = newSize;
+	r.normalize ();
+	r.makeIntegral ();
+	if (r == size)
+		return;
+	invalidComposite ();
+	auto resized = r.getWidth () != size.getWidth () || r.getHeight () != size.getHeight ();
+	size = r;
+	if (resized)
+	{
+		surface.reset ();
+		invalidRects.clear ();
+		invalidRect (CRect (0, 0, size.getWidth (), size.getHeight ()));
+	}
+	invalidComposite ();
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::setZIndex (uint32_t newZIndex)
+{
+	if (zIndex == newZIndex)
+		return;
+	removeFromSiblings ();
+	zIndex = newZIndex;
+	insertIntoSiblings ();
+	invalidComposite ();
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::setAlpha (float newAlpha)
+{
+	if (alpha == newAlpha)
+		return;
+	alpha = newAlpha;
+	invalidComposite ();
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::draw (CDrawContext* context, const CRect& updateRect)
+{
+	// the layers are composited above the frame content when it is copied to the window
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::onScaleFactorChanged (double newScaleFactor)
+{
+	if (scaleFactor == newScaleFactor)
+		return;
+	scaleFactor = newScaleFactor;
+	surface.reset ();
+	invalidRects.clear ();
+	invalidRect (CRect (0, 0, size.getWidth (), size.getHeight ()));
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::drawInvalidRects ()
+{
+	if (!invalidRects.empty ())
+	{
+		CRect bounds (0, 0, size.getWidth (), size.getHeight ());
+		if (!surface)
+		{
+			auto width = static_cast<int> (std::ceil (bounds.getWidth () * scaleFactor));
+			auto height = static_cast<int> (std::ceil (bounds.getHeight () * scaleFactor));
+			surface.assign (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height));
+			cairo_surface_set_device_scale (surface, scaleFactor, scaleFactor);
+		}
+		auto context = makeOwned<Context> (bounds, surface);
+		context->beginDraw ();
+		for (const auto& r : invalidRects)
+		{
+			context->setClipRect (r);
+			context->saveGlobalState ();
+			context->clearRect (r);
+			delegate->drawViewLayer (context, r);
+			context->restoreGlobalState ();
+		}
+		context->endDraw ();
+		invalidRects.clear ();
+	}
+	for (auto child : children)
+		child->drawInvalidRects ();
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::composite (cairo_t* context, const CPoint& parentOrigin)
+{
+	if (alpha <= 0.f || size.isEmpty ())
+		return;
+	auto origin = parentOrigin + size.getTopLeft ();
+	// the children are faded out together with their parent
+	auto useGroup = alpha < 1.f && !children.empty ();
+	if (useGroup)
+		cairo_push_group (context);
+	if (surface)
+	{
+		cairo_set_source_surface (context, surface, origin.x, origin.y);
+		if (alpha < 1.f && !useGroup)
+			cairo_paint_with_alpha (context, alpha);
+		else
+			cairo_paint (context);
+	}
+	for (auto child : children)
+		child->composite (context, origin);
+	if (useGroup)
+	{
+		cairo_pop_group_to_source (context);
+		cairo_paint_with_alpha (context, alpha);
+	}
+}
+
+//------------------------------------------------------------------------
+ViewLayerCompositor::ViewLayerCompositor (InvalidCallback&& invalidCallback)
+: invalidCallback (std::move (invalidCallback))
+{
+}
+
+//------------------------------------------------------------------------
+ViewLayerCompositor::~ViewLayerCompositor () noexcept
+{
+	for (auto layer : layers)
+		layer->detach ();
+}
+
+//------------------------------------------------------------------------
+SharedPointer<ViewLayer> ViewLayerCompositor::createLayer (IPlatformViewLayerDelegate* delegate,
+														   IPlatformViewLayer* parentLayer)
+{
+	auto parent = dynamic_cast<ViewLayer*> (parentLayer);
+	if (parent && parent->compositor != this)
+		return nullptr;
+	return makeOwned<ViewLayer> (this, parent, delegate);
+}
+
+//------------------------------------------------------------------------
+void ViewLayerCompositor::drawInvalidLayers ()
+{
+	for (auto layer : layers)
+		layer->drawInvalidRects ();
+}
+
+//------------------------------------------------------------------------
+void ViewLayerCompositor::composite (cairo_t* context, const CRect& rect)
+{
+	cairo_save (context);
+	cairo_rectangle (context, rect.left, rect.top, rect.getWidth (), rect.getHeight ());
+	cairo_clip (context);
+	for (auto layer : layers)
+		layer->composite (context, {});
+	cairo_restore (context);
+}
+
+//------------------------------------------------------------------------
+void ViewLayerCompositor::invalid (const CRect& rect)
+{
+	if (invalidCallback)
+		invalidCallback (rect);
+}
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
@@ -0,0 +1,105 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../iplatformviewlayer.h"
+#include "../../cinvalidrectlist.h"
+#include "../../crect.h"
+#include "cairoutils.h"
+#include <functional>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+
+class ViewLayerCompositor;
+
+//------------------------------------------------------------------------
+/** A view layer which draws into its own retained image surface
+ *
+ *	The layer only redraws the invalidated parts of its surface. Moving the layer, changing its
+ *	z-index or its alpha value only requires to composite the layers again.
+ */
+class ViewLayer : public IPlatformViewLayer
+{
+public:
+	ViewLayer (ViewLayerCompositor* compositor, ViewLayer* parent,
+			   IPlatformViewLayerDelegate* delegate);
+	~ViewLayer () noexcept override;
+
+	void invalidRect (const CRect& size) override;
+	void setSize (const CRect& size) override;
+	void setZIndex (uint32_t zIndex) override;
+	void setAlpha (float alpha) override;
+	void draw (CDrawContext* context, const CRect& updateRect) override;
+	void onScaleFactorChanged (double newScaleFactor) override;
+
+private:
+	friend class ViewLayerCompositor;
+
+	using Layers = std::vector<ViewLayer*>;
+
+	Layers* getSiblings () const;
+	void insertIntoSiblings ();
+	void removeFromSiblings ();
+	void detach ();
+	void detachFromCompositor ();
+
+	CPoint getOrigin () const;
+	CRect getBounds () const;
+	void invalidComposite ();
+
+	void drawInvalidRects ();
+	void composite (cairo_t* context, const CPoint& parentOrigin);
+
+	ViewLayerCompositor* compositor {nullptr};
+	ViewLayer* parent {nullptr};
+	IPlatformViewLayerDelegate* delegate {nullptr};
+	Layers children;
+	SurfaceHandle surface;
+	CInvalidRectList invalidRects;
+	CRect size;
+	double scaleFactor {1.};
+	float alpha {1.f};
+	uint32_t zIndex {0};
+};
+
+//------------------------------------------------------------------------
+/** Owns the top level view layers of a frame and composites them above the frame content
+ *
+ *	The layers are composited in z-order, child layers above their parent layer.
+ */
+class ViewLayerCompositor
+{
+public:
+	/** called with the rect in frame coordinates which needs to be composited again */
+	using InvalidCallback = std::function<void (const CRect& rect)>;
+
+	ViewLayerCompositor (InvalidCallback&& invalidCallback);
+	~ViewLayerCompositor () noexcept;
+
+	SharedPointer<ViewLayer> createLayer (IPlatformViewLayerDelegate* delegate,
+										  IPlatformViewLayer* parentLayer);
+
+	bool empty () const { return layers.empty (); }
+
+	/** redraw the invalid parts of all layers */
+	void drawInvalidLayers ();
+	/** composite all layers inside rect (in frame coordinates) onto the context */
+	void composite (cairo_t* context, const CRect& rect);
+
+private:
+	friend class ViewLayer;
+
+	void invalid (const CRect& rect);
+
+	ViewLayer::Layers layers;
+	InvalidCallback invalidCallback;
+};
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
@@ -20,9 +20,13 @@
 #include "../common/genericoptionmenu.h"
 #include "cairobitmap.h"
 #include "cairocontext.h"
+#include "cairotilerenderer.h"
+#include "cairoviewlayer.h"
 #include "x11platform.h"
+#include "x11shmbackbuffer.h"
 #include "x11utils.h"
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <unordered_map>
 #include <X11/Xlib.h>
@@ -140,33 +144,91 @@ inline Modifiers toModifiers (int state)
 } // anonymous
 
 //------------------------------------------------------------------------
-struct RedrawTimerHandler
-: ITimerHandler
-, NonAtomicReferenceCounted
+/** Schedules the redraws of a frame
+ *
+ *	A redraw is scheduled when the frame gets dirty, one frame interval after the last redraw.
+ *	Invalidations until then, or while drawing, are handled by this one redraw. No timer is
+ *	running while the frame is not dirty.
+ */
+struct FrameScheduler : ITimerHandler
 {
+	using Clock = std::chrono::steady_clock;
 	using RedrawCallback = std::function<void ()>;
 
-	RedrawTimerHandler (uint64_t delay, RedrawCallback&& redrawCallback)
+	FrameScheduler (uint32_t redrawRate, RedrawCallback&& redrawCallback)
 	: redrawCallback (std::move (redrawCallback))
 	{
-		RunLoop::instance ().get ()->registerTimer (delay, this);
+		if (redrawRate > 0)
+			frameInterval = std::chrono::microseconds (1000000 / redrawRate);
 	}
-	~RedrawTimerHandler () noexcept { RunLoop::instance ().get ()->unregisterTimer (this); }
+	~FrameScheduler () noexcept { stopTimer (); }
 
+	/** schedule a redraw if not already scheduled */
+	void schedule ()
+	{
+		if (scheduled)
+			return;
+		scheduled = true;
+		firstInvalidTime = Clock::now ();
+		if (!inRedraw)
+			startTimer ();
+	}
+
+	/** the time of the first invalidation since the last redraw */
+	Clock::time_point getFirstInvalidTime () const { return firstInvalidTime; }
+
+private:
 	void onTimer () override
 	{
-		SharedPointer<RedrawTimerHandler> Self (this);
-		Self->redrawCallback ();
+		stopTimer ();
+		scheduled = false;
+		inRedraw = true;
+		redrawCallback ();
+		inRedraw = false;
+		lastRedrawTime = Clock::now ();
+		// the frame was invalidated while drawing
+		if (scheduled)
+			startTimer ();
+	}
+
+	void startTimer ()
+	{
+		auto nextRedrawTime = lastRedrawTime + frameInterval;
+		auto delay = std::chrono::ceil<std::chrono::milliseconds> (nextRedrawTime - Clock::now ());
+		// wait at least one millisecond to collect the invalidations of the current event
+		auto interval = std::max<int64_t> (delay.count (), 1);
+		timerRunning = RunLoop::instance ().get ()->registerTimer (interval, this);
+	}
+
+	void stopTimer ()
+	{
+		if (!timerRunning)
+			return;
+		RunLoop::instance ().get ()->unregisterTimer (this);
+		timerRunning = false;
 	}
 
 	RedrawCallback redrawCallback;
+	Clock::duration frameInterval {0};
+	Clock::time_point lastRedrawTime;
+	Clock::time_point firstInvalidTime;
+	bool scheduled {false};
+	bool inRedraw {false};
+	bool timerRunning {false};
 };
 
 //------------------------------------------------------------------------
 struct DrawHandler
 {
-	DrawHandler (const ChildWindow& window)
+	DrawHandler (const ChildWindow& window, const FrameConfig* config,
+				 Cairo::ViewLayerCompositor::InvalidCallback&& layerInvalidCallback)
+	: windowID (window.getID ()), layerCompositor (std::move (layerInvalidCallback))
 	{
+		if (config && config->numRenderThreads > 0)
+			tileRenderer = std::make_unique<Cairo::TileRenderer> (config->numRenderThreads,
+																   config->renderTileSize);
+		useShmBackBuffer = config ? config->useShmBackBuffer : FrameConfig ().useShmBackBuffer;
+
 		auto s = cairo_xcb_surface_create (RunLoop::instance ().getXcbConnection (),
 										   window.getID (), window.getVisual (),
 										   window.getSize ().x, window.getSize ().y);
@@ -178,47 +240,111 @@ struct DrawHandler
 	void onSizeChanged (const CPoint& size)
 	{
 		cairo_xcb_surface_set_size (windowSurface, size.x, size.y);
-		backBuffer = Cairo::SurfaceHandle (cairo_surface_create_similar (
-			windowSurface, CAIRO_CONTENT_COLOR_ALPHA, size.x, size.y));
+		std::unique_ptr<ShmBackBuffer> newShmBackBuffer;
+		if (useShmBackBuffer)
+		{
+			newShmBackBuffer =
+				ShmBackBuffer::create (RunLoop::instance ().getXcbConnection (), windowID, size);
+			// don't try again if the server does not support it
+			useShmBackBuffer = newShmBackBuffer != nullptr;
+		}
+		if (newShmBackBuffer)
+			backBuffer = newShmBackBuffer->getSurface ();
+		// the tile renderer needs direct access to the pixels of the back buffer
+		else if (tileRenderer)
+			backBuffer = Cairo::SurfaceHandle (
+				cairo_image_surface_create (CAIRO_FORMAT_ARGB32, size.x, size.y));
+		else
+			backBuffer = Cairo::SurfaceHandle (cairo_surface_create_similar (
+				windowSurface, CAIRO_CONTENT_COLOR_ALPHA, size.x, size.y));
 		CRect r;
 		r.setSize (size);
 		drawContext = makeOwned<Cairo::Context> (r, backBuffer);
+		// the old shared memory must only be released when it is not used by the context anymore
+		shmBackBuffer = std::move (newShmBackBuffer);
 	}
 
-	template<typename RectList, typename Proc>
-	void draw (const RectList& dirtyRects, Proc proc)
-	{
-		CRect copyRect;
-		drawContext->beginDraw ();
-		for (auto rect : dirtyRects)
+	template<typename RectList, typename Proc, typename CanDrawConcurrentlyProc,
+			 typename DrawDoneProc>
+	void draw (const RectList& dirtyRects, const RectList& compositeRects, Proc proc,
+			   CanDrawConcurrentlyProc canDrawConcurrently, DrawDoneProc drawDone)
+	{
+		// only the dirty rects are copied to the window, not their union
+		CInvalidRectList copyRects;
+		for (const auto& rect : dirtyRects)
+			copyRects.add (rect);
+		for (const auto& rect : compositeRects)
+			copyRects.add (rect);
+		if (copyRects.empty ())
+			return;
+		if (shmBackBuffer && !dirtyRects.empty ())
+			shmBackBuffer->waitUntilPresented ();
+		if (!dirtyRects.empty () &&
+			(!tileRenderer ||
+			 !tileRenderer->draw (backBuffer, {dirtyRects.begin (), dirtyRects.end ()}, proc,
+								  canDrawConcurrently)))
 		{
-			drawContext->setClipRect (rect);
-			drawContext->saveGlobalState ();
-			proc (drawContext, rect);
-			drawContext->restoreGlobalState ();
-			if (copyRect.isEmpty ())
-				copyRect = rect;
-			else
-				copyRect.unite (rect);
+			drawContext->beginDraw ();
+			for (auto rect : dirtyRects)
+			{
+				drawContext->setClipRect (rect);
+				drawContext->saveGlobalState ();
+				proc (drawContext, rect);
+				drawContext->restoreGlobalState ();
+			}
+			drawContext->endDraw ();
 		}
-		drawContext->endDraw ();
-		blitBackbufferToWindow (copyRect);
+		layerCompositor.drawInvalidLayers ();
+		drawDone ();
+		blitBackbufferToWindow (copyRects);
 		xcb_flush (RunLoop::instance ().getXcbConnection ());
 	}
 
+	Cairo::ViewLayerCompositor& getLayerCompositor () { return layerCompositor; }
+
 private:
+	uint32_t windowID;
+	bool useShmBackBuffer {false};
 	Cairo::SurfaceHandle windowSurface;
+	std::unique_ptr<ShmBackBuffer> shmBackBuffer;
 	Cairo::SurfaceHandle backBuffer;
 	SharedPointer<Cairo::Context> drawContext;
+	std::unique_ptr<Cairo::TileRenderer> tileRenderer;
+	Cairo::ViewLayerCompositor layerCompositor;
 
-	void blitBackbufferToWindow (const CRect& rect)
+	void blitBackbufferToWindow (const CInvalidRectList& rects)
 	{
+		auto compositeLayers = !layerCompositor.empty ();
+		if (shmBackBuffer && !compositeLayers)
+		{
+			shmBackBuffer->present (rects);
+			return;
+		}
+
 		Cairo::ContextHandle windowContext (cairo_create (windowSurface));
-		cairo_rectangle (windowContext, rect.left, rect.top, rect.getWidth (), rect.getHeight ());
+		CRect bounds;
+		for (const auto& rect : rects)
+		{
+			cairo_rectangle (windowContext, rect.left, rect.top, rect.getWidth (),
+							 rect.getHeight ());
+			if (bounds.isEmpty ())
+				bounds = rect;
+			else
+				bounds.unite (rect);
+		}
 		cairo_clip (windowContext);
+		// the layers are composited offscreen so that the window never shows the frame content
+		// without them
+		if (compositeLayers)
+			cairo_push_group (windowContext);
 		cairo_set_source_surface (windowContext, backBuffer, 0, 0);
-		cairo_rectangle (windowContext, rect.left, rect.top, rect.getWidth (), rect.getHeight ());
-		cairo_fill (windowContext);
+		cairo_paint (windowContext);
+		if (compositeLayers)
+		{
+			layerCompositor.composite (windowContext, bounds);
+			cairo_pop_group_to_source (windowContext);
+			cairo_paint (windowContext);
+		}
 		cairo_surface_flush (windowSurface);
 	}
 };
@@ -318,15 +444,22 @@ struct Frame::Impl : IFrameEventHandler
 	DoubleClickDetector doubleClickDetector;
 	IPlatformFrameCallback* frame;
 	std::unique_ptr<GenericOptionMenuTheme> genericOptionMenuTheme;
-	SharedPointer<RedrawTimerHandler> redrawTimer;
+	FrameScheduler frameScheduler;
+	FrameTiming lastFrameTiming;
 	RectList dirtyRects;
+	RectList compositeRects;
 	CCursorType currentCursor {kCursorDefault};
 	uint32_t pointerGrabed {0};
 	XdndHandler dndHandler;
 
 	//------------------------------------------------------------------------
-	Impl (::Window parent, CPoint size, IPlatformFrameCallback* frame)
-	: window (parent, size), drawHandler (window), frame (frame), dndHandler (&window, frame)
+	Impl (::Window parent, CPoint size, IPlatformFrameCallback* frame, const FrameConfig* config)
+	: window (parent, size)
+	, drawHandler (window, config, [this] (const CRect& rect) { invalidLayerRect (rect); })
+	, frame (frame)
+	, frameScheduler (config ? config->redrawRate : FrameConfig ().redrawRate,
+					  [this] () { redraw (); })
+	, dndHandler (&window, frame)
 	{
 		RunLoop::instance ().registerWindowEventHandler (window.getID (), this);
 	}
@@ -341,6 +474,7 @@ struct Frame::Impl : IFrameEventHandler
 		drawHandler.onSizeChanged (size.getSize ());
 		dirtyRects.clear ();
 		dirtyRects.add (size);
+		frameScheduler.schedule ();
 	}
 
 	//------------------------------------------------------------------------
@@ -366,23 +500,46 @@ struct Frame::Impl : IFrameEventHandler
 	//------------------------------------------------------------------------
 	void redraw ()
 	{
-		drawHandler.draw (dirtyRects, [&] (CDrawContext* context, const CRect& rect) {
-			frame->platformDrawRect (context, rect);
-		});
+		if (dirtyRects.empty () && compositeRects.empty ())
+			return;
+		using namespace std::chrono;
+		auto toMicroseconds = [] (FrameScheduler::Clock::duration d) {
+			return static_cast<uint64_t> (duration_cast<microseconds> (d).count ());
+		};
+		auto invalidTime = frameScheduler.getFirstInvalidTime ();
+		auto drawStartTime = FrameScheduler::Clock::now ();
+		auto drawEndTime = drawStartTime;
+		drawHandler.draw (
+			dirtyRects, compositeRects,
+			[&] (CDrawContext* context, const CRect& rect) {
+				frame->platformDrawRect (context, rect);
+			},
+			[&] (const CRect& rect) { return frame->platformCanDrawRectConcurrently (rect); },
+			[&] () { drawEndTime = FrameScheduler::Clock::now (); });
 		dirtyRects.clear ();
+		compositeRects.clear ();
+
+		auto blitEndTime = FrameScheduler::Clock::now ();
+		++lastFrameTiming.frameNumber;
+		lastFrameTiming.waitDuration = toMicroseconds (drawStartTime - invalidTime);
+		lastFrameTiming.drawDuration = toMicroseconds (drawEndTime - drawStartTime);
+		lastFrameTiming.blitDuration = toMicroseconds (blitEndTime - drawEndTime);
+		lastFrameTiming.latency = toMicroseconds (blitEndTime - invalidTime);
 	}
 
 	//------------------------------------------------------------------------
 	void invalidRect (CRect r)
 	{
 		dirtyRects.add (r);
-		if (redrawTimer)
-			return;
-		redrawTimer = makeOwned<RedrawTimerHandler> (16, [this] () {
-			if (dirtyRects.data ().empty ())
-				return;
-			redraw ();
-		});
+		frameScheduler.schedule ();
+	}
+
+	//------------------------------------------------------------------------
+	void invalidLayerRect (CRect r)
+	{
+		// only the layers need to be composited again, the frame content is still valid
+		compositeRects.add (r);
+		frameScheduler.schedule ();
 	}
 
 	//------------------------------------------------------------------------
@@ -644,7 +801,8 @@ Frame::Frame (IPlatformFrameCallback* frame, const CRect& size, uint32_t parent,
 		RunLoop::init (cfg->runLoop);
 	}
 
-	impl = std::unique_ptr<Impl> (new Impl (parent, {size.getWidth (), size.getHeight ()}, frame));
+	impl = std::unique_ptr<Impl> (
+		new Impl (parent, {size.getWidth (), size.getHeight ()}, frame, cfg));
 
 	frame->platformOnActivate (true);
 }
@@ -764,6 +922,12 @@ uint32_t Frame::getX11WindowID () const
 	return impl->window.getID ();
 }
 
+//------------------------------------------------------------------------
+FrameTiming Frame::getLastFrameTiming () const
+{
+	return impl->lastFrameTiming;
+}
+
 //------------------------------------------------------------------------
 SharedPointer<IPlatformTextEdit> Frame::createPlatformTextEdit (IPlatformTextEditCallback* textEdit)
 {
@@ -796,8 +960,7 @@ SharedPointer<IPlatformOpenGLView> Frame::createPlatformOpenGLView ()
 SharedPointer<IPlatformViewLayer> Frame::createPlatformViewLayer (
 	IPlatformViewLayerDelegate* drawDelegate, IPlatformViewLayer* parentLayer)
 {
-	// optional
-	return nullptr;
+	return impl->drawHandler.getLayerCompositor ().createLayer (drawDelegate, parentLayer);
 }
 
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
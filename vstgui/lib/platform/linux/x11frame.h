@@ -60,6 +60,7 @@ private:
 	bool setupGenericOptionMenu (bool use, GenericOptionMenuTheme* theme = nullptr) override;
 
 	uint32_t getX11WindowID () const override;
+	FrameTiming getLastFrameTiming () const override;
 
 	void optionMenuPopupStarted () override;
 	void optionMenuPopupStopped () override;
@@ -0,0 +1,158 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "x11shmbackbuffer.h"
+#include <cstdlib>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <xcb/xcb.h>
+#include <xcb/xcb_util.h>
+#include <xcb/shm.h>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace X11 {
+
+//------------------------------------------------------------------------
+static uint8_t hostImageByteOrder ()
+{
+	const uint32_t value = 1;
+	return *reinterpret_cast<const uint8_t*> (&value) == 1 ? XCB_IMAGE_ORDER_LSB_FIRST
+															: XCB_IMAGE_ORDER_MSB_FIRST;
+}
+
+//------------------------------------------------------------------------
+static uint8_t bitsPerPixel (const xcb_setup_t* setup, uint8_t depth)
+{
+	auto it = xcb_setup_pixmap_formats_iterator (setup);
+	for (; it.rem; xcb_format_next (&it))
+	{
+		if (it.data->depth == depth)
+			return it.data->bits_per_pixel;
+	}
+	return 0;
+}
+
+//------------------------------------------------------------------------
+std::unique_ptr<ShmBackBuffer> ShmBackBuffer::create (xcb_connection_t* connection,
+													  xcb_drawable_t drawable, const CPoint& size)
+{
+	if (!connection || size.x < 1. || size.y < 1.)
+		return nullptr;
+
+	auto versionReply =
+		xcb_shm_query_version_reply (connection, xcb_shm_query_version (connection), nullptr);
+	if (!versionReply)
+		return nullptr;
+	free (versionReply);
+
+	// the pixels of a CAIRO_FORMAT_ARGB32 image match the ZPixmap format of depth 24 and 32
+	auto geometryReply =
+		xcb_get_geometry_reply (connection, xcb_get_geometry (connection, drawable), nullptr);
+	if (!geometryReply)
+		return nullptr;
+	auto depth = geometryReply->depth;
+	free (geometryReply);
+	if (depth != 24 && depth != 32)
+		return nullptr;
+	// the server reads the 32 bit pixels in its image byte order, which must be the one of the
+	// host Cairo has written them in
+	auto setup = xcb_get_setup (connection);
+	if (setup->image_byte_order != hostImageByteOrder () || bitsPerPixel (setup, depth) != 32)
+		return nullptr;
+
+	auto width = static_cast<int> (size.x);
+	auto height = static_cast<int> (size.y);
+	auto stride = cairo_format_stride_for_width (CAIRO_FORMAT_ARGB32, width);
+	if (stride != width * 4)
+		return nullptr;
+
+	auto shmID = shmget (IPC_PRIVATE, static_cast<size_t> (stride) * height, IPC_CREAT | 0600);
+	if (shmID < 0)
+		return nullptr;
+	auto data = shmat (shmID, nullptr, 0);
+	if (data == reinterpret_cast<void*> (-1))
+	{
+		shmctl (shmID, IPC_RMID, nullptr);
+		return nullptr;
+	}
+
+	auto segment = xcb_generate_id (connection);
+	auto error = xcb_request_check (connection,
+									xcb_shm_attach_checked (connection, segment, shmID, false));
+	// the segment is released when the server and this process have detached it
+	shmctl (shmID, IPC_RMID, nullptr);
+	if (error)
+	{
+		free (error);
+		shmdt (data);
+		return nullptr;
+	}
+
+	std::unique_ptr<ShmBackBuffer> backBuffer (new ShmBackBuffer);
+	backBuffer->connection = connection;
+	backBuffer->drawable = drawable;
+	backBuffer->segment = segment;
+	backBuffer->depth = depth;
+	backBuffer->width = static_cast<uint16_t> (width);
+	backBuffer->height = static_cast<uint16_t> (height);
+	backBuffer->data = data;
+	backBuffer->graphicsContext = xcb_generate_id (connection);
+	xcb_create_gc (connection, backBuffer->graphicsContext, drawable, 0, nullptr);
+	backBuffer->surface.assign (cairo_image_surface_create_for_data (
+		static_cast<unsigned char*> (data), CAIRO_FORMAT_ARGB32, width, height, stride));
+	return backBuffer;
+}
+
+//------------------------------------------------------------------------
+ShmBackBuffer::~ShmBackBuffer () noexcept
+{
+	// the surface may still be referenced, but it must not access the pixels anymore
+	cairo_surface_finish (surface);
+	surface.reset ();
+	waitUntilPresented ();
+	xcb_free_gc (connection, graphicsContext);
+	xcb_shm_detach (connection, segment);
+	xcb_aux_sync (connection);
+	shmdt (data);
+}
+
+//------------------------------------------------------------------------
+void ShmBackBuffer::present (const CInvalidRectList& rects)
+{
+	waitUntilPresented ();
+	cairo_surface_flush (surface);
+	CRect bounds (0, 0, width, height);
+	for (auto r : rects)
+	{
+		r.makeIntegral ();
+		r.bound (bounds);
+		if (r.isEmpty ())
+			continue;
+		auto x = static_cast<int16_t> (r.left);
+		auto y = static_cast<int16_t> (r.top);
+		xcb_shm_put_image (connection, drawable, graphicsContext, width, height, x, y,
+						   static_cast<uint16_t> (r.getWidth ()),
+						   static_cast<uint16_t> (r.getHeight ()), x, y, depth,
+						   XCB_IMAGE_FORMAT_Z_PIXMAP, false, segment, 0);
+	}
+	// the server answers requests in order, so its reply to the next request tells that it has
+	// read the pixels. The reply is collected before the next drawing changes them.
+	presentSequence = xcb_get_input_focus (connection).sequence;
+	presentPending = true;
+}
+
+//------------------------------------------------------------------------
+void ShmBackBuffer::waitUntilPresented ()
+{
+	if (!presentPending)
+		return;
+	presentPending = false;
+	xcb_get_input_focus_cookie_t cookie {presentSequence};
+	free (xcb_get_input_focus_reply (connection, cookie, nullptr));
+}
+
+//------------------------------------------------------------------------
+} // X11
+} // VSTGUI
@@ -0,0 +1,65 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../cinvalidrectlist.h"
+#include "../../cpoint.h"
+#include "cairoutils.h"
+#include <memory>
+
+struct xcb_connection_t;
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace X11 {
+
+//------------------------------------------------------------------------
+/** A back buffer in shared memory (MIT-SHM extension)
+ *
+ *	The back buffer is a Cairo image surface whose pixels are shared with the X server, so copying
+ *	the dirty rects to the window does not transfer any pixels over the connection.
+ */
+class ShmBackBuffer
+{
+public:
+	using xcb_drawable_t = uint32_t;
+
+	/** returns nullptr if the X server does not support shared memory images for the drawable,
+	 *	for example if it is a remote server, or if it expects the pixels in another layout than
+	 *	the one of the Cairo image surface */
+	static std::unique_ptr<ShmBackBuffer> create (xcb_connection_t* connection,
+												  xcb_drawable_t drawable, const CPoint& size);
+
+	~ShmBackBuffer () noexcept;
+
+	/** the image surface in CAIRO_FORMAT_ARGB32 */
+	const Cairo::SurfaceHandle& getSurface () const { return surface; }
+
+	/** copy the rects of the back buffer to the drawable, does not wait for the server */
+	void present (const CInvalidRectList& rects);
+	/** wait until the server has read the pixels of the last present, must be called before the
+	 *	surface is drawn again */
+	void waitUntilPresented ();
+
+private:
+	ShmBackBuffer () = default;
+
+	Cairo::SurfaceHandle surface;
+	xcb_connection_t* connection {nullptr};
+	xcb_drawable_t drawable {0};
+	uint32_t segment {0};
+	uint32_t graphicsContext {0};
+	uint8_t depth {0};
+	uint16_t width {0};
+	uint16_t height {0};
+	void* data {nullptr};
+	/** sequence number of the request whose reply tells that the last present is done */
+	uint32_t presentSequence {0};
+	bool presentPending {false};
+};
+
+//------------------------------------------------------------------------
+} // X11
+} // VSTGUI
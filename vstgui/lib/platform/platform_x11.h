@@ -5,6 +5,7 @@
 #pragma once
 
 #include "iplatformframe.h"
+#include <cstdint>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -40,6 +41,33 @@ class FrameConfig : public IPlatformFrameConfig
 {
 public:
 	SharedPointer<IRunLoop> runLoop;
+	/** number of worker threads used to draw large dirty regions in tiles, 0 disables tiled
+	 *	drawing. Only the parts of the frame where all views have called
+	 *	CView::setCanDrawConcurrently (true) are drawn on the worker threads. */
+	uint32_t numRenderThreads {0};
+	/** size of the tiles in pixels when numRenderThreads is not 0 */
+	uint32_t renderTileSize {256};
+	/** maximum number of redraws per second (for example 30, 60 or 120), 0 means unlimited */
+	uint32_t redrawRate {60};
+	/** draw into a back buffer in memory shared with the X server (MIT-SHM extension) if the
+	 *	server supports it, otherwise the back buffer is a server side surface */
+	bool useShmBackBuffer {true};
+};
+
+//------------------------------------------------------------------------
+/** timing of the last redraw of a frame, all durations are in microseconds */
+struct FrameTiming
+{
+	/** number of redraws since the frame was created */
+	uint64_t frameNumber {0};
+	/** time from the first invalidation to the start of drawing */
+	uint64_t waitDuration {0};
+	/** time spent drawing the dirty views and view layers */
+	uint64_t drawDuration {0};
+	/** time spent compositing the view layers and copying the back buffer to the window */
+	uint64_t blitDuration {0};
+	/** time from the first invalidation until the redraw was copied to the window */
+	uint64_t latency {0};
 };
 
 //------------------------------------------------------------------------
@@ -47,6 +75,7 @@ class IX11Frame
 {
 public:
 	virtual uint32_t getX11WindowID () const = 0;
+	virtual FrameTiming getLastFrameTiming () const = 0;
 };
 
 //------------------------------------------------------------------------
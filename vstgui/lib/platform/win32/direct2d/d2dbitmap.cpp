@@ -11,6 +11,7 @@
 #include "../win32resourcestream.h"
 #include "../win32factory.h"
 #include "../../../cstring.h"
+#include "../../../pixelbuffer.h"
 #include <wincodec.h>
 #include <d2d1.h>
 #include <shlwapi.h>
@@ -325,40 +326,16 @@ bool D2DBitmap::PixelAccess::init (D2DBitmap* inBitmap, bool _alphaPremultiplied
 //-----------------------------------------------------------------------------
 void D2DBitmap::PixelAccess::premultiplyAlpha (BYTE* ptr, UINT bytesPerRow, const CPoint& size)
 {
-	for (int32_t y = 0; y < (int32_t)size.y; y++, ptr += bytesPerRow)
-	{
-		auto* pixelPtr = (uint32_t*)ptr;
-		for (int32_t x = 0; x < (int32_t)size.x; x++, pixelPtr++)
-		{
-			uint8_t* pixel = (uint8_t*)pixelPtr;
-			if (pixel[3] == 0)
-			{
-				*pixelPtr = 0;
-				continue;
-			}
-			pixel[0] = (uint32_t)((pixel[0] * pixel[3]) >> 8);
-			pixel[1] = (uint32_t)((pixel[1] * pixel[3]) >> 8);
-			pixel[2] = (uint32_t)((pixel[2] * pixel[3]) >> 8);
-		}
-	}
+	// the B, G, R, A bytes of the bitmap are PixelBuffer::Format::ARGB
+	PixelBuffer::premultiply (PixelBuffer::Format::ARGB, ptr, bytesPerRow,
+							  static_cast<uint32_t> (size.x), static_cast<uint32_t> (size.y));
 }
 
 //-----------------------------------------------------------------------------
 void D2DBitmap::PixelAccess::unpremultiplyAlpha (BYTE* ptr, UINT bytesPerRow, const CPoint& size)
 {
-	for (int32_t y = 0; y < (int32_t)size.y; y++, ptr += bytesPerRow)
-	{
-		uint32_t* pixelPtr = (uint32_t*)ptr;
-		for (int32_t x = 0; x < (int32_t)size.x; x++, pixelPtr++)
-		{
-			uint8_t* pixel = (uint8_t*)pixelPtr;
-			if (pixel[3] == 0)
-				continue;
-			pixel[0] = (uint32_t)(pixel[0] * 255) / pixel[3];
-			pixel[1] = (uint32_t)(pixel[1] * 255) / pixel[3];
-			pixel[2] = (uint32_t)(pixel[2] * 255) / pixel[3];
-		}
-	}
+	PixelBuffer::unpremultiply (PixelBuffer::Format::ARGB, ptr, bytesPerRow,
+								static_cast<uint32_t> (size.x), static_cast<uint32_t> (size.y));
 }
 
 //-----------------------------------------------------------------------------
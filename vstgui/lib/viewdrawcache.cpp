@@ -0,0 +1,220 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "viewdrawcache.h"
+#include "cbitmap.h"
+#include "coffscreencontext.h"
+#include "cview.h"
+#include <cmath>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace ViewDrawCache {
+namespace {
+
+//------------------------------------------------------------------------
+struct Entry
+{
+	const CView* view;
+	SharedPointer<CBitmap> bitmap;
+	CPoint size;
+	double scaleFactor;
+	size_t bytes;
+};
+
+//------------------------------------------------------------------------
+struct Cache
+{
+	using EntryList = std::list<Entry>;
+
+	static Cache& instance ()
+	{
+		static Cache gInstance;
+		return gInstance;
+	}
+
+	// the frame may be drawn on multiple threads, so every access must hold the mutex
+	std::mutex mutex;
+	// the most recently drawn entry is the first one
+	EntryList entries;
+	std::unordered_map<const CView*, EntryList::iterator> map;
+	size_t budget {kDefaultMemoryBudget};
+	Statistics statistics;
+
+	void erase (EntryList::iterator it)
+	{
+		statistics.bytes -= it->bytes;
+		map.erase (it->view);
+		entries.erase (it);
+	}
+
+	void shrinkTo (size_t bytes)
+	{
+		while (!entries.empty () && statistics.bytes > bytes)
+		{
+			erase (std::prev (entries.end ()));
+			++statistics.evictions;
+		}
+	}
+
+	void add (const CView* view, const SharedPointer<CBitmap>& bitmap, double scaleFactor,
+			  size_t bytes)
+	{
+		auto it = map.find (view);
+		if (it != map.end ())
+			erase (it->second);
+		// the budget may have been lowered while the view was drawn into the bitmap
+		if (bytes > budget)
+			return;
+		shrinkTo (budget - bytes);
+		entries.push_front ({view, bitmap, view->getViewSize ().getSize (), scaleFactor, bytes});
+		map.emplace (view, entries.begin ());
+		statistics.bytes += bytes;
+	}
+};
+
+//------------------------------------------------------------------------
+double getEffectiveScaleFactor (CDrawContext* context)
+{
+	const auto& t = context->getCurrentTransform ();
+	if (t.m12 != 0. || t.m21 != 0. || t.m11 != t.m22 || t.m11 <= 0.)
+		return 0.;
+	return context->getScaleFactor () * t.m11;
+}
+
+//------------------------------------------------------------------------
+size_t getBitmapBytes (const CPoint& size, double scaleFactor)
+{
+	auto width = static_cast<size_t> (std::ceil (size.x * scaleFactor));
+	auto height = static_cast<size_t> (std::ceil (size.y * scaleFactor));
+	return width * height * 4;
+}
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> renderView (CView* view, double scaleFactor)
+{
+	const auto& viewSize = view->getViewSize ();
+	return renderBitmapOffscreen (viewSize.getSize (), scaleFactor, [&] (CDrawContext& context) {
+		CDrawContext::Transform transform (
+			context, CGraphicsTransform ().translate (-viewSize.left, -viewSize.top));
+		context.setClipRect (viewSize);
+		view->drawRect (&context, viewSize);
+	});
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+void setMemoryBudget (size_t bytes)
+{
+	auto& cache = Cache::instance ();
+	std::lock_guard<std::mutex> guard (cache.mutex);
+	cache.budget = bytes;
+	cache.shrinkTo (bytes);
+}
+
+//------------------------------------------------------------------------
+size_t getMemoryBudget ()
+{
+	auto& cache = Cache::instance ();
+	std::lock_guard<std::mutex> guard (cache.mutex);
+	return cache.budget;
+}
+
+//------------------------------------------------------------------------
+Statistics getStatistics ()
+{
+	auto& cache = Cache::instance ();
+	std::lock_guard<std::mutex> guard (cache.mutex);
+	auto result = cache.statistics;
+	result.numEntries = cache.entries.size ();
+	return result;
+}
+
+//------------------------------------------------------------------------
+void resetStatistics ()
+{
+	auto& cache = Cache::instance ();
+	std::lock_guard<std::mutex> guard (cache.mutex);
+	cache.statistics.hits = cache.statistics.misses = cache.statistics.evictions = 0;
+}
+
+//------------------------------------------------------------------------
+void purge ()
+{
+	auto& cache = Cache::instance ();
+	std::lock_guard<std::mutex> guard (cache.mutex);
+	cache.map.clear ();
+	cache.entries.clear ();
+	cache.statistics.bytes = 0;
+}
+
+//------------------------------------------------------------------------
+void drawView (CView* view, CDrawContext* context, const CRect& updateRect)
+{
+	auto& cache = Cache::instance ();
+	auto scaleFactor = getEffectiveScaleFactor (context);
+	const auto& viewSize = view->getViewSize ();
+	auto bytes = getBitmapBytes (viewSize.getSize (), scaleFactor);
+
+	SharedPointer<CBitmap> bitmap;
+	{
+		std::lock_guard<std::mutex> guard (cache.mutex);
+		auto it = cache.map.find (view);
+		if (it != cache.map.end ())
+		{
+			const auto& entry = *it->second;
+			if (entry.scaleFactor == scaleFactor && entry.size == viewSize.getSize () &&
+				!view->isDirty ())
+			{
+				cache.entries.splice (cache.entries.begin (), cache.entries, it->second);
+				bitmap = entry.bitmap;
+				++cache.statistics.hits;
+			}
+			else
+			{
+				cache.erase (it->second);
+			}
+		}
+		if (!bitmap)
+		{
+			++cache.statistics.misses;
+			// views which are bigger than the whole budget or which are drawn rotated or with a
+			// non uniform scale are drawn directly
+			if (scaleFactor == 0. || bytes == 0 || bytes > cache.budget)
+				scaleFactor = 0.;
+		}
+	}
+	if (!bitmap)
+	{
+		if (scaleFactor != 0.)
+			bitmap = renderView (view, scaleFactor);
+		if (!bitmap)
+		{
+			view->drawRect (context, updateRect);
+			return;
+		}
+		std::lock_guard<std::mutex> guard (cache.mutex);
+		cache.add (view, bitmap, scaleFactor, bytes);
+	}
+	bitmap->draw (context, viewSize);
+}
+
+//------------------------------------------------------------------------
+void invalidate (const CView* view)
+{
+	auto& cache = Cache::instance ();
+	std::lock_guard<std::mutex> guard (cache.mutex);
+	auto it = cache.map.find (view);
+	if (it != cache.map.end ())
+		cache.erase (it->second);
+}
+
+//------------------------------------------------------------------------
+} // ViewDrawCache
+} // VSTGUI
@@ -0,0 +1,66 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "vstguifwd.h"
+#include <cstddef>
+#include <cstdint>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+/** Process wide cache of the drawings of views which use CView::setDrawingCached ()
+ *
+ *	A cached view is drawn once into an offscreen bitmap in the resolution of the draw context and
+ *	afterwards the bitmap is drawn instead of the view until the view is invalidated, marked
+ *	dirty, resized or drawn with another scale factor.
+ *
+ *	The memory used by the bitmaps is limited by a budget, if adding a bitmap would exceed it, the
+ *	least recently drawn bitmaps are released.
+ */
+namespace ViewDrawCache {
+
+//------------------------------------------------------------------------
+/** counters of the view draw cache */
+struct Statistics
+{
+	/** number of times a view was drawn from its cached bitmap */
+	uint64_t hits {0};
+	/** number of times a view had to be drawn into a new bitmap */
+	uint64_t misses {0};
+	/** number of bitmaps released to stay inside the memory budget */
+	uint64_t evictions {0};
+	/** number of cached bitmaps */
+	size_t numEntries {0};
+	/** memory held by the cached bitmaps in bytes */
+	size_t bytes {0};
+};
+
+/** the default memory budget in bytes */
+static constexpr size_t kDefaultMemoryBudget = 64 * 1024 * 1024;
+
+/** set the memory budget in bytes, releases bitmaps if the new budget is smaller */
+void setMemoryBudget (size_t bytes);
+/** get the memory budget in bytes */
+size_t getMemoryBudget ();
+
+/** get the current statistics */
+Statistics getStatistics ();
+/** reset the hit, miss and eviction counters */
+void resetStatistics ();
+
+/** release all cached bitmaps */
+void purge ();
+
+/** draw the view via its cached bitmap, creates the bitmap if needed
+ *
+ *	Falls back to drawing the view directly if no bitmap can be created for it.
+ */
+void drawView (CView* view, CDrawContext* context, const CRect& updateRect);
+/** release the cached bitmap of the view */
+void invalidate (const CView* view);
+
+//------------------------------------------------------------------------
+} // ViewDrawCache
+} // VSTGUI
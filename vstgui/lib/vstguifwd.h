@@ -190,6 +190,7 @@ class CGradient;
 class UTF8String;
 class UTF8StringView;
 class CVSTGUITimer;
+class MeterFeed;
 class CMenuItem;
 class CCommandMenuItem;
 class GenericStringListDataBrowserSource;
@@ -5,25 +5,94 @@
 #include "vstgui/uidescription/base64codec.h"
 #include "vstgui/lib/malloc.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <random>
 
 using namespace VSTGUI;
 
-int main ()
+//------------------------------------------------------------------------
+template<typename Proc>
+static double measureBest (uint32_t repetitions, Proc proc)
 {
+	using Clock = std::chrono::high_resolution_clock;
+	double best = 0.;
+	for (auto i = 0u; i < repetitions; ++i)
+	{
+		auto start = Clock::now ();
+		proc ();
+		std::chrono::duration<double> duration = Clock::now () - start;
+		if (i == 0 || duration.count () < best)
+			best = duration.count ();
+	}
+	return best;
+}
+
+//------------------------------------------------------------------------
+static double gigabytesPerSecond (size_t bytes, double seconds)
+{
+	return seconds > 0. ? static_cast<double> (bytes) / seconds / 1e9 : 0.;
+}
+
+//------------------------------------------------------------------------
+/** usage: base64codecspeed [size in megabytes] [repetitions] */
+int main (int argc, char* argv[])
+{
+	size_t megaBytes = argc > 1 ? std::strtoul (argv[1], nullptr, 10) : 64;
+	uint32_t repetitions = argc > 2 ? static_cast<uint32_t> (std::strtoul (argv[2], nullptr, 10)) : 5;
+	megaBytes = std::max<size_t> (megaBytes, 1);
+	repetitions = std::max<uint32_t> (repetitions, 1);
+
 	Buffer<uint8_t> origData;
-	origData.allocate (1024*1024*500);
+	origData.allocate (1024 * 1024 * megaBytes);
 
 	std::independent_bits_engine<std::default_random_engine, sizeof (uint16_t) * 8, uint16_t> rbe;
 	std::generate (origData.get (), origData.get () + origData.size (), std::ref (rbe));
 
-	auto encoderResult = Base64Codec::encode (origData.get (), origData.size ());
-	auto decoderResult = Base64Codec::decode (encoderResult.data.get (), encoderResult.dataSize);
+	// the scalar implementation is the reference of the others
+	Base64Codec::setImplementation (Base64Codec::Implementation::Scalar);
+	auto reference = Base64Codec::encode (origData.get (), origData.size ());
+
+	Buffer<uint8_t> encoded (Base64Codec::getEncodedSize (origData.size ()));
+	Buffer<uint8_t> decoded (Base64Codec::getMaxDecodedSize (encoded.size ()));
+
+	std::printf ("%zu MB, best of %u runs\n", megaBytes, repetitions);
+	std::printf ("%-8s %12s %12s\n", "", "encode GB/s", "decode GB/s");
 
-	if (origData.size () != decoderResult.dataSize)
-		return -1;
+	int result = 0;
+	for (auto impl : {Base64Codec::Implementation::Scalar, Base64Codec::Implementation::SSSE3,
+					  Base64Codec::Implementation::AVX2, Base64Codec::Implementation::NEON})
+	{
+		if (!Base64Codec::setImplementation (impl))
+			continue;
+		size_t encodedSize = 0;
+		auto encodeTime = measureBest (repetitions, [&] () {
+			encodedSize = Base64Codec::encode (origData.get (), origData.size (), encoded.get ());
+		});
+		size_t decodedSize = 0;
+		auto decodeTime = measureBest (repetitions, [&] () {
+			decodedSize = Base64Codec::decode (reference.data.get (), reference.dataSize, decoded.get ());
+		});
+		std::printf ("%-8s %12.2f %12.2f\n", Base64Codec::getImplementationName (impl),
+					 gigabytesPerSecond (origData.size (), encodeTime),
+					 gigabytesPerSecond (origData.size (), decodeTime));
 
-	if (memcmp (origData.get (), decoderResult.data.get (), origData.size ()) != 0)
-		return -1;
-	return 0;
+		if (encodedSize != reference.dataSize ||
+			std::memcmp (encoded.get (), reference.data.get (), encodedSize) != 0)
+		{
+			std::printf ("%s: encoded data differs\n", Base64Codec::getImplementationName (impl));
+			result = -1;
+		}
+		if (decodedSize != origData.size () ||
+			std::memcmp (decoded.get (), origData.get (), decodedSize) != 0)
+		{
+			std::printf ("%s: decoded data differs\n", Base64Codec::getImplementationName (impl));
+			result = -1;
+		}
+	}
+	return result;
 }
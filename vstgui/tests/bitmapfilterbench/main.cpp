@@ -0,0 +1,236 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/detail/boxblur.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+using namespace VSTGUI;
+
+/*	Compares the box blur kernel of the BoxBlur bitmap filter with the previous implementation
+	on a 4K bitmap for different radii and checks that both produce the same output. Every
+	implementation of the kernel the processor supports is measured.
+
+	Usage: bitmapfilterbench [repetitions]
+*/
+
+//------------------------------------------------------------------------
+namespace Legacy {
+
+//------------------------------------------------------------------------
+struct BoxBlur
+{
+	Buffer<uint8_t> pc0;
+	Buffer<uint8_t> pc1;
+	Buffer<uint8_t> pc2;
+	Buffer<uint8_t> pc3;
+	Buffer<int32_t> vMin;
+	Buffer<int32_t> vMax;
+	Buffer<uint8_t> dv;
+
+	template<bool plane0, bool plane1, bool plane2, bool plane3>
+	void algo (uint8_t* inPixel, uint8_t* outPixel, int32_t width, int32_t height, int32_t radius)
+	{
+		constexpr int32_t pos0 = 0;
+		constexpr int32_t pos1 = 1;
+		constexpr int32_t pos2 = 2;
+		constexpr int32_t pos3 = 3;
+		constexpr int32_t numComponents = 4;
+
+		int32_t wm = width - 1;
+		int32_t hm = height - 1;
+		int32_t areaSize = width * height;
+		int32_t div = radius + radius + 1;
+
+		if (plane0)
+			pc0.allocate (areaSize);
+		if (plane1)
+			pc1.allocate (areaSize);
+		if (plane2)
+			pc2.allocate (areaSize);
+		if (plane3)
+			pc3.allocate (areaSize);
+		vMin.allocate (std::max (width, height));
+		vMax.allocate (std::max (width, height));
+		dv.allocate (256 * div);
+
+		for (auto i = 0u; i < dv.size (); ++i)
+			dv[i] = (i / div);
+
+		int32_t sum0, sum1, sum2, sum3;
+		for (auto y = 0, yw = 0, yi = 0; y < height; ++y, yw += width)
+		{
+			sum0 = sum1 = sum2 = sum3 = 0;
+			for (auto i = -radius; i <= radius; i++)
+			{
+				auto p = (yi + std::min (wm, std::max (i, 0))) * numComponents;
+				if (plane0)
+					sum0 += inPixel[p + pos0];
+				if (plane1)
+					sum1 += inPixel[p + pos1];
+				if (plane2)
+					sum2 += inPixel[p + pos2];
+				if (plane3)
+					sum3 += inPixel[p + pos3];
+			}
+			for (auto x = 0; x < width; ++x, ++yi)
+			{
+				if (plane0)
+					pc0[yi] = dv[sum0];
+				if (plane1)
+					pc1[yi] = dv[sum1];
+				if (plane2)
+					pc2[yi] = dv[sum2];
+				if (plane3)
+					pc3[yi] = dv[sum3];
+				if (y == 0)
+				{
+					vMin[x] = std::min (x + radius + 1, wm);
+					vMax[x] = std::max (x - radius, 0);
+				}
+				auto p1 = (yw + vMin[x]) * numComponents;
+				auto p2 = (yw + vMax[x]) * numComponents;
+				if (plane0)
+					sum0 += inPixel[p1 + pos0] - inPixel[p2 + pos0];
+				if (plane1)
+					sum1 += inPixel[p1 + pos1] - inPixel[p2 + pos1];
+				if (plane2)
+					sum2 += inPixel[p1 + pos2] - inPixel[p2 + pos2];
+				if (plane3)
+					sum3 += inPixel[p1 + pos3] - inPixel[p2 + pos3];
+			}
+		}
+
+		for (auto x = 0; x < width; ++x)
+		{
+			sum0 = sum1 = sum2 = sum3 = 0;
+			for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
+			{
+				auto yi = std::max (0, yp) + x;
+				if (plane0)
+					sum0 += pc0[yi];
+				if (plane1)
+					sum1 += pc1[yi];
+				if (plane2)
+					sum2 += pc2[yi];
+				if (plane3)
+					sum3 += pc3[yi];
+			}
+			for (auto y = 0, yi = x; y < height; ++y, yi += width)
+			{
+				auto pos = yi * numComponents;
+				if (plane0)
+					outPixel[pos + pos0] = dv[sum0];
+				if (plane1)
+					outPixel[pos + pos1] = dv[sum1];
+				if (plane2)
+					outPixel[pos + pos2] = dv[sum2];
+				if (plane3)
+					outPixel[pos + pos3] = dv[sum3];
+				if (x == 0)
+				{
+					vMin[y] = std::min (y + radius + 1, hm) * width;
+					vMax[y] = std::max (y - radius, 0) * width;
+				}
+				auto p1 = x + vMin[y];
+				auto p2 = x + vMax[y];
+				if (plane0)
+					sum0 += pc0[p1] - pc0[p2];
+				if (plane1)
+					sum1 += pc1[p1] - pc1[p2];
+				if (plane2)
+					sum2 += pc2[p1] - pc2[p2];
+				if (plane3)
+					sum3 += pc3[p1] - pc3[p2];
+			}
+		}
+	}
+};
+
+//------------------------------------------------------------------------
+} // Legacy
+
+//------------------------------------------------------------------------
+using Clock = std::chrono::high_resolution_clock;
+
+//------------------------------------------------------------------------
+template<typename Proc>
+static double measure (int repetitions, Proc proc)
+{
+	Clock::duration duration {};
+	for (auto i = 0; i < repetitions; ++i)
+	{
+		auto start = Clock::now ();
+		proc ();
+		duration += Clock::now () - start;
+	}
+	return std::chrono::duration<double, std::milli> (duration).count () / repetitions;
+}
+
+//------------------------------------------------------------------------
+static constexpr Detail::BoxBlur::Implementation implementations[] = {
+	Detail::BoxBlur::Implementation::Scalar, Detail::BoxBlur::Implementation::SSE2,
+	Detail::BoxBlur::Implementation::AVX2, Detail::BoxBlur::Implementation::NEON};
+
+//------------------------------------------------------------------------
+template<bool plane0, bool plane1, bool plane2, bool plane3>
+static bool compare (const char* name, const Buffer<uint8_t>& source, int32_t width, int32_t height,
+					 int repetitions)
+{
+	Buffer<uint8_t> legacyResult (source.size ());
+	Buffer<uint8_t> result (source.size ());
+	Legacy::BoxBlur legacyBlur;
+	Detail::BoxBlur blur;
+
+	printf ("%s\n", name);
+	for (auto radius = 2; radius <= 64; radius *= 2)
+	{
+		auto legacyTime = measure (repetitions, [&] () {
+			memcpy (legacyResult.data (), source.data (), source.size ());
+			legacyBlur.algo<plane0, plane1, plane2, plane3> (
+				legacyResult.data (), legacyResult.data (), width, height, radius / 2);
+		});
+		printf ("  radius %2d: legacy %8.2f ms\n", radius, legacyTime);
+		for (auto impl : implementations)
+		{
+			if (!Detail::BoxBlur::setImplementation (impl))
+				continue;
+			auto time = measure (repetitions, [&] () {
+				memcpy (result.data (), source.data (), source.size ());
+				blur.process<plane0, plane1, plane2, plane3> (result.data (), result.data (),
+															  width, height, radius / 2);
+			});
+			auto identical = memcmp (legacyResult.data (), result.data (), source.size ()) == 0;
+			printf ("    %-6s %8.2f ms, speedup %5.2fx%s\n",
+					Detail::BoxBlur::getImplementationName (impl), time, legacyTime / time,
+					identical ? "" : " [OUTPUT DIFFERS]");
+			if (!identical)
+				return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	constexpr int32_t width = 3840;
+	constexpr int32_t height = 2160;
+
+	auto repetitions = argc > 1 ? std::max (1, atoi (argv[1])) : 3;
+
+	Buffer<uint8_t> source (width * height * 4);
+	std::independent_bits_engine<std::default_random_engine, 8, uint16_t> rbe;
+	std::generate (source.begin (), source.end (), std::ref (rbe));
+
+	printf ("Box blur on %dx%d pixels, %d repetitions\n", width, height, repetitions);
+	auto success = compare<true, true, true, true> ("all channels", source, width, height,
+													repetitions);
+	success &= compare<false, false, false, true> ("alpha channel only", source, width, height,
+												   repetitions);
+	return success ? 0 : -1;
+}
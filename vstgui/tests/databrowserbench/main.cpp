@@ -0,0 +1,172 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cdatabrowser.h"
+#include "vstgui/lib/cdrawcontext.h"
+#include "vstgui/lib/idatabrowserdelegate.h"
+#include "vstgui/lib/vstguiinit.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+/*	Scrolls data browsers with a growing number of rows from the top to the bottom and reports
+	the time spent drawing one screen. The drawing cost should not depend on the number of rows.
+
+	Usage: databrowserbench [max-rows] [frames]
+
+	Every seventh row is selected, so the browser also needs to look up the selection state of
+	each visible row. The cells are drawn into a context which draws nothing.
+*/
+
+//------------------------------------------------------------------------
+class NullDrawContext : public CDrawContext
+{
+public:
+	NullDrawContext (const CRect& surfaceRect) : CDrawContext (surfaceRect) { init (); }
+
+	void drawLine (const LinePair& line) override {}
+	void drawLines (const LineList& lines) override {}
+	void drawPolygon (const PointList& polygonPointList, const CDrawStyle drawStyle) override {}
+	void drawRect (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawArc (const CRect& rect, const float startAngle1, const float endAngle2,
+	              const CDrawStyle drawStyle) override
+	{
+	}
+	void drawEllipse (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawPoint (const CPoint& point, const CColor& color) override {}
+	void drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offset, float alpha) override
+	{
+	}
+	void clearRect (const CRect& rect) override {}
+	CGraphicsPath* createGraphicsPath () override { return nullptr; }
+	CGraphicsPath* createTextPath (const CFontRef font, UTF8StringPtr text) override
+	{
+		return nullptr;
+	}
+	void drawGraphicsPath (CGraphicsPath* path, PathDrawMode mode,
+	                       CGraphicsTransform* transformation) override
+	{
+	}
+	void fillLinearGradient (CGraphicsPath* path, const CGradient& gradient,
+	                         const CPoint& startPoint, const CPoint& endPoint, bool evenOdd,
+	                         CGraphicsTransform* transformation) override
+	{
+	}
+	void fillRadialGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& center,
+	                         CCoord radius, const CPoint& originOffset, bool evenOdd,
+	                         CGraphicsTransform* transformation) override
+	{
+	}
+};
+
+//------------------------------------------------------------------------
+class Delegate : public DataBrowserDelegateAdapter
+{
+public:
+	static constexpr int32_t kSelectionStep = 7;
+
+	Delegate (int32_t numRows) : numRows (numRows) {}
+
+	int32_t dbGetNumRows (CDataBrowser* browser) override { return numRows; }
+	int32_t dbGetNumColumns (CDataBrowser* browser) override { return 4; }
+	CCoord dbGetRowHeight (CDataBrowser* browser) override { return 18; }
+	CCoord dbGetCurrentColumnWidth (int32_t index, CDataBrowser* browser) override
+	{
+		return 120;
+	}
+	bool dbGetLineWidthAndColor (CCoord& width, CColor& color, CDataBrowser* browser) override
+	{
+		width = 1;
+		color = kGreyCColor;
+		return true;
+	}
+	void dbDrawCell (CDrawContext* context, const CRect& size, int32_t row, int32_t column,
+	                 int32_t flags, CDataBrowser* browser) override
+	{
+		++numDrawnCells;
+		bool selected = (flags & kRowSelected) != 0;
+		if (selected != (row % kSelectionStep == 0))
+			++numWrongSelectionStates;
+	}
+
+	int32_t numRows;
+	size_t numDrawnCells {0};
+	size_t numWrongSelectionStates {0};
+};
+
+//------------------------------------------------------------------------
+struct Result
+{
+	double microSecondsPerFrame;
+	size_t cellsPerFrame;
+	size_t numWrongSelectionStates;
+};
+
+//------------------------------------------------------------------------
+static Result measure (int32_t numRows, int32_t numFrames)
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	Delegate delegate (numRows);
+	auto browser = makeOwned<CDataBrowser> (
+	    CRect (0, 0, 500, 600), &delegate,
+	    CDataBrowser::kDrawRowLines | CDataBrowser::kDrawColumnLines |
+	        CDataBrowser::kMultiSelectionStyle | CScrollView::kVerticalScrollbar);
+	browser->recalculateLayout (true);
+	for (auto row = 0; row < numRows; row += Delegate::kSelectionStep)
+		browser->selectRow (row);
+
+	NullDrawContext context (browser->getViewSize ());
+	auto start = Clock::now ();
+	for (auto frame = 0; frame < numFrames; ++frame)
+	{
+		auto row = static_cast<int32_t> (static_cast<int64_t> (numRows - 1) * frame / numFrames);
+		browser->makeRowVisible (row);
+		browser->drawRect (&context, browser->getViewSize ());
+	}
+	std::chrono::duration<double, std::micro> duration = Clock::now () - start;
+	return {duration.count () / numFrames, delegate.numDrawnCells / numFrames,
+	        delegate.numWrongSelectionStates};
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#else
+	VSTGUI::init (nullptr);
+#endif
+	auto maxRows = argc > 1 ? std::max (1000, atoi (argv[1])) : 1000000;
+	auto numFrames = argc > 2 ? std::max (1, atoi (argv[2])) : 1000;
+
+	int result = 0;
+	printf ("%10s %14s %16s\n", "rows", "us per frame", "cells per frame");
+	for (auto numRows = 1000; numRows <= maxRows; numRows *= 10)
+	{
+		auto r = measure (numRows, numFrames);
+		printf ("%10d %14.2f %16zu\n", numRows, r.microSecondsPerFrame, r.cellsPerFrame);
+		if (r.numWrongSelectionStates)
+		{
+			printf ("%zu cells were drawn with the wrong selection state\n",
+			        r.numWrongSelectionStates);
+			result = -1;
+		}
+	}
+
+	VSTGUI::exit ();
+	return result;
+}
@@ -0,0 +1,281 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cinvalidrectlist.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace VSTGUI;
+
+/*	Replays invalidation traces through CInvalidRectList and the previous quadratic
+	implementation and reports the time spent.
+
+	Usage: invalidrectlistbench [trace-file] [repetitions]
+
+	A trace file contains one rectangle per line as "left top right bottom". A line containing
+	"flush" (or an empty line) ends a frame, this is where the platform frame would draw and
+	clear the list. Without a trace file a synthetic trace of a few hundred meters and LEDs is
+	used.
+*/
+
+//------------------------------------------------------------------------
+namespace Legacy {
+
+//------------------------------------------------------------------------
+struct InvalidRectList
+{
+	using RectList = std::vector<CRect>;
+
+	bool add (const CRect& r)
+	{
+		for (auto it = list.begin (), end = list.end (); it != end; ++it)
+		{
+			if (*it == r)
+				return false;
+			if (it->rectInside (r))
+				return false;
+			if (r.rectInside (*it))
+			{
+				list.erase (it);
+				return add (r);
+			}
+			auto area1 = r.getWidth () * r.getHeight ();
+			auto area2 = it->getWidth () * it->getHeight ();
+			CRect jr (*it);
+			jr.unite (r);
+			auto joinedArea = jr.getWidth () * jr.getHeight ();
+			if (joinedArea <= (area1 + area2))
+			{
+				list.erase (it);
+				return add (jr);
+			}
+		}
+		list.emplace_back (r);
+		return true;
+	}
+
+	RectList::iterator begin () { return list.begin (); }
+	RectList::iterator end () { return list.end (); }
+	void clear () { list.clear (); }
+	const RectList& data () const { return list; }
+
+	RectList list;
+};
+
+//------------------------------------------------------------------------
+inline void joinNearbyInvalidRects (InvalidRectList& list, CCoord maxDistance)
+{
+	for (auto it = list.begin (); it != list.end (); ++it)
+	{
+		for (auto it2 = list.begin (); it2 != list.end (); ++it2)
+		{
+			if (it2 == it)
+				continue;
+			if (it->left == it2->left && it->right == it2->right)
+			{
+				CCoord distance;
+				if (it->bottom < it2->top)
+					distance = it2->top - it->bottom;
+				else
+					distance = it->top - it2->bottom;
+				if (distance <= maxDistance)
+				{
+					it->unite (*it2);
+					list.list.erase (it2);
+					joinNearbyInvalidRects (list, maxDistance);
+					return;
+				}
+			}
+			if (it->top == it2->top && it->bottom == it2->bottom)
+			{
+				CCoord distance;
+				if (it->right < it2->left)
+					distance = it2->left - it->right;
+				else
+					distance = it->left - it2->right;
+				if (distance <= maxDistance)
+				{
+					it->unite (*it2);
+					list.list.erase (it2);
+					joinNearbyInvalidRects (list, maxDistance);
+					return;
+				}
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+} // Legacy
+
+//------------------------------------------------------------------------
+using Frame = std::vector<CRect>;
+using Trace = std::vector<Frame>;
+
+//------------------------------------------------------------------------
+static bool readTrace (const char* path, Trace& trace)
+{
+	std::ifstream stream (path);
+	if (!stream.is_open ())
+		return false;
+	Frame frame;
+	std::string line;
+	while (std::getline (stream, line))
+	{
+		if (line.empty () || line == "flush")
+		{
+			if (!frame.empty ())
+				trace.emplace_back (std::move (frame));
+			frame = {};
+			continue;
+		}
+		std::istringstream lineStream (line);
+		CRect r;
+		if (lineStream >> r.left >> r.top >> r.right >> r.bottom)
+			frame.emplace_back (r);
+	}
+	if (!frame.empty ())
+		trace.emplace_back (std::move (frame));
+	return true;
+}
+
+//------------------------------------------------------------------------
+static Trace makeSyntheticTrace ()
+{
+	constexpr auto numColumns = 48;
+	constexpr auto numRows = 8;
+	constexpr auto meterWidth = 12.;
+	constexpr auto meterHeight = 80.;
+	constexpr auto ledSize = 8.;
+	constexpr auto spacing = 4.;
+	constexpr auto numFrames = 600;
+
+	std::default_random_engine engine;
+	std::uniform_real_distribution<double> level (0., 1.);
+	std::bernoulli_distribution changed (0.8);
+
+	Trace trace;
+	for (auto f = 0; f < numFrames; ++f)
+	{
+		Frame frame;
+		for (auto row = 0; row < numRows; ++row)
+		{
+			for (auto column = 0; column < numColumns; ++column)
+			{
+				CRect meter (0., 0., meterWidth, meterHeight);
+				meter.offset (column * (meterWidth + spacing),
+							  row * (meterHeight + ledSize + 3. * spacing));
+				if (changed (engine))
+				{
+					// meters only invalidate the part between the old and the new level
+					auto l1 = level (engine) * meterHeight;
+					auto l2 = level (engine) * meterHeight;
+					CRect r (meter.left, meter.bottom - std::max (l1, l2), meter.right,
+							 meter.bottom - std::min (l1, l2));
+					frame.emplace_back (r);
+				}
+				if (changed (engine))
+				{
+					CRect led (0., 0., ledSize, ledSize);
+					led.offset (meter.left + (meterWidth - ledSize) / 2.,
+								meter.bottom + spacing);
+					frame.emplace_back (led);
+				}
+			}
+		}
+		trace.emplace_back (std::move (frame));
+	}
+	return trace;
+}
+
+//------------------------------------------------------------------------
+template<typename List>
+static bool checkCoverage (const Frame& frame, const List& list)
+{
+	for (const auto& r : frame)
+	{
+		auto covered = std::any_of (list.data ().begin (), list.data ().end (),
+									[&] (const auto& lr) { return lr.rectInside (r); });
+		if (!covered)
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+template<typename List, typename JoinProc>
+static bool replay (const char* name, const Trace& trace, int repetitions, JoinProc join)
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	List list;
+	size_t numRects = 0;
+	size_t numResultRects = 0;
+	Clock::duration duration {};
+	for (auto i = 0; i < repetitions; ++i)
+	{
+		for (const auto& frame : trace)
+		{
+			auto start = Clock::now ();
+			for (const auto& r : frame)
+				list.add (r);
+			join (list);
+			duration += Clock::now () - start;
+			if (i == 0)
+			{
+				if (!checkCoverage (frame, list))
+				{
+					printf ("%s: result does not cover all invalid rects\n", name);
+					return false;
+				}
+				numRects += frame.size ();
+				numResultRects += list.data ().size ();
+			}
+			list.clear ();
+		}
+	}
+	auto ms = std::chrono::duration<double, std::milli> (duration).count () / repetitions;
+	printf ("%-10s %10.3f ms per replay, %8.4f ms per frame, %zu rects -> %zu rects\n", name, ms,
+			ms / trace.size (), numRects, numResultRects);
+	return true;
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	Trace trace;
+	if (argc > 1)
+	{
+		if (!readTrace (argv[1], trace))
+		{
+			printf ("Could not read trace file: %s\n", argv[1]);
+			return -1;
+		}
+	}
+	else
+	{
+		trace = makeSyntheticTrace ();
+	}
+	auto repetitions = argc > 2 ? std::max (1, atoi (argv[2])) : 3;
+
+	size_t numRects = 0;
+	for (const auto& frame : trace)
+		numRects += frame.size ();
+	printf ("Replaying %zu frames with %zu invalid rects %d times\n", trace.size (), numRects,
+			repetitions);
+
+	auto success =
+		replay<Legacy::InvalidRectList> ("legacy", trace, repetitions, [] (auto& list) {
+			Legacy::joinNearbyInvalidRects (list, 24.);
+		});
+	success &= replay<CInvalidRectList> ("current", trace, repetitions,
+										 [] (auto& list) { joinNearbyInvalidRects (list, 24.); });
+	return success ? 0 : -1;
+}
@@ -0,0 +1,86 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/pixelbuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace VSTGUI::PixelBuffer;
+
+/*	Measures the throughput of PixelBuffer::convert on a 2048x2048 buffer for every pair of
+	formats, alpha conversion and implementation the processor supports.
+
+	Usage: pixelbufferbench [repetitions]
+*/
+
+//------------------------------------------------------------------------
+using Clock = std::chrono::high_resolution_clock;
+
+//------------------------------------------------------------------------
+template<typename Proc>
+static double measure (int repetitions, Proc proc)
+{
+	Clock::duration duration {};
+	for (auto i = 0; i < repetitions; ++i)
+	{
+		auto start = Clock::now ();
+		proc ();
+		duration += Clock::now () - start;
+	}
+	return std::chrono::duration<double> (duration).count () / repetitions;
+}
+
+//------------------------------------------------------------------------
+static constexpr Implementation implementations[] = {
+	Implementation::Scalar, Implementation::SSSE3, Implementation::AVX2, Implementation::NEON};
+static constexpr Format formats[] = {Format::ARGB, Format::RGBA, Format::ABGR, Format::BGRA};
+static constexpr const char* formatNames[] = {"ARGB", "RGBA", "ABGR", "BGRA"};
+static constexpr const char* alphaNames[] = {"", " + premultiply", " + unpremultiply"};
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	constexpr uint32_t width = 2048;
+	constexpr uint32_t height = 2048;
+	constexpr auto numBytes = width * height * 4;
+
+	auto repetitions = argc > 1 ? std::max (1, atoi (argv[1])) : 3;
+
+	std::vector<uint32_t> pixels (width * height, 0x80406080);
+	auto buffer = reinterpret_cast<uint8_t*> (pixels.data ());
+
+	printf ("Convert %ux%u pixels, %d repetitions\n", width, height, repetitions);
+	for (auto impl : implementations)
+	{
+		if (!setImplementation (impl))
+			continue;
+		for (auto alpha : {Alpha::Keep, Alpha::Premultiply, Alpha::Unpremultiply})
+		{
+			// only the conversions without alpha conversion have SIMD implementations
+			if (alpha != Alpha::Keep && impl != Implementation::Scalar)
+				continue;
+			for (auto src : formats)
+			{
+				for (auto dst : formats)
+				{
+					if (src == dst && alpha == Alpha::Keep)
+						continue;
+					auto seconds = measure (repetitions, [&] () {
+						convert (src, dst, alpha, buffer, width * 4, width, height);
+					});
+					printf ("  %-6s %s -> %s%-16s %8.0f MB/s\n", getImplementationName (impl),
+							formatNames[static_cast<size_t> (src)],
+							formatNames[static_cast<size_t> (dst)],
+							alphaNames[static_cast<size_t> (alpha)],
+							numBytes / seconds / (1024. * 1024.));
+				}
+			}
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,244 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cresourcedescription.h"
+#include "vstgui/lib/cview.h"
+#include "vstgui/lib/vstguiinit.h"
+#include "vstgui/uidescription/detail/uiviewcreatorattributes.h"
+#include "vstgui/uidescription/uiattributes.h"
+#include "vstgui/uidescription/uidescription.h"
+#include "vstgui/uidescription/uiviewfactory.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+using namespace VSTGUI::UIViewCreator;
+
+/*	Compares UIAttributes with the previous storage (an unordered_map of strings) on a
+	description with 2000 views: the memory used by the attributes, the time to look up the
+	attribute names of the view creators, and the time to create the views the first time and
+	again with the cached typed attribute values.
+
+	Usage: uiattributesbench [num-views] [repetitions]
+*/
+
+//------------------------------------------------------------------------
+static std::atomic<size_t> allocatedBytes {0};
+static std::atomic<size_t> numAllocations {0};
+
+//------------------------------------------------------------------------
+void* operator new (size_t size)
+{
+	// the size is stored in front of the block to count the deallocated bytes
+	auto block = static_cast<size_t*> (std::malloc (size + sizeof (std::max_align_t)));
+	if (!block)
+		throw std::bad_alloc ();
+	*block = size;
+	allocatedBytes += size;
+	++numAllocations;
+	return reinterpret_cast<uint8_t*> (block) + sizeof (std::max_align_t);
+}
+
+//------------------------------------------------------------------------
+void operator delete (void* ptr) noexcept
+{
+	if (!ptr)
+		return;
+	auto block = reinterpret_cast<size_t*> (static_cast<uint8_t*> (ptr) - sizeof (std::max_align_t));
+	allocatedBytes -= *block;
+	std::free (block);
+}
+
+//------------------------------------------------------------------------
+void operator delete (void* ptr, size_t) noexcept { operator delete (ptr); }
+
+//------------------------------------------------------------------------
+namespace Legacy {
+
+//------------------------------------------------------------------------
+struct UIAttributes : std::unordered_map<std::string, std::string>
+{
+	const std::string* getAttributeValue (const std::string& name) const
+	{
+		auto it = find (name);
+		return it != end () ? &it->second : nullptr;
+	}
+};
+
+//------------------------------------------------------------------------
+} // Legacy
+
+//------------------------------------------------------------------------
+struct ViewDescription
+{
+	std::vector<std::pair<std::string, std::string>> attributes;
+};
+
+//------------------------------------------------------------------------
+static std::vector<ViewDescription> makeViews (size_t numViews)
+{
+	static const char* classes[] = {"CKnob", "CSlider", "CTextLabel", "COnOffButton",
+	                                "CParamDisplay", "CViewContainer"};
+	std::default_random_engine engine;
+	std::uniform_int_distribution<int> position (0, 500);
+	std::vector<ViewDescription> views (numViews);
+	for (auto i = 0u; i < numViews; ++i)
+	{
+		auto& attributes = views[i].attributes;
+		auto pos = [&] () {
+			return std::to_string (position (engine)) + ", " + std::to_string (position (engine));
+		};
+		attributes.emplace_back (kAttrClass, classes[i % 6]);
+		attributes.emplace_back (kAttrOrigin, pos ());
+		attributes.emplace_back (kAttrSize, pos ());
+		attributes.emplace_back (kAttrTransparent, "true");
+		attributes.emplace_back (kAttrMouseEnabled, "true");
+		attributes.emplace_back (kAttrAutosize, "left top");
+		attributes.emplace_back (kAttrControlTag, "tag" + std::to_string (i % 100));
+		attributes.emplace_back (kAttrDefaultValue, "0.5");
+		attributes.emplace_back (kAttrMinValue, "0");
+		attributes.emplace_back (kAttrMaxValue, "1");
+		attributes.emplace_back (kAttrFontColor, "~ WhiteCColor");
+		attributes.emplace_back (kAttrBackColor, "~ BlackCColor");
+		attributes.emplace_back (kAttrTooltip, "View " + std::to_string (i));
+		attributes.emplace_back (kAttrOpacity, "1");
+	}
+	return views;
+}
+
+//------------------------------------------------------------------------
+static const std::vector<UIAttributeAtom>& lookupNames ()
+{
+	// the names CViewCreator, CControlCreator and CParamDisplayCreator look up
+	static const std::vector<UIAttributeAtom> names = {
+	    kAttrOrigin,      kAttrSize,          kAttrTransparent,     kAttrMouseEnabled,
+	    kAttrWantsFocus,  kAttrBitmap,        kAttrDisabledBitmap,  kAttrAutosize,
+	    kAttrTooltip,     kAttrOpacity,       kAttrCustomViewName,  kAttrSubController,
+	    kAttrControlTag,  kAttrDefaultValue,  kAttrMinValue,        kAttrMaxValue,
+	    kAttrWheelIncValue, kAttrBackgroundOffset, kAttrFont,       kAttrFontColor,
+	    kAttrBackColor,   kAttrFrameColor,    kAttrShadowColor,     kAttrFontAntialias,
+	    kAttrStyle3DIn,   kAttrStyle3DOut,    kAttrStyleNoFrame,    kAttrStyleRoundRect,
+	    kAttrValuePrecision, kAttrTextInset,  kAttrTextAlignment,   kAttrTextRotation};
+	return names;
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+static double measure (int repetitions, Proc proc)
+{
+	using Clock = std::chrono::high_resolution_clock;
+	auto best = Clock::duration::max ();
+	for (auto i = 0; i < repetitions; ++i)
+	{
+		auto start = Clock::now ();
+		proc ();
+		best = std::min (best, Clock::now () - start);
+	}
+	return std::chrono::duration<double, std::milli> (best).count ();
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#else
+	VSTGUI::init (nullptr);
+#endif
+	auto numViews = argc > 1 ? static_cast<size_t> (std::max (1, atoi (argv[1]))) : 2000u;
+	auto repetitions = argc > 2 ? std::max (1, atoi (argv[2])) : 10;
+	auto views = makeViews (numViews);
+	const auto& names = lookupNames ();
+
+	// memory
+	auto startBytes = allocatedBytes.load ();
+	auto startAllocations = numAllocations.load ();
+	std::vector<Legacy::UIAttributes> legacyAttributes (numViews);
+	for (auto i = 0u; i < numViews; ++i)
+	{
+		for (const auto& attr : views[i].attributes)
+			legacyAttributes[i].emplace (attr.first, attr.second);
+	}
+	auto legacyBytes = allocatedBytes.load () - startBytes;
+	auto legacyAllocations = numAllocations.load () - startAllocations;
+
+	startBytes = allocatedBytes.load ();
+	startAllocations = numAllocations.load ();
+	std::vector<SharedPointer<UIAttributes>> attributes (numViews);
+	for (auto i = 0u; i < numViews; ++i)
+	{
+		attributes[i] = makeOwned<UIAttributes> (views[i].attributes.size ());
+		for (const auto& attr : views[i].attributes)
+			attributes[i]->setAttribute (attr.first, attr.second);
+	}
+	auto bytes = allocatedBytes.load () - startBytes;
+	auto allocations = numAllocations.load () - startAllocations;
+
+	printf ("%zu views with %zu attributes each\n", numViews, views[0].attributes.size ());
+	printf ("memory  legacy: %10zu bytes in %8zu allocations\n", legacyBytes, legacyAllocations);
+	printf ("memory  atoms:  %10zu bytes in %8zu allocations\n", bytes, allocations);
+
+	// attribute lookup
+	std::vector<std::string> nameStrings (names.begin (), names.end ());
+	size_t found = 0;
+	auto legacyLookup = measure (repetitions, [&] () {
+		for (const auto& a : legacyAttributes)
+			for (const auto& name : nameStrings)
+				found += a.getAttributeValue (name) ? 1 : 0;
+	});
+	auto stringLookup = measure (repetitions, [&] () {
+		for (const auto& a : attributes)
+			for (const auto& name : nameStrings)
+				found += a->getAttributeValue (name) ? 1 : 0;
+	});
+	auto atomLookup = measure (repetitions, [&] () {
+		for (const auto& a : attributes)
+			for (const auto& name : names)
+				found += a->getAttributeValue (name) ? 1 : 0;
+	});
+	printf ("lookup  legacy: %10.3f ms\n", legacyLookup);
+	printf ("lookup  string: %10.3f ms\n", stringLookup);
+	printf ("lookup  atoms:  %10.3f ms\n", atomLookup);
+
+	// view creation
+	auto description = makeOwned<UIDescription> (CResourceDescription (""));
+	description->parse ();
+	UIViewFactory factory;
+	size_t numCreated = 0;
+	auto createAll = [&] () {
+		numCreated = 0;
+		for (const auto& a : attributes)
+		{
+			if (auto view = factory.createView (*a, description))
+			{
+				++numCreated;
+				view->forget ();
+			}
+		}
+	};
+	// the first time the attribute strings are parsed, afterwards the typed values are cached
+	auto createViewsFirst = measure (1, createAll);
+	auto createViews = measure (repetitions, createAll);
+	printf ("create  first:  %10.3f ms (%zu views)\n", createViewsFirst, numCreated);
+	printf ("create  again:  %10.3f ms (%zu views)\n", createViews, numCreated);
+
+	VSTGUI::exit ();
+	return found > 0 ? 0 : -1;
+}
@@ -0,0 +1,297 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cpoint.h"
+#include "vstgui/uidescription/base64codec.h"
+#include "vstgui/uidescription/cstream.h"
+#include "vstgui/uidescription/detail/uibinarypersistence.h"
+#include "vstgui/uidescription/detail/uijsonpersistence.h"
+#include "vstgui/uidescription/detail/uixmlpersistence.h"
+#include "vstgui/uidescription/uiattributes.h"
+#include "vstgui/uidescription/uicontentprovider.h"
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+
+using namespace VSTGUI;
+using namespace VSTGUI::Detail;
+
+/*	Compares the time to load a UI description from the JSON, XML and binary format.
+
+	Usage: uidescloadbench [uidesc-file] [repetitions]
+
+	Without a file a synthetic description with embedded bitmaps and a few thousand views is
+	used. The binary format creates the views of the templates on first access, so it is measured
+	both for parsing only and for parsing and accessing all nodes.
+*/
+
+//------------------------------------------------------------------------
+static UINode* addNode (UINode* parent, UINode* node)
+{
+	parent->getChildren ().add (node);
+	return node;
+}
+
+//------------------------------------------------------------------------
+static SharedPointer<UIAttributes> makeAttributes (const std::string& name)
+{
+	auto attributes = makeOwned<UIAttributes> ();
+	attributes->setAttribute ("name", name);
+	return attributes;
+}
+
+//------------------------------------------------------------------------
+static void addViews (UINode* parent, int depth, std::default_random_engine& engine)
+{
+	static const char* classes[] = {"CKnob", "CSlider", "CTextLabel", "COnOffButton",
+	                                "CParamDisplay"};
+	std::uniform_int_distribution<int> position (0, 500);
+	auto numChildren = depth == 0 ? 4 : 8;
+	for (auto i = 0; i < numChildren; ++i)
+	{
+		auto attributes = makeOwned<UIAttributes> ();
+		auto isContainer = depth < 2 && i < 2;
+		attributes->setAttribute ("class", isContainer ? "CViewContainer" : classes[i % 5]);
+		attributes->setPointAttribute ("origin", CPoint (position (engine), position (engine)));
+		attributes->setPointAttribute ("size", CPoint (position (engine), position (engine)));
+		attributes->setAttribute ("control-tag", "tag" + std::to_string (position (engine)));
+		attributes->setAttribute ("background-color", "color" + std::to_string (i));
+		attributes->setAttribute ("font", "font" + std::to_string (i));
+		attributes->setBooleanAttribute ("transparent", true);
+		attributes->setDoubleAttribute ("opacity", 1.);
+		auto view = addNode (parent, new UINode ("view", attributes));
+		if (isContainer)
+			addViews (view, depth + 1, engine);
+	}
+}
+
+//------------------------------------------------------------------------
+static SharedPointer<UINode> makeSyntheticDescription ()
+{
+	constexpr auto numBitmaps = 100;
+	constexpr auto bitmapDataSize = 16 * 1024;
+	constexpr auto numColors = 200;
+	constexpr auto numFonts = 50;
+	constexpr auto numTags = 500;
+	constexpr auto numTemplates = 100;
+
+	std::default_random_engine engine;
+	std::uniform_int_distribution<int> byte (0, 255);
+
+	auto root = makeOwned<UINode> ("vstgui-ui-description");
+	root->getAttributes ()->setAttribute ("version", "1");
+	auto bitmaps = addNode (root, new UINode (MainNodeNames::kBitmap, nullptr, true));
+	std::vector<uint8_t> bitmapData (bitmapDataSize);
+	for (auto i = 0; i < numBitmaps; ++i)
+	{
+		auto name = "bitmap" + std::to_string (i);
+		auto attributes = makeAttributes (name);
+		attributes->setAttribute ("path", name + ".png");
+		auto bitmap = addNode (bitmaps, new UIBitmapNode ("bitmap", attributes));
+		for (auto& b : bitmapData)
+			b = static_cast<uint8_t> (byte (engine));
+		auto result = Base64Codec::encode (bitmapData.data (), bitmapData.size ());
+		auto data = addNode (bitmap, new UINode ("data"));
+		data->getAttributes ()->setAttribute ("encoding", "base64");
+		data->getData ().assign (reinterpret_cast<const char*> (result.data.get ()),
+		                         result.dataSize);
+	}
+	auto colors = addNode (root, new UINode (MainNodeNames::kColor, nullptr, true));
+	for (auto i = 0; i < numColors; ++i)
+	{
+		auto attributes = makeAttributes ("color" + std::to_string (i));
+		attributes->setAttribute ("rgba", "#102030ff");
+		addNode (colors, new UIColorNode ("color", attributes));
+	}
+	auto fonts = addNode (root, new UINode (MainNodeNames::kFont));
+	for (auto i = 0; i < numFonts; ++i)
+	{
+		auto attributes = makeAttributes ("font" + std::to_string (i));
+		attributes->setAttribute ("font-name", "Arial");
+		attributes->setIntegerAttribute ("size", 8 + i % 10);
+		addNode (fonts, new UIFontNode ("font", attributes));
+	}
+	auto tags = addNode (root, new UINode (MainNodeNames::kControlTag, nullptr, true));
+	for (auto i = 0; i < numTags; ++i)
+	{
+		auto attributes = makeAttributes ("tag" + std::to_string (i));
+		attributes->setIntegerAttribute ("tag", i);
+		addNode (tags, new UIControlTagNode ("control-tag", attributes));
+	}
+	for (auto i = 0; i < numTemplates; ++i)
+	{
+		auto attributes = makeAttributes ("template" + std::to_string (i));
+		attributes->setAttribute ("class", "CViewContainer");
+		attributes->setPointAttribute ("size", CPoint (800, 600));
+		auto templateNode = addNode (root, new UINode ("template", attributes));
+		addViews (templateNode, 0, engine);
+	}
+	return root;
+}
+
+//------------------------------------------------------------------------
+static SharedPointer<UINode> readDescription (const char* path)
+{
+	if (auto nodes = UIBinaryDescReader::read (path))
+		return nodes;
+	CFileStream stream;
+	if (!stream.open (path, CFileStream::kReadMode | CFileStream::kBinaryMode))
+		return nullptr;
+	InputStreamContentProvider contentProvider (stream);
+	if (auto nodes = UIJsonDescReader::read (contentProvider))
+		return nodes;
+#if VSTGUI_ENABLE_XML_PARSER
+	contentProvider.rewind ();
+	UIXMLParser parser;
+	return parser.parse (&contentProvider);
+#else
+	return nullptr;
+#endif
+}
+
+//------------------------------------------------------------------------
+static size_t countNodes (UINode* node)
+{
+	size_t count = 1;
+	for (auto child : node->getChildren ())
+		count += countNodes (child);
+	return count;
+}
+
+//------------------------------------------------------------------------
+static std::string toString (CMemoryStream& stream)
+{
+	return std::string (reinterpret_cast<const char*> (stream.getBuffer ()),
+	                    static_cast<size_t> (stream.tell ()));
+}
+
+//------------------------------------------------------------------------
+static bool measure (const char* name, size_t dataSize, int repetitions,
+                     const std::function<SharedPointer<UINode> ()>& read)
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	Clock::duration duration {};
+	Clock::duration best = Clock::duration::max ();
+	size_t numNodes = 0;
+	for (auto i = 0; i < repetitions; ++i)
+	{
+		auto start = Clock::now ();
+		auto nodes = read ();
+		auto elapsed = Clock::now () - start;
+		if (!nodes)
+		{
+			printf ("%s: reading failed\n", name);
+			return false;
+		}
+		if (i == 0)
+			numNodes = countNodes (nodes);
+		duration += elapsed;
+		best = std::min (best, elapsed);
+	}
+	auto ms = std::chrono::duration<double, std::milli> (duration).count () / repetitions;
+	auto bestMs = std::chrono::duration<double, std::milli> (best).count ();
+	printf ("%-20s %10.3f ms average, %10.3f ms best, %10zu bytes, %8zu nodes\n", name, ms,
+	        bestMs, dataSize, numNodes);
+	return true;
+}
+
+//------------------------------------------------------------------------
+static std::function<SharedPointer<UINode> ()> fromMemory (
+    const std::string& data, std::function<SharedPointer<UINode> (IContentProvider&)> read)
+{
+	return [&data, read] () {
+		MemoryContentProvider contentProvider (data.data (), static_cast<uint32_t> (data.size ()));
+		return read (contentProvider);
+	};
+}
+
+//------------------------------------------------------------------------
+static SharedPointer<UINode> accessAllNodes (SharedPointer<UINode> nodes)
+{
+	// the binary reader creates the views of the templates on first access
+	if (nodes)
+		countNodes (nodes);
+	return nodes;
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	SharedPointer<UINode> nodes;
+	if (argc > 1)
+	{
+		nodes = readDescription (argv[1]);
+		if (!nodes)
+		{
+			printf ("Could not read uidesc file: %s\n", argv[1]);
+			return -1;
+		}
+	}
+	else
+	{
+		nodes = makeSyntheticDescription ();
+	}
+	auto repetitions = argc > 2 ? std::max (1, atoi (argv[2])) : 10;
+
+	CMemoryStream jsonStream (1024, 1024, false);
+	CMemoryStream binaryStream (1024, 1024, false);
+	if (!UIJsonDescWriter::write (jsonStream, nodes, false) ||
+	    !UIBinaryDescWriter::write (binaryStream, nodes))
+	{
+		printf ("Writing the description failed\n");
+		return -1;
+	}
+	auto json = toString (jsonStream);
+	auto binary = toString (binaryStream);
+	const char* binaryPath = "uidescloadbench.uidesc.bin";
+	{
+		CFileStream fileStream;
+		if (!fileStream.open (binaryPath,
+		                      CFileStream::kWriteMode | CFileStream::kBinaryMode |
+		                          CFileStream::kTruncateMode) ||
+		    fileStream.writeRaw (binary.data (), static_cast<uint32_t> (binary.size ())) !=
+		        binary.size ())
+		{
+			printf ("Could not write %s\n", binaryPath);
+			return -1;
+		}
+	}
+	printf ("Loading %zu nodes %d times\n", countNodes (nodes), repetitions);
+
+	auto success = measure ("json", json.size (), repetitions,
+	                        fromMemory (json, [] (IContentProvider& contentProvider) {
+		                        return UIJsonDescReader::read (contentProvider);
+	                        }));
+#if VSTGUI_ENABLE_XML_PARSER
+	CMemoryStream xmlStream (1024, 1024, false);
+	UIXMLDescWriter xmlWriter;
+	if (xmlWriter.write (xmlStream, nodes))
+	{
+		auto xml = toString (xmlStream);
+		success &= measure ("xml", xml.size (), repetitions,
+		                    fromMemory (xml, [] (IContentProvider& contentProvider) {
+			                    UIXMLParser parser;
+			                    return parser.parse (&contentProvider);
+		                    }));
+	}
+#endif
+	auto readBinary = [] (IContentProvider& contentProvider) {
+		return UIBinaryDescReader::read (contentProvider);
+	};
+	success &= measure ("binary", binary.size (), repetitions, fromMemory (binary, readBinary));
+	success &= measure ("binary all nodes", binary.size (), repetitions,
+	                    fromMemory (binary, [&] (IContentProvider& contentProvider) {
+		                    return accessAllNodes (readBinary (contentProvider));
+	                    }));
+	success &= measure ("binary mapped", binary.size (), repetitions,
+	                    [&] () { return UIBinaryDescReader::read (binaryPath); });
+	success &= measure ("binary mapped all", binary.size (), repetitions,
+	                    [&] () { return accessAllNodes (UIBinaryDescReader::read (binaryPath)); });
+	std::remove (binaryPath);
+	return success ? 0 : -1;
+}
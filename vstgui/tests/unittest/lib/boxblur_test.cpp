@@ -0,0 +1,88 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/detail/boxblur.h"
+#include "../unittests.h"
+#include <cstring>
+#include <random>
+
+namespace VSTGUI {
+
+namespace {
+
+using Implementation = Detail::BoxBlur::Implementation;
+
+//------------------------------------------------------------------------
+struct ImplementationGuard
+{
+	ImplementationGuard () : impl (Detail::BoxBlur::getImplementation ()) {}
+	~ImplementationGuard () noexcept { Detail::BoxBlur::setImplementation (impl); }
+
+	Implementation impl;
+};
+
+//------------------------------------------------------------------------
+template<bool plane0, bool plane1, bool plane2, bool plane3>
+bool sameAsScalar (Implementation impl, int32_t width, int32_t height, int32_t radius)
+{
+	Buffer<uint8_t> source (width * height * 4);
+	std::independent_bits_engine<std::default_random_engine, 8, uint16_t> rbe;
+	for (auto& value : source)
+		value = static_cast<uint8_t> (rbe ());
+	// the filter blurs in place, the components which are not processed stay unchanged
+	Buffer<uint8_t> expected (source.size ());
+	Buffer<uint8_t> result (source.size ());
+	memcpy (expected.data (), source.data (), source.size ());
+	memcpy (result.data (), source.data (), source.size ());
+	Detail::BoxBlur blur;
+
+	Detail::BoxBlur::setImplementation (Implementation::Scalar);
+	blur.process<plane0, plane1, plane2, plane3> (expected.data (), expected.data (), width,
+												  height, radius);
+	Detail::BoxBlur::setImplementation (impl);
+	blur.process<plane0, plane1, plane2, plane3> (result.data (), result.data (), width, height,
+												  radius);
+	return memcmp (expected.data (), result.data (), source.size ()) == 0;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (BoxBlurTest, ScalarIsAlwaysAvailable)
+{
+	EXPECT_TRUE (Detail::BoxBlur::isAvailable (Implementation::Scalar));
+	EXPECT_TRUE (Detail::BoxBlur::isAvailable (Detail::BoxBlur::getImplementation ()));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (BoxBlurTest, ImplementationsMatchScalar)
+{
+	ImplementationGuard guard;
+	for (auto impl : {Implementation::SSE2, Implementation::AVX2, Implementation::NEON})
+	{
+		if (!Detail::BoxBlur::isAvailable (impl))
+			continue;
+		// the widths are not multiples of the vector sizes, so the scalar tail code runs too
+		for (auto radius : {1, 2, 7, 31, 64})
+		{
+			EXPECT_TRUE ((sameAsScalar<true, true, true, true> (impl, 67, 19, radius)));
+			EXPECT_TRUE ((sameAsScalar<false, false, false, true> (impl, 67, 19, radius)));
+			EXPECT_TRUE ((sameAsScalar<true, false, true, false> (impl, 13, 40, radius)));
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (BoxBlurTest, LargeRadiusUsesScalarDivision)
+{
+	ImplementationGuard guard;
+	for (auto impl : {Implementation::SSE2, Implementation::AVX2, Implementation::NEON})
+	{
+		if (!Detail::BoxBlur::isAvailable (impl))
+			continue;
+		EXPECT_TRUE ((sameAsScalar<true, true, true, true> (impl, 40, 8, 2100)));
+	}
+}
+
+} // VSTGUI
@@ -0,0 +1,84 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/platform/linux/cairofont.h"
+#include "../../../lib/platform/linux/linuxstring.h"
+#include "../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+/** sets a small layout cache size and restores the default one */
+struct SmallLayoutCache
+{
+	SmallLayoutCache (size_t maxEntries)
+	{
+		Cairo::Font::setLayoutCacheSize (maxEntries);
+		Cairo::Font::resetLayoutCacheStatistics ();
+	}
+
+	~SmallLayoutCache () noexcept
+	{
+		Cairo::Font::setLayoutCacheSize (Cairo::Font::kDefaultLayoutCacheSize);
+		Cairo::Font::resetLayoutCacheStatistics ();
+	}
+};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoFontTest, LayoutCacheHitsMissesAndEviction)
+{
+	SmallLayoutCache cache (2);
+	{
+		Cairo::Font font ("Arial", 12, 0);
+		LinuxString a ("a");
+		LinuxString b ("b");
+		LinuxString c ("c");
+		auto width = [&] (LinuxString& string) { font.getStringWidth (nullptr, &string); };
+
+		width (a);
+		width (b);
+		width (a);
+		auto statistics = Cairo::Font::getLayoutCacheStatistics ();
+		EXPECT_EQ (statistics.misses, 2u);
+		EXPECT_EQ (statistics.hits, 1u);
+		EXPECT_EQ (statistics.numEntries, 2u);
+
+		// c evicts b, the least recently used layout
+		width (c);
+		width (a);
+		width (b);
+		statistics = Cairo::Font::getLayoutCacheStatistics ();
+		EXPECT_EQ (statistics.misses, 4u);
+		EXPECT_EQ (statistics.hits, 2u);
+		EXPECT_EQ (statistics.numEntries, 2u);
+
+		Cairo::Font::resetLayoutCacheStatistics ();
+		statistics = Cairo::Font::getLayoutCacheStatistics ();
+		EXPECT_EQ (statistics.misses, 0u);
+		EXPECT_EQ (statistics.hits, 0u);
+		EXPECT_EQ (statistics.numEntries, 2u);
+	}
+	// the layouts of a font are removed with the font
+	EXPECT_EQ (Cairo::Font::getLayoutCacheStatistics ().numEntries, 0u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoFontTest, LayoutCacheSizeIsAtLeastOne)
+{
+	SmallLayoutCache cache (0);
+	Cairo::Font font ("Arial", 12, 0);
+	LinuxString a ("a");
+	font.getStringWidth (nullptr, &a);
+	font.getStringWidth (nullptr, &a);
+	auto statistics = Cairo::Font::getLayoutCacheStatistics ();
+	EXPECT_EQ (statistics.misses, 1u);
+	EXPECT_EQ (statistics.hits, 1u);
+	EXPECT_EQ (statistics.numEntries, 1u);
+}
+
+} // VSTGUI
@@ -2,14 +2,39 @@
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
+#include "../../../lib/bitmapcache.h"
 #include "../../../lib/cbitmap.h"
 #include "../../../lib/ccolor.h"
 #include "../../../lib/platform/iplatformbitmap.h"
 #include "../../../lib/platform/platformfactory.h"
 #include "../unittests.h"
+#include <limits>
 
 namespace VSTGUI {
 
+namespace {
+
+//------------------------------------------------------------------------
+class FakePlatformBitmap : public IPlatformBitmap
+{
+public:
+	FakePlatformBitmap (CPoint size, double scaleFactor) : size (size), scaleFactor (scaleFactor) {}
+
+	const CPoint& getSize () const override { return size; }
+	SharedPointer<IPlatformBitmapPixelAccess> lockPixels (bool alphaPremultiplied) override
+	{
+		return nullptr;
+	}
+	void setScaleFactor (double factor) override { scaleFactor = factor; }
+	double getScaleFactor () const override { return scaleFactor; }
+
+private:
+	CPoint size;
+	double scaleFactor;
+};
+
+} // anonymous
+
 //------------------------------------------------------------------------
 TEST_CASE (CBitmap, ScaleFactor)
 {
@@ -91,4 +116,80 @@ TEST_CASE (CBitmap, PixelAccess2)
 	}
 }
 
+//------------------------------------------------------------------------
+TEST_CASE (CBitmap, ReleaseAndReload)
+{
+	BitmapCache::resetStatistics ();
+	auto before = BitmapCache::getStatistics ();
+	uint32_t numReloads1x = 0;
+	uint32_t numReloads2x = 0;
+	PlatformBitmapPtr b1 = makeOwned<FakePlatformBitmap> (CPoint (10, 10), 1.);
+	PlatformBitmapPtr b2 = makeOwned<FakePlatformBitmap> (CPoint (20, 20), 2.);
+	auto bitmap = makeOwned<CBitmap> (b1);
+	EXPECT_TRUE (bitmap->addBitmap (b2));
+	// without a budget the bitmaps are not tracked
+	EXPECT_FALSE (bitmap->setReloadFunction (b1, [] () { return nullptr; }));
+	EXPECT_EQ (BitmapCache::getStatistics ().numResident, before.numResident);
+	BitmapCache::setMemoryBudget (std::numeric_limits<size_t>::max ());
+	EXPECT_TRUE (bitmap->setReloadFunction (b1, [&] () -> PlatformBitmapPtr {
+		++numReloads1x;
+		return makeOwned<FakePlatformBitmap> (CPoint (10, 10), 1.);
+	}));
+	// like a resource loaded again, the reloaded bitmap does not know its scale factor
+	EXPECT_TRUE (bitmap->setReloadFunction (b2, [&] () -> PlatformBitmapPtr {
+		++numReloads2x;
+		return makeOwned<FakePlatformBitmap> (CPoint (20, 20), 1.);
+	}));
+	EXPECT_FALSE (bitmap->setReloadFunction (makeOwned<FakePlatformBitmap> (CPoint (10, 10), 1.),
+											 [] () { return nullptr; }));
+	auto statistics = BitmapCache::getStatistics ();
+	EXPECT_EQ (statistics.numResident, before.numResident + 2);
+	EXPECT_EQ (statistics.residentBytes, before.residentBytes + 2000);
+
+	// bitmaps in use are never released
+	BitmapCache::purge ();
+	EXPECT_EQ (BitmapCache::getStatistics ().numReleased, before.numReleased);
+	b1 = nullptr;
+	b2 = nullptr;
+
+	// the bitmap of the other scale factor is released first
+	EXPECT_EQ (bitmap->getBestPlatformBitmapForScaleFactor (1.)->getScaleFactor (), 1.);
+	BitmapCache::setMemoryBudget (before.residentBytes + 1000);
+	statistics = BitmapCache::getStatistics ();
+	EXPECT_EQ (statistics.evictions, 1u);
+	EXPECT_EQ (statistics.numReleased, before.numReleased + 1);
+	EXPECT_EQ (statistics.residentBytes, before.residentBytes + 400);
+	EXPECT_EQ (bitmap->getSize (), CPoint (10, 10));
+	EXPECT_EQ (numReloads2x, 0u);
+
+	BitmapCache::setMemoryBudget (std::numeric_limits<size_t>::max ());
+	auto reloaded = bitmap->getBestPlatformBitmapForScaleFactor (2.);
+	EXPECT_TRUE (reloaded);
+	EXPECT_EQ (reloaded->getScaleFactor (), 2.);
+	EXPECT_EQ (numReloads2x, 1u);
+	EXPECT_EQ (BitmapCache::getStatistics ().reloads, 1u);
+	reloaded = nullptr;
+
+	// a released bitmap keeps its size and its place
+	BitmapCache::purge ();
+	statistics = BitmapCache::getStatistics ();
+	EXPECT_EQ (statistics.evictions, 3u);
+	EXPECT_EQ (statistics.numReleased, before.numReleased + 2);
+	EXPECT_EQ (statistics.residentBytes, before.residentBytes);
+	EXPECT_EQ (bitmap->getWidth (), 10);
+	EXPECT_EQ (bitmap->getHeight (), 10);
+	EXPECT_EQ (numReloads1x, 0u);
+	EXPECT_EQ (bitmap->getPlatformBitmap ()->getScaleFactor (), 1.);
+	EXPECT_EQ (numReloads1x, 1u);
+	EXPECT_EQ (bitmap->getBestPlatformBitmapForScaleFactor (3.)->getScaleFactor (), 2.);
+	EXPECT_EQ (numReloads2x, 2u);
+
+	bitmap = nullptr;
+	BitmapCache::setMemoryBudget (0);
+	statistics = BitmapCache::getStatistics ();
+	EXPECT_EQ (statistics.numResident, before.numResident);
+	EXPECT_EQ (statistics.numReleased, before.numReleased);
+	EXPECT_EQ (statistics.residentBytes, before.residentBytes);
+}
+
 } // VSTGUI
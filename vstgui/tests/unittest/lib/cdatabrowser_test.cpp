@@ -0,0 +1,176 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cdatabrowser.h"
+#include "../../../lib/idatabrowserdelegate.h"
+#include "../unittests.h"
+#include <algorithm>
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+class TestDelegate : public DataBrowserDelegateAdapter
+{
+public:
+	int32_t dbGetNumRows (CDataBrowser* browser) override { return numRows; }
+	int32_t dbGetNumColumns (CDataBrowser* browser) override { return 1; }
+	CCoord dbGetRowHeight (CDataBrowser* browser) override { return 10; }
+	CCoord dbGetCurrentColumnWidth (int32_t index, CDataBrowser* browser) override { return 100; }
+	void dbDrawCell (CDrawContext* context, const CRect& size, int32_t row, int32_t column,
+	                 int32_t flags, CDataBrowser* browser) override
+	{
+	}
+	void dbSelectionChanged (CDataBrowser* browser) override { ++numSelectionChanged; }
+
+	int32_t numRows {20};
+	uint32_t numSelectionChanged {0};
+};
+
+using Selection = CDataBrowser::Selection;
+
+class TestDataBrowser : public CDataBrowser
+{
+public:
+	using CDataBrowser::CDataBrowser;
+	using CDataBrowser::getMutableSelection;
+};
+
+} // anonymous
+
+TEST_CASE (CDataBrowserTest, SelectAndUnselect)
+{
+	TestDelegate delegate;
+	auto browser = owned (
+	    new CDataBrowser (CRect (0, 0, 100, 100), &delegate, CDataBrowser::kMultiSelectionStyle));
+	EXPECT_EQ (browser->getSelectedRow (), CDataBrowser::kNoSelection);
+	browser->selectRow (2);
+	browser->selectRow (5);
+	browser->selectRow (3);
+	browser->selectRow (5);
+	EXPECT (browser->getSelection () == Selection ({2, 5, 3}));
+	EXPECT_EQ (delegate.numSelectionChanged, 3u);
+	EXPECT_TRUE (browser->isRowSelected (5));
+	EXPECT_FALSE (browser->isRowSelected (4));
+	EXPECT_FALSE (browser->isRowSelected (-1));
+	EXPECT_FALSE (browser->isRowSelected (100));
+
+	browser->unselectRow (5);
+	browser->unselectRow (4);
+	EXPECT_EQ (delegate.numSelectionChanged, 4u);
+	EXPECT_FALSE (browser->isRowSelected (5));
+	EXPECT (browser->getSelection () == Selection ({2, 3}));
+	browser->unselectRow (2);
+	EXPECT_EQ (browser->getSelectedRow (), 3);
+	browser->selectRow (2);
+	EXPECT (browser->getSelection () == Selection ({3, 2}));
+
+	browser->unselectAll ();
+	EXPECT_EQ (delegate.numSelectionChanged, 7u);
+	EXPECT_TRUE (browser->getSelection ().empty ());
+	EXPECT_FALSE (browser->isRowSelected (3));
+	browser->unselectAll ();
+	EXPECT_EQ (delegate.numSelectionChanged, 7u);
+}
+
+TEST_CASE (CDataBrowserTest, SetSelectedRow)
+{
+	TestDelegate delegate;
+	auto browser = owned (new CDataBrowser (CRect (0, 0, 100, 100), &delegate));
+	browser->setSelectedRow (4);
+	EXPECT (browser->getSelection () == Selection ({4}));
+	browser->setSelectedRow (7);
+	EXPECT (browser->getSelection () == Selection ({7}));
+	EXPECT_FALSE (browser->isRowSelected (4));
+	// in single selection style selecting a row replaces the selection
+	browser->selectRow (9);
+	EXPECT (browser->getSelection () == Selection ({9}));
+	browser->setSelectedRow (100);
+	EXPECT_EQ (browser->getSelectedRow (), delegate.numRows - 1);
+	browser->setSelectedRow (CDataBrowser::kNoSelection);
+	EXPECT_TRUE (browser->getSelection ().empty ());
+	EXPECT_FALSE (browser->isRowSelected (delegate.numRows - 1));
+}
+
+TEST_CASE (CDataBrowserTest, ShrinkNumRows)
+{
+	TestDelegate delegate;
+	auto browser = owned (
+	    new CDataBrowser (CRect (0, 0, 100, 100), &delegate, CDataBrowser::kMultiSelectionStyle));
+	browser->selectRow (9);
+	browser->selectRow (1);
+	browser->selectRow (8);
+	auto numSelectionChanged = delegate.numSelectionChanged;
+	delegate.numRows = 5;
+	browser->recalculateLayout (true);
+	EXPECT (browser->getSelection () == Selection ({1}));
+	EXPECT_FALSE (browser->isRowSelected (8));
+	EXPECT_FALSE (browser->isRowSelected (9));
+	EXPECT_EQ (delegate.numSelectionChanged, numSelectionChanged + 1);
+	delegate.numRows = 20;
+	browser->recalculateLayout (true);
+	EXPECT_FALSE (browser->isRowSelected (9));
+	browser->selectRow (9);
+	EXPECT (browser->getSelection () == Selection ({1, 9}));
+}
+
+TEST_CASE (CDataBrowserTest, IsRowSelectedMatchesSelection)
+{
+	TestDelegate delegate;
+	auto browser = owned (
+	    new CDataBrowser (CRect (0, 0, 100, 100), &delegate, CDataBrowser::kMultiSelectionStyle));
+	Selection expected;
+	for (int32_t i = 0; i < 300; ++i)
+	{
+		auto row = (i * 7) % delegate.numRows;
+		auto it = std::find (expected.begin (), expected.end (), row);
+		if (i % 3)
+		{
+			browser->selectRow (row);
+			if (it == expected.end ())
+				expected.push_back (row);
+		}
+		else
+		{
+			browser->unselectRow (row);
+			if (it != expected.end ())
+				expected.erase (it);
+		}
+		for (int32_t r = 0; r < delegate.numRows; ++r)
+		{
+			auto selected = std::find (expected.begin (), expected.end (), r) != expected.end ();
+			EXPECT_EQ (browser->isRowSelected (r), selected);
+		}
+		if (i % 10 == 0)
+			EXPECT (browser->getSelection () == expected);
+	}
+	EXPECT (browser->getSelection () == expected);
+}
+
+TEST_CASE (CDataBrowserTest, SubclassChangesSelection)
+{
+	TestDelegate delegate;
+	auto browser = owned (new TestDataBrowser (CRect (0, 0, 100, 100), &delegate,
+	                                           CDataBrowser::kMultiSelectionStyle));
+	browser->selectRow (2);
+	browser->selectRow (6);
+	browser->unselectRow (2);
+	auto& selection = browser->getMutableSelection ();
+	EXPECT (selection == Selection ({6}));
+	selection.push_back (4);
+	selection.push_back (6);
+	selection.push_back (CDataBrowser::kNoSelection);
+	EXPECT_TRUE (browser->isRowSelected (4));
+	EXPECT_TRUE (browser->isRowSelected (6));
+	EXPECT_FALSE (browser->isRowSelected (2));
+	EXPECT (browser->getSelection () == Selection ({6, 4}));
+	browser->unselectRow (6);
+	EXPECT (browser->getSelection () == Selection ({4}));
+	browser->getMutableSelection ().clear ();
+	EXPECT_FALSE (browser->isRowSelected (4));
+	EXPECT_TRUE (browser->getSelection ().empty ());
+}
+
+} // VSTGUI
@@ -5,6 +5,7 @@
 #include "../../../lib/ccolor.h"
 #include "../../../lib/cframe.h"
 #include "../../../lib/events.h"
+#include "../../../lib/meterfeed.h"
 #include "../unittests.h"
 #include "eventhelpers.h"
 #include "platform_helper.h"
@@ -614,6 +615,43 @@ TEST_CASE (CFrameTest, KeyboardHook)
 	frame->unregisterKeyboardHook (&hook);
 }
 
+TEST_CASE (CFrameTest, CanDrawRectConcurrently)
+{
+	auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+	auto container = new CViewContainer (CRect (50, 50, 100, 100));
+	auto view = new View ();
+	view->setViewSize (CRect (10, 10, 20, 20));
+	container->addView (view);
+	frame->addView (container);
+	auto platformFrameCallback = static_cast<IPlatformFrameCallback*> (frame);
+	EXPECT_FALSE (platformFrameCallback->platformCanDrawRectConcurrently (CRect (0, 0, 100, 100)));
+	frame->setCanDrawConcurrently (true);
+	EXPECT_TRUE (platformFrameCallback->platformCanDrawRectConcurrently (CRect (0, 0, 50, 50)));
+	EXPECT_FALSE (platformFrameCallback->platformCanDrawRectConcurrently (CRect (75, 75, 100, 100)));
+	container->setCanDrawConcurrently (true);
+	EXPECT_TRUE (platformFrameCallback->platformCanDrawRectConcurrently (CRect (75, 75, 100, 100)));
+	EXPECT_FALSE (platformFrameCallback->platformCanDrawRectConcurrently (CRect (65, 65, 75, 75)));
+	EXPECT_FALSE (platformFrameCallback->platformCanDrawRectConcurrently (CRect (0, 0, 100, 100)));
+	view->setVisible (false);
+	EXPECT_TRUE (platformFrameCallback->platformCanDrawRectConcurrently (CRect (0, 0, 100, 100)));
+	view->setVisible (true);
+	view->setCanDrawConcurrently (true);
+	EXPECT_TRUE (platformFrameCallback->platformCanDrawRectConcurrently (CRect (0, 0, 100, 100)));
+	frame->setCanDrawConcurrently (false);
+	EXPECT_FALSE (platformFrameCallback->platformCanDrawRectConcurrently (CRect (0, 0, 50, 50)));
+}
+
+TEST_CASE (CFrameTest, AddMeterFeedTwice)
+{
+	auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+	auto feed = makeOwned<MeterFeed> ();
+	frame->addMeterFeed (feed);
+	frame->addMeterFeed (feed);
+	EXPECT_EQ (feed->getNbReference (), 2);
+	frame->removeMeterFeed (feed);
+	EXPECT_EQ (feed->getNbReference (), 1);
+}
+
 TEST_CASE (CFrameTest, Open)
 {
 	auto platformHandle = UnitTest::PlatformParentHandle::create ();
@@ -47,4 +47,60 @@ TEST_CASE (CInvalidRectListTest, AddMulti)
 	EXPECT_EQ (list.data ().size (), 2u);
 }
 
+TEST_CASE (CInvalidRectListTest, AddManySeparated)
+{
+	CInvalidRectList list;
+	for (auto i = 0; i < 100; ++i)
+		EXPECT_TRUE (list.add (CRect (0, 0, 10, 10).offset ((i % 10) * 20, (i / 10) * 20)));
+	EXPECT_EQ (list.data ().size (), 100u);
+	EXPECT_FALSE (list.add ({42, 42, 48, 48}));
+	EXPECT_EQ (list.data ().size (), 100u);
+}
+
+TEST_CASE (CInvalidRectListTest, AddManyOverlapping)
+{
+	CInvalidRectList list;
+	for (auto i = 0; i < 100; ++i)
+		EXPECT_TRUE (list.add (CRect (0, 0, 20, 10).offset (i * 10, 0)));
+	EXPECT_EQ (list.data ().size (), 1u);
+	EXPECT_EQ (list.data ().front (), CRect (0, 0, 1010, 10));
+}
+
+TEST_CASE (CInvalidRectListTest, AddBigOneWithIndex)
+{
+	CInvalidRectList list;
+	for (auto i = 0; i < 100; ++i)
+		EXPECT_TRUE (list.add (CRect (0, 0, 10, 10).offset ((i % 10) * 20, (i / 10) * 20)));
+	EXPECT_TRUE (list.add ({0, 0, 1000, 1000}));
+	EXPECT_EQ (list.data ().size (), 1u);
+	EXPECT_FALSE (list.add ({500, 500, 600, 600}));
+	EXPECT_EQ (list.data ().size (), 1u);
+}
+
+TEST_CASE (CInvalidRectListTest, EraseWithIndex)
+{
+	CInvalidRectList list;
+	for (auto i = 0; i < 100; ++i)
+		list.add (CRect (0, 0, 10, 10).offset ((i % 10) * 20, (i / 10) * 20));
+	list.erase (list.begin ());
+	EXPECT_EQ (list.data ().size (), 99u);
+	EXPECT_TRUE (list.add ({0, 0, 10, 10}));
+	EXPECT_FALSE (list.add ({180, 180, 190, 190}));
+	EXPECT_EQ (list.data ().size (), 100u);
+}
+
+TEST_CASE (CInvalidRectListTest, JoinNearby)
+{
+	CInvalidRectList list;
+	list.add ({0, 0, 10, 10});
+	list.add ({0, 20, 10, 30});
+	list.add ({20, 0, 30, 30});
+	list.add ({100, 100, 110, 110});
+	joinNearbyInvalidRects (list, 10.);
+	EXPECT_EQ (list.data ().size (), 2u);
+	EXPECT_TRUE (std::find (list.begin (), list.end (), CRect (0, 0, 30, 30)) != list.end ());
+	EXPECT_TRUE (std::find (list.begin (), list.end (), CRect (100, 100, 110, 110)) !=
+				 list.end ());
+}
+
 } // VSTGUI
@@ -3,9 +3,11 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "../../../../lib/controls/clistcontrol.h"
+#include "../../../../lib/coffscreencontext.h"
 #include "../../../../lib/cscrollview.h"
 #include "../../unittests.h"
 #include "../eventhelpers.h"
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -117,6 +119,81 @@ TEST_CASE (CListControlTest, RowRect)
 	}
 }
 
+//------------------------------------------------------------------------
+struct VariableHeightConfigurator : IListControlConfigurator, NonAtomicReferenceCounted
+{
+	static CCoord rowHeight (int32_t row) { return 10. + (row % 3) * 5.; }
+
+	CListControlRowDesc getRowDesc (int32_t row) const override
+	{
+		return {rowHeight (row), CListControlRowDesc::Selectable | CListControlRowDesc::Hoverable};
+	}
+};
+
+//------------------------------------------------------------------------
+struct RecordingDrawer : IListControlDrawer, NonAtomicReferenceCounted
+{
+	void drawBackground (CDrawContext* context, CRect size) override {}
+	void drawRow (CDrawContext* context, CRect size, Row row) override
+	{
+		rows.push_back (row);
+	}
+
+	std::vector<int32_t> rows;
+};
+
+//------------------------------------------------------------------------
+static SharedPointer<CListControl> createVariableHeightListControl (int32_t numRows)
+{
+	auto listControl = makeOwned<CListControl> (CRect (0, 0, 100, 100));
+	listControl->setMin (0.f);
+	listControl->setMax (static_cast<float> (numRows - 1));
+	listControl->setConfigurator (makeOwned<VariableHeightConfigurator> ());
+	listControl->setValue (0.f);
+	return listControl;
+}
+
+TEST_CASE (CListControlTest, VariableHeightRowGeometry)
+{
+	constexpr auto numRows = 100;
+	auto listControl = createVariableHeightListControl (numRows);
+
+	CCoord top = 0.;
+	for (auto row = 0; row < numRows; ++row)
+	{
+		auto height = VariableHeightConfigurator::rowHeight (row);
+		auto rr = listControl->getRowRect (row);
+		EXPECT (rr);
+		EXPECT (*rr == CRect (0, top, 100, top + height));
+		EXPECT_EQ (*listControl->getRowAtPoint ({10., top}), row);
+		EXPECT_EQ (*listControl->getRowAtPoint ({10., top + height - 0.5}), row);
+		top += height;
+	}
+	EXPECT_EQ (listControl->getHeight (), top);
+	EXPECT_FALSE (listControl->getRowAtPoint ({10., top}));
+	EXPECT_FALSE (listControl->getRowRect (numRows));
+}
+
+TEST_CASE (CListControlTest, DrawOnlyRowsInUpdateRect)
+{
+	auto drawer = makeOwned<RecordingDrawer> ();
+	auto drawContext = COffscreenContext::create ({100., 100.});
+
+	auto listControl = createVariableHeightListControl (100);
+	listControl->setDrawer (drawer);
+	// rows 4 to 6 span 55 to 100, the update rect also touches the bottom edge of row 3 and the
+	// top edge of row 7
+	listControl->drawRect (drawContext, CRect (0, 55, 100, 100));
+	EXPECT (drawer->rows == std::vector<int32_t> ({3, 4, 5, 6, 7}));
+
+	drawer->rows.clear ();
+	listControl = createTestListControl (20, 1000);
+	listControl->setDrawer (drawer);
+	CDrawContext::Transform transform (*drawContext, CGraphicsTransform ().translate (0., -1000.));
+	listControl->drawRect (drawContext, CRect (0, 1005, 100, 1035));
+	EXPECT (drawer->rows == std::vector<int32_t> ({50, 51}));
+}
+
 TEST_CASE (CListControlTest, KeyDownOnUnselectableRows)
 {
 	constexpr auto rowHeight = 20;
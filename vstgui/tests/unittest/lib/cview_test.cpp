@@ -11,6 +11,7 @@
 #include "../../../lib/events.h"
 #include "../../../lib/idatapackage.h"
 #include "../../../lib/iviewlistener.h"
+#include "../../../lib/viewdrawcache.h"
 #include "../unittests.h"
 
 #if MAC
@@ -106,6 +107,141 @@ TEST_CASE (CViewTest, MouseEnabledState)
 	EXPECT (v->getMouseEnabled () == true);
 }
 
+TEST_CASE (CViewTest, DrawingCachedState)
+{
+	auto v = owned (new View ());
+	EXPECT (v->isDrawingCached () == false);
+	v->setDrawingCached (true);
+	EXPECT (v->isDrawingCached () == true);
+	v->setDrawingCached (false);
+	EXPECT (v->isDrawingCached () == false);
+}
+
+TEST_CASE (CViewTest, DrawCacheMemoryBudget)
+{
+	ViewDrawCache::purge ();
+	ViewDrawCache::resetStatistics ();
+	EXPECT (ViewDrawCache::getMemoryBudget () == ViewDrawCache::kDefaultMemoryBudget);
+	ViewDrawCache::setMemoryBudget (1024);
+	EXPECT (ViewDrawCache::getMemoryBudget () == 1024);
+	ViewDrawCache::setMemoryBudget (ViewDrawCache::kDefaultMemoryBudget);
+	auto statistics = ViewDrawCache::getStatistics ();
+	EXPECT (statistics.hits == 0);
+	EXPECT (statistics.misses == 0);
+	EXPECT (statistics.evictions == 0);
+	EXPECT (statistics.numEntries == 0);
+	EXPECT (statistics.bytes == 0);
+}
+
+namespace {
+
+class DrawCountingView : public CView
+{
+public:
+	DrawCountingView () : CView (CRect (0, 0, 10, 10)) { setDrawingCached (true); }
+	void draw (CDrawContext* context) override
+	{
+		++numDraws;
+		CView::draw (context);
+	}
+
+	uint32_t numDraws {0};
+};
+
+} // anonymous
+
+TEST_CASE (CViewTest, DrawCacheHitAndMiss)
+{
+	ViewDrawCache::purge ();
+	ViewDrawCache::resetStatistics ();
+	auto v = makeOwned<DrawCountingView> ();
+	auto drawContext = COffscreenContext::create ({100., 100.});
+	ViewDrawCache::drawView (v, drawContext, v->getViewSize ());
+	EXPECT_EQ (v->numDraws, 1u);
+	auto statistics = ViewDrawCache::getStatistics ();
+	EXPECT_EQ (statistics.misses, 1u);
+	EXPECT_EQ (statistics.hits, 0u);
+	EXPECT_EQ (statistics.numEntries, 1u);
+	EXPECT_EQ (statistics.bytes, 10u * 10u * 4u);
+
+	ViewDrawCache::drawView (v, drawContext, v->getViewSize ());
+	EXPECT_EQ (v->numDraws, 1u);
+	statistics = ViewDrawCache::getStatistics ();
+	EXPECT_EQ (statistics.misses, 1u);
+	EXPECT_EQ (statistics.hits, 1u);
+	ViewDrawCache::purge ();
+}
+
+TEST_CASE (CViewTest, DrawCacheEviction)
+{
+	ViewDrawCache::purge ();
+	ViewDrawCache::resetStatistics ();
+	// room for the bitmaps of two 10x10 views
+	ViewDrawCache::setMemoryBudget (2 * 10 * 10 * 4);
+	auto v1 = makeOwned<DrawCountingView> ();
+	auto v2 = makeOwned<DrawCountingView> ();
+	auto v3 = makeOwned<DrawCountingView> ();
+	auto drawContext = COffscreenContext::create ({100., 100.});
+	ViewDrawCache::drawView (v1, drawContext, v1->getViewSize ());
+	ViewDrawCache::drawView (v2, drawContext, v2->getViewSize ());
+	EXPECT_EQ (ViewDrawCache::getStatistics ().evictions, 0u);
+	// the least recently drawn bitmap is released
+	ViewDrawCache::drawView (v1, drawContext, v1->getViewSize ());
+	ViewDrawCache::drawView (v3, drawContext, v3->getViewSize ());
+	auto statistics = ViewDrawCache::getStatistics ();
+	EXPECT_EQ (statistics.evictions, 1u);
+	EXPECT_EQ (statistics.numEntries, 2u);
+	ViewDrawCache::drawView (v1, drawContext, v1->getViewSize ());
+	EXPECT_EQ (v1->numDraws, 1u);
+	ViewDrawCache::drawView (v2, drawContext, v2->getViewSize ());
+	EXPECT_EQ (v2->numDraws, 2u);
+
+	// a view bigger than the budget is drawn directly
+	v3->setViewSize (CRect (0, 0, 20, 20));
+	ViewDrawCache::drawView (v3, drawContext, v3->getViewSize ());
+	ViewDrawCache::drawView (v3, drawContext, v3->getViewSize ());
+	EXPECT_EQ (v3->numDraws, 3u);
+	EXPECT_EQ (ViewDrawCache::getStatistics ().numEntries, 2u);
+
+	// lowering the budget releases bitmaps
+	ViewDrawCache::setMemoryBudget (10 * 10 * 4);
+	statistics = ViewDrawCache::getStatistics ();
+	EXPECT_EQ (statistics.numEntries, 1u);
+	EXPECT_EQ (statistics.bytes, 10u * 10u * 4u);
+	ViewDrawCache::setMemoryBudget (ViewDrawCache::kDefaultMemoryBudget);
+	ViewDrawCache::purge ();
+}
+
+TEST_CASE (CViewTest, DrawCacheInvalidation)
+{
+	ViewDrawCache::purge ();
+	auto v = makeOwned<DrawCountingView> ();
+	auto drawContext = COffscreenContext::create ({100., 100.});
+	ViewDrawCache::drawView (v, drawContext, v->getViewSize ());
+	EXPECT_EQ (v->numDraws, 1u);
+
+	v->invalid ();
+	EXPECT_EQ (ViewDrawCache::getStatistics ().numEntries, 0u);
+	ViewDrawCache::drawView (v, drawContext, v->getViewSize ());
+	EXPECT_EQ (v->numDraws, 2u);
+
+	v->setViewSize (CRect (0, 0, 20, 20));
+	EXPECT_EQ (ViewDrawCache::getStatistics ().numEntries, 0u);
+	ViewDrawCache::drawView (v, drawContext, v->getViewSize ());
+	EXPECT_EQ (v->numDraws, 3u);
+	EXPECT_EQ (ViewDrawCache::getStatistics ().bytes, 20u * 20u * 4u);
+
+	auto drawContext2x = COffscreenContext::create ({100., 100.}, 2.);
+	ViewDrawCache::drawView (v, drawContext2x, v->getViewSize ());
+	EXPECT_EQ (v->numDraws, 4u);
+	EXPECT_EQ (ViewDrawCache::getStatistics ().bytes, 40u * 40u * 4u);
+	ViewDrawCache::drawView (v, drawContext2x, v->getViewSize ());
+	EXPECT_EQ (v->numDraws, 4u);
+
+	v->setDrawingCached (false);
+	EXPECT_EQ (ViewDrawCache::getStatistics ().numEntries, 0u);
+}
+
 TEST_CASE (CViewTest, AutosizeFlags)
 {
 	auto v = owned (new View ());
@@ -3,12 +3,14 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "../../../lib/cframe.h"
+#include "../../../lib/coffscreencontext.h"
 #include "../../../lib/iviewlistener.h"
 #include "../../../lib/ccolor.h"
 #include "../../../lib/dragging.h"
 #include "../../../lib/events.h"
 #include "../unittests.h"
 #include "eventhelpers.h"
+#include <chrono>
 #include <vector>
 
 namespace VSTGUI {
@@ -109,6 +111,36 @@ public:
 	
  };
 
+//------------------------------------------------------------------------
+class DrawRecordingView : public CView
+{
+public:
+	DrawRecordingView (const CRect& size, std::vector<CView*>& drawnViews)
+	: CView (size), drawnViews (drawnViews)
+	{
+	}
+
+	void drawRect (CDrawContext* context, const CRect& updateRect) override
+	{
+		drawnViews.emplace_back (this);
+	}
+
+	std::vector<CView*>& drawnViews;
+};
+
+//------------------------------------------------------------------------
+void addViewGrid (CViewContainer* container, int32_t numColumns, int32_t numRows, CCoord size)
+{
+	for (auto row = 0; row < numRows; ++row)
+	{
+		for (auto column = 0; column < numColumns; ++column)
+		{
+			CRect r (0, 0, size - 2, size - 2);
+			container->addView (new CView (r.offset (column * size, row * size)));
+		}
+	}
+}
+
 } // anonymous
 
 TEST_SUITE_SETUP (CViewContainerTest)
@@ -638,4 +670,217 @@ TEST_CASE (CViewContainerTest, GetContainerAt)
 	EXPECT (res == c1);
 }
 
+TEST_CASE (CViewContainerTest, Copy)
+{
+	auto& container = TEST_SUITE_GET_STORAGE (SharedPointer<CViewContainer>);
+
+	auto c1 = new CViewContainer (CRect (0, 0, 10, 10));
+	c1->addView (new CView (CRect (0, 0, 5, 5)));
+	container->addView (c1);
+	auto copy = owned (static_cast<CViewContainer*> (container->newCopy ()));
+	EXPECT (copy->isSubview () == false);
+	EXPECT (copy->getNbViews () == 1);
+	auto c1Copy = copy->getView (0)->asViewContainer ();
+	EXPECT (c1Copy && c1Copy != c1);
+	EXPECT (c1Copy->isSubview ());
+	EXPECT (c1Copy->getNbViews () == 1);
+	EXPECT (c1Copy->getView (0)->getViewSize () == CRect (0, 0, 5, 5));
+}
+
+TEST_CASE (CViewContainerTest, SpatialIndexFindsSameViews)
+{
+	auto frame = new CFrame (CRect (0, 0, 400, 300), nullptr);
+	auto container = new CViewContainer (CRect (0, 0, 400, 300));
+	addViewGrid (container, 40, 30, 10);
+	container->addView (new CView (CRect (0, 0, 400, 300)), container->getView (0));
+	container->addView (new CView (CRect (95, 95, 205, 155)));
+	container->addView (new CView (CRect (300, 200, 310, 210)), CRect (300, 200, 350, 250));
+	container->getView (12)->setVisible (false);
+	container->getView (13)->setMouseEnabled (false);
+	auto innerContainer = new CViewContainer (CRect (150, 150, 250, 250));
+	innerContainer->setSpatialIndexEnabled (true);
+	addViewGrid (innerContainer, 10, 10, 10);
+	container->addView (innerContainer);
+	frame->addView (container);
+	frame->attached (frame);
+
+	struct Result
+	{
+		CView* view;
+		CViewContainer* viewContainer;
+		CViewContainer::ViewList views;
+		bool hit;
+	};
+	auto query = [&] (CPoint p) {
+		Result result;
+		result.view = container->getViewAt (p, GetViewOptions ().deep ().mouseEnabled ());
+		result.viewContainer = container->getContainerAt (p);
+		container->getViewsAt (p, result.views);
+		result.hit = container->hitTestSubViews (p, MouseDownEvent ());
+		return result;
+	};
+	std::vector<CPoint> points;
+	for (CCoord y = -5.; y < 310.; y += 3.5)
+	{
+		for (CCoord x = -5.; x < 410.; x += 3.5)
+			points.emplace_back (x, y);
+	}
+	std::vector<Result> expected;
+	for (const auto& p : points)
+		expected.emplace_back (query (p));
+
+	container->setSpatialIndexEnabled (true);
+	EXPECT_TRUE (container->getSpatialIndexEnabled ());
+	for (size_t i = 0; i < points.size (); ++i)
+	{
+		auto result = query (points[i]);
+		EXPECT_EQ (result.view, expected[i].view);
+		EXPECT_EQ (result.viewContainer, expected[i].viewContainer);
+		EXPECT (result.views == expected[i].views);
+		EXPECT_EQ (result.hit, expected[i].hit);
+	}
+	frame->close ();
+}
+
+TEST_CASE (CViewContainerTest, SpatialIndexFollowsChildViews)
+{
+	auto frame = new CFrame (CRect (0, 0, 400, 300), nullptr);
+	auto container = new CViewContainer (CRect (0, 0, 400, 300));
+	container->setSpatialIndexEnabled (true);
+	addViewGrid (container, 40, 30, 10);
+	frame->addView (container);
+	frame->attached (frame);
+
+	auto view = container->getView (0);
+	EXPECT_EQ (container->getViewAt (CPoint (1, 1)), view);
+	view->setViewSize (CRect (207, 207, 211, 211));
+	EXPECT_EQ (container->getViewAt (CPoint (1, 1)), nullptr);
+	EXPECT_EQ (container->getViewAt (CPoint (209, 209)), view);
+	view->setViewSize (CRect (-50, 500, -40, 510));
+	EXPECT_EQ (container->getViewAt (CPoint (-45, 505)), view);
+	view->setMouseableArea (CRect (380, 280, 420, 320));
+	EXPECT_EQ (container->getViewAt (CPoint (-45, 505)), nullptr);
+	EXPECT_EQ (container->getViewAt (CPoint (410, 310)), view);
+
+	auto topView = new CView (CRect (100, 100, 110, 110));
+	container->addView (topView);
+	EXPECT_EQ (container->getViewAt (CPoint (101, 101)), topView);
+	container->changeViewZOrder (topView, 0);
+	EXPECT_NE (container->getViewAt (CPoint (101, 101)), topView);
+	auto below = container->getViewAt (CPoint (101, 101));
+	container->removeView (below);
+	EXPECT_EQ (container->getViewAt (CPoint (101, 101)), topView);
+
+	container->setSpatialIndexEnabled (false);
+	EXPECT_FALSE (container->getSpatialIndexEnabled ());
+	EXPECT_EQ (container->getViewAt (CPoint (410, 310)), view);
+	frame->close ();
+}
+
+TEST_CASE (CViewContainerTest, SpatialIndexDrawsSameViews)
+{
+	std::vector<CView*> drawnViews;
+	auto frame = new CFrame (CRect (0, 0, 400, 300), nullptr);
+	auto container = new CViewContainer (CRect (0, 0, 400, 300));
+	container->addView (new DrawRecordingView (CRect (0, 0, 400, 300), drawnViews));
+	for (auto row = 0; row < 30; ++row)
+	{
+		for (auto column = 0; column < 40; ++column)
+		{
+			CRect r (0, 0, 8, 8);
+			r.offset (column * 10, row * 10);
+			container->addView (new DrawRecordingView (r, drawnViews));
+		}
+	}
+	container->addView (new DrawRecordingView (CRect (95, 95, 205, 155), drawnViews));
+	container->getView (12)->setVisible (false);
+	frame->addView (container);
+	frame->attached (frame);
+
+	auto drawContext = COffscreenContext::create ({400., 300.});
+	for (auto updateRect : {CRect (0, 0, 400, 300), CRect (100, 100, 110, 110),
+	                        CRect (95, 95, 96, 96), CRect (-10, -10, 5, 5), CRect (398, 298, 420, 320),
+	                        CRect (8, 8, 10, 10), CRect (150, 20, 390, 80)})
+	{
+		container->setSpatialIndexEnabled (false);
+		drawnViews.clear ();
+		container->drawRect (drawContext, updateRect);
+		auto expected = drawnViews;
+		EXPECT_FALSE (expected.empty ());
+
+		container->setSpatialIndexEnabled (true);
+		drawnViews.clear ();
+		container->drawRect (drawContext, updateRect);
+		EXPECT (drawnViews == expected);
+	}
+	frame->close ();
+}
+
+TEST_CASE (CViewContainerTest, DrawStatistics)
+{
+	std::vector<CView*> drawnViews;
+	auto frame = new CFrame (CRect (0, 0, 400, 300), nullptr);
+	auto container = new CViewContainer (CRect (0, 0, 400, 300));
+	for (auto row = 0; row < 30; ++row)
+	{
+		for (auto column = 0; column < 40; ++column)
+		{
+			CRect r (0, 0, 10, 10);
+			r.offset (column * 10, row * 10);
+			container->addView (new DrawRecordingView (r, drawnViews));
+		}
+	}
+	frame->addView (container);
+	frame->attached (frame);
+
+	auto drawContext = COffscreenContext::create ({400., 300.});
+	frame->resetDrawStatistics ();
+	container->drawRect (drawContext, CRect (101, 101, 109, 109));
+	auto statistics = frame->getDrawStatistics ();
+	EXPECT_EQ (statistics.numVisitedViews, 1200u);
+	EXPECT_EQ (statistics.numDrawnViews, 1u);
+
+	container->setSpatialIndexEnabled (true);
+	frame->resetDrawStatistics ();
+	container->drawRect (drawContext, CRect (101, 101, 109, 109));
+	statistics = frame->getDrawStatistics ();
+	EXPECT (statistics.numVisitedViews < 10u);
+	EXPECT_EQ (statistics.numDrawnViews, 1u);
+	EXPECT_EQ (drawnViews.size (), 2u);
+	EXPECT_EQ (drawnViews[0], drawnViews[1]);
+	frame->close ();
+}
+
+TEST_CASE (CViewContainerTest, HitTestThroughput)
+{
+	using Clock = std::chrono::high_resolution_clock;
+	constexpr auto numPoints = 20000;
+
+	auto frame = new CFrame (CRect (0, 0, 800, 500), nullptr);
+	auto container = new CViewContainer (CRect (0, 0, 800, 500));
+	addViewGrid (container, 40, 25, 20);
+	frame->addView (container);
+	frame->attached (frame);
+
+	auto measure = [&] () {
+		size_t numHits = 0;
+		auto start = Clock::now ();
+		for (auto i = 0; i < numPoints; ++i)
+		{
+			CPoint p ((i * 7919) % 800, (i * 7907) % 500);
+			if (container->getViewAt (p, GetViewOptions ().deep ().mouseEnabled ()))
+				++numHits;
+		}
+		auto seconds = std::chrono::duration<double> (Clock::now () - start).count ();
+		return std::make_pair (seconds / numPoints * 1e9, numHits);
+	};
+	auto linear = measure ();
+	container->setSpatialIndexEnabled (true);
+	auto indexed = measure ();
+	context->print ("getViewAt with %u views: %.0f ns linear, %.0f ns indexed",
+	                container->getNbViews (), linear.first, indexed.first);
+	EXPECT_EQ (linear.second, indexed.second);
+	frame->close ();
+}
+
 } // namespaces
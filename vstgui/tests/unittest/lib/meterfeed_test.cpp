@@ -0,0 +1,236 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cbitmap.h"
+#include "../../../lib/coffscreencontext.h"
+#include "../../../lib/controls/cvumeter.h"
+#include "../../../lib/meterfeed.h"
+#include "../unittests.h"
+#include <atomic>
+#include <thread>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+class TestControl : public CControl
+{
+public:
+	TestControl () : CControl (CRect (0, 0, 10, 10)) {}
+	void draw (CDrawContext* pContext) override {}
+	void invalid () override { ++numInvalidCalls; }
+
+	uint32_t numInvalidCalls {0};
+
+	CLASS_METHODS (TestControl, CControl)
+};
+
+//------------------------------------------------------------------------
+class TestVuMeter : public CVuMeter
+{
+public:
+	TestVuMeter () : CVuMeter (CRect (0, 0, 10, 100), nullptr, nullptr, 10) {}
+	void invalid () override { ++numInvalidCalls; }
+
+	uint32_t numInvalidCalls {0};
+};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (MeterFeedTest, LastValueWins)
+{
+	auto feed = makeOwned<MeterFeed> (16);
+	auto control = makeOwned<TestControl> ();
+	auto meter = feed->addMeter (control);
+	EXPECT_EQ (feed->getMeter (meter), control.get ());
+
+	EXPECT_TRUE (feed->push (meter, 0.2f));
+	EXPECT_TRUE (feed->push (meter, 0.7f));
+	EXPECT_EQ (feed->drain (), 1u);
+	EXPECT_EQ (control->getValue (), 0.7f);
+	EXPECT_EQ (control->numInvalidCalls, 1u);
+
+	EXPECT_EQ (feed->drain (), 0u);
+	EXPECT_TRUE (feed->push (meter, 0.7f));
+	EXPECT_EQ (feed->drain (), 0u);
+	EXPECT_EQ (control->numInvalidCalls, 1u);
+
+	feed->removeMeter (meter);
+	EXPECT_EQ (feed->getMeter (meter), nullptr);
+	EXPECT_TRUE (feed->push (meter, 0.1f));
+	EXPECT_EQ (feed->drain (), 0u);
+	EXPECT_EQ (control->getValue (), 0.7f);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (MeterFeedTest, RecycledMeterIgnoresOldValues)
+{
+	auto feed = makeOwned<MeterFeed> (16);
+	auto control1 = makeOwned<TestControl> ();
+	auto control2 = makeOwned<TestControl> ();
+	auto meter1 = feed->addMeter (control1);
+	EXPECT_TRUE (feed->push (meter1, 0.3f));
+	feed->removeMeter (meter1);
+	auto meter2 = feed->addMeter (control2);
+	EXPECT_NE (meter2, meter1);
+	EXPECT_EQ (feed->getMeter (meter1), nullptr);
+	EXPECT_EQ (feed->getMeter (meter2), control2.get ());
+	// removing the old id again does not remove the new meter
+	feed->removeMeter (meter1);
+	EXPECT_EQ (feed->getMeter (meter2), control2.get ());
+
+	EXPECT_TRUE (feed->push (meter1, 0.4f));
+	EXPECT_EQ (feed->drain (), 0u);
+	EXPECT_EQ (control2->getValue (), 0.f);
+	EXPECT_EQ (control2->numInvalidCalls, 0u);
+	EXPECT_TRUE (feed->push (meter2, 0.5f));
+	EXPECT_EQ (feed->drain (), 1u);
+	EXPECT_EQ (control2->getValue (), 0.5f);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (MeterFeedTest, FullRingBuffer)
+{
+	auto feed = makeOwned<MeterFeed> (5);
+	EXPECT_EQ (feed->getCapacity (), 8u);
+	auto control = makeOwned<TestControl> ();
+	auto meter = feed->addMeter (control);
+	for (auto i = 0; i < 8; ++i)
+		EXPECT_TRUE (feed->push (meter, i / 10.f));
+	EXPECT_FALSE (feed->push (meter, 1.f));
+	feed->drain ();
+	EXPECT_EQ (control->getValue (), 0.7f);
+	EXPECT_TRUE (feed->push (meter, 1.f));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (MeterFeedTest, VuMeterInvalidatesOnLedChanges)
+{
+	auto feed = makeOwned<MeterFeed> ();
+	auto vuMeter = makeOwned<TestVuMeter> ();
+	vuMeter->setDecreaseStepValue (0.01f);
+	auto meter = feed->addMeter (vuMeter);
+	EXPECT_FALSE (vuMeter->wantsIdle ());
+
+	feed->push (meter, 1.f);
+	feed->drain ();
+	EXPECT_EQ (vuMeter->getOldValue (), 1.f);
+	EXPECT_EQ (vuMeter->getNumLitLeds (vuMeter->getOldValue ()), 10);
+	vuMeter->numInvalidCalls = 0;
+	vuMeter->setDirty (false);
+
+	// the display falls in 100 steps, but only the 10 LED changes are drawn
+	feed->push (meter, 0.f);
+	uint32_t numInvalidated = 0;
+	for (auto i = 0; i < 200; ++i)
+		numInvalidated += feed->drain ();
+	EXPECT_EQ (numInvalidated, 10u);
+	EXPECT_EQ (vuMeter->numInvalidCalls, 10u);
+	EXPECT_EQ (vuMeter->getOldValue (), 0.f);
+	EXPECT_EQ (vuMeter->getNumLitLeds (vuMeter->getOldValue ()), 0);
+	EXPECT_FALSE (vuMeter->isDirty ());
+
+	feed->removeMeter (meter);
+	EXPECT_TRUE (vuMeter->wantsIdle ());
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (MeterFeedTest, RemoveRestoresVuMeterIdleState)
+{
+	auto feed = makeOwned<MeterFeed> ();
+	auto vuMeter = makeOwned<TestVuMeter> ();
+	vuMeter->setWantsIdle (false);
+	auto meter = feed->addMeter (vuMeter);
+	EXPECT_FALSE (vuMeter->wantsIdle ());
+	feed->removeMeter (meter);
+	EXPECT_FALSE (vuMeter->wantsIdle ());
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (MeterFeedTest, VuMeterWithoutIdleAndFeedDecaysOnDraw)
+{
+	auto vuMeter = makeOwned<TestVuMeter> ();
+	vuMeter->setOnBitmap (makeOwned<CBitmap> (10., 100.));
+	vuMeter->setDecreaseStepValue (0.5f);
+	vuMeter->setWantsIdle (false);
+	auto drawContext = COffscreenContext::create ({10., 100.});
+
+	vuMeter->setValue (0.f);
+	EXPECT_TRUE (vuMeter->isDirty ());
+	vuMeter->draw (drawContext);
+	EXPECT_EQ (vuMeter->getOldValue (), 0.5f);
+	EXPECT_TRUE (vuMeter->isDirty ());
+	vuMeter->draw (drawContext);
+	EXPECT_EQ (vuMeter->getOldValue (), 0.f);
+	EXPECT_FALSE (vuMeter->isDirty ());
+	vuMeter->setValue (1.f);
+	EXPECT_TRUE (vuMeter->isDirty ());
+	vuMeter->draw (drawContext);
+	EXPECT_EQ (vuMeter->getOldValue (), 1.f);
+
+	// the decay of a fed meter is left to the feed
+	auto feed = makeOwned<MeterFeed> ();
+	auto meter = feed->addMeter (vuMeter);
+	EXPECT_TRUE (vuMeter->isFedByMeterFeed ());
+	vuMeter->setValue (0.f);
+	EXPECT_FALSE (vuMeter->isDirty ());
+	vuMeter->draw (drawContext);
+	EXPECT_EQ (vuMeter->getOldValue (), 1.f);
+	feed->removeMeter (meter);
+	EXPECT_FALSE (vuMeter->isFedByMeterFeed ());
+	EXPECT_TRUE (vuMeter->isDirty ());
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (MeterFeedTest, ProducerThread)
+{
+	constexpr uint32_t numMeters = 4;
+	constexpr uint32_t numValues = 10000;
+
+	auto feed = makeOwned<MeterFeed> (256);
+	SharedPointer<TestControl> controls[numMeters];
+	MeterFeed::MeterID meters[numMeters];
+	for (auto i = 0u; i < numMeters; ++i)
+	{
+		controls[i] = makeOwned<TestControl> ();
+		meters[i] = feed->addMeter (controls[i]);
+	}
+
+	std::atomic<bool> done {false};
+	std::thread producer ([&] () {
+		for (auto value = 1u; value <= numValues; ++value)
+		{
+			for (auto meter : meters)
+			{
+				while (!feed->push (meter, value / static_cast<float> (numValues)))
+					std::this_thread::yield ();
+			}
+		}
+		done = true;
+	});
+
+	// the values of a meter must never go back
+	bool inOrder = true;
+	float lastValue = 0.f;
+	while (true)
+	{
+		auto finished = done.load ();
+		feed->drain ();
+		auto value = controls[0]->getValue ();
+		if (value < lastValue)
+			inOrder = false;
+		lastValue = value;
+		if (finished)
+			break;
+	}
+	producer.join ();
+
+	EXPECT_TRUE (inOrder);
+	for (auto& control : controls)
+		EXPECT_EQ (control->getValue (), 1.f);
+}
+
+} // VSTGUI
@@ -3,7 +3,11 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "../../../lib/pixelbuffer.h"
+#include "../../../lib/vstguibase.h"
 #include "../unittests.h"
+#include <algorithm>
+#include <array>
+#include <vector>
 
 namespace VSTGUI {
 using namespace PixelBuffer;
@@ -92,4 +96,155 @@ TEST_CASE (PixelBufferTest, BGRA_2_ARGB)
 	EXPECT (pixel == 0x44332211);
 }
 
+namespace {
+
+//------------------------------------------------------------------------
+/** the bytes of a pixel in memory, see PixelBuffer::Format */
+std::array<uint8_t, 4> makePixel (Format format, uint8_t a, uint8_t r, uint8_t g, uint8_t b)
+{
+	std::array<uint8_t, 4> components {};
+	switch (format)
+	{
+		case Format::ARGB: components = {{a, r, g, b}}; break;
+		case Format::RGBA: components = {{r, g, b, a}}; break;
+		case Format::ABGR: components = {{a, b, g, r}}; break;
+		case Format::BGRA: components = {{b, g, r, a}}; break;
+	}
+	if (ByteOrder::kNativeByteOrder == ByteOrder::kLittleEndianByteOrder)
+		std::reverse (components.begin (), components.end ());
+	return components;
+}
+
+//------------------------------------------------------------------------
+/** the format with the bytes in reverse order */
+Format reversed (Format format)
+{
+	switch (format)
+	{
+		case Format::ARGB: return Format::BGRA;
+		case Format::RGBA: return Format::ABGR;
+		case Format::ABGR: return Format::RGBA;
+		case Format::BGRA: return Format::ARGB;
+	}
+	return format;
+}
+
+} // anonymous
+
+TEST_CASE (PixelBufferTest, Premultiply)
+{
+	for (auto format : {Format::ARGB, Format::RGBA, Format::ABGR, Format::BGRA})
+	{
+		auto pixel = makePixel (format, 0x80, 0xFF, 0x40, 0x00);
+		premultiply (format, pixel.data (), 4, 1, 1);
+		EXPECT (pixel == makePixel (format, 0x80, 0x80, 0x20, 0x00));
+	}
+}
+
+TEST_CASE (PixelBufferTest, Unpremultiply)
+{
+	for (auto format : {Format::ARGB, Format::RGBA, Format::ABGR, Format::BGRA})
+	{
+		auto pixel = makePixel (format, 0x80, 0x80, 0x20, 0x00);
+		unpremultiply (format, pixel.data (), 4, 1, 1);
+		EXPECT (pixel == makePixel (format, 0x80, 0xFF, 0x40, 0x00));
+
+		// a transparent pixel is left as it is
+		pixel = makePixel (format, 0x00, 0x10, 0x20, 0x30);
+		unpremultiply (format, pixel.data (), 4, 1, 1);
+		EXPECT (pixel == makePixel (format, 0x00, 0x10, 0x20, 0x30));
+	}
+}
+
+TEST_CASE (PixelBufferTest, ConvertAndPremultiplyKnownPixels)
+{
+	for (auto src : {Format::ARGB, Format::RGBA, Format::ABGR, Format::BGRA})
+	{
+		auto dst = reversed (src);
+		auto pixel = makePixel (src, 0x80, 0xFF, 0x40, 0x00);
+		convert (src, dst, Alpha::Premultiply, pixel.data (), 4, 1, 1);
+		EXPECT (pixel == makePixel (dst, 0x80, 0x80, 0x20, 0x00));
+
+		pixel = makePixel (src, 0x80, 0x80, 0x20, 0x00);
+		convert (src, dst, Alpha::Unpremultiply, pixel.data (), 4, 1, 1);
+		EXPECT (pixel == makePixel (dst, 0x80, 0xFF, 0x40, 0x00));
+
+		pixel = makePixel (src, 0x80, 0xFF, 0x40, 0x00);
+		convert (src, dst, Alpha::Keep, pixel.data (), 4, 1, 1);
+		EXPECT (pixel == makePixel (dst, 0x80, 0xFF, 0x40, 0x00));
+	}
+}
+
+TEST_CASE (PixelBufferTest, ARGB_2_BGRA_Premultiply)
+{
+	// 0x80FF0000 becomes 0x00008080 on a little endian processor
+	auto pixel = makePixel (Format::ARGB, 0x80, 0xFF, 0x00, 0x00);
+	convert (Format::ARGB, Format::BGRA, Alpha::Premultiply, pixel.data (), 4, 1, 1);
+	EXPECT (pixel == makePixel (Format::BGRA, 0x80, 0x80, 0x00, 0x00));
+}
+
+TEST_CASE (PixelBufferTest, PremultiplyRoundTrip)
+{
+	std::vector<uint32_t> pixels (256 * 256);
+	for (auto a = 0u; a < 256; ++a)
+	{
+		for (auto c = 0u; c < 256; ++c)
+		{
+			auto p = reinterpret_cast<uint8_t*> (&pixels[a * 256 + c]);
+			auto value = static_cast<uint8_t> (c * a / 255);
+			auto pixel = makePixel (Format::ARGB, static_cast<uint8_t> (a), value, value, value);
+			std::copy (pixel.begin (), pixel.end (), p);
+		}
+	}
+	auto original = pixels;
+	auto buffer = reinterpret_cast<uint8_t*> (pixels.data ());
+	unpremultiply (Format::ARGB, buffer, 256 * 4, 256, 256);
+	premultiply (Format::ARGB, buffer, 256 * 4, 256, 256);
+	EXPECT (pixels == original);
+}
+
+TEST_CASE (PixelBufferTest, ConvertAndPremultiply)
+{
+	uint32_t pixel = 0x11223344;
+	uint32_t expected = pixel;
+	premultiply (Format::ARGB, reinterpret_cast<uint8_t*> (&expected), 4, 1, 1);
+	convert (Format::ARGB, Format::BGRA, reinterpret_cast<uint8_t*> (&expected), 4, 1, 1);
+	convert (Format::ARGB, Format::BGRA, Alpha::Premultiply, reinterpret_cast<uint8_t*> (&pixel), 4,
+			 1, 1);
+	EXPECT_EQ (pixel, expected);
+}
+
+TEST_CASE (PixelBufferTest, ImplementationsMatchScalar)
+{
+	constexpr uint32_t width = 37;
+	constexpr uint32_t height = 5;
+	// the rows are padded, the padding must stay untouched
+	constexpr uint32_t bytesPerRow = width * 4 + 12;
+
+	std::vector<uint8_t> source (bytesPerRow * height);
+	for (auto i = 0u; i < source.size (); ++i)
+		source[i] = static_cast<uint8_t> (i * 7 + 3);
+
+	auto previous = getImplementation ();
+	for (auto impl : {Implementation::SSSE3, Implementation::AVX2, Implementation::NEON})
+	{
+		if (!isAvailable (impl))
+			continue;
+		for (auto src : {Format::ARGB, Format::RGBA, Format::ABGR, Format::BGRA})
+		{
+			for (auto dst : {Format::ARGB, Format::RGBA, Format::ABGR, Format::BGRA})
+			{
+				auto expected = source;
+				EXPECT_TRUE (setImplementation (Implementation::Scalar));
+				convert (src, dst, expected.data (), bytesPerRow, width, height);
+				auto result = source;
+				EXPECT_TRUE (setImplementation (impl));
+				convert (src, dst, result.data (), bytesPerRow, width, height);
+				EXPECT (result == expected);
+			}
+		}
+	}
+	setImplementation (previous);
+}
+
 } // namespace VSTGUI
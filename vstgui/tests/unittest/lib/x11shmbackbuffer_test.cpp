@@ -0,0 +1,134 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/platform/linux/x11shmbackbuffer.h"
+#include "../unittests.h"
+#include <cstdlib>
+#include <xcb/xcb.h>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+/** a pixmap on the X server of the DISPLAY environment variable, for example an Xvfb server */
+struct TestPixmap
+{
+	static constexpr uint16_t width = 16;
+	static constexpr uint16_t height = 8;
+
+	TestPixmap ()
+	{
+		if (!std::getenv ("DISPLAY"))
+			return;
+		int screenNumber = 0;
+		connection = xcb_connect (nullptr, &screenNumber);
+		if (xcb_connection_has_error (connection))
+			return;
+		auto it = xcb_setup_roots_iterator (xcb_get_setup (connection));
+		for (; it.rem && screenNumber > 0; --screenNumber)
+			xcb_screen_next (&it);
+		if (!it.rem)
+			return;
+		pixmap = xcb_generate_id (connection);
+		xcb_create_pixmap (connection, it.data->root_depth, pixmap, it.data->root, width, height);
+	}
+
+	~TestPixmap () noexcept
+	{
+		if (pixmap)
+			xcb_free_pixmap (connection, pixmap);
+		if (connection)
+			xcb_disconnect (connection);
+	}
+
+	uint32_t getPixel (int16_t x, int16_t y) const
+	{
+		auto cookie = xcb_get_image (connection, XCB_IMAGE_FORMAT_Z_PIXMAP, pixmap, x, y, 1, 1,
+									 0xffffffff);
+		auto reply = xcb_get_image_reply (connection, cookie, nullptr);
+		if (!reply)
+			return 0;
+		uint32_t pixel = 0;
+		if (xcb_get_image_data_length (reply) >= 4)
+		{
+			auto data = xcb_get_image_data (reply);
+			auto lsbFirst = xcb_get_setup (connection)->image_byte_order == XCB_IMAGE_ORDER_LSB_FIRST;
+			for (auto i = 0; i < 4; ++i)
+				pixel |= static_cast<uint32_t> (data[lsbFirst ? i : 3 - i]) << (i * 8);
+		}
+		free (reply);
+		return pixel & 0x00ffffff;
+	}
+
+	xcb_connection_t* connection {nullptr};
+	xcb_pixmap_t pixmap {0};
+};
+
+//------------------------------------------------------------------------
+void fillRect (const Cairo::SurfaceHandle& surface, const CRect& r, double red, double green,
+			   double blue)
+{
+	auto cr = cairo_create (surface);
+	cairo_set_source_rgb (cr, red, green, blue);
+	cairo_rectangle (cr, r.left, r.top, r.getWidth (), r.getHeight ());
+	cairo_fill (cr);
+	cairo_destroy (cr);
+}
+
+//------------------------------------------------------------------------
+CInvalidRectList makeRectList (const CRect& r)
+{
+	CInvalidRectList list;
+	list.add (r);
+	return list;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (X11ShmBackBuffer, PresentCopiesOnlyTheRects)
+{
+	TestPixmap target;
+	if (!target.pixmap)
+		return; // no X server
+	auto backBuffer = X11::ShmBackBuffer::create (target.connection, target.pixmap,
+												  {TestPixmap::width, TestPixmap::height});
+	if (!backBuffer)
+		return; // no shared memory images or another pixel layout
+	fillRect (backBuffer->getSurface (), {0, 0, TestPixmap::width, TestPixmap::height}, 0., 0.,
+			  1.);
+	backBuffer->present (makeRectList ({0, 0, TestPixmap::width, TestPixmap::height}));
+	backBuffer->waitUntilPresented ();
+	EXPECT_EQ (target.getPixel (0, 0), 0x0000ffu);
+	EXPECT_EQ (target.getPixel (12, 4), 0x0000ffu);
+
+	fillRect (backBuffer->getSurface (), {0, 0, TestPixmap::width, TestPixmap::height}, 1., 0.,
+			  0.);
+	backBuffer->present (makeRectList ({8, 0, TestPixmap::width, TestPixmap::height}));
+	backBuffer->waitUntilPresented ();
+	EXPECT_EQ (target.getPixel (0, 0), 0x0000ffu);
+	EXPECT_EQ (target.getPixel (12, 4), 0xff0000u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (X11ShmBackBuffer, PresentTwiceWithoutWaiting)
+{
+	TestPixmap target;
+	if (!target.pixmap)
+		return; // no X server
+	auto backBuffer = X11::ShmBackBuffer::create (target.connection, target.pixmap,
+												  {TestPixmap::width, TestPixmap::height});
+	if (!backBuffer)
+		return;
+	CRect all (0, 0, TestPixmap::width, TestPixmap::height);
+	fillRect (backBuffer->getSurface (), all, 0., 1., 0.);
+	backBuffer->present (makeRectList (all));
+	// the second present collects the reply of the first one
+	backBuffer->present (makeRectList (all));
+	backBuffer = nullptr;
+	EXPECT_EQ (target.getPixel (3, 3), 0x00ff00u);
+}
+
+} // VSTGUI
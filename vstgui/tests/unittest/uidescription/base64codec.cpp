@@ -3,8 +3,12 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "../../../uidescription/base64codec.h"
+#include "../../../uidescription/cstream.h"
 #include "../unittests.h"
+#include <cstring>
+#include <random>
 #include <string>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -72,4 +76,80 @@ TEST_CASE (Base64CodecTest, DecodeBinary)
 	EXPECT (ptr[5] == 0x0A);
 }
 
+TEST_CASE (Base64CodecTest, EncodeShortData)
+{
+	std::string test ("AB");
+	auto empty = Base64Codec::encode (test.data (), 0);
+	EXPECT (empty.dataSize == 0);
+	auto oneByte = Base64Codec::encode (test.data (), 1);
+	EXPECT (oneByte.dataSize == 4);
+	EXPECT (std::string (reinterpret_cast<const char*> (oneByte.data.get ()), 4) == "QQ==");
+	auto twoBytes = Base64Codec::encode (test.data (), 2);
+	EXPECT (twoBytes.dataSize == 4);
+	EXPECT (std::string (reinterpret_cast<const char*> (twoBytes.data.get ()), 4) == "QUI=");
+}
+
+TEST_CASE (Base64CodecTest, StreamingDecoder)
+{
+	std::mt19937 random (42);
+	std::vector<uint8_t> data (1000);
+	for (auto& byte : data)
+		byte = static_cast<uint8_t> (random ());
+	auto encoded = Base64Codec::encode (data.data (), data.size ());
+
+	std::vector<uint8_t> decoded (Base64Codec::getMaxDecodedSize (encoded.dataSize));
+	Base64Codec::Decoder decoder;
+	size_t numBytes = 0;
+	for (size_t pos = 0; pos < encoded.dataSize;)
+	{
+		auto size = std::min<size_t> (random () % 50, encoded.dataSize - pos);
+		numBytes += decoder.decode (encoded.data.get () + pos, size, decoded.data () + numBytes);
+		pos += size;
+	}
+	numBytes += decoder.finish (decoded.data () + numBytes);
+	EXPECT (numBytes == data.size ());
+	EXPECT (std::memcmp (decoded.data (), data.data (), data.size ()) == 0);
+}
+
+TEST_CASE (Base64CodecTest, DecodeIntoStream)
+{
+	std::string test ("iVBORw0K");
+	CMemoryStream stream;
+	EXPECT (Base64Codec::decode (test.data (), test.size (), stream));
+	EXPECT (stream.tell () == 6);
+	auto ptr = reinterpret_cast<const uint8_t*> (stream.getBuffer ());
+	EXPECT (ptr[0] == 0x89);
+	EXPECT (ptr[1] == 0x50);
+	EXPECT (ptr[5] == 0x0A);
+}
+
+TEST_CASE (Base64CodecTest, ImplementationsAreEqual)
+{
+	std::mt19937 random (7);
+	std::vector<uint8_t> data (4099);
+	for (auto& byte : data)
+		byte = static_cast<uint8_t> (random ());
+
+	auto implementation = Base64Codec::getImplementation ();
+	for (auto size : {0u, 1u, 2u, 3u, 47u, 48u, 100u, 1000u, 4099u})
+	{
+		EXPECT (Base64Codec::setImplementation (Base64Codec::Implementation::Scalar));
+		auto reference = Base64Codec::encode (data.data (), size);
+		for (auto impl : {Base64Codec::Implementation::SSSE3, Base64Codec::Implementation::AVX2,
+						  Base64Codec::Implementation::NEON})
+		{
+			if (!Base64Codec::setImplementation (impl))
+				continue;
+			auto encoded = Base64Codec::encode (data.data (), size);
+			EXPECT (encoded.dataSize == reference.dataSize);
+			EXPECT (size == 0 || std::memcmp (encoded.data.get (), reference.data.get (),
+											  encoded.dataSize) == 0);
+			auto decoded = Base64Codec::decode (encoded.data.get (), encoded.dataSize);
+			EXPECT (decoded.dataSize == size);
+			EXPECT (size == 0 || std::memcmp (decoded.data.get (), data.data (), size) == 0);
+		}
+	}
+	Base64Codec::setImplementation (implementation);
+}
+
 }
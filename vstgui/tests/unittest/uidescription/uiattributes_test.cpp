@@ -37,6 +37,105 @@ TEST_CASE (UIAttributesTest, RemoveAttribute)
 	EXPECT (a.hasAttribute ("Key") == false);
 }
 
+TEST_CASE (UIAttributesTest, AtomAccess)
+{
+	UIAttributeAtom key ("AtomKey");
+	UIAttributes a;
+	a.setAttribute (key, "Value");
+	EXPECT (a.hasAttribute (key));
+	EXPECT (a.hasAttribute ("AtomKey"));
+	EXPECT (*a.getAttributeValue (key) == "Value");
+	a.setAttribute ("AtomKey", "Value2");
+	EXPECT (*a.getAttributeValue (key) == "Value2");
+	a.removeAttribute (key);
+	EXPECT (a.hasAttribute ("AtomKey") == false);
+}
+
+TEST_CASE (UIAttributesTest, AtomInterning)
+{
+	UIAttributeAtom a1 ("InternedName");
+	UIAttributeAtom a2 (std::string ("InternedName"));
+	EXPECT (a1 == a2);
+	EXPECT (a1.getID () == a2.getID ());
+	EXPECT (a1 == "InternedName");
+	EXPECT (std::string ("InternedName") == a1);
+	EXPECT (UIAttributeAtom::find ("InternedName") == a1);
+	EXPECT (UIAttributeAtom::find ("NeverInternedName").isValid () == false);
+	UIAttributes a;
+	EXPECT (a.getAttributeValue ("NeverInternedName") == nullptr);
+	EXPECT (UIAttributeAtom::find ("NeverInternedName").isValid () == false);
+}
+
+TEST_CASE (UIAttributesTest, Iteration)
+{
+	UIAttributes a;
+	a.setAttribute ("K3", "V3");
+	a.setAttribute ("K1", "V1");
+	a.setAttribute ("K2", "V2");
+	a.setAttribute ("K1", "V4");
+	size_t count = 0;
+	for (const auto& attr : a)
+	{
+		EXPECT (*a.getAttributeValue (attr.first) == attr.second);
+		++count;
+	}
+	EXPECT (count == 3);
+}
+
+TEST_CASE (UIAttributesTest, CachedTypedValues)
+{
+	UIAttributes a;
+	a.setAttribute ("origin", "10, 20");
+	a.setAttribute ("size", "30, 40, 50, 60");
+	CPoint p;
+	EXPECT (a.getPointAttribute ("origin", p) && p == CPoint (10, 20));
+	EXPECT (a.getPointAttribute ("origin", p) && p == CPoint (10, 20));
+	// the same value can be read as another type
+	CRect r;
+	EXPECT (a.getRectAttribute ("origin", r) == false);
+	EXPECT (a.getRectAttribute ("size", r) && r == CRect (30, 40, 50, 60));
+	// inserting an attribute in front keeps the cached values in order
+	a.setAttribute ("background", "1");
+	double d;
+	EXPECT (a.getDoubleAttribute ("background", d) && d == 1.);
+	EXPECT (a.getRectAttribute ("size", r) && r == CRect (30, 40, 50, 60));
+	// changing a value invalidates its cached value
+	a.setAttribute ("origin", "5, 6");
+	EXPECT (a.getPointAttribute ("origin", p) && p == CPoint (5, 6));
+	a.setAttribute ("origin", "invalid");
+	EXPECT (a.getPointAttribute ("origin", p) == false);
+	a.removeAttribute ("background");
+	EXPECT (a.getRectAttribute ("size", r) && r == CRect (30, 40, 50, 60));
+	int32_t i;
+	EXPECT (a.getIntegerAttribute ("background", i) == false);
+	a.removeAll ();
+	EXPECT (a.getRectAttribute ("size", r) == false);
+}
+
+TEST_CASE (UIAttributesTest, ParsedAttribute)
+{
+	UIAttributes a;
+	a.setAttribute ("size", "30, 40, 50, 60");
+	// the getter uses the parsed value instead of parsing the string
+	a.setParsedAttribute (UIAttributeAtom ("origin"), "10, 20", UIAttributes::ParsedType::Point,
+	                      {1., 2., 0., 0.});
+	CPoint p;
+	EXPECT (a.getPointAttribute ("origin", p) && p == CPoint (1, 2));
+	EXPECT (*a.getAttributeValue ("origin") == "10, 20");
+	CRect r;
+	EXPECT (a.getRectAttribute ("size", r) && r == CRect (30, 40, 50, 60));
+	// a getter of another type parses the string
+	EXPECT (a.getRectAttribute ("origin", r) == false);
+	a.setParsedAttribute (UIAttributeAtom ("value"), "1", UIAttributes::ParsedType::Integer,
+	                      {1., 0., 0., 0.});
+	double d;
+	EXPECT (a.getDoubleAttribute ("value", d) && d == 1.);
+	a.setParsedAttribute (UIAttributeAtom ("title"), "text", UIAttributes::ParsedType::None,
+	                      {0., 0., 0., 0.});
+	EXPECT (*a.getAttributeValue ("title") == "text");
+	EXPECT (a.getPointAttribute ("origin", p) && p == CPoint (1, 2));
+}
+
 TEST_CASE (UIAttributesTest, BoolAttribute)
 {
 	UIAttributes a;
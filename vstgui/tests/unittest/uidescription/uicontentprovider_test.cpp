@@ -0,0 +1,92 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../uidescription/uicontentprovider.h"
+#include "../unittests.h"
+#include <string>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+struct CountingContentProvider : MemoryContentProvider
+{
+	using MemoryContentProvider::MemoryContentProvider;
+
+	uint32_t readRawData (int8_t* buffer, uint32_t size) override
+	{
+		++numReads;
+		return MemoryContentProvider::readRawData (buffer, size);
+	}
+	void rewind () override
+	{
+		++numRewinds;
+		MemoryContentProvider::rewind ();
+	}
+
+	uint32_t numReads {0};
+	uint32_t numRewinds {0};
+};
+
+constexpr auto content = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+//------------------------------------------------------------------------
+std::string readString (IContentProvider& provider, uint32_t size)
+{
+	std::string result (size, 0);
+	auto numRead = provider.readRawData (reinterpret_cast<int8_t*> (&result[0]), size);
+	result.resize (numRead);
+	return result;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (BufferedContentProviderTest, PeekDoesNotConsume)
+{
+	CountingContentProvider source (content, static_cast<uint32_t> (strlen (content)));
+	BufferedContentProvider provider (source, 16);
+	const int8_t* data;
+	EXPECT (provider.peek (data, 4) == 4);
+	EXPECT (memcmp (data, "0123", 4) == 0);
+	EXPECT (readString (provider, 6) == "012345");
+	EXPECT (source.numReads == 1);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (BufferedContentProviderTest, ReadAcrossBuffer)
+{
+	CountingContentProvider source (content, static_cast<uint32_t> (strlen (content)));
+	BufferedContentProvider provider (source, 16);
+	EXPECT (readString (provider, 10) == "0123456789");
+	EXPECT (readString (provider, 10) == "abcdefghij");
+	EXPECT (readString (provider, 100) == "klmnopqrstuvwxyz");
+	EXPECT (readString (provider, 1).empty ());
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (BufferedContentProviderTest, RewindWithinBuffer)
+{
+	CountingContentProvider source (content, static_cast<uint32_t> (strlen (content)));
+	BufferedContentProvider provider (source, 64);
+	EXPECT (readString (provider, 10) == "0123456789");
+	provider.rewind ();
+	EXPECT (source.numRewinds == 0);
+	EXPECT (readString (provider, 4) == "0123");
+	EXPECT (source.numReads == 1);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (BufferedContentProviderTest, RewindAfterBuffer)
+{
+	CountingContentProvider source (content, static_cast<uint32_t> (strlen (content)));
+	BufferedContentProvider provider (source, 8);
+	EXPECT (readString (provider, 20) == "0123456789abcdefghij");
+	provider.rewind ();
+	EXPECT (source.numRewinds == 1);
+	EXPECT (readString (provider, 4) == "0123");
+}
+
+} // VSTGUI
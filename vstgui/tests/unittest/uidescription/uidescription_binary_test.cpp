@@ -0,0 +1,238 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/ccolor.h"
+#include "../../../uidescription/base64codec.h"
+#include "../../../uidescription/detail/uibinarypersistence.h"
+#include "../../../uidescription/uiattributes.h"
+#include "../../../uidescription/uicontentprovider.h"
+#include "uidescription_test_helper.h"
+
+namespace VSTGUI {
+using namespace UIDescriptionTesting;
+
+namespace {
+
+//------------------------------------------------------------------------
+constexpr auto allNodesUIDesc = R"(
+{
+	"vstgui-ui-description": {
+		"version": "1",
+		"variables": {
+			"v1": "10",
+			"v2": "string"
+		},
+		"bitmaps": {
+			"b1": {
+				"path": "b1.png"
+			}
+		},
+		"fonts": {
+			"f1": {
+				"font-name": "Arial",
+				"size": "8"
+			}
+		},
+		"colors": {
+			"c1": "#000000ff",
+			"c2": "#ff000064"
+		},
+		"gradients": {
+			"g1": [
+				{
+					"rgba": "#000000ff",
+					"start": "0"
+				},
+				{
+					"rgba": "#ffffffff",
+					"start": "1"
+				}
+			]
+		},
+		"control-tags": {
+			"t1": "1234",
+			"t2": "'mytg'"
+		},
+		"custom": {
+			"CustomAttributes": {
+				"key": "value"
+			}
+		},
+		"templates": {
+			"view": {
+				"attributes": {
+					"class": "CViewContainer",
+					"origin": "0, 0",
+					"size": "400, 235"
+				},
+				"children": {
+					"CViewContainer": {
+						"attributes": {
+							"class": "CViewContainer",
+							"origin": "4, 10",
+							"size": "392, 40"
+						},
+						"children": {
+							"CView": {
+								"attributes": {
+									"class": "CView",
+									"origin": "0, 0",
+									"size": "10, 10"
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
+)";
+
+//------------------------------------------------------------------------
+std::string saveToString (SaveUIDescription& desc, int32_t flags)
+{
+	CMemoryStream outputStream (1024, 1024, true);
+	EXPECT (desc.saveToStream (outputStream, flags, nullptr));
+	return std::string (reinterpret_cast<const char*> (outputStream.getBuffer ()),
+	                    static_cast<size_t> (outputStream.tell ()));
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, RoundTrip)
+{
+	MemoryContentProvider provider (allNodesUIDesc,
+	                                static_cast<uint32_t> (strlen (allNodesUIDesc)));
+	SaveUIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+	auto json = saveToString (desc, 0);
+	auto binary = saveToString (desc, UIDescription::kWriteAsBinary);
+	EXPECT (Detail::UIBinaryDescReader::isBinaryDesc (binary.data (), binary.size ()));
+
+	MemoryContentProvider binaryProvider (binary.data (), static_cast<uint32_t> (binary.size ()));
+	SaveUIDescription binaryDesc (&binaryProvider);
+	EXPECT (binaryDesc.parse () == true);
+	EXPECT (saveToString (binaryDesc, 0) == json);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, Values)
+{
+	MemoryContentProvider provider (allNodesUIDesc,
+	                                static_cast<uint32_t> (strlen (allNodesUIDesc)));
+	SaveUIDescription jsonDesc (&provider);
+	EXPECT (jsonDesc.parse () == true);
+	auto binary = saveToString (jsonDesc, UIDescription::kWriteAsBinary);
+
+	MemoryContentProvider binaryProvider (binary.data (), static_cast<uint32_t> (binary.size ()));
+	UIDescription desc (&binaryProvider);
+	EXPECT (desc.parse () == true);
+	CColor c;
+	EXPECT (desc.getColor ("c1", c));
+	EXPECT (c == CColor (0, 0, 0, 255));
+	EXPECT (desc.getColor ("c2", c));
+	EXPECT (c == CColor (255, 0, 0, 100));
+	EXPECT (desc.getTagForName ("t1") == 1234);
+	EXPECT (desc.getTagForName ("t2") == 'mytg');
+	double value;
+	EXPECT (desc.getVariable ("v1", value));
+	EXPECT (value == 10.);
+	std::string strValue;
+	EXPECT (desc.getVariable ("v2", strValue));
+	EXPECT (strValue == "string");
+	EXPECT (desc.hasFontName ("f1"));
+	EXPECT (desc.hasGradientName ("g1"));
+	EXPECT (desc.hasBitmapName ("b1"));
+	auto attributes = desc.getCustomAttributes ("CustomAttributes");
+	EXPECT (attributes);
+	EXPECT (*attributes->getAttributeValue ("key") == "value");
+	std::list<const std::string*> names;
+	desc.collectTemplateViewNames (names);
+	EXPECT (names.size () == 1);
+	EXPECT (*names.front () == "view");
+	// the view attributes come with their parsed values
+	auto viewAttributes = desc.getViewAttributes ("view");
+	EXPECT (viewAttributes);
+	CPoint p;
+	EXPECT (viewAttributes->getPointAttribute ("size", p));
+	EXPECT (p == CPoint (400, 235));
+	EXPECT (*viewAttributes->getAttributeValue ("class") == "CViewContainer");
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, EncodedImageData)
+{
+	const uint8_t imageData[] = {0x89, 'P', 'N', 'G', 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	auto base64 = Base64Codec::encode (imageData, sizeof (imageData));
+
+	auto root = makeOwned<Detail::UINode> ("vstgui-ui-description");
+	auto bitmaps = new Detail::UINode (Detail::MainNodeNames::kBitmap, nullptr, true);
+	root->getChildren ().add (bitmaps);
+	auto attributes = makeOwned<UIAttributes> ();
+	attributes->setAttribute ("name", "b1");
+	attributes->setAttribute ("path", "b1.png");
+	auto bitmapNode = new Detail::UIBitmapNode ("bitmap", attributes);
+	bitmaps->getChildren ().add (bitmapNode);
+	auto dataNode = new Detail::UINode ("data");
+	dataNode->getAttributes ()->setAttribute ("encoding", "base64");
+	dataNode->getData ().assign (reinterpret_cast<const char*> (base64.data.get ()),
+	                             base64.dataSize);
+	bitmapNode->getChildren ().add (dataNode);
+
+	CMemoryStream stream;
+	EXPECT (Detail::UIBinaryDescWriter::write (stream, root));
+	MemoryContentProvider provider (stream.getBuffer (), static_cast<uint32_t> (stream.tell ()));
+	auto readRoot = Detail::UIBinaryDescReader::read (provider);
+	EXPECT (readRoot);
+	auto readBitmaps = readRoot->getChildren ().findChildNode (Detail::MainNodeNames::kBitmap);
+	EXPECT (readBitmaps);
+	auto readBitmapNode = dynamic_cast<Detail::UIBitmapNode*> (
+	    readBitmaps->getChildren ().findChildNodeWithAttributeValue ("name", "b1"));
+	EXPECT (readBitmapNode);
+	// the image data is not stored as a base64 encoded data node
+	EXPECT (readBitmapNode->hasXMLData () == false);
+	const void* data;
+	size_t dataSize;
+	EXPECT (readBitmapNode->getEncodedImageData (data, dataSize));
+	EXPECT (dataSize == sizeof (imageData));
+	EXPECT (memcmp (data, imageData, dataSize) == 0);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, InvalidData)
+{
+	MemoryContentProvider provider (allNodesUIDesc,
+	                                static_cast<uint32_t> (strlen (allNodesUIDesc)));
+	SaveUIDescription jsonDesc (&provider);
+	EXPECT (jsonDesc.parse () == true);
+	auto binary = saveToString (jsonDesc, UIDescription::kWriteAsBinary);
+
+	auto truncated = binary.substr (0, binary.size () / 2);
+	MemoryContentProvider truncatedProvider (truncated.data (),
+	                                         static_cast<uint32_t> (truncated.size ()));
+	EXPECT (Detail::UIBinaryDescReader::read (truncatedProvider) == nullptr);
+
+	auto corrupted = binary;
+	// the string table would end outside of the data
+	corrupted[12] = '\xff';
+	corrupted[13] = '\xff';
+	MemoryContentProvider corruptedProvider (corrupted.data (),
+	                                         static_cast<uint32_t> (corrupted.size ()));
+	EXPECT (Detail::UIBinaryDescReader::read (corruptedProvider) == nullptr);
+
+	// the file size is the last field of the 72 byte header
+	auto hugeFileSize = binary.substr (0, 72);
+	std::fill (hugeFileSize.begin () + 64, hugeFileSize.end (), '\xff');
+	MemoryContentProvider hugeFileSizeProvider (hugeFileSize.data (),
+	                                            static_cast<uint32_t> (hugeFileSize.size ()));
+	EXPECT (Detail::UIBinaryDescReader::read (hugeFileSizeProvider) == nullptr);
+	std::fill (hugeFileSize.begin () + 68, hugeFileSize.end (), '\0');
+	MemoryContentProvider maxFileSizeProvider (hugeFileSize.data (),
+	                                           static_cast<uint32_t> (hugeFileSize.size ()));
+	EXPECT (Detail::UIBinaryDescReader::read (maxFileSizeProvider) == nullptr);
+}
+
+} // VSTGUI
@@ -1211,6 +1211,38 @@ TEST_CASE (UIDescriptionJSONTests, Colors)
 	EXPECT (desc.getColor ("new color", c) == false);
 }
 
+TEST_CASE (UIDescriptionJSONTests, LookupNamesFollowChanges)
+{
+	MemoryContentProvider provider (colorNodesUIDesc,
+	                                static_cast<uint32_t> (strlen (colorNodesUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+	EXPECT (desc.lookupColorName (CColor (255, 0, 255, 100)) == std::string ("c5"));
+	EXPECT (desc.lookupColorName (CColor (1, 2, 3, 4)) == nullptr);
+
+	desc.changeColor ("c5", CColor (1, 2, 3, 4));
+	EXPECT (desc.lookupColorName (CColor (255, 0, 255, 100)) == nullptr);
+	EXPECT (desc.lookupColorName (CColor (1, 2, 3, 4)) == std::string ("c5"));
+	desc.changeColorName ("c5", "renamed");
+	EXPECT (desc.lookupColorName (CColor (1, 2, 3, 4)) == std::string ("renamed"));
+	// the first node in the sorted list wins if several have the same value
+	desc.changeColor ("added", CColor (1, 2, 3, 4));
+	EXPECT (desc.lookupColorName (CColor (1, 2, 3, 4)) == std::string ("added"));
+	desc.removeColor ("added");
+	EXPECT (desc.lookupColorName (CColor (1, 2, 3, 4)) == std::string ("renamed"));
+	desc.removeColor ("renamed");
+	EXPECT (desc.lookupColorName (CColor (1, 2, 3, 4)) == nullptr);
+
+	MemoryContentProvider tagProvider (tagNodesUIDesc,
+	                                   static_cast<uint32_t> (strlen (tagNodesUIDesc)));
+	UIDescription tagDesc (&tagProvider);
+	EXPECT (tagDesc.parse () == true);
+	EXPECT (tagDesc.lookupControlTagName (1234) == std::string ("t1"));
+	tagDesc.changeControlTagString ("t1", "4567 - 5");
+	EXPECT (tagDesc.lookupControlTagName (1234) == nullptr);
+	EXPECT (tagDesc.lookupControlTagName (4562) == std::string ("t1"));
+}
+
 TEST_CASE (UIDescriptionJSONTests, Fonts)
 {
 	MemoryContentProvider provider (fontNodesUIDesc,
@@ -1300,6 +1332,53 @@ TEST_CASE (UIDescriptionJSONTests, Bitmaps)
 	EXPECT (dynamic_cast<CNinePartTiledBitmap*> (bitmap) == nullptr);
 }
 
+TEST_CASE (UIDescriptionJSONTests, PreloadBitmaps)
+{
+	MemoryContentProvider provider (withAllNodesUIDesc,
+	                                static_cast<uint32_t> (strlen (withAllNodesUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+	desc.preloadBitmaps (2);
+	auto bitmap = desc.getBitmap ("b1");
+	EXPECT (bitmap);
+	auto statistics = desc.getBitmapPreloadStatistics ();
+	EXPECT (statistics.numBitmaps == 3);
+	EXPECT (statistics.criticalPath <= statistics.decodeTime);
+
+	MemoryContentProvider provider2 (withAllNodesUIDesc,
+	                                 static_cast<uint32_t> (strlen (withAllNodesUIDesc)));
+	UIDescription desc2 (&provider2);
+	EXPECT (desc2.parse () == true);
+	auto bitmap2 = desc2.getBitmap ("b1");
+	EXPECT (bitmap2);
+	EXPECT (bitmap->getSize () == bitmap2->getSize ());
+	EXPECT (bitmap->isLoaded () == bitmap2->isLoaded ());
+	EXPECT (std::string (bitmap->getResourceDescription ().u.name) == "b1.png");
+	// a second preload skips the bitmaps which are created or already preloaded
+	desc.preloadBitmaps (2);
+	EXPECT (desc.getBitmapPreloadStatistics ().numBitmaps == 0);
+	EXPECT (desc.getBitmap ("b1") == bitmap);
+	EXPECT (desc.getBitmap ("dataBitmap"));
+}
+
+TEST_CASE (UIDescriptionJSONTests, LookupBitmapNameDoesNotCreateBitmaps)
+{
+	MemoryContentProvider provider (withAllNodesUIDesc,
+	                                static_cast<uint32_t> (strlen (withAllNodesUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+	auto other = makeOwned<CBitmap> (10, 10);
+	EXPECT (desc.lookupBitmapName (other) == nullptr);
+	// the preload only skips bitmaps which are created
+	desc.preloadBitmaps (2);
+	EXPECT (desc.getBitmapPreloadStatistics ().numBitmaps == 3);
+	// a bitmap created after the last lookup is found
+	auto bitmap = desc.getBitmap ("b1");
+	EXPECT (bitmap);
+	EXPECT (desc.lookupBitmapName (bitmap) == std::string ("b1"));
+	EXPECT (desc.lookupBitmapName (other) == nullptr);
+}
+
 TEST_CASE (UIDescriptionJSONTests, Tags)
 {
 	MemoryContentProvider provider (tagNodesUIDesc,
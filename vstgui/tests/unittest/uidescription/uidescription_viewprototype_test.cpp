@@ -0,0 +1,219 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/controls/ccontrol.h"
+#include "../../../lib/controls/ctextlabel.h"
+#include "../../../lib/cviewcontainer.h"
+#include "../../../uidescription/detail/uiviewcreatorattributes.h"
+#include "../../../uidescription/uiattributes.h"
+#include "../../../uidescription/uicontentprovider.h"
+#include "uidescription_test_helper.h"
+
+namespace VSTGUI {
+using namespace UIDescriptionTesting;
+
+namespace {
+
+//------------------------------------------------------------------------
+constexpr auto prototypeUIDesc = R"(
+{
+	"vstgui-ui-description": {
+		"version": "1",
+		"colors": {
+			"c1": "#000000ff"
+		},
+		"control-tags": {
+			"t1": "1",
+			"t2": "2"
+		},
+		"templates": {
+			"strip": {
+				"attributes": {
+					"background-color": "c1",
+					"class": "CViewContainer",
+					"origin": "0, 0",
+					"size": "100, 300"
+				},
+				"children": {
+					"CSlider": {
+						"attributes": {
+							"class": "CSlider",
+							"control-tag": "t1",
+							"origin": "10, 10",
+							"size": "20, 200"
+						}
+					},
+					"COnOffButton": {
+						"attributes": {
+							"class": "COnOffButton",
+							"control-tag": "t2",
+							"origin": "40, 10",
+							"size": "20, 20"
+						}
+					},
+					"CViewContainer": {
+						"attributes": {
+							"class": "CViewContainer",
+							"origin": "0, 250",
+							"size": "100, 50"
+						},
+						"children": {
+							"CTextLabel": {
+								"attributes": {
+									"class": "CTextLabel",
+									"origin": "0, 0",
+									"size": "100, 20",
+									"title": "Label"
+								}
+							}
+						}
+					}
+				}
+			},
+			"custom": {
+				"attributes": {
+					"class": "CViewContainer",
+					"custom-view-name": "MyView",
+					"origin": "0, 0",
+					"size": "100, 100"
+				}
+			}
+		}
+	}
+}
+)";
+
+//------------------------------------------------------------------------
+struct CountingController : Controller
+{
+	int32_t getTagForName (UTF8StringPtr name, int32_t registeredTag) const override
+	{
+		return registeredTag + 100;
+	}
+	CView* createView (const UIAttributes& attributes, const IUIDescription* description) override
+	{
+		++numCreateCalls;
+		return nullptr;
+	}
+	CView* verifyView (CView* view, const UIAttributes& attributes,
+	                   const IUIDescription* description) override
+	{
+		++numVerifyCalls;
+		// a newly created view is not yet added to its parent
+		EXPECT (view->getParentView () == nullptr);
+		if (replaceLabels && dynamic_cast<CTextLabel*> (view))
+		{
+			view->forget ();
+			return new CView (CRect (0, 0, 10, 10));
+		}
+		return view;
+	}
+
+	uint32_t numCreateCalls {0};
+	uint32_t numVerifyCalls {0};
+	bool replaceLabels {false};
+};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionViewPrototypeTests, Instances)
+{
+	MemoryContentProvider provider (prototypeUIDesc,
+	                                static_cast<uint32_t> (strlen (prototypeUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+	desc.setViewPrototypeCacheEnabled (true);
+	EXPECT (desc.isViewPrototypeCacheEnabled ());
+
+	CountingController controller;
+	SharedPointer<CView> previous;
+	for (auto i = 0; i < 3; ++i)
+	{
+		controller.numVerifyCalls = 0;
+		auto view = owned (desc.createView ("strip", &controller));
+		EXPECT (view);
+		EXPECT (view != previous);
+		EXPECT (controller.numVerifyCalls == 5);
+		std::string templateName;
+		EXPECT (desc.getTemplateNameFromView (view, templateName));
+		EXPECT (templateName == "strip");
+		auto container = view->asViewContainer ();
+		EXPECT (container && container->getNbViews () == 3);
+		auto slider = dynamic_cast<CControl*> (container->getView (0));
+		EXPECT (slider);
+		EXPECT (slider->getViewSize () == CRect (10, 10, 30, 210));
+		EXPECT (slider->getTag () == 101);
+		EXPECT (slider->getListener () == &controller);
+		auto button = dynamic_cast<CControl*> (container->getView (1));
+		EXPECT (button && button->getTag () == 102);
+		auto labelContainer = container->getView (2)->asViewContainer ();
+		EXPECT (labelContainer && labelContainer->getNbViews () == 1);
+		auto label = dynamic_cast<CTextLabel*> (labelContainer->getView (0));
+		EXPECT (label && label->getText () == "Label");
+		previous = view;
+	}
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionViewPrototypeTests, VerifyViewReplacesView)
+{
+	MemoryContentProvider provider (prototypeUIDesc,
+	                                static_cast<uint32_t> (strlen (prototypeUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+	desc.setViewPrototypeCacheEnabled (true);
+
+	CountingController controller;
+	controller.replaceLabels = true;
+	for (auto i = 0; i < 2; ++i)
+	{
+		auto view = owned (desc.createView ("strip", &controller));
+		EXPECT (view);
+		auto labelContainer = view->asViewContainer ()->getView (2)->asViewContainer ();
+		EXPECT (labelContainer->getNbViews () == 1);
+		EXPECT (dynamic_cast<CTextLabel*> (labelContainer->getView (0)) == nullptr);
+		EXPECT (labelContainer->getView (0)->getViewSize () == CRect (0, 0, 10, 10));
+	}
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionViewPrototypeTests, CustomViewsAreNotCached)
+{
+	MemoryContentProvider provider (prototypeUIDesc,
+	                                static_cast<uint32_t> (strlen (prototypeUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+	desc.setViewPrototypeCacheEnabled (true);
+
+	CountingController controller;
+	for (auto i = 0u; i < 3u; ++i)
+	{
+		auto view = owned (desc.createView ("custom", &controller));
+		EXPECT (view);
+		EXPECT (controller.numCreateCalls == i + 1u);
+		EXPECT (controller.numVerifyCalls == i + 1u);
+	}
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionViewPrototypeTests, ChangeInvalidatesPrototypes)
+{
+	MemoryContentProvider provider (prototypeUIDesc,
+	                                static_cast<uint32_t> (strlen (prototypeUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+	desc.setViewPrototypeCacheEnabled (true);
+
+	CountingController controller;
+	auto view = owned (desc.createView ("strip", &controller));
+	auto container = view->asViewContainer ();
+	EXPECT (container->getBackgroundColor () == CColor (0, 0, 0, 255));
+	desc.changeColor ("c1", CColor (255, 0, 0, 255));
+	view = owned (desc.createView ("strip", &controller));
+	container = view->asViewContainer ();
+	EXPECT (container->getBackgroundColor () == CColor (255, 0, 0, 255));
+}
+
+} // VSTGUI
@@ -304,6 +304,17 @@ TEST_CASE (UIDescriptionXMLTests, ParseEmpty)
 	EXPECT (desc.getController () == nullptr);
 }
 
+TEST_CASE (UIDescriptionXMLTests, ParseWithByteOrderMark)
+{
+	std::string uidesc = "\xef\xbb\xbf";
+	uidesc += colorNodesUIDesc;
+	MemoryContentProvider provider (uidesc.data (), static_cast<uint32_t> (uidesc.size ()));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+	CColor c;
+	EXPECT (desc.getColor ("c1", c));
+}
+
 TEST_CASE (UIDescriptionXMLTests, Colors)
 {
 	MemoryContentProvider provider (colorNodesUIDesc,
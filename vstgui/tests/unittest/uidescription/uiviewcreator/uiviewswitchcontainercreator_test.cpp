@@ -71,6 +71,30 @@ TEST_CASE (UIViewSwitchContainerCreatorTest, AnimationTime)
 	    [] (UIViewSwitchContainer* v) { return v->getAnimationTime () == 1234; });
 }
 
+TEST_CASE (UIViewSwitchContainerCreatorTest, KeepAlivePages)
+{
+	DummyUIDescription uidesc;
+	testAttribute<UIViewSwitchContainer> (
+	    kUIViewSwitchContainer, kAttrKeepAlivePages, 3, &uidesc,
+	    [] (UIViewSwitchContainer* v) { return v->getKeepAlivePages () == 3; });
+}
+
+TEST_CASE (UIViewSwitchContainerCreatorTest, KeepAliveViewBudget)
+{
+	DummyUIDescription uidesc;
+	testAttribute<UIViewSwitchContainer> (
+	    kUIViewSwitchContainer, kAttrKeepAliveViewBudget, 500, &uidesc,
+	    [] (UIViewSwitchContainer* v) { return v->getKeepAliveViewBudget () == 500; });
+}
+
+TEST_CASE (UIViewSwitchContainerCreatorTest, PrebuildPages)
+{
+	DummyUIDescription uidesc;
+	testAttribute<UIViewSwitchContainer> (
+	    kUIViewSwitchContainer, kAttrPrebuildPages, true, &uidesc,
+	    [] (UIViewSwitchContainer* v) { return v->getPrebuildPages (); });
+}
+
 TEST_CASE (UIViewSwitchContainerCreatorTest, AnimationStyleValues)
 {
 	DummyUIDescription uidesc;
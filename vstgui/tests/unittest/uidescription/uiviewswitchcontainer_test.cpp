@@ -2,6 +2,7 @@
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
+#include "../../../lib/cframe.h"
 #include "../../../lib/controls/cbuttons.h"
 #include "../../../lib/cstring.h"
 #include "../../../uidescription/uiviewswitchcontainer.h"
@@ -25,18 +26,34 @@ struct View3 : public CView
 	View3 () : CView (CRect ()) { setAutosizeFlags (kAutosizeAll); }
 };
 
+struct View4 : public CView
+{
+	View4 () : CView (CRect (0, 0, 100, 100)) {}
+};
+
 struct TestUIDescription : public UIDescriptionAdapter
 {
 	CView* createView (UTF8StringPtr name, IController* controller) const override
 	{
-		if (UTF8StringView (name) == "v1")
+		++numCreateCalls;
+		if (UTF8StringView (name) == "c1")
+		{
+			auto container = new CViewContainer (CRect ());
+			container->addView (new View1 ());
+			container->addView (new View2 ());
+			return container;
+		}
+		else if (UTF8StringView (name) == "v1")
 			return new View1 ();
 		else if (UTF8StringView (name) == "v2")
 			return new View2 ();
 		else if (UTF8StringView (name) == "v3")
 			return new View3 ();
+		else if (UTF8StringView (name) == "v4")
+			return new View4 ();
 		return nullptr;
 	}
+	mutable uint32_t numCreateCalls {0};
 };
 
 TEST_CASE (UIDescriptionViewSwitchControllerTest, SwitchViaIndex)
@@ -115,4 +132,130 @@ TEST_CASE (UIDescriptionViewSwitchControllerTest, NoAnimation)
 	container->removed (rootView);
 }
 
+TEST_CASE (UIDescriptionViewSwitchControllerTest, KeepAlivePages)
+{
+	TestUIDescription uiDesc;
+	auto rootView = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto viewSwitch = new UIViewSwitchContainer (CRect (0, 0, 100, 100));
+	viewSwitch->setAnimationTime (0);
+	viewSwitch->setKeepAlivePages (1);
+	auto controller = new UIDescriptionViewSwitchController (viewSwitch, &uiDesc, nullptr);
+	controller->setTemplateNames ("v1,v2,v3");
+	EXPECT (container->addView (viewSwitch));
+	container->attached (rootView);
+	viewSwitch->setCurrentViewIndex (0);
+	auto view1 = viewSwitch->getView (0);
+	viewSwitch->setCurrentViewIndex (1);
+	EXPECT (viewSwitch->isPageKeptAlive (0));
+	EXPECT (view1->isAttached () == false);
+	viewSwitch->setCurrentViewIndex (0);
+	EXPECT (viewSwitch->getView (0) == view1);
+	EXPECT (viewSwitch->isPageKeptAlive (1));
+	EXPECT (viewSwitch->isPageKeptAlive (0) == false);
+	EXPECT (uiDesc.numCreateCalls == 2);
+	// only the last page is kept alive
+	viewSwitch->setCurrentViewIndex (2);
+	EXPECT (viewSwitch->isPageKeptAlive (0));
+	EXPECT (viewSwitch->isPageKeptAlive (1) == false);
+	EXPECT (uiDesc.numCreateCalls == 3);
+	container->removed (rootView);
+	EXPECT (viewSwitch->isPageKeptAlive (0) == false);
+}
+
+TEST_CASE (UIDescriptionViewSwitchControllerTest, KeepAliveViewBudget)
+{
+	TestUIDescription uiDesc;
+	auto rootView = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto viewSwitch = new UIViewSwitchContainer (CRect (0, 0, 100, 100));
+	viewSwitch->setAnimationTime (0);
+	viewSwitch->setKeepAlivePages (2);
+	viewSwitch->setKeepAliveViewBudget (2);
+	auto controller = new UIDescriptionViewSwitchController (viewSwitch, &uiDesc, nullptr);
+	controller->setTemplateNames ("v1,c1,v2");
+	EXPECT (container->addView (viewSwitch));
+	container->attached (rootView);
+	viewSwitch->setCurrentViewIndex (0);
+	viewSwitch->setCurrentViewIndex (1);
+	EXPECT (viewSwitch->isPageKeptAlive (0));
+	// the container page has three views and does not fit into the budget
+	viewSwitch->setCurrentViewIndex (2);
+	EXPECT (viewSwitch->isPageKeptAlive (1) == false);
+	EXPECT (viewSwitch->isPageKeptAlive (0));
+	viewSwitch->setCurrentViewIndex (0);
+	EXPECT (viewSwitch->isPageKeptAlive (2));
+	viewSwitch->setKeepAliveViewBudget (1);
+	EXPECT (viewSwitch->isPageKeptAlive (2));
+	viewSwitch->setKeepAlivePages (0);
+	EXPECT (viewSwitch->isPageKeptAlive (2) == false);
+	container->removed (rootView);
+}
+
+TEST_CASE (UIDescriptionViewSwitchControllerTest, PrebuildPages)
+{
+	TestUIDescription uiDesc;
+	auto rootView = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto viewSwitch = new UIViewSwitchContainer (CRect (0, 0, 100, 100));
+	viewSwitch->setAnimationTime (0);
+	viewSwitch->setKeepAlivePages (2);
+	auto controller = new UIDescriptionViewSwitchController (viewSwitch, &uiDesc, nullptr);
+	controller->setTemplateNames ("v1,v2,v3");
+	EXPECT (container->addView (viewSwitch));
+	container->attached (rootView);
+	viewSwitch->setCurrentViewIndex (0);
+	viewSwitch->setPrebuildPages (true);
+	EXPECT (viewSwitch->wantsIdle ());
+	viewSwitch->onIdle ();
+	EXPECT (viewSwitch->isPageKeptAlive (1));
+	viewSwitch->onIdle ();
+	EXPECT (viewSwitch->isPageKeptAlive (2));
+	EXPECT (viewSwitch->wantsIdle () == false);
+	EXPECT (uiDesc.numCreateCalls == 3);
+	viewSwitch->setCurrentViewIndex (2);
+	EXPECT (dynamic_cast<View3*> (viewSwitch->getView (0)));
+	EXPECT (viewSwitch->getView (0)->getViewSize () == viewSwitch->getViewSize ());
+	viewSwitch->setCurrentViewIndex (1);
+	EXPECT (dynamic_cast<View2*> (viewSwitch->getView (0)));
+	EXPECT (uiDesc.numCreateCalls == 3);
+	container->removed (rootView);
+}
+
+TEST_CASE (UIDescriptionViewSwitchControllerTest, KeepAlivePagesWithAnimation)
+{
+	TestUIDescription uiDesc;
+	auto frame = new CFrame (CRect (0, 0, 100, 100), nullptr);
+	auto viewSwitch = new UIViewSwitchContainer (CRect (0, 0, 100, 100));
+	viewSwitch->setKeepAlivePages (1);
+	auto controller = new UIDescriptionViewSwitchController (viewSwitch, &uiDesc, nullptr);
+	controller->setTemplateNames ("v4,v4");
+	frame->addView (viewSwitch);
+	frame->attached (frame);
+	viewSwitch->setCurrentViewIndex (0);
+	auto view1 = viewSwitch->getView (0);
+	viewSwitch->setCurrentViewIndex (1);
+	viewSwitch->removeAnimation ("UIViewSwitchContainer::setCurrentViewIndex");
+	// the fade animation leaves the old page transparent
+	EXPECT (view1->getAlphaValue () == 0.f);
+	viewSwitch->setCurrentViewIndex (0);
+	EXPECT (viewSwitch->getView (0) == view1);
+	viewSwitch->removeAnimation ("UIViewSwitchContainer::setCurrentViewIndex");
+	EXPECT (view1->getAlphaValue () == 1.f);
+	EXPECT (view1->getViewSize () == CRect (0, 0, 100, 100));
+
+	viewSwitch->setAnimationStyle (UIViewSwitchContainer::kPushInOut);
+	viewSwitch->setCurrentViewIndex (1);
+	viewSwitch->removeAnimation ("UIViewSwitchContainer::setCurrentViewIndex");
+	// the push animation leaves the old page outside of the container
+	EXPECT (view1->getViewSize () != CRect (0, 0, 100, 100));
+	viewSwitch->setCurrentViewIndex (0);
+	viewSwitch->removeAnimation ("UIViewSwitchContainer::setCurrentViewIndex");
+	EXPECT (viewSwitch->getView (0) == view1);
+	EXPECT (view1->getAlphaValue () == 1.f);
+	EXPECT (view1->getViewSize () == CRect (0, 0, 100, 100));
+	EXPECT (uiDesc.numCreateCalls == 2);
+	frame->close ();
+}
+
 } // VSTGUI
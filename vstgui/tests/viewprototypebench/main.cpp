@@ -0,0 +1,166 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cview.h"
+#include "vstgui/lib/vstguiinit.h"
+#include "vstgui/uidescription/icontroller.h"
+#include "vstgui/uidescription/uicontentprovider.h"
+#include "vstgui/uidescription/uidescription.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+/*	Compares creating many instances of the same template from the description with creating
+	them from a cached prototype of the template.
+
+	Usage: viewprototypebench [num-instances] [repetitions]
+
+	The template is a channel strip with a few dozen controls and labels, its controller resolves
+	the control tags and counts the verifyView calls, which must be the same for both ways.
+*/
+
+//------------------------------------------------------------------------
+static std::string makeDescription ()
+{
+	static const char* controlClasses[] = {"CKnob", "CSlider", "COnOffButton", "CParamDisplay"};
+	constexpr auto numSections = 6;
+	constexpr auto numControls = 6;
+
+	std::string tags;
+	for (auto i = 0; i < numSections * numControls; ++i)
+	{
+		tags += i ? ",\n" : "";
+		tags += "\"tag" + std::to_string (i) + "\": \"" + std::to_string (i) + "\"";
+	}
+
+	std::string sections;
+	for (auto s = 0; s < numSections; ++s)
+	{
+		std::string controls;
+		for (auto c = 0; c < numControls; ++c)
+		{
+			auto index = std::to_string (s * numControls + c);
+			auto x = std::to_string (c * 20);
+			controls += c ? ",\n" : "";
+			controls += "\"control" + index + "\": {\"attributes\": {\"class\": \"" +
+			            controlClasses[c % 4] + "\", \"control-tag\": \"tag" + index +
+			            "\", \"origin\": \"" + x + ", 0\", \"size\": \"20, 20\", " +
+			            "\"default-value\": \"0.5\", \"transparent\": \"true\"}},\n";
+			controls += "\"label" + index + "\": {\"attributes\": {\"class\": \"CTextLabel\", " +
+			            "\"title\": \"Param " + index + "\", \"origin\": \"" + x +
+			            ", 20\", \"size\": \"20, 10\", \"font-color\": \"text\", " +
+			            "\"back-color\": \"background\"}}";
+		}
+		sections += s ? ",\n" : "";
+		sections += "\"section" + std::to_string (s) + "\": {\"attributes\": {\"class\": " +
+		            "\"CViewContainer\", \"origin\": \"0, " + std::to_string (s * 30) +
+		            "\", \"size\": \"120, 30\", \"background-color\": \"background\"}, " +
+		            "\"children\": {" + controls + "}}";
+	}
+
+	return "{\"vstgui-ui-description\": {\"version\": \"1\",\n"
+	       "\"colors\": {\"text\": \"#ffffffff\", \"background\": \"#202020ff\"},\n"
+	       "\"control-tags\": {" +
+	       tags +
+	       "},\n"
+	       "\"templates\": {\"strip\": {\"attributes\": {\"class\": \"CViewContainer\", "
+	       "\"origin\": \"0, 0\", \"size\": \"120, 180\"}, \"children\": {" +
+	       sections + "}}}}}";
+}
+
+//------------------------------------------------------------------------
+struct Controller : IController
+{
+	void valueChanged (CControl* pControl) override {}
+	CView* verifyView (CView* view, const UIAttributes& attributes,
+	                   const IUIDescription* description) override
+	{
+		++numVerifyCalls;
+		return view;
+	}
+
+	size_t numVerifyCalls {0};
+};
+
+//------------------------------------------------------------------------
+static double measure (UIDescription& description, Controller& controller, size_t numInstances,
+                       int repetitions)
+{
+	using Clock = std::chrono::high_resolution_clock;
+	std::vector<CView*> views (numInstances);
+	auto best = Clock::duration::max ();
+	for (auto i = 0; i < repetitions; ++i)
+	{
+		controller.numVerifyCalls = 0;
+		auto start = Clock::now ();
+		for (auto& view : views)
+			view = description.createView ("strip", &controller);
+		best = std::min (best, Clock::now () - start);
+		for (auto view : views)
+		{
+			if (view)
+				view->forget ();
+		}
+	}
+	return std::chrono::duration<double, std::milli> (best).count ();
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#else
+	VSTGUI::init (nullptr);
+#endif
+	auto numInstances = argc > 1 ? static_cast<size_t> (std::max (1, atoi (argv[1]))) : 64u;
+	auto repetitions = argc > 2 ? std::max (1, atoi (argv[2])) : 10;
+
+	auto json = makeDescription ();
+	MemoryContentProvider contentProvider (json.data (), static_cast<uint32_t> (json.size ()));
+	auto description = makeOwned<UIDescription> (&contentProvider);
+	if (!description->parse ())
+	{
+		printf ("Parsing the description failed\n");
+		return -1;
+	}
+
+	Controller controller;
+	auto regular = measure (*description, controller, numInstances, repetitions);
+	auto regularVerifyCalls = controller.numVerifyCalls;
+	description->setViewPrototypeCacheEnabled (true);
+	auto prototype = measure (*description, controller, numInstances, repetitions);
+	auto prototypeVerifyCalls = controller.numVerifyCalls;
+
+	printf ("%zu instances of a template with %zu views\n", numInstances,
+	        regularVerifyCalls / numInstances);
+	printf ("description: %10.3f ms (%8.2f us per instance)\n", regular,
+	        regular * 1000. / numInstances);
+	printf ("prototype:   %10.3f ms (%8.2f us per instance)\n", prototype,
+	        prototype * 1000. / numInstances);
+
+	description = nullptr;
+	VSTGUI::exit ();
+	if (regularVerifyCalls != prototypeVerifyCalls)
+	{
+		printf ("verifyView was called %zu times instead of %zu\n", prototypeVerifyCalls,
+		        regularVerifyCalls);
+		return -1;
+	}
+	return 0;
+}
@@ -45,6 +45,7 @@ int main (int argv, char* argc[])
 	std::string inputPath;
 	std::string outputPath;
 	bool noCompression = false;
+	bool binary = false;
 	uint32_t compressionLevel = 1;
 	for (auto i = 0; i < argv; ++i)
 	{
@@ -71,13 +72,17 @@ int main (int argv, char* argc[])
 		{
 			noCompression = true;
 		}
+		else if (arg == "--binary")
+		{
+			binary = true;
+		}
 	}
 	if (inputPath.empty () || outputPath.empty ())
 	{
 		printAndTerminate ("No input or output path specified!");
 	}
 	printf ("Copy %s to %s%s\n", inputPath.data (), outputPath.data (),
-			noCompression ? " [uncompressed]" : "[compressed]");
+			binary ? " [binary]" : noCompression ? " [uncompressed]" : "[compressed]");
 
 	CompressedUIDescription uiDesc (CResourceDescription (inputPath.data ()));
 	if (!uiDesc.parse ())
@@ -85,7 +90,15 @@ int main (int argv, char* argc[])
 		printAndTerminate ("Parsing failed!");
 	}
 	int32_t flags = UIDescription::kWriteImagesIntoUIDescFile;
-	if (noCompression)
+	if (binary)
+	{
+		flags |= UIDescription::kWriteAsBinary | UIDescription::kDoNotVerifyImageData;
+		if (!uiDesc.UIDescription::save (outputPath.data (), flags))
+		{
+			printAndTerminate ("saving failed");
+		}
+	}
+	else if (noCompression)
 	{
 		if (inputPath == outputPath && uiDesc.getOriginalIsCompressed () == false)
 			return 0;
@@ -0,0 +1,591 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "base64codec.h"
+#include "cstream.h"
+#include <algorithm>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define VSTGUI_BASE64_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#define VSTGUI_BASE64_TARGET(name)
+#else
+#define VSTGUI_BASE64_TARGET(name) __attribute__ ((target (name)))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define VSTGUI_BASE64_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace VSTGUI {
+namespace {
+
+//-----------------------------------------------------------------------------
+constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+//-----------------------------------------------------------------------------
+struct DecodeTable
+{
+	uint8_t values[256];
+
+	constexpr DecodeTable () : values ()
+	{
+		for (uint8_t i = 0; i < 64; ++i)
+			values[static_cast<uint8_t> (kAlphabet[i])] = i;
+	}
+};
+constexpr DecodeTable kDecodeTable;
+
+//-----------------------------------------------------------------------------
+// Scalar
+//-----------------------------------------------------------------------------
+inline size_t decodeScalar (const uint8_t* input, size_t numChars, uint8_t* output)
+{
+	const auto& table = kDecodeTable.values;
+	auto out = output;
+	for (auto end = input + numChars; input != end; input += 4, out += 3)
+	{
+		auto value = (static_cast<uint32_t> (table[input[0]]) << 18) |
+		             (static_cast<uint32_t> (table[input[1]]) << 12) |
+		             (static_cast<uint32_t> (table[input[2]]) << 6) | table[input[3]];
+		out[0] = static_cast<uint8_t> (value >> 16);
+		out[1] = static_cast<uint8_t> (value >> 8);
+		out[2] = static_cast<uint8_t> (value);
+	}
+	return static_cast<size_t> (out - output);
+}
+
+//-----------------------------------------------------------------------------
+inline size_t decodeFinalBlock (const uint8_t input[4], uint8_t output[3])
+{
+	uint8_t block[3];
+	decodeScalar (input, 4, block);
+	size_t result = 3;
+	if (input[2] == '=')
+		result = 1;
+	else if (input[3] == '=')
+		result = 2;
+	std::copy (block, block + result, output);
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+inline size_t encodeScalar (const uint8_t* input, size_t numBytes, uint8_t* output)
+{
+	auto out = output;
+	for (auto end = input + numBytes; input != end; input += 3, out += 4)
+	{
+		auto value = (static_cast<uint32_t> (input[0]) << 16) |
+		             (static_cast<uint32_t> (input[1]) << 8) | input[2];
+		out[0] = static_cast<uint8_t> (kAlphabet[(value >> 18) & 0x3f]);
+		out[1] = static_cast<uint8_t> (kAlphabet[(value >> 12) & 0x3f]);
+		out[2] = static_cast<uint8_t> (kAlphabet[(value >> 6) & 0x3f]);
+		out[3] = static_cast<uint8_t> (kAlphabet[value & 0x3f]);
+	}
+	return static_cast<size_t> (out - output);
+}
+
+#if VSTGUI_BASE64_X86
+//-----------------------------------------------------------------------------
+// SSSE3 and AVX2
+//
+// Decoding classifies each character by its high and low nibble with two table lookups, a
+// character is part of the alphabet if the two classes have no bit in common. The offset which
+// turns a character into its 6 bit value only depends on the high nibble, except for '/'.
+// Blocks with other characters, like the padding, are left to the scalar code.
+//-----------------------------------------------------------------------------
+#define VSTGUI_BASE64_DECODE_LUT_LO                                                            \
+	0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+#define VSTGUI_BASE64_DECODE_LUT_HI                                                            \
+	0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+#define VSTGUI_BASE64_DECODE_LUT_ROLL 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+// packs the 3 bytes of each 32 bit word together
+#define VSTGUI_BASE64_DECODE_PACK 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+// spreads 12 bytes to the 16 bit words which the multiplications split into 6 bit indices
+#define VSTGUI_BASE64_ENCODE_SPREAD 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10
+// the offset of the character of an index by the class calculated in translate
+#define VSTGUI_BASE64_ENCODE_SHIFT                                                             \
+	'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,  \
+	    '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0
+
+//-----------------------------------------------------------------------------
+VSTGUI_BASE64_TARGET ("ssse3")
+size_t decodeSSSE3 (const uint8_t* input, size_t numChars, uint8_t* output)
+{
+	const auto lutLo = _mm_setr_epi8 (VSTGUI_BASE64_DECODE_LUT_LO);
+	const auto lutHi = _mm_setr_epi8 (VSTGUI_BASE64_DECODE_LUT_HI);
+	const auto lutRoll = _mm_setr_epi8 (VSTGUI_BASE64_DECODE_LUT_ROLL);
+	const auto pack = _mm_setr_epi8 (VSTGUI_BASE64_DECODE_PACK);
+	const auto nibbleMask = _mm_set1_epi8 (0x0f);
+	const auto slash = _mm_set1_epi8 ('/');
+	const auto zero = _mm_setzero_si128 ();
+
+	size_t consumed = 0;
+	// a block writes 16 bytes of which 12 are valid, the following characters overwrite the rest
+	while (numChars - consumed >= 16 + 12)
+	{
+		auto str = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input + consumed));
+		auto hiNibbles = _mm_and_si128 (_mm_srli_epi32 (str, 4), nibbleMask);
+		auto loNibbles = _mm_and_si128 (str, nibbleMask);
+		auto hi = _mm_shuffle_epi8 (lutHi, hiNibbles);
+		auto lo = _mm_shuffle_epi8 (lutLo, loNibbles);
+		if (_mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm_and_si128 (lo, hi), zero)) != 0xFFFF)
+			break;
+		auto roll = _mm_shuffle_epi8 (lutRoll, _mm_add_epi8 (_mm_cmpeq_epi8 (str, slash), hiNibbles));
+		str = _mm_add_epi8 (str, roll);
+		str = _mm_maddubs_epi16 (str, _mm_set1_epi32 (0x01400140));
+		str = _mm_madd_epi16 (str, _mm_set1_epi32 (0x00011000));
+		str = _mm_shuffle_epi8 (str, pack);
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (output + consumed / 4 * 3), str);
+		consumed += 16;
+	}
+	return consumed;
+}
+
+//-----------------------------------------------------------------------------
+VSTGUI_BASE64_TARGET ("avx2")
+size_t decodeAVX2 (const uint8_t* input, size_t numChars, uint8_t* output)
+{
+	const auto lutLo =
+	    _mm256_setr_epi8 (VSTGUI_BASE64_DECODE_LUT_LO, VSTGUI_BASE64_DECODE_LUT_LO);
+	const auto lutHi =
+	    _mm256_setr_epi8 (VSTGUI_BASE64_DECODE_LUT_HI, VSTGUI_BASE64_DECODE_LUT_HI);
+	const auto lutRoll =
+	    _mm256_setr_epi8 (VSTGUI_BASE64_DECODE_LUT_ROLL, VSTGUI_BASE64_DECODE_LUT_ROLL);
+	const auto pack = _mm256_setr_epi8 (VSTGUI_BASE64_DECODE_PACK, VSTGUI_BASE64_DECODE_PACK);
+	const auto compact = _mm256_setr_epi32 (0, 1, 2, 4, 5, 6, 7, 7);
+	const auto nibbleMask = _mm256_set1_epi8 (0x0f);
+	const auto slash = _mm256_set1_epi8 ('/');
+
+	size_t consumed = 0;
+	// a block writes 32 bytes of which 24 are valid, the following characters overwrite the rest
+	while (numChars - consumed >= 32 + 16)
+	{
+		auto str = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (input + consumed));
+		auto hiNibbles = _mm256_and_si256 (_mm256_srli_epi32 (str, 4), nibbleMask);
+		auto loNibbles = _mm256_and_si256 (str, nibbleMask);
+		auto hi = _mm256_shuffle_epi8 (lutHi, hiNibbles);
+		auto lo = _mm256_shuffle_epi8 (lutLo, loNibbles);
+		if (!_mm256_testz_si256 (lo, hi))
+			break;
+		auto roll = _mm256_shuffle_epi8 (lutRoll,
+		                                 _mm256_add_epi8 (_mm256_cmpeq_epi8 (str, slash), hiNibbles));
+		str = _mm256_add_epi8 (str, roll);
+		str = _mm256_maddubs_epi16 (str, _mm256_set1_epi32 (0x01400140));
+		str = _mm256_madd_epi16 (str, _mm256_set1_epi32 (0x00011000));
+		str = _mm256_shuffle_epi8 (str, pack);
+		str = _mm256_permutevar8x32_epi32 (str, compact);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (output + consumed / 4 * 3), str);
+		consumed += 32;
+	}
+	return consumed + decodeSSSE3 (input + consumed, numChars - consumed, output + consumed / 4 * 3);
+}
+
+//-----------------------------------------------------------------------------
+VSTGUI_BASE64_TARGET ("ssse3")
+inline __m128i encodeIndicesSSSE3 (__m128i in)
+{
+	in = _mm_shuffle_epi8 (in, _mm_setr_epi8 (VSTGUI_BASE64_ENCODE_SPREAD));
+	auto t0 = _mm_mulhi_epu16 (_mm_and_si128 (in, _mm_set1_epi32 (0x0fc0fc00)),
+	                           _mm_set1_epi32 (0x04000040));
+	auto t1 = _mm_mullo_epi16 (_mm_and_si128 (in, _mm_set1_epi32 (0x003f03f0)),
+	                           _mm_set1_epi32 (0x01000010));
+	return _mm_or_si128 (t0, t1);
+}
+
+//-----------------------------------------------------------------------------
+VSTGUI_BASE64_TARGET ("ssse3")
+inline __m128i translateSSSE3 (__m128i indices)
+{
+	// 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+	auto result = _mm_subs_epu8 (indices, _mm_set1_epi8 (51));
+	auto less = _mm_cmpgt_epi8 (_mm_set1_epi8 (26), indices);
+	result = _mm_or_si128 (result, _mm_and_si128 (less, _mm_set1_epi8 (13)));
+	result = _mm_shuffle_epi8 (_mm_setr_epi8 (VSTGUI_BASE64_ENCODE_SHIFT), result);
+	return _mm_add_epi8 (result, indices);
+}
+
+//-----------------------------------------------------------------------------
+VSTGUI_BASE64_TARGET ("ssse3")
+size_t encodeSSSE3 (const uint8_t* input, size_t numBytes, uint8_t* output)
+{
+	size_t consumed = 0;
+	// a block reads 16 bytes of which 12 are encoded
+	while (numBytes - consumed >= 16)
+	{
+		auto in = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input + consumed));
+		auto str = translateSSSE3 (encodeIndicesSSSE3 (in));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (output + consumed / 3 * 4), str);
+		consumed += 12;
+	}
+	return consumed;
+}
+
+//-----------------------------------------------------------------------------
+VSTGUI_BASE64_TARGET ("avx2")
+size_t encodeAVX2 (const uint8_t* input, size_t numBytes, uint8_t* output)
+{
+	const auto spread =
+	    _mm256_setr_epi8 (VSTGUI_BASE64_ENCODE_SPREAD, VSTGUI_BASE64_ENCODE_SPREAD);
+	const auto shift = _mm256_setr_epi8 (VSTGUI_BASE64_ENCODE_SHIFT, VSTGUI_BASE64_ENCODE_SHIFT);
+
+	size_t consumed = 0;
+	// a block reads 28 bytes of which 24 are encoded, 12 in each lane
+	while (numBytes - consumed >= 28)
+	{
+		auto lo = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input + consumed));
+		auto hi = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input + consumed + 12));
+		auto in = _mm256_inserti128_si256 (_mm256_castsi128_si256 (lo), hi, 1);
+		in = _mm256_shuffle_epi8 (in, spread);
+		auto t0 = _mm256_mulhi_epu16 (_mm256_and_si256 (in, _mm256_set1_epi32 (0x0fc0fc00)),
+		                              _mm256_set1_epi32 (0x04000040));
+		auto t1 = _mm256_mullo_epi16 (_mm256_and_si256 (in, _mm256_set1_epi32 (0x003f03f0)),
+		                              _mm256_set1_epi32 (0x01000010));
+		auto indices = _mm256_or_si256 (t0, t1);
+		auto result = _mm256_subs_epu8 (indices, _mm256_set1_epi8 (51));
+		auto less = _mm256_cmpgt_epi8 (_mm256_set1_epi8 (26), indices);
+		result = _mm256_or_si256 (result, _mm256_and_si256 (less, _mm256_set1_epi8 (13)));
+		result = _mm256_add_epi8 (_mm256_shuffle_epi8 (shift, result), indices);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (output + consumed / 3 * 4), result);
+		consumed += 24;
+	}
+	return consumed + encodeSSSE3 (input + consumed, numBytes - consumed, output + consumed / 3 * 4);
+}
+
+//-----------------------------------------------------------------------------
+bool cpuSupportsSSSE3 ()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid (info, 1);
+	return (info[2] & (1 << 9)) != 0;
+#else
+	return __builtin_cpu_supports ("ssse3");
+#endif
+}
+
+//-----------------------------------------------------------------------------
+bool cpuSupportsAVX2 ()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid (info, 1);
+	// the operating system must save the AVX registers
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv (0) & 6) != 6)
+		return false;
+	__cpuidex (info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports ("avx2");
+#endif
+}
+
+#endif // VSTGUI_BASE64_X86
+
+#if VSTGUI_BASE64_NEON
+//-----------------------------------------------------------------------------
+// NEON
+//
+// The structured loads and stores deinterleave the characters and bytes, so the 6 bit values
+// of each position of a group are in one register. Decoding uses the same tables as SSSE3.
+//-----------------------------------------------------------------------------
+inline uint8x16_t decodeNEON (uint8x16_t str, uint8x16_t& invalid)
+{
+	static const uint8_t lutLoValues[16] = {0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+	                                        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A};
+	static const uint8_t lutHiValues[16] = {0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+	                                        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10};
+	static const uint8_t lutRollValues[16] = {0, 16, 19, 4, 191, 191, 185, 185,
+	                                          0, 0,  0,  0, 0,   0,   0,   0};
+	auto hiNibbles = vshrq_n_u8 (str, 4);
+	auto hi = vqtbl1q_u8 (vld1q_u8 (lutHiValues), hiNibbles);
+	auto lo = vqtbl1q_u8 (vld1q_u8 (lutLoValues), vandq_u8 (str, vdupq_n_u8 (0x0f)));
+	invalid = vorrq_u8 (invalid, vandq_u8 (lo, hi));
+	auto roll = vqtbl1q_u8 (vld1q_u8 (lutRollValues),
+	                        vaddq_u8 (vceqq_u8 (str, vdupq_n_u8 ('/')), hiNibbles));
+	return vaddq_u8 (str, roll);
+}
+
+//-----------------------------------------------------------------------------
+size_t decodeNEON (const uint8_t* input, size_t numChars, uint8_t* output)
+{
+	size_t consumed = 0;
+	while (numChars - consumed >= 64)
+	{
+		auto str = vld4q_u8 (input + consumed);
+		auto invalid = vdupq_n_u8 (0);
+		auto a = decodeNEON (str.val[0], invalid);
+		auto b = decodeNEON (str.val[1], invalid);
+		auto c = decodeNEON (str.val[2], invalid);
+		auto d = decodeNEON (str.val[3], invalid);
+		if (vmaxvq_u8 (invalid) != 0)
+			break;
+		uint8x16x3_t out;
+		out.val[0] = vorrq_u8 (vshlq_n_u8 (a, 2), vshrq_n_u8 (b, 4));
+		out.val[1] = vorrq_u8 (vshlq_n_u8 (b, 4), vshrq_n_u8 (c, 2));
+		out.val[2] = vorrq_u8 (vshlq_n_u8 (c, 6), d);
+		vst3q_u8 (output + consumed / 4 * 3, out);
+		consumed += 64;
+	}
+	return consumed;
+}
+
+//-----------------------------------------------------------------------------
+size_t encodeNEON (const uint8_t* input, size_t numBytes, uint8_t* output)
+{
+	auto alphabet = reinterpret_cast<const uint8_t*> (kAlphabet);
+	uint8x16x4_t table;
+	table.val[0] = vld1q_u8 (alphabet);
+	table.val[1] = vld1q_u8 (alphabet + 16);
+	table.val[2] = vld1q_u8 (alphabet + 32);
+	table.val[3] = vld1q_u8 (alphabet + 48);
+	const auto mask = vdupq_n_u8 (0x3f);
+
+	size_t consumed = 0;
+	while (numBytes - consumed >= 48)
+	{
+		auto in = vld3q_u8 (input + consumed);
+		uint8x16x4_t out;
+		out.val[0] = vshrq_n_u8 (in.val[0], 2);
+		out.val[1] = vandq_u8 (vorrq_u8 (vshlq_n_u8 (in.val[0], 4), vshrq_n_u8 (in.val[1], 4)), mask);
+		out.val[2] = vandq_u8 (vorrq_u8 (vshlq_n_u8 (in.val[1], 2), vshrq_n_u8 (in.val[2], 6)), mask);
+		out.val[3] = vandq_u8 (in.val[2], mask);
+		for (auto& v : out.val)
+			v = vqtbl4q_u8 (table, v);
+		vst4q_u8 (output + consumed / 3 * 4, out);
+		consumed += 48;
+	}
+	return consumed;
+}
+#endif // VSTGUI_BASE64_NEON
+
+//-----------------------------------------------------------------------------
+/** decode whole groups of four characters, none of them is the padded end of the data */
+size_t decodeGroups (Base64Codec::Implementation impl, const uint8_t* input, size_t numChars,
+                     uint8_t* output)
+{
+	size_t consumed = 0;
+	switch (impl)
+	{
+#if VSTGUI_BASE64_X86
+		case Base64Codec::Implementation::AVX2:
+			consumed = decodeAVX2 (input, numChars, output);
+			break;
+		case Base64Codec::Implementation::SSSE3:
+			consumed = decodeSSSE3 (input, numChars, output);
+			break;
+#endif
+#if VSTGUI_BASE64_NEON
+		case Base64Codec::Implementation::NEON:
+			consumed = decodeNEON (input, numChars, output);
+			break;
+#endif
+		default:
+			break;
+	}
+	auto written = consumed / 4 * 3;
+	return written + decodeScalar (input + consumed, numChars - consumed, output + written);
+}
+
+//-----------------------------------------------------------------------------
+/** encode whole groups of three bytes */
+size_t encodeGroups (Base64Codec::Implementation impl, const uint8_t* input, size_t numBytes,
+                     uint8_t* output)
+{
+	size_t consumed = 0;
+	switch (impl)
+	{
+#if VSTGUI_BASE64_X86
+		case Base64Codec::Implementation::AVX2:
+			consumed = encodeAVX2 (input, numBytes, output);
+			break;
+		case Base64Codec::Implementation::SSSE3:
+			consumed = encodeSSSE3 (input, numBytes, output);
+			break;
+#endif
+#if VSTGUI_BASE64_NEON
+		case Base64Codec::Implementation::NEON:
+			consumed = encodeNEON (input, numBytes, output);
+			break;
+#endif
+		default:
+			break;
+	}
+	auto written = consumed / 3 * 4;
+	return written + encodeScalar (input + consumed, numBytes - consumed, output + written);
+}
+
+//-----------------------------------------------------------------------------
+Base64Codec::Implementation bestImplementation ()
+{
+	for (auto impl : {Base64Codec::Implementation::AVX2, Base64Codec::Implementation::SSSE3,
+	                  Base64Codec::Implementation::NEON})
+	{
+		if (Base64Codec::isAvailable (impl))
+			return impl;
+	}
+	return Base64Codec::Implementation::Scalar;
+}
+
+//-----------------------------------------------------------------------------
+std::atomic<Base64Codec::Implementation>& selectedImplementation ()
+{
+	static std::atomic<Base64Codec::Implementation> gImplementation {bestImplementation ()};
+	return gImplementation;
+}
+
+//-----------------------------------------------------------------------------
+} // anonymous
+
+//-----------------------------------------------------------------------------
+bool Base64Codec::isAvailable (Implementation impl)
+{
+	switch (impl)
+	{
+		case Implementation::Scalar:
+			return true;
+#if VSTGUI_BASE64_X86
+		case Implementation::SSSE3:
+			return cpuSupportsSSSE3 ();
+		case Implementation::AVX2:
+			return cpuSupportsSSSE3 () && cpuSupportsAVX2 ();
+#endif
+#if VSTGUI_BASE64_NEON
+		case Implementation::NEON:
+			return true;
+#endif
+		default:
+			return false;
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool Base64Codec::setImplementation (Implementation impl)
+{
+	if (!isAvailable (impl))
+		return false;
+	selectedImplementation ().store (impl);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+auto Base64Codec::getImplementation () -> Implementation
+{
+	return selectedImplementation ().load ();
+}
+
+//-----------------------------------------------------------------------------
+const char* Base64Codec::getImplementationName (Implementation impl)
+{
+	switch (impl)
+	{
+		case Implementation::Scalar:
+			return "Scalar";
+		case Implementation::SSSE3:
+			return "SSSE3";
+		case Implementation::AVX2:
+			return "AVX2";
+		case Implementation::NEON:
+			return "NEON";
+	}
+	return "";
+}
+
+//-----------------------------------------------------------------------------
+size_t Base64Codec::Decoder::decode (const void* inputData, size_t inputSize, uint8_t* output)
+{
+	auto input = static_cast<const uint8_t*> (inputData);
+	auto total = numPending + inputSize;
+	if (total <= 4)
+	{
+		std::copy (input, input + inputSize, pending + numPending);
+		numPending = static_cast<uint32_t> (total);
+		return 0;
+	}
+	// the last one to four characters may be the padded end of the data
+	size_t keep = total % 4 ? total % 4 : 4;
+	size_t numChars = total - keep;
+	size_t written = 0;
+	if (numPending)
+	{
+		auto fill = 4 - numPending;
+		std::copy (input, input + fill, pending + numPending);
+		written = decodeScalar (pending, 4, output);
+		input += fill;
+		numChars -= 4;
+	}
+	written += decodeGroups (getImplementation (), input, numChars, output + written);
+	input += numChars;
+	std::copy (input, input + keep, pending);
+	numPending = static_cast<uint32_t> (keep);
+	return written;
+}
+
+//-----------------------------------------------------------------------------
+size_t Base64Codec::Decoder::finish (uint8_t* output)
+{
+	if (numPending == 0)
+		return 0;
+	uint8_t block[4] = {'=', '=', '=', '='};
+	std::copy (pending, pending + numPending, block);
+	numPending = 0;
+	return decodeFinalBlock (block, output);
+}
+
+//-----------------------------------------------------------------------------
+size_t Base64Codec::decode (const void* input, size_t inputSize, uint8_t* output)
+{
+	Decoder decoder;
+	auto written = decoder.decode (input, inputSize, output);
+	return written + decoder.finish (output + written);
+}
+
+//-----------------------------------------------------------------------------
+bool Base64Codec::decode (const void* input, size_t inputSize, OutputStream& stream)
+{
+	static constexpr size_t kChunkSize = 64 * 1024;
+	Buffer<uint8_t> buffer (getMaxDecodedSize (kChunkSize));
+	auto write = [&] (size_t numBytes) {
+		return numBytes == 0 ||
+		       stream.writeRaw (buffer.get (), static_cast<uint32_t> (numBytes)) == numBytes;
+	};
+	Decoder decoder;
+	auto ptr = static_cast<const uint8_t*> (input);
+	while (inputSize)
+	{
+		auto size = std::min (inputSize, kChunkSize);
+		if (!write (decoder.decode (ptr, size, buffer.get ())))
+			return false;
+		ptr += size;
+		inputSize -= size;
+	}
+	return write (decoder.finish (buffer.get ()));
+}
+
+//-----------------------------------------------------------------------------
+size_t Base64Codec::encode (const void* binaryData, size_t binaryDataSize, uint8_t* output)
+{
+	auto input = static_cast<const uint8_t*> (binaryData);
+	auto numBytes = binaryDataSize / 3 * 3;
+	auto written = encodeGroups (getImplementation (), input, numBytes, output);
+	auto remaining = binaryDataSize - numBytes;
+	if (remaining)
+	{
+		uint8_t block[3] = {input[numBytes], remaining > 1 ? input[numBytes + 1] : uint8_t (0), 0};
+		uint8_t* out = output + written;
+		encodeScalar (block, 3, out);
+		out[3] = '=';
+		if (remaining == 1)
+			out[2] = '=';
+		written += 4;
+	}
+	return written;
+}
+
+} // VSTGUI
@@ -0,0 +1,798 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "uibinarypersistence.h"
+#include "../../lib/crect.h"
+#include "../../lib/malloc.h"
+#include "../base64codec.h"
+#include "../uiattributes.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+#if MAC || LINUX
+#include "../../lib/finally.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+namespace UIBinaryDesc {
+
+//------------------------------------------------------------------------
+static constexpr uint8_t kIdentifier[8] = {'V', 'S', 'T', 'G', 'U', 'I', 'B', 'D'};
+static constexpr uint32_t kVersion = 1;
+static constexpr uint32_t kNoIndex = 0xffffffff;
+/** the writer does not create larger files, the reader must not trust the size in the header */
+static constexpr uint64_t kMaxFileSize = std::numeric_limits<uint32_t>::max ();
+/** the children of the nodes at this depth are created when they are accessed */
+static constexpr uint32_t kLazyChildrenDepth = 2;
+
+//------------------------------------------------------------------------
+enum class NodeKind : uint32_t
+{
+	Node,
+	Comment,
+	Variable,
+	ControlTag,
+	Bitmap,
+	Font,
+	Color,
+	Gradient,
+	Last = Gradient
+};
+
+//------------------------------------------------------------------------
+enum NodeFlags : uint32_t
+{
+	kFastChildNameAttributeLookup = 1 << 0,
+};
+
+//------------------------------------------------------------------------
+enum class ValueType : uint32_t
+{
+	String,
+	Bool,
+	Integer,
+	Double,
+	Point,
+	Rect,
+	Color,
+	Last = Color
+};
+
+//------------------------------------------------------------------------
+struct Header
+{
+	uint8_t identifier[8];
+	uint32_t version;
+	uint32_t numStrings;
+	uint32_t numNodes;
+	uint32_t numAttributes;
+	uint32_t numBlobs;
+	uint32_t reserved;
+	uint64_t stringsOffset;
+	uint64_t nodesOffset;
+	uint64_t attributesOffset;
+	uint64_t blobsOffset;
+	uint64_t fileSize;
+};
+
+//------------------------------------------------------------------------
+struct StringRecord
+{
+	uint64_t offset;
+	uint32_t size; // without the terminating zero
+	uint32_t reserved;
+};
+
+//------------------------------------------------------------------------
+struct NodeRecord
+{
+	uint32_t name;
+	NodeKind kind;
+	uint32_t flags;
+	uint32_t firstAttribute;
+	uint32_t numAttributes;
+	uint32_t firstChild;
+	uint32_t numChildren;
+	uint32_t data;
+	uint32_t blob;
+	uint32_t reserved;
+};
+
+//------------------------------------------------------------------------
+struct AttributeRecord
+{
+	uint32_t key;
+	uint32_t value;
+	ValueType type;
+	uint32_t reserved;
+	double values[4];
+};
+
+//------------------------------------------------------------------------
+struct BlobRecord
+{
+	uint64_t offset;
+	uint64_t size;
+};
+
+static_assert (sizeof (Header) == 72, "");
+static_assert (sizeof (StringRecord) == 16, "");
+static_assert (sizeof (NodeRecord) == 40, "");
+static_assert (sizeof (AttributeRecord) == 48, "");
+static_assert (sizeof (BlobRecord) == 16, "");
+
+//------------------------------------------------------------------------
+static constexpr uint64_t alignedSize (uint64_t size)
+{
+	return (size + 7) & ~static_cast<uint64_t> (7);
+}
+
+//------------------------------------------------------------------------
+/** the tables are used directly, so the format can only be used on little endian hosts */
+static bool isLittleEndianHost ()
+{
+	const uint16_t value = 1;
+	return *reinterpret_cast<const uint8_t*> (&value) == 1;
+}
+
+//------------------------------------------------------------------------
+/** the memory of a binary UI description, shared by all nodes created from it */
+class Document : public NonAtomicReferenceCounted
+{
+public:
+	explicit Document (Buffer<uint8_t>&& buffer)
+	: buffer (std::move (buffer)), data (this->buffer.get ()), size (this->buffer.size ())
+	{
+	}
+
+#if MAC || LINUX
+	Document (void* mappedData, size_t size)
+	: data (static_cast<const uint8_t*> (mappedData)), size (size), mapped (true)
+	{
+	}
+#endif
+
+	~Document () noexcept override
+	{
+#if MAC || LINUX
+		if (mapped)
+			munmap (const_cast<uint8_t*> (data), size);
+#endif
+	}
+
+	bool validate () const;
+	UINode* createNode (uint32_t index, uint32_t depth);
+
+private:
+	template <typename T>
+	const T* table (uint64_t offset) const
+	{
+		return reinterpret_cast<const T*> (data + offset);
+	}
+	template <typename T>
+	bool validTable (uint64_t offset, uint32_t count) const
+	{
+		return offset % 8 == 0 && offset <= size && (size - offset) / sizeof (T) >= count;
+	}
+
+	const Header& header () const { return *table<Header> (0); }
+	const StringRecord* strings () const { return table<StringRecord> (header ().stringsOffset); }
+	const NodeRecord* nodes () const { return table<NodeRecord> (header ().nodesOffset); }
+	const AttributeRecord* attributes () const
+	{
+		return table<AttributeRecord> (header ().attributesOffset);
+	}
+	const BlobRecord* blobs () const { return table<BlobRecord> (header ().blobsOffset); }
+
+	const char* getCString (uint32_t index) const
+	{
+		return reinterpret_cast<const char*> (data + strings ()[index].offset);
+	}
+	std::string getString (uint32_t index) const
+	{
+		return std::string (reinterpret_cast<const char*> (data + strings ()[index].offset),
+		                    strings ()[index].size);
+	}
+
+	UIAttributeAtom getAtom (uint32_t index)
+	{
+		if (atoms.empty ())
+			atoms.resize (header ().numStrings);
+		auto& atom = atoms[index];
+		if (!atom.isValid ())
+			atom = UIAttributeAtom (getString (index));
+		return atom;
+	}
+
+	void createChildren (UIDescList& children, uint32_t index, uint32_t depth);
+
+	std::vector<UIAttributeAtom> atoms;
+	Buffer<uint8_t> buffer;
+	const uint8_t* data {nullptr};
+	size_t size {0};
+	bool mapped {false};
+};
+
+//------------------------------------------------------------------------
+bool Document::validate () const
+{
+	if (size < sizeof (Header) || !UIBinaryDescReader::isBinaryDesc (data, size))
+		return false;
+	const auto& h = header ();
+	if (h.version != kVersion || h.fileSize != size || h.numNodes == 0)
+		return false;
+	if (!validTable<StringRecord> (h.stringsOffset, h.numStrings) ||
+	    !validTable<NodeRecord> (h.nodesOffset, h.numNodes) ||
+	    !validTable<AttributeRecord> (h.attributesOffset, h.numAttributes) ||
+	    !validTable<BlobRecord> (h.blobsOffset, h.numBlobs))
+		return false;
+	for (auto i = 0u; i < h.numStrings; ++i)
+	{
+		const auto& s = strings ()[i];
+		if (s.offset >= size || size - s.offset <= s.size || data[s.offset + s.size] != 0)
+			return false;
+	}
+	for (auto i = 0u; i < h.numAttributes; ++i)
+	{
+		const auto& a = attributes ()[i];
+		if (a.key >= h.numStrings || a.value >= h.numStrings || a.type > ValueType::Last)
+			return false;
+	}
+	for (auto i = 0u; i < h.numBlobs; ++i)
+	{
+		const auto& b = blobs ()[i];
+		if (b.offset > size || size - b.offset < b.size)
+			return false;
+	}
+	for (auto i = 0u; i < h.numNodes; ++i)
+	{
+		const auto& n = nodes ()[i];
+		if (n.name >= h.numStrings || n.kind > NodeKind::Last)
+			return false;
+		if (n.firstAttribute > h.numAttributes || h.numAttributes - n.firstAttribute < n.numAttributes)
+			return false;
+		// the children always follow their parent, so the nodes cannot form a cycle
+		if (n.numChildren && (n.firstChild <= i || n.firstChild > h.numNodes ||
+		                      h.numNodes - n.firstChild < n.numChildren))
+			return false;
+		if ((n.data != kNoIndex && n.data >= h.numStrings) ||
+		    (n.blob != kNoIndex && n.blob >= h.numBlobs))
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+static UIAttributes::ParsedType toParsedType (ValueType type)
+{
+	switch (type)
+	{
+		case ValueType::Bool: return UIAttributes::ParsedType::Boolean;
+		case ValueType::Integer: return UIAttributes::ParsedType::Integer;
+		case ValueType::Double: return UIAttributes::ParsedType::Double;
+		case ValueType::Point: return UIAttributes::ParsedType::Point;
+		case ValueType::Rect: return UIAttributes::ParsedType::Rect;
+		default: break;
+	}
+	return UIAttributes::ParsedType::None;
+}
+
+//------------------------------------------------------------------------
+UINode* Document::createNode (uint32_t index, uint32_t depth)
+{
+	const auto& record = nodes ()[index];
+	auto name = getString (record.name);
+	auto nodeAttributes = makeOwned<UIAttributes> (static_cast<size_t> (record.numAttributes));
+	const AttributeRecord* typedValue = nullptr;
+	for (auto i = record.firstAttribute; i < record.firstAttribute + record.numAttributes; ++i)
+	{
+		const auto& attr = attributes ()[i];
+		if (record.kind == NodeKind::Node)
+		{
+			nodeAttributes->setParsedAttribute (getAtom (attr.key), getString (attr.value),
+			                                    toParsedType (attr.type), attr.values);
+			continue;
+		}
+		nodeAttributes->setAttribute (getAtom (attr.key), getString (attr.value));
+		switch (record.kind)
+		{
+			case NodeKind::Color:
+			{
+				if (attr.type == ValueType::Color)
+					typedValue = &attr;
+				break;
+			}
+			case NodeKind::Variable:
+			{
+				if (attr.type == ValueType::Double && strcmp (getCString (attr.key), "value") == 0)
+					typedValue = &attr;
+				break;
+			}
+			case NodeKind::ControlTag:
+			{
+				if (attr.type == ValueType::Integer && strcmp (getCString (attr.key), "tag") == 0)
+					typedValue = &attr;
+				break;
+			}
+			default: break;
+		}
+	}
+
+	UINode* node = nullptr;
+	switch (record.kind)
+	{
+		case NodeKind::Node:
+		{
+			node = new UINode (name, nodeAttributes,
+			                   (record.flags & kFastChildNameAttributeLookup) != 0);
+			break;
+		}
+		case NodeKind::Comment:
+		{
+			node = new UICommentNode ({});
+			break;
+		}
+		case NodeKind::Variable:
+		{
+			if (typedValue)
+				node = new UIVariableNode (name, nodeAttributes, UIVariableNode::kNumber,
+				                           typedValue->values[0]);
+			else
+				node = new UIVariableNode (name, nodeAttributes);
+			break;
+		}
+		case NodeKind::ControlTag:
+		{
+			auto tagNode = new UIControlTagNode (name, nodeAttributes);
+			if (typedValue)
+				tagNode->setTag (static_cast<int32_t> (typedValue->values[0]));
+			node = tagNode;
+			break;
+		}
+		case NodeKind::Bitmap:
+		{
+			auto bitmapNode = new UIBitmapNode (name, nodeAttributes);
+			if (record.blob != kNoIndex)
+			{
+				const auto& blob = blobs ()[record.blob];
+				bitmapNode->setEncodedImageData (SharedPointer<IReference> (this),
+				                                 data + blob.offset, static_cast<size_t> (blob.size));
+			}
+			node = bitmapNode;
+			break;
+		}
+		case NodeKind::Font:
+		{
+			node = new UIFontNode (name, nodeAttributes);
+			break;
+		}
+		case NodeKind::Color:
+		{
+			if (typedValue)
+			{
+				CColor color (static_cast<uint8_t> (typedValue->values[0]),
+				              static_cast<uint8_t> (typedValue->values[1]),
+				              static_cast<uint8_t> (typedValue->values[2]),
+				              static_cast<uint8_t> (typedValue->values[3]));
+				node = new UIColorNode (name, nodeAttributes, color);
+			}
+			else
+				node = new UIColorNode (name, nodeAttributes);
+			break;
+		}
+		case NodeKind::Gradient:
+		{
+			node = new UIGradientNode (name, nodeAttributes);
+			break;
+		}
+	}
+	if (record.data != kNoIndex)
+		node->setData (getString (record.data));
+	if (record.numChildren)
+	{
+		if (depth < kLazyChildrenDepth)
+		{
+			createChildren (node->getChildren (), index, depth + 1);
+		}
+		else
+		{
+			SharedPointer<Document> self (this);
+			node->setChildrenLoader ([self, index, depth] (UIDescList& children) {
+				self->createChildren (children, index, depth + 1);
+			});
+		}
+	}
+	return node;
+}
+
+//------------------------------------------------------------------------
+void Document::createChildren (UIDescList& children, uint32_t index, uint32_t depth)
+{
+	const auto& record = nodes ()[index];
+	for (auto i = record.firstChild; i < record.firstChild + record.numChildren; ++i)
+		children.add (createNode (i, depth));
+}
+
+//------------------------------------------------------------------------
+static SharedPointer<UINode> createRootNode (const SharedPointer<Document>& document)
+{
+	if (!document->validate ())
+		return nullptr;
+	return owned (document->createNode (0, 0));
+}
+
+//------------------------------------------------------------------------
+static bool readAll (IContentProvider& contentProvider, uint8_t* buffer, size_t size)
+{
+	while (size)
+	{
+		auto chunk = static_cast<uint32_t> (std::min<size_t> (size, 1024 * 1024));
+		auto numRead = contentProvider.readRawData (reinterpret_cast<int8_t*> (buffer), chunk);
+		if (numRead == 0 || numRead == kStreamIOError)
+			return false;
+		buffer += numRead;
+		size -= numRead;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // UIBinaryDesc
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescReader {
+
+using namespace UIBinaryDesc;
+
+//------------------------------------------------------------------------
+bool isBinaryDesc (const void* data, size_t size)
+{
+	if (!isLittleEndianHost ())
+		return false;
+	return size >= sizeof (kIdentifier) && memcmp (data, kIdentifier, sizeof (kIdentifier)) == 0;
+}
+
+//------------------------------------------------------------------------
+SharedPointer<UINode> read (IContentProvider& contentProvider)
+{
+	Header header;
+	if (!readAll (contentProvider, reinterpret_cast<uint8_t*> (&header), sizeof (header)) ||
+	    !isBinaryDesc (&header, sizeof (header)) || header.fileSize < sizeof (header) ||
+	    header.fileSize > kMaxFileSize || header.fileSize > std::numeric_limits<size_t>::max ())
+	{
+		contentProvider.rewind ();
+		return nullptr;
+	}
+	Buffer<uint8_t> buffer (static_cast<size_t> (header.fileSize));
+	if (buffer.get () == nullptr)
+	{
+		contentProvider.rewind ();
+		return nullptr;
+	}
+	memcpy (buffer.get (), &header, sizeof (header));
+	if (!readAll (contentProvider, buffer.get () + sizeof (header),
+	              buffer.size () - sizeof (header)))
+	{
+		contentProvider.rewind ();
+		return nullptr;
+	}
+	return createRootNode (makeOwned<Document> (std::move (buffer)));
+}
+
+//------------------------------------------------------------------------
+SharedPointer<UINode> read (UTF8StringPtr path)
+{
+#if MAC || LINUX
+	auto fd = ::open (path, O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+	auto closeFile = finally ([fd] () { ::close (fd); });
+	Header header;
+	if (::read (fd, &header, sizeof (header)) != sizeof (header) ||
+	    !isBinaryDesc (&header, sizeof (header)))
+		return nullptr;
+	struct stat fileStat;
+	if (fstat (fd, &fileStat) != 0 || static_cast<uint64_t> (fileStat.st_size) != header.fileSize)
+		return nullptr;
+	auto size = static_cast<size_t> (fileStat.st_size);
+	auto mappedData = mmap (nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (mappedData == MAP_FAILED)
+		return nullptr;
+	return createRootNode (makeOwned<Document> (mappedData, size));
+#else
+	CFileStream stream;
+	if (!stream.open (path, CFileStream::kReadMode | CFileStream::kBinaryMode,
+	                  kLittleEndianByteOrder))
+		return nullptr;
+	InputStreamContentProvider contentProvider (stream);
+	return read (contentProvider);
+#endif
+}
+
+//------------------------------------------------------------------------
+} // UIBinaryDescReader
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescWriter {
+
+using namespace UIBinaryDesc;
+
+//------------------------------------------------------------------------
+struct Writer
+{
+	std::vector<StringRecord> strings;
+	std::string stringData;
+	std::unordered_map<std::string, uint32_t> stringIndices;
+	std::vector<NodeRecord> nodes;
+	std::vector<AttributeRecord> attributes;
+	std::vector<Buffer<uint8_t>> blobs;
+
+	uint32_t intern (const std::string& str)
+	{
+		auto it = stringIndices.find (str);
+		if (it != stringIndices.end ())
+			return it->second;
+		auto index = static_cast<uint32_t> (strings.size ());
+		strings.push_back ({stringData.size (), static_cast<uint32_t> (str.size ()), 0});
+		stringData.append (str);
+		stringData.push_back (0);
+		stringIndices.emplace (str, index);
+		return index;
+	}
+
+	static NodeKind getKind (UINode* node)
+	{
+		if (dynamic_cast<UICommentNode*> (node))
+			return NodeKind::Comment;
+		if (dynamic_cast<UIVariableNode*> (node))
+			return NodeKind::Variable;
+		if (dynamic_cast<UIControlTagNode*> (node))
+			return NodeKind::ControlTag;
+		if (dynamic_cast<UIBitmapNode*> (node))
+			return NodeKind::Bitmap;
+		if (dynamic_cast<UIFontNode*> (node))
+			return NodeKind::Font;
+		if (dynamic_cast<UIColorNode*> (node))
+			return NodeKind::Color;
+		if (dynamic_cast<UIGradientNode*> (node))
+			return NodeKind::Gradient;
+		return NodeKind::Node;
+	}
+
+	static void setTypedValue (AttributeRecord& record, UINode* node, NodeKind kind,
+	                           const std::string& key, const std::string& value)
+	{
+		record.type = ValueType::String;
+		switch (kind)
+		{
+			case NodeKind::Color:
+			{
+				if (key == "rgba" || key == "rgb")
+				{
+					const auto& color = static_cast<UIColorNode*> (node)->getColor ();
+					record.type = ValueType::Color;
+					record.values[0] = color.red;
+					record.values[1] = color.green;
+					record.values[2] = color.blue;
+					record.values[3] = color.alpha;
+				}
+				break;
+			}
+			case NodeKind::Variable:
+			{
+				auto variableNode = static_cast<UIVariableNode*> (node);
+				if (key == "value" && variableNode->getType () == UIVariableNode::kNumber)
+				{
+					record.type = ValueType::Double;
+					record.values[0] = variableNode->getNumber ();
+				}
+				break;
+			}
+			case NodeKind::ControlTag:
+			{
+				auto tag = static_cast<UIControlTagNode*> (node)->getTag ();
+				if (key == "tag" && tag != -1)
+				{
+					record.type = ValueType::Integer;
+					record.values[0] = tag;
+				}
+				break;
+			}
+			case NodeKind::Node:
+			{
+				bool b;
+				int32_t i;
+				double d;
+				CPoint p;
+				CRect r;
+				if (UIAttributes::stringToBool (value, b))
+				{
+					record.type = ValueType::Bool;
+					record.values[0] = b ? 1. : 0.;
+				}
+				else if (UIAttributes::stringToInteger (value, i))
+				{
+					record.type = ValueType::Integer;
+					record.values[0] = i;
+				}
+				else if (UIAttributes::stringToDouble (value, d))
+				{
+					record.type = ValueType::Double;
+					record.values[0] = d;
+				}
+				else if (UIAttributes::stringToPoint (value, p))
+				{
+					record.type = ValueType::Point;
+					record.values[0] = p.x;
+					record.values[1] = p.y;
+				}
+				else if (UIAttributes::stringToRect (value, r))
+				{
+					record.type = ValueType::Rect;
+					record.values[0] = r.left;
+					record.values[1] = r.top;
+					record.values[2] = r.right;
+					record.values[3] = r.bottom;
+				}
+				break;
+			}
+			default: break;
+		}
+	}
+
+	/** returns the data node which was converted to the blob */
+	UINode* addBitmapBlob (NodeRecord& record, UIBitmapNode* bitmapNode)
+	{
+		Buffer<uint8_t> blob;
+		auto dataNode = bitmapNode->getChildren ().findChildNode ("data");
+		if (dataNode)
+		{
+			auto encoding = dataNode->getAttributes ()->getAttributeValue ("encoding");
+			if (encoding && *encoding == "base64" && !dataNode->getData ().empty ())
+			{
+				auto result = Base64Codec::decode (dataNode->getData ());
+				blob.allocate (result.dataSize);
+				memcpy (blob.get (), result.data.get (), result.dataSize);
+			}
+			else
+				dataNode = nullptr;
+		}
+		const void* encodedData;
+		size_t encodedDataSize;
+		if (!dataNode && bitmapNode->getEncodedImageData (encodedData, encodedDataSize))
+		{
+			blob.allocate (encodedDataSize);
+			memcpy (blob.get (), encodedData, encodedDataSize);
+		}
+		if (!blob.empty ())
+		{
+			record.blob = static_cast<uint32_t> (blobs.size ());
+			blobs.emplace_back (std::move (blob));
+		}
+		return dataNode;
+	}
+
+	void addNodes (UINode* rootNode)
+	{
+		// breadth first, so that the children of every node are consecutive
+		std::vector<UINode*> queue {rootNode};
+		for (size_t index = 0; index < queue.size (); ++index)
+		{
+			auto node = queue[index];
+			NodeRecord record {};
+			record.name = intern (node->getName ());
+			record.kind = getKind (node);
+			record.data = node->getData ().empty () ? kNoIndex : intern (node->getData ());
+			record.blob = kNoIndex;
+			if (dynamic_cast<UIDescListWithFastFindAttributeNameChild*> (&node->getChildren ()))
+				record.flags |= kFastChildNameAttributeLookup;
+
+			record.firstAttribute = static_cast<uint32_t> (attributes.size ());
+			for (const auto& attr : *node->getAttributes ())
+			{
+				AttributeRecord attrRecord {};
+				attrRecord.key = intern (attr.first);
+				attrRecord.value = intern (attr.second);
+				setTypedValue (attrRecord, node, record.kind, attr.first, attr.second);
+				attributes.emplace_back (attrRecord);
+			}
+			record.numAttributes = static_cast<uint32_t> (attributes.size ()) - record.firstAttribute;
+
+			UINode* skipChild = nullptr;
+			if (record.kind == NodeKind::Bitmap)
+				skipChild = addBitmapBlob (record, static_cast<UIBitmapNode*> (node));
+			record.firstChild = static_cast<uint32_t> (queue.size ());
+			for (auto child : node->getChildren ())
+			{
+				if (child == skipChild || child->noExport ())
+					continue;
+				queue.emplace_back (child);
+			}
+			record.numChildren = static_cast<uint32_t> (queue.size ()) - record.firstChild;
+			if (record.numChildren == 0)
+				record.firstChild = 0;
+			nodes.emplace_back (record);
+		}
+	}
+
+	bool write (OutputStream& stream)
+	{
+		Header header {};
+		memcpy (header.identifier, kIdentifier, sizeof (kIdentifier));
+		header.version = kVersion;
+		header.numStrings = static_cast<uint32_t> (strings.size ());
+		header.numNodes = static_cast<uint32_t> (nodes.size ());
+		header.numAttributes = static_cast<uint32_t> (attributes.size ());
+		header.numBlobs = static_cast<uint32_t> (blobs.size ());
+		header.stringsOffset = sizeof (Header);
+		header.nodesOffset = header.stringsOffset + strings.size () * sizeof (StringRecord);
+		header.attributesOffset = header.nodesOffset + nodes.size () * sizeof (NodeRecord);
+		header.blobsOffset = header.attributesOffset + attributes.size () * sizeof (AttributeRecord);
+		auto stringDataOffset = header.blobsOffset + blobs.size () * sizeof (BlobRecord);
+		auto blobDataOffset = alignedSize (stringDataOffset + stringData.size ());
+
+		for (auto& s : strings)
+			s.offset += stringDataOffset;
+		std::vector<BlobRecord> blobRecords;
+		auto offset = blobDataOffset;
+		for (const auto& blob : blobs)
+		{
+			blobRecords.push_back ({offset, blob.size ()});
+			offset = alignedSize (offset + blob.size ());
+		}
+		header.fileSize = offset;
+		if (header.fileSize > kMaxFileSize)
+			return false;
+
+		uint64_t pos = 0;
+		auto writeRaw = [&] (const void* data, size_t size) {
+			if (size == 0)
+				return true;
+			pos += size;
+			return stream.writeRaw (data, static_cast<uint32_t> (size)) == size;
+		};
+		auto writePadding = [&] () {
+			static constexpr uint8_t zeros[8] = {};
+			return writeRaw (zeros, static_cast<size_t> (alignedSize (pos) - pos));
+		};
+		if (!writeRaw (&header, sizeof (header)) ||
+		    !writeRaw (strings.data (), strings.size () * sizeof (StringRecord)) ||
+		    !writeRaw (nodes.data (), nodes.size () * sizeof (NodeRecord)) ||
+		    !writeRaw (attributes.data (), attributes.size () * sizeof (AttributeRecord)) ||
+		    !writeRaw (blobRecords.data (), blobRecords.size () * sizeof (BlobRecord)) ||
+		    !writeRaw (stringData.data (), stringData.size ()) || !writePadding ())
+			return false;
+		for (const auto& blob : blobs)
+		{
+			if (!writeRaw (blob.get (), blob.size ()) || !writePadding ())
+				return false;
+		}
+		return pos == header.fileSize;
+	}
+};
+
+//------------------------------------------------------------------------
+bool write (OutputStream& stream, UINode* rootNode)
+{
+	if (!isLittleEndianHost ())
+		return false;
+	Writer writer;
+	writer.addNodes (rootNode);
+	return writer.write (stream);
+}
+
+//------------------------------------------------------------------------
+} // UIBinaryDescWriter
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
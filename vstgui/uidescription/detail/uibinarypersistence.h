@@ -0,0 +1,67 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../cstream.h"
+#include "../icontentprovider.h"
+#include "uinode.h"
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+/** @page uidescription_binary_format Binary UI Description Format
+ *
+ *	A precompiled UI description laid out to be used directly from a memory mapped file. All
+ *	values are little endian and all tables are 8 byte aligned:
+ *
+ *	- header (identifier, version, table offsets and sizes)
+ *	- string table: every string (node names, attribute keys and values) is stored only once and
+ *	  referenced by its index
+ *	- node table: the nodes in breadth first order, so that the children of a node are consecutive
+ *	- attribute table: the attributes of a node are consecutive, every attribute has its string
+ *	  value and the value already parsed to its type (bool, integer, double, point, rect or color).
+ *	  The parsed values of view attributes fill the typed cache of UIAttributes, the ones of the
+ *	  resources are used to create the color, variable and control tag nodes
+ *	- blob table: the encoded image data of the bitmaps, not base64 encoded
+ *
+ *	The reader creates the resource and template nodes immediately, the children of them (the
+ *	views of a template, the stops of a gradient) are created when they are accessed the first
+ *	time.
+ */
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescReader {
+
+//------------------------------------------------------------------------
+/** check if the data starts with the identifier of the binary format */
+bool isBinaryDesc (const void* data, size_t size);
+
+//------------------------------------------------------------------------
+/** read the content into memory and build the node tree from it */
+SharedPointer<UINode> read (IContentProvider& contentProvider);
+
+//------------------------------------------------------------------------
+/** map the file into memory and build the node tree from it
+ *
+ *	returns nullptr without reading the whole file if it is not in the binary format
+ */
+SharedPointer<UINode> read (UTF8StringPtr path);
+
+//------------------------------------------------------------------------
+} // UIBinaryDescReader
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescWriter {
+
+//------------------------------------------------------------------------
+bool write (OutputStream& stream, UINode* rootNode);
+
+//------------------------------------------------------------------------
+} // UIBinaryDescWriter
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
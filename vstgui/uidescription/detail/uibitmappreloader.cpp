@@ -0,0 +1,212 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "uibitmappreloader.h"
+#include "../../lib/cresourcedescription.h"
+#include "../../lib/platform/platformfactory.h"
+#include "../base64codec.h"
+#include <algorithm>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+bool BitmapDecodeJob::start ()
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	if (state != State::Queued)
+		return false;
+	state = State::Decoding;
+	return true;
+}
+
+//------------------------------------------------------------------------
+PlatformBitmapPtr BitmapDecodeJob::load () const
+{
+	const auto& factory = getPlatformFactory ();
+	auto bitmap = factory.createBitmap (CResourceDescription (path.data ()));
+	if (!bitmap && !absolutePath.empty ())
+		bitmap = factory.createBitmapFromPath (absolutePath.data ());
+	if (!bitmap)
+	{
+		if (base64Data)
+		{
+			auto data = Base64Codec::decode (*base64Data);
+			bitmap = factory.createBitmapFromMemory (data.data.get (), data.dataSize);
+		}
+		else if (encodedData)
+		{
+			bitmap = factory.createBitmapFromMemory (encodedData,
+			                                         static_cast<uint32_t> (encodedDataSize));
+		}
+		if (bitmap && scaleFactor != 0.)
+			bitmap->setScaleFactor (scaleFactor);
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+void BitmapDecodeJob::decode ()
+{
+	auto startTime = Clock::now ();
+	auto bitmap = load ();
+	auto endTime = Clock::now ();
+
+	std::lock_guard<std::mutex> guard (mutex);
+	result = bitmap;
+	decodeTime = endTime - startTime;
+	finishTime = endTime;
+	state = State::Finished;
+	finished.notify_all ();
+}
+
+//------------------------------------------------------------------------
+void BitmapDecodeJob::run ()
+{
+	if (start ())
+		decode ();
+}
+
+//------------------------------------------------------------------------
+PlatformBitmapPtr BitmapDecodeJob::wait ()
+{
+	auto startTime = Clock::now ();
+	if (start ())
+		decode ();
+	std::unique_lock<std::mutex> lock (mutex);
+	finished.wait (lock, [this] () { return state == State::Finished; });
+	waitTime = Clock::now () - startTime;
+	return result;
+}
+
+//------------------------------------------------------------------------
+void BitmapDecodeJob::cancel ()
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	if (state == State::Queued)
+	{
+		state = State::Finished;
+		finishTime = Clock::now ();
+		return;
+	}
+	finished.wait (lock, [this] () { return state == State::Finished; });
+}
+
+//------------------------------------------------------------------------
+bool BitmapDecodeJob::isFinished () const
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	return state == State::Finished;
+}
+
+//------------------------------------------------------------------------
+auto BitmapDecodeJob::getDecodeTime () const -> Clock::duration
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	return decodeTime;
+}
+
+//------------------------------------------------------------------------
+auto BitmapDecodeJob::getWaitTime () const -> Clock::duration
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	return waitTime;
+}
+
+//------------------------------------------------------------------------
+auto BitmapDecodeJob::getFinishTime () const -> Clock::time_point
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	return finishTime;
+}
+
+//------------------------------------------------------------------------
+BitmapPreloader::~BitmapPreloader () noexcept
+{
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		queue.clear ();
+	}
+	for (auto& thread : threads)
+		thread.join ();
+}
+
+//------------------------------------------------------------------------
+void BitmapPreloader::add (const std::shared_ptr<BitmapDecodeJob>& job)
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	queue.emplace_back (job);
+	jobs.emplace_back (job);
+}
+
+//------------------------------------------------------------------------
+void BitmapPreloader::start (uint32_t numThreads)
+{
+	startTime = BitmapDecodeJob::Clock::now ();
+	if (numThreads == 0)
+		numThreads = std::max (std::thread::hardware_concurrency (), 1u);
+	numThreads = std::min (numThreads, static_cast<uint32_t> (queue.size ()));
+	threads.reserve (numThreads);
+	for (auto i = 0u; i < numThreads; ++i)
+		threads.emplace_back ([this] () { workerThread (); });
+}
+
+//------------------------------------------------------------------------
+std::shared_ptr<BitmapDecodeJob> BitmapPreloader::nextJob ()
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	if (queue.empty ())
+		return nullptr;
+	auto job = queue.front ();
+	queue.pop_front ();
+	return job;
+}
+
+//------------------------------------------------------------------------
+void BitmapPreloader::workerThread ()
+{
+	while (auto job = nextJob ())
+		job->run ();
+}
+
+//------------------------------------------------------------------------
+void BitmapPreloader::waitUntilFinished ()
+{
+	while (auto job = nextJob ())
+		job->run ();
+	for (auto& thread : threads)
+		thread.join ();
+	threads.clear ();
+}
+
+//------------------------------------------------------------------------
+auto BitmapPreloader::getStatistics () -> Statistics
+{
+	waitUntilFinished ();
+	Statistics statistics;
+	BitmapDecodeJob::Clock::duration decodeTime {};
+	BitmapDecodeJob::Clock::duration criticalPath {};
+	BitmapDecodeJob::Clock::duration waitTime {};
+	auto finishTime = startTime;
+	for (auto& job : jobs)
+	{
+		auto jobDecodeTime = job->getDecodeTime ();
+		decodeTime += jobDecodeTime;
+		criticalPath = std::max (criticalPath, jobDecodeTime);
+		waitTime += job->getWaitTime ();
+		finishTime = std::max (finishTime, job->getFinishTime ());
+	}
+	using Seconds = std::chrono::duration<double>;
+	statistics.numBitmaps = static_cast<uint32_t> (jobs.size ());
+	statistics.decodeTime = std::chrono::duration_cast<Seconds> (decodeTime).count ();
+	statistics.criticalPath = std::chrono::duration_cast<Seconds> (criticalPath).count ();
+	statistics.elapsedTime = std::chrono::duration_cast<Seconds> (finishTime - startTime).count ();
+	statistics.waitTime = std::chrono::duration_cast<Seconds> (waitTime).count ();
+	return statistics;
+}
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
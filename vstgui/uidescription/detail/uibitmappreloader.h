@@ -0,0 +1,118 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../lib/platform/iplatformbitmap.h"
+#include "../uidescription.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+/** Decodes the platform bitmap of a bitmap node, possibly on another thread
+ *
+ *	The sources are copied from the node when the job is created, so decoding does not touch the
+ *	node or its attributes, which are not thread safe. The node keeps its data node and its encoded image data alive until the job is finished
+ *	or canceled.
+ */
+class BitmapDecodeJob
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	/** the path of the bitmap resource */
+	std::string path;
+	/** the path next to the uidesc file, tried if the resource is not found */
+	std::string absolutePath;
+	/** base64 encoded image data of the data node */
+	const std::string* base64Data {nullptr};
+	/** encoded image data */
+	const void* encodedData {nullptr};
+	size_t encodedDataSize {0};
+	/** the scale factor of bitmaps decoded from data, 0 if not set */
+	double scaleFactor {0.};
+
+	/** decode the bitmap if no other thread is decoding it */
+	void run ();
+	/** wait until the bitmap is decoded, decodes it on the calling thread if no other thread
+	 *	started yet */
+	PlatformBitmapPtr wait ();
+	/** wait for a running decode, a queued job is not decoded anymore */
+	void cancel ();
+	/** decode the bitmap on the calling thread without changing the state of the job */
+	PlatformBitmapPtr load () const;
+
+	bool isFinished () const;
+	/** the time used to decode the bitmap */
+	Clock::duration getDecodeTime () const;
+	/** the time the caller of wait was blocked by the job */
+	Clock::duration getWaitTime () const;
+	Clock::time_point getFinishTime () const;
+
+private:
+	enum class State
+	{
+		Queued,
+		Decoding,
+		Finished,
+	};
+
+	bool start ();
+	void decode ();
+
+	mutable std::mutex mutex;
+	std::condition_variable finished;
+	State state {State::Queued};
+	PlatformBitmapPtr result;
+	Clock::duration decodeTime {};
+	Clock::duration waitTime {};
+	Clock::time_point finishTime {};
+};
+
+//------------------------------------------------------------------------
+/** Runs bitmap decode jobs on a pool of threads
+ *
+ *	The threads end when all jobs are done. The jobs which are not started when the preloader is
+ *	destroyed are left for the bitmap nodes to decode on demand.
+ */
+class BitmapPreloader
+{
+public:
+	using Statistics = UIDescription::BitmapPreloadStatistics;
+
+	BitmapPreloader () = default;
+	~BitmapPreloader () noexcept;
+
+	void add (const std::shared_ptr<BitmapDecodeJob>& job);
+	/** start the threads, 0 uses the number of hardware threads */
+	void start (uint32_t numThreads);
+	/** wait until all jobs are finished, helps decoding the queued jobs */
+	void waitUntilFinished ();
+	/** wait until all jobs are finished and return the statistics */
+	Statistics getStatistics ();
+
+private:
+	std::shared_ptr<BitmapDecodeJob> nextJob ();
+	void workerThread ();
+
+	std::mutex mutex;
+	std::deque<std::shared_ptr<BitmapDecodeJob>> queue;
+	std::vector<std::shared_ptr<BitmapDecodeJob>> jobs;
+	std::vector<std::thread> threads;
+	BitmapDecodeJob::Clock::time_point startTime;
+};
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
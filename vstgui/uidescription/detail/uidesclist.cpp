@@ -5,17 +5,29 @@
 #include "../uiattributes.h"
 #include "uidesclist.h"
 #include "uinode.h"
+#include <atomic>
 
 namespace VSTGUI {
 namespace Detail {
 
 //-----------------------------------------------------------------------------
-UIDescList::UIDescList (bool ownsObjects) : ownsObjects (ownsObjects)
+static uint64_t nextRevision ()
+{
+	static std::atomic<uint64_t> gRevision {0};
+	return ++gRevision;
+}
+
+//-----------------------------------------------------------------------------
+/** shorter lists are searched without an index */
+static constexpr size_t kNodeNameIndexMinSize = 8;
+
+//-----------------------------------------------------------------------------
+UIDescList::UIDescList (bool ownsObjects) : ownsObjects (ownsObjects), revision (nextRevision ())
 {
 }
 
 //------------------------------------------------------------------------
-UIDescList::UIDescList (const UIDescList& uiDesc) : ownsObjects (false)
+UIDescList::UIDescList (const UIDescList& uiDesc) : ownsObjects (false), revision (nextRevision ())
 {
 	for (auto& child : uiDesc)
 		add (child);
@@ -33,6 +45,9 @@ void UIDescList::add (UINode* obj)
 	if (!ownsObjects)
 		obj->remember ();
 	UIDescListContainerType::emplace_back (obj);
+	revision = nextRevision ();
+	if (nodeNameIndex)
+		nodeNameIndex->emplace (obj->getName (), obj);
 }
 
 //-----------------------------------------------------------------------------
@@ -43,6 +58,7 @@ void UIDescList::remove (UINode* obj)
 	if (pos != UIDescListContainerType::end ())
 	{
 		UIDescListContainerType::erase (pos);
+		changed ();
 		obj->forget ();
 	}
 }
@@ -53,18 +69,45 @@ void UIDescList::removeAll ()
 	for (const_reverse_iterator it = rbegin (), end = rend (); it != end; ++it)
 		(*it)->forget ();
 	clear ();
+	changed ();
+}
+
+//-----------------------------------------------------------------------------
+void UIDescList::changed ()
+{
+	revision = nextRevision ();
+	nodeNameIndex = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void UIDescList::nodeAttributeChanged (UINode* child, const std::string& attributeName,
+                                       const std::string& oldAttributeValue)
+{
+	changed ();
 }
 
 //-----------------------------------------------------------------------------
 UINode* UIDescList::findChildNode (UTF8StringView nodeName) const
 {
-	for (const auto& node : *this)
+	if (size () < kNodeNameIndexMinSize)
 	{
-		auto& name = node->getName ();
-		if (nodeName == UTF8StringView (name))
-			return node;
+		for (const auto& node : *this)
+		{
+			auto& name = node->getName ();
+			if (nodeName == UTF8StringView (name))
+				return node;
+		}
+		return nullptr;
 	}
-	return nullptr;
+	if (!nodeNameIndex)
+	{
+		nodeNameIndex = std::make_unique<NodeNameIndex> ();
+		nodeNameIndex->reserve (size ());
+		for (const auto& node : *this)
+			nodeNameIndex->emplace (node->getName (), node);
+	}
+	auto it = nodeNameIndex->find (static_cast<UTF8StringPtr> (nodeName));
+	return it != nodeNameIndex->end () ? it->second : nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -93,6 +136,7 @@ void UIDescList::sort ()
 			return true;
 		return false;
 	});
+	changed ();
 }
 
 //------------------------------------------------------------------------
@@ -145,6 +189,7 @@ UINode* UIDescListWithFastFindAttributeNameChild::findChildNodeWithAttributeValu
 void UIDescListWithFastFindAttributeNameChild::nodeAttributeChanged (
     UINode* node, const std::string& attributeName, const std::string& oldAttributeValue)
 {
+	UIDescList::nodeAttributeChanged (node, attributeName, oldAttributeValue);
 	if (attributeName != "name")
 		return;
 	ChildMap::iterator it = childMap.find (oldAttributeValue);
@@ -6,6 +6,8 @@
 
 #include "../../lib/cstring.h"
 #include "../../lib/vstguibase.h"
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -41,14 +43,25 @@ public:
 	                                                 const std::string& attributeValue) const;
 
 	virtual void nodeAttributeChanged (UINode* child, const std::string& attributeName,
-	                                   const std::string& oldAttributeValue)
-	{
-	}
+	                                   const std::string& oldAttributeValue);
 
 	void sort ();
 
+	/** a process wide unique number which changes when a node is added, removed or reordered and
+	 *	when nodeAttributeChanged is called. Indices of the nodes are valid while it is unchanged. */
+	uint64_t getRevision () const { return revision; }
+
 protected:
+	void changed ();
+
 	bool ownsObjects;
+
+private:
+	using NodeNameIndex = std::unordered_map<std::string, UINode*>;
+
+	uint64_t revision;
+	// the first node of each node name, created on demand for longer lists
+	mutable std::unique_ptr<NodeNameIndex> nodeNameIndex;
 };
 
 //-----------------------------------------------------------------------------
@@ -466,10 +466,12 @@ void writeAttributes (const UIAttributes& attributes, JSONWriter& writer,
                       bool ignoreNameAttribute = false)
 {
 #if __cplusplus > 201402L
-	std::map<std::string_view, std::string_view> ordered (attributes.begin (), attributes.end ());
+	std::map<std::string_view, std::string_view> ordered;
 #else
-	std::map<std::string, std::string> ordered (attributes.begin (), attributes.end ());
+	std::map<std::string, std::string> ordered;
 #endif
+	for (const auto& attr : attributes)
+		ordered.emplace (attr.first.getString (), attr.second);
 	for (const auto& attr : ordered)
 	{
 		if (ignoreNameAttribute && attr.first == attributeNameStr)
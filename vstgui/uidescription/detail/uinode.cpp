@@ -13,6 +13,7 @@
 #include "locale.h"
 #include "parsecolor.h"
 #include "scalefactorutils.h"
+#include "uibitmappreloader.h"
 #include "uinode.h"
 #include <list>
 #include <string>
@@ -51,7 +52,7 @@ UINode::UINode (const UINode& n)
 : name (n.name)
 , data (n.data)
 , attributes (makeOwned<UIAttributes> (*n.attributes))
-, children (makeOwned<UIDescList> (*n.children))
+, children (makeOwned<UIDescList> (n.getChildren ()))
 , flags (n.flags)
 {
 }
@@ -64,20 +65,34 @@ UINode::~UINode () noexcept
 //-----------------------------------------------------------------------------
 bool UINode::hasChildren () const
 {
-	return !children->empty ();
+	return !getChildren ().empty ();
+}
+
+//-----------------------------------------------------------------------------
+void UINode::setChildrenLoader (ChildrenLoader&& loader)
+{
+	childrenLoader = std::move (loader);
+}
+
+//-----------------------------------------------------------------------------
+void UINode::loadChildren () const
+{
+	auto loader = std::move (childrenLoader);
+	childrenLoader = nullptr;
+	loader (*children);
 }
 
 //-----------------------------------------------------------------------------
 void UINode::childAttributeChanged (UINode* child, const char* attributeName,
                                     const char* oldAttributeValue)
 {
-	children->nodeAttributeChanged (child, attributeName, oldAttributeValue);
+	getChildren ().nodeAttributeChanged (child, attributeName, oldAttributeValue);
 }
 
 //-----------------------------------------------------------------------------
 void UINode::sortChildren ()
 {
-	children->sort ();
+	getChildren ().sort ();
 }
 
 //------------------------------------------------------------------------
@@ -134,6 +149,14 @@ UIVariableNode::UIVariableNode (const std::string& name,
 	}
 }
 
+//-----------------------------------------------------------------------------
+UIVariableNode::UIVariableNode (const std::string& name,
+                                const SharedPointer<UIAttributes>& attributes, Type type,
+                                double number)
+: UINode (name, attributes), type (type), number (number)
+{
+}
+
 //-----------------------------------------------------------------------------
 UIVariableNode::Type UIVariableNode::getType () const
 {
@@ -224,6 +247,7 @@ UIBitmapNode::UIBitmapNode (const std::string& name, const SharedPointer<UIAttri
 //-----------------------------------------------------------------------------
 UIBitmapNode::~UIBitmapNode () noexcept
 {
+	cancelDecodeJob ();
 	if (bitmap)
 		bitmap->forget ();
 }
@@ -231,6 +255,7 @@ UIBitmapNode::~UIBitmapNode () noexcept
 //-----------------------------------------------------------------------------
 void UIBitmapNode::freePlatformResources ()
 {
+	cancelDecodeJob ();
 	if (bitmap)
 		bitmap->forget ();
 	bitmap = nullptr;
@@ -327,9 +352,11 @@ void UIBitmapNode::createXMLData (const std::string& pathHint)
 //-----------------------------------------------------------------------------
 void UIBitmapNode::removeXMLData ()
 {
+	cancelDecodeJob ();
 	UINode* node = getChildren ().findChildNode ("data");
 	if (node)
 		getChildren ().remove (node);
+	setEncodedImageData (nullptr, nullptr, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -341,6 +368,99 @@ CBitmap* UIBitmapNode::createBitmap (const std::string& str,
 	return new CBitmap (CResourceDescription (str.c_str ()));
 }
 
+//-----------------------------------------------------------------------------
+CBitmap* UIBitmapNode::createBitmap (const std::string& str, CNinePartTiledDescription* partDesc,
+                                     const PlatformBitmapPtr& platformBitmap) const
+{
+	if (partDesc)
+		return new CNinePartTiledBitmap (CResourceDescription (str.c_str ()), platformBitmap,
+		                                 *partDesc);
+	return new CBitmap (CResourceDescription (str.c_str ()), platformBitmap);
+}
+
+//------------------------------------------------------------------------
+std::shared_ptr<BitmapDecodeJob> UIBitmapNode::makeDecodeJob (const std::string& pathHint) const
+{
+	const std::string* path = attributes->getAttributeValue ("path");
+	if (path == nullptr)
+		return nullptr;
+	auto job = std::make_shared<BitmapDecodeJob> ();
+	job->path = *path;
+	if (pathIsAbsolute (pathHint))
+	{
+		std::string absPath = pathHint;
+		if (removeLastPathComponent (absPath))
+			job->absolutePath = absPath + "/" + *path;
+	}
+	if (auto node = dataNode ())
+	{
+		auto codecStr = node->getAttributes ()->getAttributeValue ("encoding");
+		if (codecStr && *codecStr == "base64")
+			job->base64Data = &node->getData ();
+	}
+	else if (encodedImageData)
+	{
+		job->encodedData = encodedImageData;
+		job->encodedDataSize = encodedImageDataSize;
+	}
+	attributes->getDoubleAttribute ("scale-factor", job->scaleFactor);
+	return job;
+}
+
+//------------------------------------------------------------------------
+std::shared_ptr<BitmapDecodeJob> UIBitmapNode::createDecodeJob (const std::string& pathHint)
+{
+	if (bitmap || decodeJob)
+		return nullptr;
+	decodeJob = makeDecodeJob (pathHint);
+	return decodeJob;
+}
+
+//------------------------------------------------------------------------
+void UIBitmapNode::makeBitmapReleasable (const std::string& pathHint)
+{
+	auto platformBitmap = bitmap->getPlatformBitmap ();
+	auto loader = makeDecodeJob (pathHint);
+	if (!platformBitmap || !loader)
+		return;
+	// the loader points into the data node and the encoded image data, keep them alive
+	SharedPointer<UINode> sourceNode = dataNode ();
+	auto sourceOwner = encodedImageDataOwner;
+	bitmap->setReloadFunction (platformBitmap, [loader, sourceNode, sourceOwner] () {
+		return loader->load ();
+	});
+}
+
+//------------------------------------------------------------------------
+void UIBitmapNode::cancelDecodeJob ()
+{
+	if (decodeJob)
+	{
+		decodeJob->cancel ();
+		decodeJob = nullptr;
+	}
+}
+
+//------------------------------------------------------------------------
+void UIBitmapNode::setEncodedImageData (const SharedPointer<IReference>& owner, const void* data,
+                                        size_t size)
+{
+	cancelDecodeJob ();
+	encodedImageDataOwner = owner;
+	encodedImageData = data;
+	encodedImageDataSize = size;
+}
+
+//------------------------------------------------------------------------
+bool UIBitmapNode::getEncodedImageData (const void*& data, size_t& size) const
+{
+	if (encodedImageData == nullptr)
+		return false;
+	data = encodedImageData;
+	size = encodedImageDataSize;
+	return true;
+}
+
 //------------------------------------------------------------------------
 UINode* UIBitmapNode::dataNode () const
 {
@@ -357,19 +477,33 @@ PlatformBitmapPtr UIBitmapNode::createBitmapFromDataNode () const
 		if (codecStr && *codecStr == "base64")
 		{
 			auto result = Base64Codec::decode (node->getData ());
-			if (auto platformBitmap = getPlatformFactory ().createBitmapFromMemory (
-			        result.data.get (), result.dataSize))
-			{
-				double scaleFactor = 1.;
-				if (attributes->getDoubleAttribute ("scale-factor", scaleFactor))
-					platformBitmap->setScaleFactor (scaleFactor);
-				return platformBitmap;
-			}
+			return createBitmapFromMemory (result.data.get (), result.dataSize);
 		}
 	}
+	else if (encodedImageData)
+	{
+		return createBitmapFromMemory (encodedImageData, encodedImageDataSize);
+	}
+	return nullptr;
+}
+
+//------------------------------------------------------------------------
+PlatformBitmapPtr UIBitmapNode::createBitmapFromMemory (const void* data, size_t size) const
+{
+	if (auto platformBitmap =
+	        getPlatformFactory ().createBitmapFromMemory (data, static_cast<uint32_t> (size)))
+	{
+		double scaleFactor = 1.;
+		if (attributes->getDoubleAttribute ("scale-factor", scaleFactor))
+			platformBitmap->setScaleFactor (scaleFactor);
+		return platformBitmap;
+	}
 	return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+uint64_t UIBitmapNode::bitmapCreationCount = 0;
+
 //-----------------------------------------------------------------------------
 CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
 {
@@ -387,7 +521,16 @@ CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
 				                                      offsets.bottom);
 				partDescPtr = &partDesc;
 			}
-			bitmap = createBitmap (*path, partDescPtr);
+			if (decodeJob)
+			{
+				bitmap = createBitmap (*path, partDescPtr, decodeJob->wait ());
+				decodeJob = nullptr;
+				// the job tried all sources of the bitmap
+				if (bitmap->getPlatformBitmap () == nullptr)
+					return bitmap;
+			}
+			else
+				bitmap = createBitmap (*path, partDescPtr);
 			if (bitmap->getPlatformBitmap () == nullptr && pathIsAbsolute (pathHint))
 			{
 				std::string absPath = pathHint;
@@ -417,6 +560,10 @@ CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
 				attributes->setDoubleAttribute ("scale-factor", scaleFactor);
 			}
 		}
+		if (bitmap && path)
+			makeBitmapReleasable (pathHint);
+		if (bitmap)
+			++bitmapCreationCount;
 	}
 	return bitmap;
 }
@@ -424,6 +571,7 @@ CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
 //-----------------------------------------------------------------------------
 void UIBitmapNode::setBitmap (UTF8StringPtr bitmapName)
 {
+	cancelDecodeJob ();
 	std::string name (bitmapName);
 	attributes->setAttribute ("path", name);
 	if (bitmap)
@@ -626,6 +774,13 @@ UIColorNode::UIColorNode (const std::string& name, const SharedPointer<UIAttribu
 		parseColor (*rgba, color);
 }
 
+//-----------------------------------------------------------------------------
+UIColorNode::UIColorNode (const std::string& name, const SharedPointer<UIAttributes>& attributes,
+                          const CColor& color)
+: UINode (name, attributes), color (color)
+{
+}
+
 //-----------------------------------------------------------------------------
 void UIColorNode::setColor (const CColor& newColor)
 {
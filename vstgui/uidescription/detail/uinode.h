@@ -8,6 +8,8 @@
 #include "../uidescriptionfwd.h"
 #include "../../lib/ccolor.h"
 #include "uidesclist.h"
+#include <functional>
+#include <memory>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -32,6 +34,8 @@ class UINode : public NonAtomicReferenceCounted
 {
 public:
 	using DataStorage = std::string;
+	/** creates the children of the node */
+	using ChildrenLoader = std::function<void (UIDescList& children)>;
 
 	UINode (const std::string& name, const SharedPointer<UIAttributes>& attributes = {},
 	        bool needsFastChildNameAttributeLookup = false);
@@ -47,8 +51,15 @@ public:
 	void setData (DataStorage&& newData);
 
 	const SharedPointer<UIAttributes>& getAttributes () const { return attributes; }
-	UIDescList& getChildren () const { return *children; }
+	UIDescList& getChildren () const
+	{
+		if (childrenLoader)
+			loadChildren ();
+		return *children;
+	}
 	bool hasChildren () const;
+	/** defer the creation of the children until they are accessed the first time */
+	void setChildrenLoader (ChildrenLoader&& loader);
 	void childAttributeChanged (UINode* child, const char* attributeName,
 	                            const char* oldAttributeValue);
 
@@ -66,10 +77,13 @@ public:
 	virtual void freePlatformResources () {}
 
 protected:
+	void loadChildren () const;
+
 	std::string name;
 	DataStorage data;
 	SharedPointer<UIAttributes> attributes;
 	SharedPointer<UIDescList> children;
+	mutable ChildrenLoader childrenLoader;
 	int32_t flags;
 };
 
@@ -93,6 +107,10 @@ public:
 		kUnknown
 	};
 
+	/** the value was already parsed */
+	UIVariableNode (const std::string& name, const SharedPointer<UIAttributes>& attributes,
+	                Type type, double number);
+
 	Type getType () const;
 	double getNumber () const;
 	const std::string& getString () const;
@@ -117,12 +135,18 @@ protected:
 	int32_t tag;
 };
 
+class BitmapDecodeJob;
+
 //-----------------------------------------------------------------------------
 class UIBitmapNode : public UINode
 {
 public:
 	UIBitmapNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
 	CBitmap* getBitmap (const std::string& pathHint);
+	/** the bitmap if getBitmap has already created it, never decodes */
+	CBitmap* getCreatedBitmap () const { return bitmap; }
+	/** counts the bitmaps created by getBitmap of all bitmap nodes */
+	static uint64_t getBitmapCreationCount () { return bitmapCreationCount; }
 	void setBitmap (UTF8StringPtr bitmapName);
 	void setNinePartTiledOffset (const CRect* offsets);
 	void invalidBitmap ();
@@ -135,17 +159,41 @@ public:
 	void removeXMLData ();
 	bool hasXMLData () const;
 
+	/** the encoded image data (for example PNG) is used if the bitmap is not found and there is
+	 *	no data node. The owner must keep the memory alive. */
+	void setEncodedImageData (const SharedPointer<IReference>& owner, const void* data,
+	                          size_t size);
+	bool getEncodedImageData (const void*& data, size_t& size) const;
+
+	/** prepare decoding the platform bitmap on another thread, getBitmap waits for the job.
+	 *	Returns nullptr if the bitmap is already created. */
+	std::shared_ptr<BitmapDecodeJob> createDecodeJob (const std::string& pathHint);
+
 	void freePlatformResources () override;
 
 protected:
 	~UIBitmapNode () noexcept override;
 	CBitmap* createBitmap (const std::string& str, CNinePartTiledDescription* partDesc) const;
+	CBitmap* createBitmap (const std::string& str, CNinePartTiledDescription* partDesc,
+	                       const PlatformBitmapPtr& platformBitmap) const;
+	void cancelDecodeJob ();
+	/** a job with the sources of the bitmap, which is not started */
+	std::shared_ptr<BitmapDecodeJob> makeDecodeJob (const std::string& pathHint) const;
+	/** let the bitmap release its platform bitmap and load it again from the sources */
+	void makeBitmapReleasable (const std::string& pathHint);
 	PlatformBitmapPtr createBitmapFromDataNode () const;
+	PlatformBitmapPtr createBitmapFromMemory (const void* data, size_t size) const;
 	static bool imagesEqual (IPlatformBitmap* b1, IPlatformBitmap* b2);
 	UINode* dataNode () const;
 	CBitmap* bitmap;
+	SharedPointer<IReference> encodedImageDataOwner;
+	const void* encodedImageData {nullptr};
+	size_t encodedImageDataSize {0};
+	std::shared_ptr<BitmapDecodeJob> decodeJob;
 	bool filterProcessed;
 	bool scaledBitmapsAdded;
+
+	static uint64_t bitmapCreationCount;
 };
 
 //-----------------------------------------------------------------------------
@@ -170,6 +218,9 @@ class UIColorNode : public UINode
 {
 public:
 	UIColorNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
+	/** the color was already parsed */
+	UIColorNode (const std::string& name, const SharedPointer<UIAttributes>& attributes,
+	             const CColor& color);
 	const CColor& getColor () const { return color; }
 	void setColor (const CColor& newColor);
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../iuidescription.h"
+#include "../uiattributes.h"
 #include <cstring>
 
 namespace VSTGUI {
@@ -51,271 +52,274 @@ static const IdStringPtr kCStringListControl = "CStringListControl";
 //-----------------------------------------------------------------------------
 // attributes used in more than one view creator
 //-----------------------------------------------------------------------------
-static const std::string kAttrClass = "class";
-static const std::string kAttrTitle = "title";
-static const std::string kAttrFont = "font";
-static const std::string kAttrFontColor = "font-color";
-static const std::string kAttrFrameColor = "frame-color";
-static const std::string kAttrTextAlignment = "text-alignment";
-static const std::string kAttrRoundRectRadius = "round-rect-radius";
-static const std::string kAttrFrameWidth = "frame-width";
-static const std::string kAttrGradientStartColor = "gradient-start-color";
-static const std::string kAttrGradientEndColor = "gradient-end-color";
-static const std::string kAttrZoomFactor = "zoom-factor";
-static const std::string kAttrHandleBitmap = "handle-bitmap";
-static const std::string kAttrOrientation = "orientation";
-static const std::string kAttrAnimationTime = "animation-time";
-static const std::string kAttrGradient = "gradient";
+static const UIAttributeAtom kAttrClass ("class");
+static const UIAttributeAtom kAttrTitle ("title");
+static const UIAttributeAtom kAttrFont ("font");
+static const UIAttributeAtom kAttrFontColor ("font-color");
+static const UIAttributeAtom kAttrFrameColor ("frame-color");
+static const UIAttributeAtom kAttrTextAlignment ("text-alignment");
+static const UIAttributeAtom kAttrRoundRectRadius ("round-rect-radius");
+static const UIAttributeAtom kAttrFrameWidth ("frame-width");
+static const UIAttributeAtom kAttrGradientStartColor ("gradient-start-color");
+static const UIAttributeAtom kAttrGradientEndColor ("gradient-end-color");
+static const UIAttributeAtom kAttrZoomFactor ("zoom-factor");
+static const UIAttributeAtom kAttrHandleBitmap ("handle-bitmap");
+static const UIAttributeAtom kAttrOrientation ("orientation");
+static const UIAttributeAtom kAttrAnimationTime ("animation-time");
+static const UIAttributeAtom kAttrGradient ("gradient");
 
 //-----------------------------------------------------------------------------
 // CViewCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrOrigin = "origin";
-static const std::string kAttrSize = "size";
-static const std::string kAttrTransparent = "transparent";
-static const std::string kAttrMouseEnabled = "mouse-enabled";
-static const std::string kAttrWantsFocus = "wants-focus";
-static const std::string kAttrBitmap = "bitmap";
-static const std::string kAttrDisabledBitmap = "disabled-bitmap";
-static const std::string kAttrAutosize = "autosize";
-static const std::string kAttrTooltip = "tooltip";
-static const std::string kAttrCustomViewName = IUIDescription::kCustomViewName;
-static const std::string kAttrSubController = "sub-controller";
-static const std::string kAttrUIDescLabel = "uidesc-label";
-static const std::string kAttrOpacity = "opacity";
+static const UIAttributeAtom kAttrOrigin ("origin");
+static const UIAttributeAtom kAttrSize ("size");
+static const UIAttributeAtom kAttrTransparent ("transparent");
+static const UIAttributeAtom kAttrMouseEnabled ("mouse-enabled");
+static const UIAttributeAtom kAttrWantsFocus ("wants-focus");
+static const UIAttributeAtom kAttrBitmap ("bitmap");
+static const UIAttributeAtom kAttrDisabledBitmap ("disabled-bitmap");
+static const UIAttributeAtom kAttrAutosize ("autosize");
+static const UIAttributeAtom kAttrTooltip ("tooltip");
+static const UIAttributeAtom kAttrCustomViewName (IUIDescription::kCustomViewName);
+static const UIAttributeAtom kAttrSubController ("sub-controller");
+static const UIAttributeAtom kAttrUIDescLabel ("uidesc-label");
+static const UIAttributeAtom kAttrOpacity ("opacity");
 
 //-----------------------------------------------------------------------------
 // CViewContainerCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrBackgroundColor = "background-color";
-static const std::string kAttrBackgroundColorDrawStyle = "background-color-draw-style";
+static const UIAttributeAtom kAttrBackgroundColor ("background-color");
+static const UIAttributeAtom kAttrBackgroundColorDrawStyle ("background-color-draw-style");
 
 //-----------------------------------------------------------------------------
 // CLayeredViewContainerCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrZIndex = "z-index";
+static const UIAttributeAtom kAttrZIndex ("z-index");
 
 //-----------------------------------------------------------------------------
 // CRowColumnViewCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrRowStyle = "row-style";
-static const std::string kAttrSpacing = "spacing";
-static const std::string kAttrMargin = "margin";
-static const std::string kAttrAnimateViewResizing = "animate-view-resizing";
-static const std::string kAttrHideClippedSubviews = "hide-clipped-subviews";
-static const std::string kAttrEqualSizeLayout = "equal-size-layout";
-static const std::string kAttrViewResizeAnimationTime = "view-resize-animation-time";
+static const UIAttributeAtom kAttrRowStyle ("row-style");
+static const UIAttributeAtom kAttrSpacing ("spacing");
+static const UIAttributeAtom kAttrMargin ("margin");
+static const UIAttributeAtom kAttrAnimateViewResizing ("animate-view-resizing");
+static const UIAttributeAtom kAttrHideClippedSubviews ("hide-clipped-subviews");
+static const UIAttributeAtom kAttrEqualSizeLayout ("equal-size-layout");
+static const UIAttributeAtom kAttrViewResizeAnimationTime ("view-resize-animation-time");
 
 //-----------------------------------------------------------------------------
 // CScrollViewCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrContainerSize = "container-size";
-static const std::string kAttrHorizontalScrollbar = "horizontal-scrollbar";
-static const std::string kAttrVerticalScrollbar = "vertical-scrollbar";
-static const std::string kAttrAutoDragScrolling = "auto-drag-scrolling";
-static const std::string kAttrBordered = "bordered";
-static const std::string kAttrOverlayScrollbars = "overlay-scrollbars";
-static const std::string kAttrFollowFocusView = "follow-focus-view";
-static const std::string kAttrAutoHideScrollbars = "auto-hide-scrollbars";
-static const std::string kAttrScrollbarBackgroundColor = "scrollbar-background-color";
-static const std::string kAttrScrollbarFrameColor = "scrollbar-frame-color";
-static const std::string kAttrScrollbarScrollerColor = "scrollbar-scroller-color";
-static const std::string kAttrScrollbarWidth = "scrollbar-width";
+static const UIAttributeAtom kAttrContainerSize ("container-size");
+static const UIAttributeAtom kAttrHorizontalScrollbar ("horizontal-scrollbar");
+static const UIAttributeAtom kAttrVerticalScrollbar ("vertical-scrollbar");
+static const UIAttributeAtom kAttrAutoDragScrolling ("auto-drag-scrolling");
+static const UIAttributeAtom kAttrBordered ("bordered");
+static const UIAttributeAtom kAttrOverlayScrollbars ("overlay-scrollbars");
+static const UIAttributeAtom kAttrFollowFocusView ("follow-focus-view");
+static const UIAttributeAtom kAttrAutoHideScrollbars ("auto-hide-scrollbars");
+static const UIAttributeAtom kAttrScrollbarBackgroundColor ("scrollbar-background-color");
+static const UIAttributeAtom kAttrScrollbarFrameColor ("scrollbar-frame-color");
+static const UIAttributeAtom kAttrScrollbarScrollerColor ("scrollbar-scroller-color");
+static const UIAttributeAtom kAttrScrollbarWidth ("scrollbar-width");
 
 //-----------------------------------------------------------------------------
 // CControlCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrControlTag = "control-tag";
-static const std::string kAttrDefaultValue = "default-value";
-static const std::string kAttrMinValue = "min-value";
-static const std::string kAttrMaxValue = "max-value";
-static const std::string kAttrWheelIncValue = "wheel-inc-value";
-static const std::string kAttrBackgroundOffset = "background-offset";
+static const UIAttributeAtom kAttrControlTag ("control-tag");
+static const UIAttributeAtom kAttrDefaultValue ("default-value");
+static const UIAttributeAtom kAttrMinValue ("min-value");
+static const UIAttributeAtom kAttrMaxValue ("max-value");
+static const UIAttributeAtom kAttrWheelIncValue ("wheel-inc-value");
+static const UIAttributeAtom kAttrBackgroundOffset ("background-offset");
 
 //-----------------------------------------------------------------------------
 // CCheckBoxCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrBoxframeColor = "boxframe-color";
-static const std::string kAttrBoxfillColor = "boxfill-color";
-static const std::string kAttrCheckmarkColor = "checkmark-color";
-static const std::string kAttrDrawCrossbox = "draw-crossbox";
-static const std::string kAttrAutosizeToFit = "autosize-to-fit";
+static const UIAttributeAtom kAttrBoxframeColor ("boxframe-color");
+static const UIAttributeAtom kAttrBoxfillColor ("boxfill-color");
+static const UIAttributeAtom kAttrCheckmarkColor ("checkmark-color");
+static const UIAttributeAtom kAttrDrawCrossbox ("draw-crossbox");
+static const UIAttributeAtom kAttrAutosizeToFit ("autosize-to-fit");
 
 //-----------------------------------------------------------------------------
 // CParamDisplayCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrBackColor = "back-color";
-static const std::string kAttrShadowColor = "shadow-color";
-static const std::string kAttrFontAntialias = "font-antialias";
-static const std::string kAttrStyle3DIn = "style-3D-in";
-static const std::string kAttrStyle3DOut = "style-3D-out";
-static const std::string kAttrStyleNoFrame = "style-no-frame";
-static const std::string kAttrStyleNoText = "style-no-text";
-static const std::string kAttrStyleNoDraw = "style-no-draw";
-static const std::string kAttrStyleShadowText = "style-shadow-text";
-static const std::string kAttrStyleRoundRect = "style-round-rect";
-static const std::string kAttrTextInset = "text-inset";
-static const std::string kAttrValuePrecision = "value-precision";
-static const std::string kAttrTextRotation = "text-rotation";
-static const std::string kAttrTextShadowOffset = "text-shadow-offset";
+static const UIAttributeAtom kAttrBackColor ("back-color");
+static const UIAttributeAtom kAttrShadowColor ("shadow-color");
+static const UIAttributeAtom kAttrFontAntialias ("font-antialias");
+static const UIAttributeAtom kAttrStyle3DIn ("style-3D-in");
+static const UIAttributeAtom kAttrStyle3DOut ("style-3D-out");
+static const UIAttributeAtom kAttrStyleNoFrame ("style-no-frame");
+static const UIAttributeAtom kAttrStyleNoText ("style-no-text");
+static const UIAttributeAtom kAttrStyleNoDraw ("style-no-draw");
+static const UIAttributeAtom kAttrStyleShadowText ("style-shadow-text");
+static const UIAttributeAtom kAttrStyleRoundRect ("style-round-rect");
+static const UIAttributeAtom kAttrTextInset ("text-inset");
+static const UIAttributeAtom kAttrValuePrecision ("value-precision");
+static const UIAttributeAtom kAttrTextRotation ("text-rotation");
+static const UIAttributeAtom kAttrTextShadowOffset ("text-shadow-offset");
 
 //-----------------------------------------------------------------------------
 // COptionMenuCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrMenuPopupStyle = "menu-popup-style";
-static const std::string kAttrMenuCheckStyle = "menu-check-style";
+static const UIAttributeAtom kAttrMenuPopupStyle ("menu-popup-style");
+static const UIAttributeAtom kAttrMenuCheckStyle ("menu-check-style");
 
 //-----------------------------------------------------------------------------
 // CTextLabelCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrTruncateMode = "truncate-mode";
+static const UIAttributeAtom kAttrTruncateMode ("truncate-mode");
 
 //-----------------------------------------------------------------------------
 // CMultiLineTextLabelCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrLineLayout = "line-layout";
-static const std::string kAttrAutoHeight = "auto-height";
-static const std::string kAttrVerticalCentered = "vertical-centered";
+static const UIAttributeAtom kAttrLineLayout ("line-layout");
+static const UIAttributeAtom kAttrAutoHeight ("auto-height");
+static const UIAttributeAtom kAttrVerticalCentered ("vertical-centered");
 
 //-----------------------------------------------------------------------------
 // CTextEditCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrSecureStyle = "secure-style";
-static const std::string kAttrImmediateTextChange = "immediate-text-change";
-static const std::string kAttrStyleDoubleClick = "style-doubleclick";
-static const std::string kAttrPlaceholderTitle = "placeholder-title";
+static const UIAttributeAtom kAttrSecureStyle ("secure-style");
+static const UIAttributeAtom kAttrImmediateTextChange ("immediate-text-change");
+static const UIAttributeAtom kAttrStyleDoubleClick ("style-doubleclick");
+static const UIAttributeAtom kAttrPlaceholderTitle ("placeholder-title");
 
-static const std::string kAttrClearMarkInset = "clearmark-inset";
+static const UIAttributeAtom kAttrClearMarkInset ("clearmark-inset");
 
 //-----------------------------------------------------------------------------
 // CTextButtonCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrTextColor = "text-color";
-static const std::string kAttrTextColorHighlighted = "text-color-highlighted";
-static const std::string kAttrGradientStartColorHighlighted = "gradient-start-color-highlighted";
-static const std::string kAttrGradientEndColorHighlighted = "gradient-end-color-highlighted";
-static const std::string kAttrFrameColorHighlighted = "frame-color-highlighted";
-static const std::string kAttrRoundRadius = "round-radius";
-static const std::string kAttrKickStyle = "kick-style";
-static const std::string kAttrIcon = "icon";
-static const std::string kAttrIconHighlighted = "icon-highlighted";
-static const std::string kAttrIconPosition = "icon-position";
-static const std::string kAttrIconTextMargin = "icon-text-margin";
-static const std::string kAttrGradientHighlighted = "gradient-highlighted";
+static const UIAttributeAtom kAttrTextColor ("text-color");
+static const UIAttributeAtom kAttrTextColorHighlighted ("text-color-highlighted");
+static const UIAttributeAtom kAttrGradientStartColorHighlighted ("gradient-start-color-highlighted");
+static const UIAttributeAtom kAttrGradientEndColorHighlighted ("gradient-end-color-highlighted");
+static const UIAttributeAtom kAttrFrameColorHighlighted ("frame-color-highlighted");
+static const UIAttributeAtom kAttrRoundRadius ("round-radius");
+static const UIAttributeAtom kAttrKickStyle ("kick-style");
+static const UIAttributeAtom kAttrIcon ("icon");
+static const UIAttributeAtom kAttrIconHighlighted ("icon-highlighted");
+static const UIAttributeAtom kAttrIconPosition ("icon-position");
+static const UIAttributeAtom kAttrIconTextMargin ("icon-text-margin");
+static const UIAttributeAtom kAttrGradientHighlighted ("gradient-highlighted");
 
 //-----------------------------------------------------------------------------
 // CSegmentButtonCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrStyle = "style";
-static const std::string kAttrSelectionMode = "selection-mode";
-static const std::string kAttrSegmentNames = "segment-names";
+static const UIAttributeAtom kAttrStyle ("style");
+static const UIAttributeAtom kAttrSelectionMode ("selection-mode");
+static const UIAttributeAtom kAttrSegmentNames ("segment-names");
 
 //-----------------------------------------------------------------------------
 // CKnobCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrAngleStart = "angle-start";
-static const std::string kAttrAngleRange = "angle-range";
-static const std::string kAttrValueInset = "value-inset";
-static const std::string kAttrCoronaInset = "corona-inset";
-static const std::string kAttrCoronaColor = "corona-color";
-static const std::string kAttrCoronaDrawing = "corona-drawing";
-static const std::string kAttrCoronaOutline = "corona-outline";
-static const std::string kAttrCoronaInverted = "corona-inverted";
-static const std::string kAttrCoronaFromCenter = "corona-from-center";
-static const std::string kAttrCoronaDashDot = "corona-dash-dot";
-static const std::string kAttrCoronaDashDotLengths = "corona-dash-dot-lengths";
-static const std::string kAttrHandleColor = "handle-color";
-static const std::string kAttrHandleShadowColor = "handle-shadow-color";
-static const std::string kAttrHandleLineWidth = "handle-line-width";
-static const std::string kAttrCircleDrawing = "circle-drawing";
-static const std::string kAttrCoronaLineCapButt = "corona-line-cap-butt";
-static const std::string kAttrSkipHandleDrawing = "skip-handle-drawing";
-static const std::string kAttrCoronaOutlineWidthAdd = "corona-outline-width-add";
+static const UIAttributeAtom kAttrAngleStart ("angle-start");
+static const UIAttributeAtom kAttrAngleRange ("angle-range");
+static const UIAttributeAtom kAttrValueInset ("value-inset");
+static const UIAttributeAtom kAttrCoronaInset ("corona-inset");
+static const UIAttributeAtom kAttrCoronaColor ("corona-color");
+static const UIAttributeAtom kAttrCoronaDrawing ("corona-drawing");
+static const UIAttributeAtom kAttrCoronaOutline ("corona-outline");
+static const UIAttributeAtom kAttrCoronaInverted ("corona-inverted");
+static const UIAttributeAtom kAttrCoronaFromCenter ("corona-from-center");
+static const UIAttributeAtom kAttrCoronaDashDot ("corona-dash-dot");
+static const UIAttributeAtom kAttrCoronaDashDotLengths ("corona-dash-dot-lengths");
+static const UIAttributeAtom kAttrHandleColor ("handle-color");
+static const UIAttributeAtom kAttrHandleShadowColor ("handle-shadow-color");
+static const UIAttributeAtom kAttrHandleLineWidth ("handle-line-width");
+static const UIAttributeAtom kAttrCircleDrawing ("circle-drawing");
+static const UIAttributeAtom kAttrCoronaLineCapButt ("corona-line-cap-butt");
+static const UIAttributeAtom kAttrSkipHandleDrawing ("skip-handle-drawing");
+static const UIAttributeAtom kAttrCoronaOutlineWidthAdd ("corona-outline-width-add");
 
 //-----------------------------------------------------------------------------
 // IMultiBitmapControlCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrHeightOfOneImage = "height-of-one-image";
-static const std::string kAttrSubPixmaps = "sub-pixmaps";
+static const UIAttributeAtom kAttrHeightOfOneImage ("height-of-one-image");
+static const UIAttributeAtom kAttrSubPixmaps ("sub-pixmaps");
 
 //-----------------------------------------------------------------------------
 // CAnimKnobCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrInverseBitmap = "inverse-bitmap";
+static const UIAttributeAtom kAttrInverseBitmap ("inverse-bitmap");
 
 //-----------------------------------------------------------------------------
 // CSliderCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrMode = "mode";
-static const std::string kAttrHandleOffset = "handle-offset";
-static const std::string kAttrBitmapOffset = "bitmap-offset";
-static const std::string kAttrReverseOrientation = "reverse-orientation";
-static const std::string kAttrDrawFrame = "draw-frame";
-static const std::string kAttrDrawBack = "draw-back";
-static const std::string kAttrDrawValue = "draw-value";
-static const std::string kAttrDrawValueInverted = "draw-value-inverted";
-static const std::string kAttrDrawValueFromCenter = "draw-value-from-center";
-static const std::string kAttrDrawFrameColor = "draw-frame-color";
-static const std::string kAttrDrawBackColor = "draw-back-color";
-static const std::string kAttrDrawValueColor = "draw-value-color";
+static const UIAttributeAtom kAttrMode ("mode");
+static const UIAttributeAtom kAttrHandleOffset ("handle-offset");
+static const UIAttributeAtom kAttrBitmapOffset ("bitmap-offset");
+static const UIAttributeAtom kAttrReverseOrientation ("reverse-orientation");
+static const UIAttributeAtom kAttrDrawFrame ("draw-frame");
+static const UIAttributeAtom kAttrDrawBack ("draw-back");
+static const UIAttributeAtom kAttrDrawValue ("draw-value");
+static const UIAttributeAtom kAttrDrawValueInverted ("draw-value-inverted");
+static const UIAttributeAtom kAttrDrawValueFromCenter ("draw-value-from-center");
+static const UIAttributeAtom kAttrDrawFrameColor ("draw-frame-color");
+static const UIAttributeAtom kAttrDrawBackColor ("draw-back-color");
+static const UIAttributeAtom kAttrDrawValueColor ("draw-value-color");
 
 //-----------------------------------------------------------------------------
 // CVuMeterCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrOffBitmap = "off-bitmap";
-static const std::string kAttrNumLed = "num-led";
-static const std::string kAttrDecreaseStepValue = "decrease-step-value";
+static const UIAttributeAtom kAttrOffBitmap ("off-bitmap");
+static const UIAttributeAtom kAttrNumLed ("num-led");
+static const UIAttributeAtom kAttrDecreaseStepValue ("decrease-step-value");
 
 //-----------------------------------------------------------------------------
 // CAnimationSplashScreenCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrSplashBitmap = "splash-bitmap";
-static const std::string kAttrSplashOrigin = "splash-origin";
-static const std::string kAttrSplashSize = "splash-size";
-static const std::string kAttrAnimationIndex = "animation-index";
+static const UIAttributeAtom kAttrSplashBitmap ("splash-bitmap");
+static const UIAttributeAtom kAttrSplashOrigin ("splash-origin");
+static const UIAttributeAtom kAttrSplashSize ("splash-size");
+static const UIAttributeAtom kAttrAnimationIndex ("animation-index");
 
 //-----------------------------------------------------------------------------
 // UIViewSwitchContainerCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrTemplateNames = "template-names";
-static const std::string kAttrTemplateSwitchControl = "template-switch-control";
-static const std::string kAttrAnimationStyle = "animation-style";
-static const std::string kAttrAnimationTimingFunction = "animation-timing-function";
+static const UIAttributeAtom kAttrTemplateNames ("template-names");
+static const UIAttributeAtom kAttrTemplateSwitchControl ("template-switch-control");
+static const UIAttributeAtom kAttrAnimationStyle ("animation-style");
+static const UIAttributeAtom kAttrAnimationTimingFunction ("animation-timing-function");
+static const UIAttributeAtom kAttrKeepAlivePages ("keep-alive-pages");
+static const UIAttributeAtom kAttrKeepAliveViewBudget ("keep-alive-view-budget");
+static const UIAttributeAtom kAttrPrebuildPages ("prebuild-pages");
 
 //-----------------------------------------------------------------------------
 // CSplitViewCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrSeparatorWidth = "separator-width";
-static const std::string kAttrResizeMethod = "resize-method";
+static const UIAttributeAtom kAttrSeparatorWidth ("separator-width");
+static const UIAttributeAtom kAttrResizeMethod ("resize-method");
 
 //-----------------------------------------------------------------------------
 // CShadowViewContainerCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrShadowIntensity = "shadow-intensity";
-static const std::string kAttrShadowBlurSize = "shadow-blur-size";
-static const std::string kAttrShadowOffset = "shadow-offset";
+static const UIAttributeAtom kAttrShadowIntensity ("shadow-intensity");
+static const UIAttributeAtom kAttrShadowBlurSize ("shadow-blur-size");
+static const UIAttributeAtom kAttrShadowOffset ("shadow-offset");
 
 //-----------------------------------------------------------------------------
 // CGradientViewCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrGradientAngle = "gradient-angle";
-static const std::string kAttrGradientStyle = "gradient-style";
-static const std::string kAttrGradientStartColorOffset = "gradient-start-color-offset";
-static const std::string kAttrGradientEndColorOffset = "gradient-end-color-offset";
-static const std::string kAttrDrawAntialiased = "draw-antialiased";
-static const std::string kAttrRadialCenter = "radial-center";
-static const std::string kAttrRadialRadius = "radial-radius";
+static const UIAttributeAtom kAttrGradientAngle ("gradient-angle");
+static const UIAttributeAtom kAttrGradientStyle ("gradient-style");
+static const UIAttributeAtom kAttrGradientStartColorOffset ("gradient-start-color-offset");
+static const UIAttributeAtom kAttrGradientEndColorOffset ("gradient-end-color-offset");
+static const UIAttributeAtom kAttrDrawAntialiased ("draw-antialiased");
+static const UIAttributeAtom kAttrRadialCenter ("radial-center");
+static const UIAttributeAtom kAttrRadialRadius ("radial-radius");
 
 //------------------------------------------------------------------------
 // StringListControlCreator attributes
 //------------------------------------------------------------------------
-static const std::string kAttrSelectedFontColor = "font-color-selected";
-static const std::string kAttrSelectedBackColor = "back-color-selected";
-static const std::string kAttrLineColor = "line-color";
-static const std::string kAttrLineWidth = "line-width";
-static const std::string kAttrHoverColor = "hover-color";
-static const std::string kAttrRowHeight = "row-height";
-static const std::string kAttrStyleHover = "style-hover";
+static const UIAttributeAtom kAttrSelectedFontColor ("font-color-selected");
+static const UIAttributeAtom kAttrSelectedBackColor ("back-color-selected");
+static const UIAttributeAtom kAttrLineColor ("line-color");
+static const UIAttributeAtom kAttrLineWidth ("line-width");
+static const UIAttributeAtom kAttrHoverColor ("hover-color");
+static const UIAttributeAtom kAttrRowHeight ("row-height");
+static const UIAttributeAtom kAttrStyleHover ("style-hover");
 
 //------------------------------------------------------------------------
 // Some globally used strings
@@ -9,6 +9,8 @@
 #include "../lib/cstring.h"
 #include <sstream>
 #include <algorithm>
+#include <iterator>
+#include <mutex>
 
 namespace VSTGUI {
 namespace {
@@ -44,8 +46,60 @@ Optional<std::string> trimmedNumericalString (const std::string& str, size_t fro
 	return Optional<std::string> {std::move (result)};
 }
 
+//------------------------------------------------------------------------
+struct AtomTable
+{
+	std::mutex mutex;
+	std::unordered_map<std::string, uint32_t> entries;
+};
+
+//------------------------------------------------------------------------
+AtomTable& getAtomTable ()
+{
+	// never destroyed, atoms may still be used while other static objects are destroyed
+	static auto table = new AtomTable;
+	return *table;
+}
+
 } // anonymous
 
+//-----------------------------------------------------------------------------
+UIAttributeAtom::UIAttributeAtom (const std::string& name)
+{
+	auto& table = getAtomTable ();
+	std::lock_guard<std::mutex> guard (table.mutex);
+	auto it = table.entries.find (name);
+	if (it == table.entries.end ())
+	{
+		auto id = static_cast<uint32_t> (table.entries.size () + 1);
+		it = table.entries.emplace (name, id).first;
+	}
+	entry = &(*it);
+}
+
+//-----------------------------------------------------------------------------
+UIAttributeAtom::UIAttributeAtom (UTF8StringPtr name) : UIAttributeAtom (std::string (name))
+{
+}
+
+//-----------------------------------------------------------------------------
+UIAttributeAtom UIAttributeAtom::find (const std::string& name)
+{
+	auto& table = getAtomTable ();
+	std::lock_guard<std::mutex> guard (table.mutex);
+	auto it = table.entries.find (name);
+	if (it == table.entries.end ())
+		return {};
+	return UIAttributeAtom (&(*it));
+}
+
+//-----------------------------------------------------------------------------
+const std::string& UIAttributeAtom::getString () const
+{
+	static const std::string emptyString;
+	return entry ? entry->first : emptyString;
+}
+
 //-----------------------------------------------------------------------------
 std::string UIAttributes::pointToString (CPoint p)
 {
@@ -238,7 +292,9 @@ UIAttributes::UIAttributes (UTF8StringPtr* attributes)
 		int32_t i = 0;
 		while (attributes[i] != nullptr && attributes[i+1] != nullptr)
 		{
-			emplace (attributes[i], attributes[i+1]);
+			UIAttributeAtom name (attributes[i]);
+			if (!hasAttribute (name))
+				setAttribute (name, attributes[i+1]);
 			i += 2;
 		}
 	}
@@ -250,6 +306,36 @@ UIAttributes::UIAttributes (size_t reserve)
 	UIAttributesMap::reserve (reserve);
 }
 
+//-----------------------------------------------------------------------------
+UIAttributes::const_iterator UIAttributes::findAttribute (UIAttributeAtom name) const
+{
+	return std::lower_bound (
+	    begin (), end (), name,
+	    [] (const value_type& attribute, UIAttributeAtom atom) { return attribute.first < atom; });
+}
+
+//-----------------------------------------------------------------------------
+template<typename ParseFunc>
+const UIAttributes::CachedValue* UIAttributes::getCachedValue (UIAttributeAtom name,
+                                                               CachedValue::Type type,
+                                                               ParseFunc parse) const
+{
+	if (!name.isValid ())
+		return nullptr;
+	auto iter = findAttribute (name);
+	if (iter == end () || iter->first != name)
+		return nullptr;
+	if (cachedValues.empty ())
+		cachedValues.resize (size ());
+	auto& cached = cachedValues[iter - begin ()];
+	if (cached.type != type)
+	{
+		cached.type = type;
+		cached.valid = parse (iter->second, cached.values);
+	}
+	return cached.valid ? &cached : nullptr;
+}
+
 //-----------------------------------------------------------------------------
 bool UIAttributes::hasAttribute (const std::string& name) const
 {
@@ -258,11 +344,25 @@ bool UIAttributes::hasAttribute (const std::string& name) const
 	return false;
 }
 
+//-----------------------------------------------------------------------------
+bool UIAttributes::hasAttribute (UIAttributeAtom name) const
+{
+	return getAttributeValue (name) != nullptr;
+}
+
 //-----------------------------------------------------------------------------
 const std::string* UIAttributes::getAttributeValue (const std::string& name) const
 {
-	const_iterator iter = find (name);
-	if (iter != end ())
+	return getAttributeValue (UIAttributeAtom::find (name));
+}
+
+//-----------------------------------------------------------------------------
+const std::string* UIAttributes::getAttributeValue (UIAttributeAtom name) const
+{
+	if (!name.isValid ())
+		return nullptr;
+	auto iter = findAttribute (name);
+	if (iter != end () && iter->first == name)
 		return &iter->second;
 	return nullptr;
 }
@@ -270,39 +370,82 @@ const std::string* UIAttributes::getAttributeValue (const std::string& name) con
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (const std::string& name, const std::string& value)
 {
-	iterator iter = find (name);
-	if (iter != end ())
-		iter->second = value;
-	else
-		emplace (name, value);
+	setAttribute (UIAttributeAtom (name), value);
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (const std::string& name, std::string&& value)
 {
-	iterator iter = find (name);
-	if (iter != end ())
-		iter->second = std::move (value);
-	else
-		emplace (name, std::move (value));
+	setAttribute (UIAttributeAtom (name), std::move (value));
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (std::string&& name, std::string&& value)
 {
-	iterator iter = find (name);
-	if (iter != end ())
+	setAttribute (UIAttributeAtom (name), std::move (value));
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::setAttribute (UIAttributeAtom name, const std::string& value)
+{
+	setAttribute (name, std::string (value));
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::setAttribute (UIAttributeAtom name, std::string&& value)
+{
+	vstgui_assert (name.isValid ());
+	auto index = findAttribute (name) - begin ();
+	auto iter = UIAttributesMap::begin () + index;
+	if (iter != UIAttributesMap::end () && iter->first == name)
+	{
+		if (iter->second == value)
+			return;
 		iter->second = std::move (value);
+		if (!cachedValues.empty ())
+			cachedValues[index] = {};
+	}
 	else
-		emplace (std::move (name), std::move (value));
+	{
+		emplace (iter, name, std::move (value));
+		if (!cachedValues.empty ())
+			cachedValues.emplace (cachedValues.begin () + index);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::setParsedAttribute (UIAttributeAtom name, std::string&& value, ParsedType type,
+                                       const double (&values)[4])
+{
+	setAttribute (name, std::move (value));
+	if (type == ParsedType::None)
+		return;
+	if (cachedValues.empty ())
+		cachedValues.resize (size ());
+	auto& cached = cachedValues[findAttribute (name) - begin ()];
+	cached.type = type;
+	cached.valid = true;
+	std::copy (std::begin (values), std::end (values), std::begin (cached.values));
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::removeAttribute (const std::string& name)
 {
-	iterator iter = find (name);
-	if (iter != end ())
+	removeAttribute (UIAttributeAtom::find (name));
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::removeAttribute (UIAttributeAtom name)
+{
+	if (!name.isValid ())
+		return;
+	auto iter = findAttribute (name);
+	if (iter != end () && iter->first == name)
+	{
+		if (!cachedValues.empty ())
+			cachedValues.erase (cachedValues.begin () + (iter - begin ()));
 		erase (iter);
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -314,9 +457,20 @@ void UIAttributes::setDoubleAttribute (const std::string& name, double value)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getDoubleAttribute (const std::string& name, double& value) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToDouble (*str, value);
-	return false;
+	return getDoubleAttribute (UIAttributeAtom::find (name), value);
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getDoubleAttribute (UIAttributeAtom name, double& value) const
+{
+	auto cached = getCachedValue (name, CachedValue::Type::Double,
+	                              [] (const std::string& str, double* values) {
+		                              return stringToDouble (str, values[0]);
+	                              });
+	if (!cached)
+		return false;
+	value = cached->values[0];
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -328,9 +482,24 @@ void UIAttributes::setBooleanAttribute (const std::string& name, bool value)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getBooleanAttribute (const std::string& name, bool& value) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToBool (*str, value);
-	return false;
+	return getBooleanAttribute (UIAttributeAtom::find (name), value);
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getBooleanAttribute (UIAttributeAtom name, bool& value) const
+{
+	auto cached = getCachedValue (name, CachedValue::Type::Boolean,
+	                              [] (const std::string& str, double* values) {
+		                              bool b;
+		                              if (!stringToBool (str, b))
+			                              return false;
+		                              values[0] = b ? 1. : 0.;
+		                              return true;
+	                              });
+	if (!cached)
+		return false;
+	value = cached->values[0] != 0.;
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -342,9 +511,24 @@ void UIAttributes::setIntegerAttribute (const std::string& name, int32_t value)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getIntegerAttribute (const std::string& name, int32_t& value) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToInteger(*str, value);
-	return false;
+	return getIntegerAttribute (UIAttributeAtom::find (name), value);
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getIntegerAttribute (UIAttributeAtom name, int32_t& value) const
+{
+	auto cached = getCachedValue (name, CachedValue::Type::Integer,
+	                              [] (const std::string& str, double* values) {
+		                              int32_t i;
+		                              if (!stringToInteger (str, i))
+			                              return false;
+		                              values[0] = i;
+		                              return true;
+	                              });
+	if (!cached)
+		return false;
+	value = static_cast<int32_t> (cached->values[0]);
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -356,9 +540,26 @@ void UIAttributes::setPointAttribute (const std::string& name, const CPoint& p)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getPointAttribute (const std::string& name, CPoint& p) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToPoint (*str, p);
-	return false;
+	return getPointAttribute (UIAttributeAtom::find (name), p);
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getPointAttribute (UIAttributeAtom name, CPoint& p) const
+{
+	auto cached = getCachedValue (name, CachedValue::Type::Point,
+	                              [] (const std::string& str, double* values) {
+		                              CPoint point;
+		                              if (!stringToPoint (str, point))
+			                              return false;
+		                              values[0] = point.x;
+		                              values[1] = point.y;
+		                              return true;
+	                              });
+	if (!cached)
+		return false;
+	p.x = cached->values[0];
+	p.y = cached->values[1];
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -370,9 +571,27 @@ void UIAttributes::setRectAttribute (const std::string& name, const CRect& r)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getRectAttribute (const std::string& name, CRect& r) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToRect (*str, r);
-	return false;
+	return getRectAttribute (UIAttributeAtom::find (name), r);
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getRectAttribute (UIAttributeAtom name, CRect& r) const
+{
+	auto cached = getCachedValue (name, CachedValue::Type::Rect,
+	                              [] (const std::string& str, double* values) {
+		                              CRect rect;
+		                              if (!stringToRect (str, rect))
+			                              return false;
+		                              values[0] = rect.left;
+		                              values[1] = rect.top;
+		                              values[2] = rect.right;
+		                              values[3] = rect.bottom;
+		                              return true;
+	                              });
+	if (!cached)
+		return false;
+	r = CRect (cached->values[0], cached->values[1], cached->values[2], cached->values[3]);
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -383,9 +602,15 @@ void UIAttributes::setStringArrayAttribute (const std::string& name, const Strin
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::getStringArrayAttribute (const std::string& name, StringArray& values) const
+{
+	return getStringArrayAttribute (UIAttributeAtom::find (name), values);
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getStringArrayAttribute (UIAttributeAtom name, StringArray& values) const
 {
 	if (auto str = getAttributeValue (name))
-		return stringToStringArray(*str, values);
+		return stringToStringArray (*str, values);
 	return false;
 }
 
@@ -7,6 +7,8 @@
 #include "../lib/vstguifwd.h"
 #include "../lib/cstring.h"
 
+#include <string>
+#include <utility>
 #include <vector>
 #include "../lib/platform/std_unorderedmap.h"
 
@@ -14,9 +16,63 @@ namespace VSTGUI {
 class OutputStream;
 class InputStream;
 
-using UIAttributesMap = std::unordered_map<std::string,std::string>;
+//-----------------------------------------------------------------------------
+/** An interned attribute name
+ *
+ *	All atoms of the same name refer to one entry of a process wide table, so comparing and
+ *	ordering atoms does not touch the string. Atoms convert implicitly to the name string.
+ */
+class UIAttributeAtom
+{
+public:
+	UIAttributeAtom () = default;
+	explicit UIAttributeAtom (const std::string& name);
+	explicit UIAttributeAtom (UTF8StringPtr name);
+
+	/** returns an invalid atom if no atom with this name exists */
+	static UIAttributeAtom find (const std::string& name);
+
+	bool isValid () const { return entry != nullptr; }
+	uint32_t getID () const { return entry ? entry->second : 0; }
+	const std::string& getString () const;
+
+	operator const std::string& () const { return getString (); }
+	const char* c_str () const { return getString ().c_str (); }
+	const char* data () const { return getString ().data (); }
+	size_t size () const { return getString ().size (); }
+	bool empty () const { return getString ().empty (); }
+
+	bool operator== (const UIAttributeAtom& other) const { return entry == other.entry; }
+	bool operator!= (const UIAttributeAtom& other) const { return entry != other.entry; }
+	bool operator< (const UIAttributeAtom& other) const { return getID () < other.getID (); }
+
+private:
+	using Entry = std::pair<const std::string, uint32_t>;
+
+	explicit UIAttributeAtom (const Entry* entry) : entry (entry) {}
+
+	const Entry* entry {nullptr};
+};
+
+inline bool operator== (const UIAttributeAtom& a, const std::string& s) { return a.getString () == s; }
+inline bool operator== (const std::string& s, const UIAttributeAtom& a) { return a.getString () == s; }
+inline bool operator!= (const UIAttributeAtom& a, const std::string& s) { return a.getString () != s; }
+inline bool operator!= (const std::string& s, const UIAttributeAtom& a) { return a.getString () != s; }
+inline bool operator== (const UIAttributeAtom& a, UTF8StringPtr s) { return a.getString () == s; }
+inline bool operator== (UTF8StringPtr s, const UIAttributeAtom& a) { return a.getString () == s; }
+inline bool operator!= (const UIAttributeAtom& a, UTF8StringPtr s) { return a.getString () != s; }
+inline bool operator!= (UTF8StringPtr s, const UIAttributeAtom& a) { return a.getString () != s; }
+
+/** attribute name and value pairs, sorted by the id of the name atom */
+using UIAttributesMap = std::vector<std::pair<UIAttributeAtom, std::string>>;
 
 //-----------------------------------------------------------------------------
+/** The attributes of a UI description node
+ *
+ *	The typed getters cache the parsed values, so even the const methods change the object and
+ *	an instance must only be used by one thread at a time. Code which runs on other threads, like
+ *	the bitmap preloader, copies the values it needs on the calling thread.
+ */
 class UIAttributes : public NonAtomicReferenceCounted, private UIAttributesMap
 {
 public:
@@ -28,37 +84,70 @@ public:
 
 	using UIAttributesMap::empty;
 
-	using UIAttributesMap::begin;
-	using UIAttributesMap::end;
-	using UIAttributesMap::iterator;
 	using UIAttributesMap::const_iterator;
+	using iterator = const_iterator;
+
+	/** the values can only be changed via setAttribute, so that the typed cache stays valid */
+	const_iterator begin () const { return UIAttributesMap::begin (); }
+	const_iterator end () const { return UIAttributesMap::end (); }
 
 	bool hasAttribute (const std::string& name) const;
+	bool hasAttribute (UIAttributeAtom name) const;
 	const std::string* getAttributeValue (const std::string& name) const;
+	const std::string* getAttributeValue (UIAttributeAtom name) const;
 	void setAttribute (const std::string& name, const std::string& value);
 	void setAttribute (const std::string& name, std::string&& value);
 	void setAttribute (std::string&& name, std::string&& value);
+	void setAttribute (UIAttributeAtom name, const std::string& value);
+	void setAttribute (UIAttributeAtom name, std::string&& value);
 	void removeAttribute (const std::string& name);
+	void removeAttribute (UIAttributeAtom name);
+
+	/** the types the typed getters parse the attribute values into */
+	enum class ParsedType : uint8_t
+	{
+		None,
+		Boolean,
+		Integer,
+		Double,
+		Point,
+		Rect
+	};
+	/** set the attribute together with its value parsed as the typed getter of the type does it,
+	 *	so the first call of the getter does not parse the string. Used by readers of formats which
+	 *	store the parsed values, values holds the fields in the order of CPoint or CRect. */
+	void setParsedAttribute (UIAttributeAtom name, std::string&& value, ParsedType type,
+	                         const double (&values)[4]);
 
 	void setBooleanAttribute (const std::string& name, bool value);
 	bool getBooleanAttribute (const std::string& name, bool& value) const;
+	bool getBooleanAttribute (UIAttributeAtom name, bool& value) const;
 
 	void setIntegerAttribute (const std::string& name, int32_t value);
 	bool getIntegerAttribute (const std::string& name, int32_t& value) const;
+	bool getIntegerAttribute (UIAttributeAtom name, int32_t& value) const;
 
 	void setDoubleAttribute (const std::string& name, double value);
 	bool getDoubleAttribute (const std::string& name, double& value) const;
+	bool getDoubleAttribute (UIAttributeAtom name, double& value) const;
 	
 	void setPointAttribute (const std::string& name, const CPoint& p);
 	bool getPointAttribute (const std::string& name, CPoint& p) const;
+	bool getPointAttribute (UIAttributeAtom name, CPoint& p) const;
 	
 	void setRectAttribute (const std::string& name, const CRect& r);
 	bool getRectAttribute (const std::string& name, CRect& r) const;
+	bool getRectAttribute (UIAttributeAtom name, CRect& r) const;
 
 	void setStringArrayAttribute (const std::string& name, const StringArray& values);
 	bool getStringArrayAttribute (const std::string& name, StringArray& values) const;
+	bool getStringArrayAttribute (UIAttributeAtom name, StringArray& values) const;
 	
-	void removeAll () { clear (); }
+	void removeAll ()
+	{
+		clear ();
+		cachedValues.clear ();
+	}
 
 	bool store (OutputStream& stream) const;
 	bool restore (InputStream& stream);
@@ -75,7 +164,26 @@ public:
 	static bool stringToRect (const std::string& str, CRect& r);
 	static std::string stringArrayToString (const StringArray& values);
 	static bool stringToStringArray (const std::string& str, StringArray& values);
-	
+
+private:
+	/** the value of an attribute as parsed by the last typed getter */
+	struct CachedValue
+	{
+		using Type = ParsedType;
+		Type type {Type::None};
+		bool valid {false};
+		double values[4] {};
+	};
+
+	const_iterator findAttribute (UIAttributeAtom name) const;
+	template<typename ParseFunc>
+	const CachedValue* getCachedValue (UIAttributeAtom name, CachedValue::Type type,
+	                                   ParseFunc parse) const;
+
+	/** parallel to the attributes, allocated on the first typed access and reset when an
+	 *	attribute changes. Templates are instantiated from the same attributes again and again,
+	 *	so their strings are only parsed once. */
+	mutable std::vector<CachedValue> cachedValues;
 };
 
 } // VSTGUI
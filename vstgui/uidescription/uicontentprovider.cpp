@@ -3,6 +3,8 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "uicontentprovider.h"
+#include <algorithm>
+#include <cstring>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -50,5 +52,91 @@ void InputStreamContentProvider::rewind ()
 }
 
 
+//------------------------------------------------------------------------
+BufferedContentProvider::BufferedContentProvider (IContentProvider& provider, uint32_t bufferSize)
+: provider (provider)
+, buffer (std::max<uint32_t> (bufferSize, 1))
+{
+}
+
+//------------------------------------------------------------------------
+bool BufferedContentProvider::fill ()
+{
+	auto bufferSize = static_cast<uint32_t> (buffer.size ());
+	if (end == bufferSize)
+		return false;
+	auto numRead = provider.readRawData (buffer.data () + end, bufferSize - end);
+	if (numRead == 0 || numRead == kStreamIOError)
+		return false;
+	end += numRead;
+	return true;
+}
+
+//------------------------------------------------------------------------
+uint32_t BufferedContentProvider::peek (const int8_t*& data, uint32_t size)
+{
+	size = std::min (size, static_cast<uint32_t> (buffer.size ()));
+	if (end - position < size)
+	{
+		if (position > 0)
+		{
+			memmove (buffer.data (), buffer.data () + position, end - position);
+			end -= position;
+			position = 0;
+			bufferAtStart = false;
+		}
+		while (end < size && fill ())
+			;
+	}
+	data = buffer.data () + position;
+	return std::min (size, end - position);
+}
+
+//------------------------------------------------------------------------
+uint32_t BufferedContentProvider::readRawData (int8_t* outBuffer, uint32_t size)
+{
+	uint32_t numRead = 0;
+	while (numRead < size)
+	{
+		if (position == end)
+		{
+			if (end > 0)
+				bufferAtStart = false;
+			position = end = 0;
+			auto remaining = size - numRead;
+			if (remaining >= buffer.size ())
+			{
+				// no need to copy large reads through the buffer
+				auto directRead = provider.readRawData (outBuffer + numRead, remaining);
+				if (directRead == 0 || directRead == kStreamIOError)
+					break;
+				bufferAtStart = false;
+				numRead += directRead;
+				continue;
+			}
+			if (!fill ())
+				break;
+		}
+		auto numCopy = std::min (size - numRead, end - position);
+		memcpy (outBuffer + numRead, buffer.data () + position, numCopy);
+		position += numCopy;
+		numRead += numCopy;
+	}
+	return numRead;
+}
+
+//------------------------------------------------------------------------
+void BufferedContentProvider::rewind ()
+{
+	if (bufferAtStart)
+	{
+		position = 0;
+		return;
+	}
+	provider.rewind ();
+	position = end = 0;
+	bufferAtStart = true;
+}
+
 //------------------------------------------------------------------------
 } // VSTGUI
@@ -6,6 +6,7 @@
 
 #include "icontentprovider.h"
 #include "cstream.h"
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -32,5 +33,36 @@ protected:
 	int64_t startPos;
 };
 
+//-----------------------------------------------------------------------------
+/** reads another content provider in large blocks
+ *
+ *	The start of the content can be inspected with peek () without consuming it and rewinding is
+ *	free as long as the buffer still holds the start of the content.
+ */
+class BufferedContentProvider : public IContentProvider
+{
+public:
+	explicit BufferedContentProvider (IContentProvider& provider, uint32_t bufferSize = 64 * 1024);
+
+	/** make the next bytes available without consuming them
+	 *
+	 *	@return the number of bytes available at data, less than size only at the end of the
+	 *	content or if size is larger than the buffer
+	 */
+	uint32_t peek (const int8_t*& data, uint32_t size);
+
+	uint32_t readRawData (int8_t* buffer, uint32_t size) override;
+	void rewind () override;
+
+protected:
+	bool fill ();
+
+	IContentProvider& provider;
+	std::vector<int8_t> buffer;
+	uint32_t position {0};
+	uint32_t end {0};
+	bool bufferAtStart {true};
+};
+
 //------------------------------------------------------------------------
 } // VSTGUI
@@ -16,6 +16,7 @@
 #include "../lib/cfont.h"
 #include "../lib/cstring.h"
 #include "../lib/cframe.h"
+#include "../lib/controls/ccontrol.h"
 #include "../lib/cdrawcontext.h"
 #include "../lib/cgradient.h"
 #include "../lib/cgraphicspath.h"
@@ -28,6 +29,8 @@
 #include "detail/locale.h"
 #include "detail/parsecolor.h"
 #include "detail/scalefactorutils.h"
+#include "detail/uibinarypersistence.h"
+#include "detail/uibitmappreloader.h"
 #include "detail/uidesclist.h"
 #include "detail/uijsonpersistence.h"
 #include "detail/uinode.h"
@@ -38,6 +41,8 @@
 #include <algorithm>
 #include <cassert>
 #include <deque>
+#include <typeinfo>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -99,6 +104,76 @@ struct UIDescription::Impl : ListenerProvider<Impl, UIDescriptionListener>
 	
 	Optional<UINode*> variableBaseNode;
 
+	/** a view tree built once from a template without a controller */
+	struct ViewPrototype
+	{
+		struct Entry
+		{
+			UINode* node {nullptr};
+			CView* view {nullptr};
+			/** the indices of the view and its parent in the depth first order of the tree */
+			size_t viewIndex {0};
+			size_t parentIndex {0};
+			/** the control tag to resolve again with the controller of an instance */
+			SharedPointer<UIAttributes> controlTag {nullptr};
+		};
+
+		SharedPointer<CView> view;
+		/** the views in depth first order */
+		std::vector<CView*> views;
+		/** the views created from nodes, in the order they are verified by the controller */
+		std::vector<Entry> entries;
+		bool cloneable {true};
+	};
+
+	/** the prototypes of the templates, a nullptr entry for a template that can not be cloned.
+	 *	Any change of the description removes them. */
+	struct ViewPrototypeCache : UIDescriptionListenerAdapter
+	{
+		std::unordered_map<const UINode*, std::unique_ptr<ViewPrototype>> prototypes;
+
+		bool doUIDescTemplateUpdate (UIDescription* desc, UTF8StringPtr name) override
+		{
+			prototypes.clear ();
+			return true;
+		}
+		void onUIDescTagChanged (UIDescription* desc) override { prototypes.clear (); }
+		void onUIDescColorChanged (UIDescription* desc) override { prototypes.clear (); }
+		void onUIDescFontChanged (UIDescription* desc) override { prototypes.clear (); }
+		void onUIDescBitmapChanged (UIDescription* desc) override { prototypes.clear (); }
+		void onUIDescTemplateChanged (UIDescription* desc) override { prototypes.clear (); }
+		void onUIDescGradientChanged (UIDescription* desc) override { prototypes.clear (); }
+	};
+	mutable std::unique_ptr<ViewPrototypeCache> viewPrototypeCache;
+	mutable ViewPrototype* recordingPrototype {nullptr};
+
+	std::unique_ptr<Detail::BitmapPreloader> bitmapPreloader;
+
+	/** the nodes of a main node by a key derived from their value, for the reverse lookups of the
+	 *	resource names. Built again when the revision of the list of nodes or of the values
+	 *	changed. */
+	template<typename KeyType>
+	struct NodeValueIndex
+	{
+		using Key = KeyType;
+		struct Entry
+		{
+			/** the position in the list, the first of several nodes with the same value wins */
+			size_t position;
+			UINode* node;
+		};
+		uint64_t revision {0};
+		uint64_t valueRevision {0};
+		std::unordered_multimap<Key, Entry> nodes;
+	};
+	mutable NodeValueIndex<uint32_t> colorIndex;
+	mutable NodeValueIndex<const CFontDesc*> fontIndex;
+	/** only contains the bitmaps already created, a lookup never decodes a bitmap */
+	mutable NodeValueIndex<const CBitmap*> bitmapIndex;
+	/** gradients are found by the hash of their color stops */
+	mutable NodeValueIndex<size_t> gradientIndex;
+	mutable NodeValueIndex<int32_t> controlTagIndex;
+
 	UINode* getVariableBaseNode ()
 	{
 		if (!variableBaseNode)
@@ -242,26 +317,90 @@ void UIDescription::setContentProvider (IContentProvider* provider)
 	impl->contentProvider = provider;
 }
 
+//-----------------------------------------------------------------------------
+enum class UIDescFormat
+{
+	Unknown,
+	Binary,
+	JSON,
+	XML
+};
+
+//-----------------------------------------------------------------------------
+static UIDescFormat detectUIDescFormat (BufferedContentProvider& contentProvider)
+{
+	static constexpr uint32_t kSniffSize = 1024;
+
+	const int8_t* data;
+	auto size = contentProvider.peek (data, kSniffSize);
+	if (Detail::UIBinaryDescReader::isBinaryDesc (data, size))
+		return UIDescFormat::Binary;
+	auto text = reinterpret_cast<const uint8_t*> (data);
+	uint32_t pos = 0;
+	if (size >= 3 && text[0] == 0xef && text[1] == 0xbb && text[2] == 0xbf) // UTF-8 BOM
+		pos = 3;
+	for (; pos < size; ++pos)
+	{
+		switch (text[pos])
+		{
+			case ' ':
+			case '\t':
+			case '\r':
+			case '\n': continue;
+			case '{': return UIDescFormat::JSON;
+			case '<': return UIDescFormat::XML;
+			default: return UIDescFormat::Unknown;
+		}
+	}
+	return UIDescFormat::Unknown;
+}
+
+//-----------------------------------------------------------------------------
+static SharedPointer<Detail::UINode> parseUIDesc (IContentProvider& contentProvider,
+                                                  UTF8StringPtr filePath = nullptr)
+{
+	BufferedContentProvider bufferedProvider (contentProvider);
+	switch (detectUIDescFormat (bufferedProvider))
+	{
+		case UIDescFormat::Binary:
+		{
+			if (filePath)
+			{
+				if (auto nodes = Detail::UIBinaryDescReader::read (filePath))
+					return nodes;
+			}
+			return Detail::UIBinaryDescReader::read (bufferedProvider);
+		}
+		case UIDescFormat::JSON:
+		{
+			return Detail::UIJsonDescReader::read (bufferedProvider);
+		}
+		case UIDescFormat::XML:
+		{
+#if VSTGUI_ENABLE_XML_PARSER
+			Detail::UIXMLParser parser;
+			return parser.parse (&bufferedProvider);
+#else
+#if DEBUG
+			DebugPrint ("XML not available.");
+#endif
+			break;
+#endif
+		}
+		case UIDescFormat::Unknown: break;
+	}
+	return nullptr;
+}
+
 //-----------------------------------------------------------------------------
 bool UIDescription::parse ()
 {
 	if (parsed ())
 		return true;
-		
-	static auto parseUIDesc = [] (IContentProvider* contentProvider) -> SharedPointer<UINode> {
-		if (auto nodes = Detail::UIJsonDescReader::read (*contentProvider))
-			return nodes;
-#if VSTGUI_ENABLE_XML_PARSER
-		Detail::UIXMLParser parser;
-		if (auto nodes = parser.parse (contentProvider))
-			return nodes;
-#endif
-		return nullptr;
-	};
 
 	if (impl->contentProvider)
 	{
-		if ((impl->nodes = parseUIDesc (impl->contentProvider)))
+		if ((impl->nodes = parseUIDesc (*impl->contentProvider)))
 		{
 			addDefaultNodes ();
 			return true;
@@ -273,7 +412,7 @@ bool UIDescription::parse ()
 		if (resInputStream.open (impl->uidescFile))
 		{
 			InputStreamContentProvider contentProvider (resInputStream);
-			if ((impl->nodes = parseUIDesc (&contentProvider)))
+			if ((impl->nodes = parseUIDesc (contentProvider)))
 			{
 				addDefaultNodes ();
 				return true;
@@ -284,8 +423,9 @@ bool UIDescription::parse ()
 			CFileStream fileStream;
 			if (fileStream.open (impl->uidescFile.u.name, CFileStream::kReadMode))
 			{
+				// a binary description is mapped into memory via the path instead of read
 				InputStreamContentProvider contentProvider (fileStream);
-				if ((impl->nodes = parseUIDesc (&contentProvider)))
+				if ((impl->nodes = parseUIDesc (contentProvider, impl->uidescFile.u.name)))
 				{
 					addDefaultNodes ();
 					return true;
@@ -358,6 +498,9 @@ void UIDescription::freePlatformResources ()
 {
 	if (impl->nodes)
 		FreeNodePlatformResources (impl->nodes);
+	// the fonts and bitmaps are created again with other addresses
+	impl->fontIndex.revision = 0;
+	impl->bitmapIndex.revision = 0;
 }
 
 //------------------------------------------------------------------------
@@ -420,7 +563,10 @@ bool UIDescription::save (UTF8StringPtr filename, int32_t flags, AttributeSaveFi
 	std::string oldName = moveOldFile (filename);
 	bool result = false;
 	CFileStream stream;
-	if (stream.open (filename, CFileStream::kWriteMode|CFileStream::kTruncateMode))
+	int32_t streamMode = CFileStream::kWriteMode|CFileStream::kTruncateMode;
+	if (flags & kWriteAsBinary)
+		streamMode |= CFileStream::kBinaryMode;
+	if (stream.open (filename, streamMode))
 	{
 		result = saveToStream (stream, flags, func);
 	}
@@ -471,6 +617,10 @@ bool UIDescription::saveToStream (OutputStream& stream, int32_t flags, Attribute
 	}
 	impl->nodes->getAttributes ()->setAttribute ("version", "1");
 	
+	// the binary writer writes whole tables at once and needs no buffering
+	if (flags & kWriteAsBinary)
+		return Detail::UIBinaryDescWriter::write (stream, impl->nodes);
+
 	BufferedOutputStream bufferedStream (stream);
 	if (flags & kWriteAsXML)
 	{
@@ -491,6 +641,8 @@ bool UIDescription::saveToStream (OutputStream& stream, int32_t flags, Attribute
 void UIDescription::setSharedResources (const SharedPointer<UIDescription>& resources)
 {
 	impl->sharedResources = resources;
+	if (impl->viewPrototypeCache)
+		impl->viewPrototypeCache->prototypes.clear ();
 }
 
 //-----------------------------------------------------------------------------
@@ -721,6 +873,8 @@ CView* UIDescription::createViewFromNode (UINode* node) const
 			}
 		}
 	}
+	if (result && impl->recordingPrototype)
+		recordViewPrototypeEntry (node, result);
 	if (result && impl->controller)
 		result = impl->controller->verifyView (result, *node->getAttributes (), this);
 	if (subController)
@@ -741,6 +895,190 @@ CView* UIDescription::createViewFromNode (UINode* node) const
 	return result;
 }
 
+//-----------------------------------------------------------------------------
+void UIDescription::setViewPrototypeCacheEnabled (bool state)
+{
+	if (state == isViewPrototypeCacheEnabled ())
+		return;
+	if (state)
+	{
+		impl->viewPrototypeCache = std::unique_ptr<Impl::ViewPrototypeCache> (new Impl::ViewPrototypeCache);
+		impl->registerListener (impl->viewPrototypeCache.get ());
+	}
+	else
+	{
+		impl->unregisterListener (impl->viewPrototypeCache.get ());
+		impl->viewPrototypeCache = nullptr;
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescription::isViewPrototypeCacheEnabled () const
+{
+	return impl->viewPrototypeCache != nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void UIDescription::preloadBitmaps (uint32_t numThreads)
+{
+	UINode* bitmapNodes = getBaseNode (Detail::MainNodeNames::kBitmap);
+	if (!bitmapNodes)
+		return;
+	auto preloader = std::unique_ptr<Detail::BitmapPreloader> (new Detail::BitmapPreloader);
+	for (auto& childNode : bitmapNodes->getChildren ())
+	{
+		if (auto bitmapNode = dynamic_cast<Detail::UIBitmapNode*> (childNode))
+		{
+			if (auto job = bitmapNode->createDecodeJob (impl->filePath))
+				preloader->add (job);
+		}
+	}
+	if (impl->bitmapPreloader)
+		impl->bitmapPreloader->waitUntilFinished ();
+	impl->bitmapPreloader = std::move (preloader);
+	impl->bitmapPreloader->start (numThreads);
+}
+
+//-----------------------------------------------------------------------------
+auto UIDescription::getBitmapPreloadStatistics () const -> BitmapPreloadStatistics
+{
+	if (impl->bitmapPreloader)
+		return impl->bitmapPreloader->getStatistics ();
+	return {};
+}
+
+//-----------------------------------------------------------------------------
+void UIDescription::recordViewPrototypeEntry (UINode* node, CView* view) const
+{
+	auto prototype = impl->recordingPrototype;
+	const auto& attributes = *node->getAttributes ();
+	// the controller creates custom views and sub controllers for every instance, and a view
+	// switch container owns its controller
+	if (attributes.hasAttribute (UIViewCreator::kAttrCustomViewName) ||
+	    attributes.hasAttribute (UIViewCreator::kAttrSubController) ||
+	    dynamic_cast<UIViewSwitchContainer*> (view))
+	{
+		prototype->cloneable = false;
+		return;
+	}
+	Impl::ViewPrototype::Entry entry {node, view};
+	if (dynamic_cast<CControl*> (view))
+	{
+		if (auto tagName = attributes.getAttributeValue (UIViewCreator::kAttrControlTag))
+		{
+			entry.controlTag = makeOwned<UIAttributes> (1);
+			entry.controlTag->setAttribute (UIViewCreator::kAttrControlTag, *tagName);
+		}
+	}
+	prototype->entries.emplace_back (std::move (entry));
+}
+
+//-----------------------------------------------------------------------------
+static void collectViews (CView* view, std::vector<CView*>& views,
+                          std::vector<size_t>* parentIndices = nullptr, size_t parentIndex = 0)
+{
+	auto index = views.size ();
+	views.emplace_back (view);
+	if (parentIndices)
+		parentIndices->emplace_back (parentIndex);
+	if (auto container = view->asViewContainer ())
+	{
+		container->forEachChild (
+		    [&] (CView* child) { collectViews (child, views, parentIndices, index); });
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescription::createViewFromPrototype (UINode* templateNode, CView*& result) const
+{
+	auto cache = impl->viewPrototypeCache.get ();
+	if (!cache || impl->recordingPrototype)
+		return false;
+	auto it = cache->prototypes.find (templateNode);
+	if (it == cache->prototypes.end ())
+	{
+		// build the prototype without the controller, it is asked for every instance
+		auto prototype = std::unique_ptr<Impl::ViewPrototype> (new Impl::ViewPrototype);
+		{
+			ScopePointer<IController> noController (&impl->controller, nullptr);
+			ScopePointer<Impl::ViewPrototype> recording (&impl->recordingPrototype,
+			                                             prototype.get ());
+			prototype->view = owned (createViewFromNode (templateNode));
+		}
+		if (prototype->view && prototype->cloneable)
+		{
+			std::vector<size_t> parentIndices;
+			collectViews (prototype->view, prototype->views, &parentIndices);
+			std::unordered_map<CView*, size_t> viewIndices;
+			for (auto index = 0u; index < prototype->views.size (); ++index)
+				viewIndices.emplace (prototype->views[index], index);
+			for (auto& entry : prototype->entries)
+			{
+				auto indexIt = viewIndices.find (entry.view);
+				if (indexIt == viewIndices.end ())
+				{
+					prototype->cloneable = false;
+					break;
+				}
+				entry.viewIndex = indexIt->second;
+				entry.parentIndex = parentIndices[entry.viewIndex];
+			}
+		}
+		if (!prototype->view || !prototype->cloneable)
+			prototype = nullptr;
+		it = cache->prototypes.emplace (templateNode, std::move (prototype)).first;
+	}
+	auto prototype = it->second.get ();
+	if (!prototype)
+		return false;
+
+	auto clone = static_cast<CView*> (prototype->view->newCopy ());
+	std::vector<CView*> views;
+	views.reserve (prototype->views.size ());
+	if (clone)
+		collectViews (clone, views);
+	// a view class without its own copy constructor is copied as its base class
+	bool sameTree = views.size () == prototype->views.size ();
+	for (auto index = 0u; sameTree && index < views.size (); ++index)
+		sameTree = typeid (*views[index]) == typeid (*prototype->views[index]);
+	if (!sameTree)
+	{
+		if (clone)
+			clone->forget ();
+		it->second = nullptr;
+		return false;
+	}
+
+	result = clone;
+	for (const auto& entry : prototype->entries)
+	{
+		auto view = views[entry.viewIndex];
+		if (entry.controlTag)
+			impl->viewFactory->applyAttributeValues (view, *entry.controlTag, this);
+		if (!impl->controller)
+			continue;
+		if (view == clone)
+		{
+			result = impl->controller->verifyView (view, *entry.node->getAttributes (), this);
+			continue;
+		}
+		// like a newly created view, the view is not yet added to its parent when verified
+		auto parent = views[entry.parentIndex]->asViewContainer ();
+		ViewIterator next (parent);
+		while (*next && *next != view)
+			++next;
+		CView* before = *(++next);
+		parent->removeView (view, false);
+		if (auto verified =
+		        impl->controller->verifyView (view, *entry.node->getAttributes (), this))
+		{
+			if (!parent->addView (verified, before))
+				verified->forget ();
+		}
+	}
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 CViewAttributeID UIDescription::kTemplateNameAttributeID = 'uitl';
 
@@ -757,7 +1095,9 @@ CView* UIDescription::createView (UTF8StringPtr name, IController* _controller)
 				const std::string* nodeName = itNode->getAttributes ()->getAttributeValue ("name");
 				if (nodeName && *nodeName == name)
 				{
-					CView* view = createViewFromNode (itNode);
+					CView* view = nullptr;
+					if (!createViewFromPrototype (itNode, view))
+						view = createViewFromNode (itNode);
 					if (view)
 						view->setAttribute (kTemplateNameAttributeID, static_cast<uint32_t> (strlen (name) + 1), name);
 					return view;
@@ -1049,7 +1389,17 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 						childNode->setScaledBitmapsAdded ();
 						CBitmap* childBitmap = getBitmap (childNodeBitmapName->c_str ());
 						if (childBitmap && childBitmap->getPlatformBitmap ())
-							bitmap->addBitmap (childBitmap->getPlatformBitmap ());
+						{
+							auto platformBitmap = childBitmap->getPlatformBitmap ();
+							if (bitmap->addBitmap (platformBitmap))
+							{
+								// a released scaled version is shared with the child bitmap again
+								SharedPointer<CBitmap> child (childBitmap);
+								bitmap->setReloadFunction (platformBitmap, [child] () {
+									return child->getPlatformBitmap ();
+								});
+							}
+						}
 					}
 				}
 			}
@@ -1093,29 +1443,84 @@ CGradient* UIDescription::getGradient (UTF8StringPtr name) const
 }
 
 //-----------------------------------------------------------------------------
-template<typename NodeType, typename ObjType, typename CompareFunction> UTF8StringPtr UIDescription::lookupName (const ObjType& obj, IdStringPtr mainNodeName, CompareFunction compare) const
+template<typename NodeType, typename Index, typename ObjType, typename NodeKeyFunction, typename CompareFunction>
+UTF8StringPtr UIDescription::lookupName (const ObjType& obj, const typename Index::Key& key, IdStringPtr mainNodeName, Index& index, NodeKeyFunction nodeKey, CompareFunction compare, uint64_t valueRevision) const
 {
 	UINode* baseNode = getBaseNode (mainNodeName);
-	if (baseNode)
+	if (baseNode == nullptr)
+		return nullptr;
+	auto& children = baseNode->getChildren ();
+	if (index.revision != children.getRevision () || index.valueRevision != valueRevision)
 	{
-		auto& children = baseNode->getChildren ();
+		index.revision = children.getRevision ();
+		index.valueRevision = valueRevision;
+		index.nodes.clear ();
+		size_t position = 0;
 		for (const auto& itNode : children)
 		{
+			typename Index::Key nodeKeyValue;
 			auto* node = dynamic_cast<NodeType*>(itNode);
-			if (node && compare (this, node, obj))
-			{
-				const std::string* name = node->getAttributes ()->getAttributeValue ("name");
-				return name ? name->c_str () : nullptr;
-			}
+			if (node && nodeKey (this, node, nodeKeyValue))
+				index.nodes.emplace (nodeKeyValue, typename Index::Entry {position, node});
+			++position;
 		}
 	}
+	const typename Index::Entry* found = nullptr;
+	auto range = index.nodes.equal_range (key);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (found && found->position < it->second.position)
+			continue;
+		if (compare (this, static_cast<NodeType*> (it->second.node), obj))
+			found = &it->second;
+	}
+	if (found)
+	{
+		const std::string* name = found->node->getAttributes ()->getAttributeValue ("name");
+		return name ? name->c_str () : nullptr;
+	}
 	return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+static uint32_t colorKey (const CColor& color)
+{
+	return (static_cast<uint32_t> (color.red) << 24) | (static_cast<uint32_t> (color.green) << 16) |
+	       (static_cast<uint32_t> (color.blue) << 8) | color.alpha;
+}
+
+//-----------------------------------------------------------------------------
+static size_t colorStopsKey (const GradientColorStopMap& colorStops)
+{
+	size_t key = colorStops.size ();
+	for (const auto& colorStop : colorStops)
+	{
+		key = key * 31 + std::hash<double> () (colorStop.first);
+		key = key * 31 + colorKey (colorStop.second);
+	}
+	return key;
+}
+
+//-----------------------------------------------------------------------------
+static bool controlTagValue (const UIDescription* desc, Detail::UIControlTagNode* node, int32_t& value)
+{
+	value = node->getTag ();
+	if (value == -1 && node->getTagString ())
+	{
+		double v;
+		if (desc->calculateStringValue (node->getTagString ()->c_str (), v))
+			value = (int32_t)v;
+	}
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupColorName (const CColor& color) const
 {
-	return lookupName<Detail::UIColorNode> (color, Detail::MainNodeNames::kColor, [] (const UIDescription* desc, Detail::UIColorNode* node, const CColor& color) {
+	return lookupName<Detail::UIColorNode> (color, colorKey (color), Detail::MainNodeNames::kColor, impl->colorIndex, [] (const UIDescription* desc, Detail::UIColorNode* node, uint32_t& key) {
+		key = colorKey (node->getColor ());
+		return true;
+	}, [] (const UIDescription* desc, Detail::UIColorNode* node, const CColor& color) {
 		return node->getColor() == color;
 	});
 }
@@ -1123,7 +1528,10 @@ UTF8StringPtr UIDescription::lookupColorName (const CColor& color) const
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupFontName (const CFontRef font) const
 {
-	return font ? lookupName<Detail::UIFontNode> (font, Detail::MainNodeNames::kFont, [] (const UIDescription* desc, Detail::UIFontNode* node, const CFontRef& font) {
+	return font ? lookupName<Detail::UIFontNode> (font, font, Detail::MainNodeNames::kFont, impl->fontIndex, [] (const UIDescription* desc, Detail::UIFontNode* node, const CFontDesc*& key) {
+		key = node->getFont ();
+		return key != nullptr;
+	}, [] (const UIDescription* desc, Detail::UIFontNode* node, const CFontRef& font) {
 		return node->getFont () && node->getFont () == font;
 	}) : nullptr;
 }
@@ -1131,15 +1539,27 @@ UTF8StringPtr UIDescription::lookupFontName (const CFontRef font) const
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupBitmapName (const CBitmap* bitmap) const
 {
-	return bitmap ? lookupName<Detail::UIBitmapNode> (bitmap, Detail::MainNodeNames::kBitmap, [] (const UIDescription* desc, Detail::UIBitmapNode* node, const CBitmap* bitmap) {
-		return node->getBitmap (desc->impl->filePath) == bitmap;
-	}) : nullptr;
+	// a bitmap of this description is created by its node, so the nodes whose bitmap is not
+	// created yet can not match
+	return bitmap ? lookupName<Detail::UIBitmapNode> (bitmap, bitmap, Detail::MainNodeNames::kBitmap, impl->bitmapIndex, [] (const UIDescription* desc, Detail::UIBitmapNode* node, const CBitmap*& key) {
+		key = node->getCreatedBitmap ();
+		return key != nullptr;
+	}, [] (const UIDescription* desc, Detail::UIBitmapNode* node, const CBitmap* bitmap) {
+		return node->getCreatedBitmap () == bitmap;
+	}, Detail::UIBitmapNode::getBitmapCreationCount ()) : nullptr;
 }
 
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupGradientName (const CGradient* gradient) const
 {
-	return gradient ? lookupName<Detail::UIGradientNode> (gradient, Detail::MainNodeNames::kGradient, [] (const UIDescription* desc, Detail::UIGradientNode* node, const CGradient* gradient) {
+	return gradient ? lookupName<Detail::UIGradientNode> (gradient, colorStopsKey (gradient->getColorStops ()), Detail::MainNodeNames::kGradient, impl->gradientIndex, [] (const UIDescription* desc, Detail::UIGradientNode* node, size_t& key) {
+		if (auto nodeGradient = node->getGradient ())
+		{
+			key = colorStopsKey (nodeGradient->getColorStops ());
+			return true;
+		}
+		return false;
+	}, [] (const UIDescription* desc, Detail::UIGradientNode* node, const CGradient* gradient) {
 		return node->getGradient() == gradient || (node->getGradient () && gradient->getColorStops () == node->getGradient ()->getColorStops ());
 	}) : nullptr;
 }
@@ -1147,14 +1567,9 @@ UTF8StringPtr UIDescription::lookupGradientName (const CGradient* gradient) cons
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupControlTagName (const int32_t tag) const
 {
-	return lookupName<Detail::UIControlTagNode> (tag, Detail::MainNodeNames::kControlTag, [] (const UIDescription* desc, Detail::UIControlTagNode* node, const int32_t tag) {
-		int32_t nodeTag = node->getTag ();
-		if (nodeTag == -1 && node->getTagString ())
-		{
-			double v;
-			if (desc->calculateStringValue (node->getTagString ()->c_str (), v))
-				nodeTag = (int32_t)v;
-		}
+	return lookupName<Detail::UIControlTagNode> (tag, tag, Detail::MainNodeNames::kControlTag, impl->controlTagIndex, controlTagValue, [] (const UIDescription* desc, Detail::UIControlTagNode* node, const int32_t tag) {
+		int32_t nodeTag;
+		controlTagValue (desc, node, nodeTag);
 		return nodeTag == tag;
 	});
 }
@@ -1218,6 +1633,13 @@ void UIDescription::changeGradientName (UTF8StringPtr oldName, UTF8StringPtr new
 	});
 }
 
+//-----------------------------------------------------------------------------
+static std::string getAttributeValueString (Detail::UINode* node, const char* attributeName)
+{
+	auto value = node->getAttributes ()->getAttributeValue (attributeName);
+	return value ? *value : std::string ();
+}
+
 //-----------------------------------------------------------------------------
 void UIDescription::changeColor (UTF8StringPtr name, const CColor& newColor)
 {
@@ -1227,7 +1649,9 @@ void UIDescription::changeColor (UTF8StringPtr name, const CColor& newColor)
 	{
 		if (!node->noExport ())
 		{
+			auto oldValue = getAttributeValueString (node, "rgba");
 			node->setColor (newColor);
+			colorsNode->childAttributeChanged (node, "rgba", oldValue.data ());
 			impl->forEachListener ([this] (UIDescriptionListener* l) {
 				l->onUIDescColorChanged (this);
 			});
@@ -1261,7 +1685,9 @@ void UIDescription::changeFont (UTF8StringPtr name, CFontRef newFont)
 	{
 		if (!node->noExport ())
 		{
+			auto oldValue = getAttributeValueString (node, "font-name");
 			node->setFont (newFont);
+			fontsNode->childAttributeChanged (node, "font-name", oldValue.data ());
 			impl->forEachListener ([this] (UIDescriptionListener* l) {
 				l->onUIDescFontChanged (this);
 			});
@@ -1294,6 +1720,8 @@ void UIDescription::changeGradient (UTF8StringPtr name, CGradient* newGradient)
 		if (!node->noExport ())
 		{
 			node->setGradient (newGradient);
+			// the color stops are child nodes of the gradient node
+			gradientsNode->childAttributeChanged (node, "color-stop", "");
 			impl->forEachListener ([this] (UIDescriptionListener* l) {
 				l->onUIDescGradientChanged (this);
 			});
@@ -1325,8 +1753,10 @@ void UIDescription::changeBitmap (UTF8StringPtr name, UTF8StringPtr newName, con
 	{
 		if (!node->noExport ())
 		{
+			auto oldValue = getAttributeValueString (node, "path");
 			node->setBitmap (newName);
 			node->setNinePartTiledOffset (nineparttiledOffset);
+			bitmapsNode->childAttributeChanged (node, "path", oldValue.data ());
 			impl->forEachListener ([this] (UIDescriptionListener* l) {
 				l->onUIDescBitmapChanged (this);
 			});
@@ -1855,7 +2285,9 @@ bool UIDescription::changeControlTagString  (UTF8StringPtr tagName, const std::s
 	{
 		if (create)
 			return false;
+		auto oldValue = getAttributeValueString (controlTagNode, "tag");
 		controlTagNode->setTagString (newTagString);
+		tagsNode->childAttributeChanged (controlTagNode, "tag", oldValue.data ());
 		impl->forEachListener ([this](UIDescriptionListener* l) { l->onUIDescTagChanged (this); });
 		return true;
 	}
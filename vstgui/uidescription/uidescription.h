@@ -28,6 +28,7 @@ protected:
 		WriteImagesIntoUIDescFileBit,
 		DoNotVerifyImageDataBit,
 		WriteAsXmlBit,
+		WriteAsBinaryBit,
 		LastSaveFlagBit,
 	};
 public:
@@ -43,6 +44,8 @@ public:
 		kWriteImagesIntoUIDescFile	= 1 << WriteImagesIntoUIDescFileBit,
 		kDoNotVerifyImageData	= 1 << DoNotVerifyImageDataBit,
 		kWriteAsXML = 1 << WriteAsXmlBit,
+		/** write the precompiled binary format, which can be loaded faster than XML or JSON */
+		kWriteAsBinary = 1 << WriteAsBinaryBit,
 		
 		kWriteImagesIntoXMLFile [[deprecated("use kWriteImagesIntoUIDescFile")]] = kWriteImagesIntoUIDescFile,
 		kDoNotVerifyImageXMLData [[deprecated("use kDoNotVerifyImageData")]] = kDoNotVerifyImageData,
@@ -145,6 +148,43 @@ public:
 	using FocusDrawing = FocusDrawingSettings;
 	FocusDrawing getFocusDrawingSettings () const;
 	void setFocusDrawingSettings (const FocusDrawing& fd);
+
+	/** create further instances of a template by copying a view tree built once from it
+	 *
+	 *	The controller is not asked while the tree is built, but the control tags are resolved and
+	 *	verifyView is called for every view of an instance. Templates with custom views, sub
+	 *	controllers or view switch containers, and views which can not be copied, are created
+	 *	from the description every time.
+	 */
+	void setViewPrototypeCacheEnabled (bool state);
+	bool isViewPrototypeCacheEnabled () const;
+
+	/** counters of the bitmap preloading, times are in seconds */
+	struct BitmapPreloadStatistics
+	{
+		/** number of bitmaps given to the preloader */
+		uint32_t numBitmaps {0};
+		/** the sum of the decode times of all bitmaps */
+		double decodeTime {0.};
+		/** the longest decode time of a single bitmap, the preloading can not be faster */
+		double criticalPath {0.};
+		/** the time from the start of the preloading until the last bitmap was decoded */
+		double elapsedTime {0.};
+		/** the time getBitmap was blocked by bitmaps which were not decoded yet */
+		double waitTime {0.};
+	};
+
+	/** decode all bitmaps of the parsed description on a pool of threads
+	 *
+	 *	Call it after parse (). getBitmap waits only if the bitmap is not yet decoded, or decodes
+	 *	it itself if no thread started on it. The platform must be able to create bitmaps from
+	 *	files and memory on other threads than the main thread.
+	 *
+	 *	@param numThreads number of threads, 0 uses the number of hardware threads
+	 */
+	void preloadBitmaps (uint32_t numThreads = 0);
+	/** wait until all preloaded bitmaps are decoded and return the statistics */
+	BitmapPreloadStatistics getBitmapPreloadStatistics () const;
 	
 	void freePlatformResources ();
 
@@ -162,12 +202,14 @@ protected:
 	const CResourceDescription& getUIDescFile () const;
 private:
 	CView* createViewFromNode (UINode* node) const;
+	bool createViewFromPrototype (UINode* templateNode, CView*& result) const;
+	void recordViewPrototypeEntry (UINode* node, CView* view) const;
 	UINode* getBaseNode (UTF8StringPtr name) const;
 	UINode* findChildNodeByNameAttribute (UINode* node, UTF8StringPtr nameAttribute) const;
 	UINode* findNodeForView (CView* view) const;
 	bool updateAttributesForView (UINode* node, CView* view, bool deep = true);
 	void removeNode (UTF8StringPtr name, IdStringPtr mainNodeName);
-	template<typename NodeType, typename ObjType, typename CompareFunction> UTF8StringPtr lookupName (const ObjType& obj, IdStringPtr mainNodeName, CompareFunction compare) const;
+	template<typename NodeType, typename Index, typename ObjType, typename NodeKeyFunction, typename CompareFunction> UTF8StringPtr lookupName (const ObjType& obj, const typename Index::Key& key, IdStringPtr mainNodeName, Index& index, NodeKeyFunction nodeKey, CompareFunction compare, uint64_t valueRevision = 0) const;
 	template<typename NodeType> void changeNodeName (UTF8StringPtr oldName, UTF8StringPtr newName, IdStringPtr mainNodeName);
 	template<typename NodeType> void collectNamesFromNode (IdStringPtr mainNodeName, std::list<const std::string*>& names) const;
 	
@@ -149,8 +149,9 @@ CView* UIViewFactory::createViewByName (const std::string* className, const UIAt
 			IdStringPtr viewName = (*iter).second->getViewName ();
 			view->setAttribute (kViewNameAttribute, viewName);
 			UIAttributes evaluatedAttributes;
-			evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, description);
-			while (iter != registry.end () && (*iter).second->apply (view, evaluatedAttributes, description))
+			const auto& viewAttributes =
+			    evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, description);
+			while (iter != registry.end () && (*iter).second->apply (view, viewAttributes, description))
 			{
 				if ((*iter).second->getBaseViewName () == nullptr)
 					break;
@@ -186,9 +187,10 @@ bool UIViewFactory::applyAttributeValues (CView* view, const UIAttributes& attri
 	auto iter = registry.find (getViewName (view));
 
 	UIAttributes evaluatedAttributes;
-	evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, desc);
+	const auto& viewAttributes =
+	    evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, desc);
 	
-	while (iter != registry.end () && (result = (*iter).second->apply (view, evaluatedAttributes, desc)) && (*iter).second->getBaseViewName ())
+	while (iter != registry.end () && (result = (*iter).second->apply (view, viewAttributes, desc)) && (*iter).second->getBaseViewName ())
 	{
 		iter = registry.find ((*iter).second->getBaseViewName ());
 	}
@@ -207,8 +209,9 @@ bool UIViewFactory::applyCustomViewAttributeValues (CView* customView, IdStringP
 		customView->setAttribute (kViewNameAttribute, viewName);
 	}
 	UIAttributes evaluatedAttributes;
-	evaluateAttributesAndRemember (customView, attributes, evaluatedAttributes, desc);
-	while (iter != registry.end () && (result = (*iter).second->apply (customView, evaluatedAttributes, desc)) && (*iter).second->getBaseViewName ())
+	const auto& viewAttributes =
+	    evaluateAttributesAndRemember (customView, attributes, evaluatedAttributes, desc);
+	while (iter != registry.end () && (result = (*iter).second->apply (customView, viewAttributes, desc)) && (*iter).second->getBaseViewName ())
 	{
 		iter = registry.find ((*iter).second->getBaseViewName ());
 	}
@@ -225,8 +228,11 @@ IdStringPtr UIViewFactory::getViewName (CView* view)
 }
 
 //-----------------------------------------------------------------------------
-void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const
+const UIAttributes& UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const
 {
+	// the attributes are only copied if a value refers to a variable, otherwise the creators use
+	// the attributes of the node and its cached typed values
+	bool hasVariables = false;
 	std::string evaluatedValue;
 	for (const auto& attr : attributes)
 	{
@@ -236,6 +242,12 @@ void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttribut
 		#if VSTGUI_LIVE_EDITING
 			rememberAttribute (view, attr.first.c_str (), value.c_str ());
 		#endif
+			if (!hasVariables)
+			{
+				for (const auto& a : attributes)
+					evaluatedAttributes.setAttribute (a.first, a.second);
+				hasVariables = true;
+			}
 			evaluatedAttributes.setAttribute (attr.first, evaluatedValue);
 		}
 		else
@@ -254,9 +266,9 @@ void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttribut
 					break;
 			}
 		#endif
-			evaluatedAttributes.setAttribute (attr.first, value);
 		}
 	}
+	return hasVariables ? evaluatedAttributes : attributes;
 }
 
 #if VSTGUI_LIVE_EDITING
@@ -54,7 +54,7 @@ public:
 #endif
 
 protected:
-	void evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const;
+	const UIAttributes& evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const;
 	CView* createViewByName (const std::string* className, const UIAttributes& attributes, const IUIDescription* description) const;
 
 #if VSTGUI_LIVE_EDITING
@@ -9,6 +9,7 @@
 #include "../lib/controls/ccontrol.h"
 #include "../lib/animation/timingfunctions.h"
 #include "../lib/animation/animations.h"
+#include <algorithm>
 
 namespace VSTGUI {
 
@@ -43,9 +44,17 @@ void UIViewSwitchContainer::setCurrentViewIndex (int32_t viewIndex)
 
 	if (controller && viewIndex != currentViewIndex)
 	{
-		CView* view = controller->createViewForIndex (viewIndex);
+		// finish a running animation first, the kept page may still be animated out
+		if (keepAlivePages > 0 && isAttached () && animationTime)
+			removeAnimation ("UIViewSwitchContainer::setCurrentViewIndex");
+		CView* view = createPage (viewIndex);
 		if (view)
 		{
+			if (keepAlivePages > 0 && currentViewIndex >= 0)
+			{
+				if (auto oldView = getView (0))
+					keepPageAlive (currentViewIndex, oldView);
+			}
 			if (view->getAutosizeFlags () & kAutosizeAll)
 			{
 				CRect vs (getViewSize ());
@@ -144,6 +153,149 @@ void UIViewSwitchContainer::setCurrentViewIndex (int32_t viewIndex)
 	}
 }
 
+//-----------------------------------------------------------------------------
+CView* UIViewSwitchContainer::createPage (int32_t viewIndex)
+{
+	auto it = std::find_if (keptPages.begin (), keptPages.end (),
+	                        [&] (const KeptPage& page) { return page.viewIndex == viewIndex; });
+	if (it != keptPages.end ())
+	{
+		CView* view = it->view;
+		view->remember ();
+		view->setAlphaValue (it->alphaValue);
+		view->setViewSize (it->viewSize);
+		view->setMouseableArea (it->viewSize);
+		keptPages.erase (it);
+		updateWantsIdle ();
+		return view;
+	}
+	return controller->createViewForIndex (viewIndex);
+}
+
+//-----------------------------------------------------------------------------
+static uint32_t countViews (CView* view)
+{
+	uint32_t numViews = 1;
+	if (auto container = view->asViewContainer ())
+	{
+		container->forEachChild ([&] (CView* child) { numViews += countViews (child); });
+	}
+	return numViews;
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::keepPageAlive (int32_t viewIndex, CView* view)
+{
+	auto numViews = countViews (view);
+	if (keepAliveViewBudget && numViews > keepAliveViewBudget)
+		return;
+	keptPages.insert (keptPages.begin (),
+	                  {viewIndex, view, numViews, view->getAlphaValue (), view->getViewSize ()});
+	evictKeptPages ();
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::evictKeptPages ()
+{
+	if (keptPages.size () > keepAlivePages)
+		keptPages.resize (keepAlivePages);
+	if (keepAliveViewBudget)
+	{
+		uint32_t numViews = 0;
+		for (const auto& page : keptPages)
+			numViews += page.numViews;
+		while (numViews > keepAliveViewBudget)
+		{
+			numViews -= keptPages.back ().numViews;
+			keptPages.pop_back ();
+		}
+	}
+	updateWantsIdle ();
+}
+
+//-----------------------------------------------------------------------------
+bool UIViewSwitchContainer::isPageKeptAlive (int32_t viewIndex) const
+{
+	return std::any_of (keptPages.begin (), keptPages.end (),
+	                    [&] (const KeptPage& page) { return page.viewIndex == viewIndex; });
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::releaseKeptAlivePages ()
+{
+	keptPages.clear ();
+	prebuildBlocked = false;
+	updateWantsIdle ();
+}
+
+//-----------------------------------------------------------------------------
+int32_t UIViewSwitchContainer::nextPageToPrebuild () const
+{
+	if (!controller || prebuildBlocked || keptPages.size () >= keepAlivePages)
+		return -1;
+	auto numViews = controller->getNumViews ();
+	auto start = std::max (currentViewIndex, 0);
+	for (auto offset = 0; offset < numViews; ++offset)
+	{
+		auto viewIndex = (start + offset) % numViews;
+		if (viewIndex != currentViewIndex && !isPageKeptAlive (viewIndex))
+			return viewIndex;
+	}
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::updateWantsIdle ()
+{
+	setWantsIdle (prebuildPages && nextPageToPrebuild () != -1);
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::onIdle ()
+{
+	auto viewIndex = nextPageToPrebuild ();
+	if (viewIndex == -1)
+	{
+		setWantsIdle (false);
+		return;
+	}
+	if (auto view = controller->createViewForIndex (viewIndex))
+	{
+		// prebuilt pages were never shown, so they are the first to be released
+		keptPages.push_back ({viewIndex, view, countViews (view), view->getAlphaValue (),
+		                      view->getViewSize ()});
+		view->forget ();
+		evictKeptPages ();
+		if (isPageKeptAlive (viewIndex))
+			return;
+	}
+	prebuildBlocked = true;
+	setWantsIdle (false);
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::setKeepAlivePages (uint32_t numPages)
+{
+	keepAlivePages = numPages;
+	prebuildBlocked = false;
+	evictKeptPages ();
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::setKeepAliveViewBudget (uint32_t numViews)
+{
+	keepAliveViewBudget = numViews;
+	prebuildBlocked = false;
+	evictKeptPages ();
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::setPrebuildPages (bool state)
+{
+	prebuildPages = state;
+	updateWantsIdle ();
+}
+
 //-----------------------------------------------------------------------------
 void UIViewSwitchContainer::setAnimationTime (uint32_t ms)
 {
@@ -182,6 +334,7 @@ bool UIViewSwitchContainer::removed (CView* parent)
 		if (result && controller)
 			controller->switchContainerRemoved ();
 		CViewContainer::removeAll ();
+		releaseKeptAlivePages ();
 		return result;
 	}
 	return false;
@@ -211,6 +364,12 @@ CView* UIDescriptionViewSwitchController::createViewForIndex (int32_t index)
 	return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+int32_t UIDescriptionViewSwitchController::getNumViews () const
+{
+	return static_cast<int32_t> (templateNames.size ());
+}
+
 //-----------------------------------------------------------------------------
 static CControl* findControlForTag (CViewContainer* parent, int32_t tag, bool reverse = true)
 {
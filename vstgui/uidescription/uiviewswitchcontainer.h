@@ -50,8 +50,30 @@ public:
 	void setTimingFunction (TimingFunction t);
 	TimingFunction getTimingFunction () const { return timingFunction; }
 
+	/** number of pages which are kept alive detached after switching away from them, so that
+	 *	switching back to them does not create the views again. 0 disables the pool.
+	 */
+	void setKeepAlivePages (uint32_t numPages);
+	uint32_t getKeepAlivePages () const { return keepAlivePages; }
+
+	/** maximum number of views in all kept alive pages together, 0 means no limit.
+	 *	The least recently shown pages are released first when the budget is exceeded.
+	 */
+	void setKeepAliveViewBudget (uint32_t numViews);
+	uint32_t getKeepAliveViewBudget () const { return keepAliveViewBudget; }
+
+	/** create the pages which are not yet kept alive on idle while the container is attached */
+	void setPrebuildPages (bool state);
+	bool getPrebuildPages () const { return prebuildPages; }
+
+	/** returns true if the page for the index is kept alive */
+	bool isPageKeptAlive (int32_t viewIndex) const;
+	/** release all kept alive pages */
+	void releaseKeptAlivePages ();
+
 	bool attached (CView* parent) override;
 	bool removed (CView* parent) override;
+	void onIdle () override;
 //-----------------------------------------------------------------------------
 	CLASS_METHODS (UIViewSwitchContainer, CViewContainer)
 protected:
@@ -60,6 +82,29 @@ protected:
 	uint32_t animationTime {120};
 	AnimationStyle animationStyle {kFadeInOut};
 	TimingFunction timingFunction {kLinear};
+	uint32_t keepAlivePages {0};
+	uint32_t keepAliveViewBudget {0};
+	bool prebuildPages {false};
+
+private:
+	struct KeptPage
+	{
+		int32_t viewIndex;
+		SharedPointer<CView> view;
+		uint32_t numViews;
+		// the exchange animation changes the alpha value and the size of the old view
+		float alphaValue;
+		CRect viewSize;
+	};
+
+	CView* createPage (int32_t viewIndex);
+	void keepPageAlive (int32_t viewIndex, CView* view);
+	void evictKeptPages ();
+	int32_t nextPageToPrebuild () const;
+	void updateWantsIdle ();
+
+	std::vector<KeptPage> keptPages; // most recently shown first
+	bool prebuildBlocked {false};
 };
 
 //-----------------------------------------------------------------------------
@@ -74,6 +119,8 @@ public:
 	UIViewSwitchContainer* getViewSwitchContainer () const { return viewSwitch; }
 
 	virtual CView* createViewForIndex (int32_t index) = 0;
+	/** number of views the controller can create, used to prebuild pages */
+	virtual int32_t getNumViews () const { return 0; }
 	virtual void switchContainerAttached () = 0;
 	virtual void switchContainerRemoved () = 0;
 protected:
@@ -87,6 +134,7 @@ public:
 	UIDescriptionViewSwitchController (UIViewSwitchContainer* viewSwitch, const IUIDescription* uiDescription, IController* uiController);
 
 	CView* createViewForIndex (int32_t index) override;
+	int32_t getNumViews () const override;
 	void switchContainerAttached () override;
 	void switchContainerRemoved () override;
 
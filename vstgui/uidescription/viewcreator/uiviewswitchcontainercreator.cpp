@@ -9,6 +9,7 @@
 #include "../uiviewcreator.h"
 #include "../uiviewfactory.h"
 #include "../uiviewswitchcontainer.h"
+#include <algorithm>
 #include <array>
 
 //------------------------------------------------------------------------
@@ -123,6 +124,22 @@ bool UIViewSwitchContainerCreator::apply (CView* view, const UIAttributes& attri
 	{
 		viewSwitch->setAnimationTime (static_cast<uint32_t> (animationTime));
 	}
+	int32_t keepAlivePages;
+	if (attributes.getIntegerAttribute (kAttrKeepAlivePages, keepAlivePages))
+	{
+		viewSwitch->setKeepAlivePages (static_cast<uint32_t> (std::max (keepAlivePages, 0)));
+	}
+	int32_t keepAliveViewBudget;
+	if (attributes.getIntegerAttribute (kAttrKeepAliveViewBudget, keepAliveViewBudget))
+	{
+		viewSwitch->setKeepAliveViewBudget (
+		    static_cast<uint32_t> (std::max (keepAliveViewBudget, 0)));
+	}
+	bool prebuildPages;
+	if (attributes.getBooleanAttribute (kAttrPrebuildPages, prebuildPages))
+	{
+		viewSwitch->setPrebuildPages (prebuildPages);
+	}
 	return true;
 }
 
@@ -134,6 +151,9 @@ bool UIViewSwitchContainerCreator::getAttributeNames (StringList& attributeNames
 	attributeNames.emplace_back (kAttrAnimationStyle);
 	attributeNames.emplace_back (kAttrAnimationTimingFunction);
 	attributeNames.emplace_back (kAttrAnimationTime);
+	attributeNames.emplace_back (kAttrKeepAlivePages);
+	attributeNames.emplace_back (kAttrKeepAliveViewBudget);
+	attributeNames.emplace_back (kAttrPrebuildPages);
 	return true;
 }
 
@@ -150,6 +170,12 @@ auto UIViewSwitchContainerCreator::getAttributeType (const string& attributeName
 		return kListType;
 	if (attributeName == kAttrAnimationTime)
 		return kIntegerType;
+	if (attributeName == kAttrKeepAlivePages)
+		return kIntegerType;
+	if (attributeName == kAttrKeepAliveViewBudget)
+		return kIntegerType;
+	if (attributeName == kAttrPrebuildPages)
+		return kBooleanType;
 	return kUnknownType;
 }
 
@@ -193,6 +219,23 @@ bool UIViewSwitchContainerCreator::getAttributeValue (CView* view, const string&
 		    UIAttributes::integerToString (static_cast<int32_t> (viewSwitch->getAnimationTime ()));
 		return true;
 	}
+	else if (attributeName == kAttrKeepAlivePages)
+	{
+		stringValue =
+		    UIAttributes::integerToString (static_cast<int32_t> (viewSwitch->getKeepAlivePages ()));
+		return true;
+	}
+	else if (attributeName == kAttrKeepAliveViewBudget)
+	{
+		stringValue = UIAttributes::integerToString (
+		    static_cast<int32_t> (viewSwitch->getKeepAliveViewBudget ()));
+		return true;
+	}
+	else if (attributeName == kAttrPrebuildPages)
+	{
+		stringValue = UIAttributes::boolToString (viewSwitch->getPrebuildPages ());
+		return true;
+	}
 	else if (attributeName == kAttrAnimationStyle)
 	{
 		stringValue = animationStyleStrings ()[viewSwitch->getAnimationStyle ()];
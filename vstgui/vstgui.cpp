@@ -2,6 +2,7 @@
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
+#include "lib/bitmapcache.cpp"
 #include "lib/cbitmap.cpp"
 #include "lib/cbitmapfilter.cpp"
 #include "lib/cclipboard.cpp"
@@ -32,9 +33,12 @@
 #include "lib/cview.cpp"
 #include "lib/cviewcontainer.cpp"
 #include "lib/cvstguitimer.cpp"
+#include "lib/detail/boxblur.cpp"
 #include "lib/events.cpp"
 #include "lib/genericstringlistdatabrowsersource.cpp"
+#include "lib/meterfeed.cpp"
 #include "lib/pixelbuffer.cpp"
+#include "lib/viewdrawcache.cpp"
 #include "lib/vstguidebug.cpp"
 #include "lib/vstguiinit.cpp"
 
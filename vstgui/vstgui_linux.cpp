@@ -6,6 +6,7 @@
 #include "lib/platform/linux/x11fileselector.cpp"
 #include "lib/platform/linux/x11frame.cpp"
 #include "lib/platform/linux/x11platform.cpp"
+#include "lib/platform/linux/x11shmbackbuffer.cpp"
 #include "lib/platform/linux/x11timer.cpp"
 #include "lib/platform/linux/x11utils.cpp"
 
@@ -14,5 +15,7 @@
 #include "lib/platform/linux/cairofont.cpp"
 #include "lib/platform/linux/cairogradient.cpp"
 #include "lib/platform/linux/cairopath.cpp"
+#include "lib/platform/linux/cairotilerenderer.cpp"
+#include "lib/platform/linux/cairoviewlayer.cpp"
 
 #include "lib/platform/linux/linuxfactory.cpp"
@@ -4,6 +4,7 @@
 
 #include "vstgui_uidescription.h"
 
+#include "uidescription/base64codec.cpp"
 #include "uidescription/compresseduidescription.cpp"
 #include "uidescription/cstream.cpp"
 #include "uidescription/uiattributes.cpp"
@@ -71,6 +72,8 @@
 #include "uidescription/viewcreator/vumetercreator.cpp"
 #include "uidescription/viewcreator/xypadcreator.cpp"
 
+#include "uidescription/detail/uibinarypersistence.cpp"
+#include "uidescription/detail/uibitmappreloader.cpp"
 #include "uidescription/detail/uidesclist.cpp"
 #include "uidescription/detail/uijsonpersistence.cpp"
 #include "uidescription/detail/uinode.cpp"